@@ -353,20 +353,25 @@ Only a dummy now, filled for the xml acompanying saved images.
           <YCutoff_Fraction>0.1</YCutoff_Fraction>
           <XRetrace_Fraction>0.2</XRetrace_Fraction>
           <YRetrace_Fraction>0.05</YRetrace_Fraction>
+          <LineRepeats>1</LineRepeats>
         </preset0>
       </presets>
       <XCutoff_Fraction>0.1</XCutoff_Fraction>
       <YCutoff_Fraction>0.1</YCutoff_Fraction>
       <XRetrace_Fraction>0.1</XRetrace_Fraction>
       <YRetrace_Fraction>0.1</YRetrace_Fraction>
+      <LineRepeats>1</LineRepeats>
     </framesawtooth>
 ~~~~~
 Initial settings for sawtooth framescanning on program start. Important in xml files acompanying a saved image (Note: in
 'area0-ScanMode' you can see which type of scan was used to acquire that image).
 Have a look at scope::parameters::ScannerVectorFrameBasic and scope::parameters::ScannerVectorFrameSaw for further information.
-Check also scope::PixelmapperFrameSaw to see how an image is assembled depending on these parameters. If have put in a
+Check also scope::PixelmapperFrameLineRepeat to see how an image is assembled depending on these parameters. If have put in a
 preset as an example. If you save presets in Scope (and save the parameter file afterwards or use one that was saved
 with an image) more stuff is put in here. See scope::parameters::ScannerVectorFrameSaw::Preset.
+With LineRepeats larger than 1 every image line is scanned that often before y moves on (y is held) and the repeats are averaged
+line by line. Compared to frame averaging (Averages) the samples of a pixel are only a line time apart and every frame is complete
+after one pass.
 ~~~~~
     <framebidirectional>
       <XResolution_Pixel>256</XResolution_Pixel>
@@ -398,10 +403,87 @@ to see how an image is assembled depending on these parameters.
       <XRotation_Degree>0</XRotation_Degree>
       <YRotation_Degree>0</YRotation_Degree>
       <presets />
+      <XCutoff_Fraction>0.1</XCutoff_Fraction>
+      <YCutoff_Fraction>0.1</YCutoff_Fraction>
+      <XRetrace_Fraction>0.1</XRetrace_Fraction>
+      <YRetrace_Fraction>0.1</YRetrace_Fraction>
+      <Plane0>
+        <ZPosition_um>0</ZPosition_um>
+        <Pockels_Fraction>0.2</Pockels_Fraction>
+      </Plane0>
+      <Plane1>
+        <ZPosition_um>50</ZPosition_um>
+        <Pockels_Fraction>0.3</Pockels_Fraction>
+      </Plane1>
     </frameplanehopper>
 ~~~~~
-Initial settings for plane hopper framescanning on program start. Have a look at scope::parameters::ScannerVectorFramePlaneHopper
-for further information. Note that the plane hopping is not fully implemented yet!
+Initial settings for plane hopper framescanning on program start. Every plane is scanned as a sawtooth frame with its own fast z
+position and Pockels value, one after the other. Every plane goes into its own image (scope::PixelmapperFramePlaneHopper), planes are
+displayed one below the other and saved into separate files (_P0, _P1, ...). Have a look at scope::parameters::ScannerVectorFramePlaneHopper
+for further information.
+~~~~~
+    <Volume>
+      <XResolution>256</XResolution>
+      <YResolution>256</YResolution>
+      <Zoom>1</Zoom>
+      <XOffset_Fraction>0</XOffset_Fraction>
+      <YOffset_Fraction>0</YOffset_Fraction>
+      <FastZ_um>0</FastZ_um>
+      <Pockels_Fraction>0</Pockels_Fraction>
+      <XRotation_Degree>0</XRotation_Degree>
+      <YRotation_Degree>0</YRotation_Degree>
+      <presets />
+      <XCutoff_Fraction>0.1</XCutoff_Fraction>
+      <YCutoff_Fraction>0.1</YCutoff_Fraction>
+      <XRetrace_Fraction>0.1</XRetrace_Fraction>
+      <YRetrace_Fraction>0.1</YRetrace_Fraction>
+      <Slices>10</Slices>
+      <ZStart_um>0</ZStart_um>
+      <ZStop_um>100</ZStop_um>
+      <ContinuousZ>false</ContinuousZ>
+    </Volume>
+~~~~~
+Initial settings for volume scanning on program start. Slices sawtooth frames are scanned from ZStart_um to ZStop_um. With ContinuousZ
+false the fast z steps from slice to slice during the y retrace (staircase), with ContinuousZ true it moves line by line through the whole volume
+and back during the last slice's y retrace (sawtooth). Positions are converted with the fast z calibration into a voltage lookup table with one
+entry per line. Slices are mapped, displayed and saved like the planes of the plane hopper. Have a look at scope::parameters::ScannerVectorFrameVolume
+for further information.
+~~~~~
+    <Lissajous>
+      <XResolution>256</XResolution>
+      <YResolution>256</YResolution>
+      <Zoom>1</Zoom>
+      <XOffset_Fraction>0</XOffset_Fraction>
+      <YOffset_Fraction>0</YOffset_Fraction>
+      <FastZ_um>0</FastZ_um>
+      <Pockels_Fraction>0</Pockels_Fraction>
+      <XRotation_Degree>0</XRotation_Degree>
+      <YRotation_Degree>0</YRotation_Degree>
+      <presets />
+      <SamplesPerPixel>4</SamplesPerPixel>
+      <XCycles>256</XCycles>
+      <YCycles>255</YCycles>
+    </Lissajous>
+    <Spiral>
+      <XResolution>256</XResolution>
+      <YResolution>256</YResolution>
+      <Zoom>1</Zoom>
+      <XOffset_Fraction>0</XOffset_Fraction>
+      <YOffset_Fraction>0</YOffset_Fraction>
+      <FastZ_um>0</FastZ_um>
+      <Pockels_Fraction>0</Pockels_Fraction>
+      <XRotation_Degree>0</XRotation_Degree>
+      <YRotation_Degree>0</YRotation_Degree>
+      <presets />
+      <SamplesPerPixel>4</SamplesPerPixel>
+      <Turns>128</Turns>
+    </Spiral>
+~~~~~
+Initial settings for smooth trajectory scans on program start. A Lissajous frame consists of XCycles x and YCycles y sine periods (similar
+numbers without a common divisor cover the field most evenly), a spiral frame goes from the center out to the edge of the field in Turns
+revolutions and back in. There are no turnarounds and no flyback, every sample is used. A frame has SamplesPerPixel*XResolution*YResolution
+samples, pixels hit several times are averaged and pixels the trajectory misses are filled from their nearest hit neighbour
+(scope::PixelmapperTrajectory). Have a look at scope::parameters::ScannerVectorLissajous and scope::parameters::ScannerVectorSpiral for further information.
 ~~~~~
     <fpuzstage>
 	  <Position_um>0</Position_um>
@@ -462,10 +544,12 @@ See scope::StorageController for details.
     <Spacing_um>1</Spacing_um>
     <ZDeviceType>ZStage</ZDeviceType>
 	<OverallTime_s>1</OverallTime_s>
+	<ContinuousFastZ>false</ContinuousFastZ>
   </stack>
 ~~~~~
 This is filled with useful information in the xml accompanying a saved stack.\n
-See scope::ScopeController::ScopeControllerImpl::RunStack for details.
+See scope::ScopeController::ScopeControllerImpl::RunStack for details. With ContinuousFastZ true and ZDeviceType FastZ the whole stack
+is acquired in one run with precalculated fast z and Pockels waveforms for all planes (see scope::ScopeController::RunStackContinuous).
 ~~~~~
   <timeseries>
     <Frames>1</Frames>
@@ -513,10 +597,20 @@ Using the sample clock of the analog output task on the same card ensures synchr
 This is filled with information from inside Scope.
 ~~~~~
 	<frames />
-</scope>
 ~~~~~
 If you click on "Tools->Save window positions" in Scope the current positionts of all its windows are saved. If you then choose "File->Save parameters..." these
-window positions are saved in here in the parameters xml file.\n\n
+window positions are saved in here in the parameters xml file.
+~~~~~
+	<threads>
+		<DaqPriority>0</DaqPriority>
+		<DaqAffinityMask>0</DaqAffinityMask>
+		<PipelinePriority>0</PipelinePriority>
+		<PipelineAffinityMask>0</PipelineAffinityMask>
+	</threads>
+</scope>
+~~~~~
+Windows thread priorities (e.g. 2 for highest) and CPU affinity masks (0 for all CPUs) of the DAQ and pipeline worker threads. The controllers keep
+their worker threads for the whole session, see scope::BaseController and scope::WorkerThread. Optional, leave it out for the defaults.\n\n
 That's it!
 */
 
@@ -829,7 +923,7 @@ User 'yoursourceforgeusername', Environment-Directories-Remote directory '/home/
 - using Windows Imaging Components for TIFF saving (see scope::ScopeMultiImageEncoder) and [exiftools.exe](http://www.sno.phy.queensu.ca/~phil/exiftool/) for writing [ImageJ](http://rsbweb.nih.gov/ij/) compatible TIFF tags (see scope::StorageController::StorageControllerImpl::FixTIFFTags).
 - A pipeline of 'controllers' for data acquisition (scope::DaqController), assembling images (scope::PipelineController), displaying images and histograms (scope::DisplayController), and storing to disk (scope::StorageController)
 - classes for different hardware for sampling PMT input (scope::InputsDAQmx and scope::InputsFPGA), and FPGA classes (scope::FPGADemultiplexer, scope::FPGAPhotonCounterV2)
-- classes for different scan modes, until now frame scanning in sawtooth (scope::ScannerVectorFrameSaw) or bidirectional (scope::ScannerVectorFrameBiDi) mode and ETL plane hopping (scope::ScannerVectorFramePlaneHopper)
+- classes for different scan modes, until now frame scanning in sawtooth (scope::ScannerVectorFrameSaw) or bidirectional (scope::ScannerVectorFrameBiDi) mode, scanning only selected regions of interest (scope::ScannerVectorFrameMultiROI), line scans along a straight or freehand path for kymographs (scope::ScannerVectorLine), ETL plane hopping (scope::ScannerVectorFramePlaneHopper), continuous fast z volume scanning (scope::ScannerVectorFrameVolume) and Lissajous or spiral trajectories (scope::ScannerVectorLissajous, scope::ScannerVectorSpiral)
 - the ability to run all these controller for every area in a separate thread
 - implementing a custom set of thread-safe values (scope::ScopeValue, scope::ScopeNumber, scope::ScopeString) that can be connected to functions via Boost::signals2
 - implementing a custom set of thread-safe controls (scope::gui::CScopeEditCtrl, scope::gui::CScopeSliderCtrl, ...) to use underlying scope::ScopeValue.
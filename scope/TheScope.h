@@ -16,6 +16,7 @@
 #include "devices/xyz/XYZControl.h"
 #include "devices/xyz/XYZControlGalil.h"
 #include "devices/xyz/XYZControlSutter.h"
+#include "devices/xyz/XYZControlSimulated.h"
 #include "TheScopeButtons.h"
 #include "TheScopeCounters.h"
 
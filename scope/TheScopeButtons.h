@@ -45,9 +45,13 @@ namespace scope {
 		ScanModeButtons() {
 			map.emplace(ScannerVectorTypeHelper::Mode::Bidirectional, ScopeScanModeButton(ScannerVectorTypeHelper::Mode::Bidirectional));
 			map.emplace(ScannerVectorTypeHelper::Mode::LineStraight, ScopeScanModeButton(ScannerVectorTypeHelper::Mode::LineStraight));
+			map.emplace(ScannerVectorTypeHelper::Mode::Lissajous, ScopeScanModeButton(ScannerVectorTypeHelper::Mode::Lissajous));
+			map.emplace(ScannerVectorTypeHelper::Mode::MultiROI, ScopeScanModeButton(ScannerVectorTypeHelper::Mode::MultiROI));
 			map.emplace(ScannerVectorTypeHelper::Mode::Planehopper, ScopeScanModeButton(ScannerVectorTypeHelper::Mode::Planehopper));
 			map.emplace(ScannerVectorTypeHelper::Mode::ResonanceBiDi, ScopeScanModeButton(ScannerVectorTypeHelper::Mode::ResonanceBiDi));
 			map.emplace(ScannerVectorTypeHelper::Mode::ResonanceHopper, ScopeScanModeButton(ScannerVectorTypeHelper::Mode::ResonanceHopper));
+			map.emplace(ScannerVectorTypeHelper::Mode::Spiral, ScopeScanModeButton(ScannerVectorTypeHelper::Mode::Spiral));
+			map.emplace(ScannerVectorTypeHelper::Mode::Volume, ScopeScanModeButton(ScannerVectorTypeHelper::Mode::Volume));
 			map.emplace(ScannerVectorTypeHelper::Mode::Sawtooth, ScopeScanModeButton(ScannerVectorTypeHelper::Mode::Sawtooth));
 		}
 	};
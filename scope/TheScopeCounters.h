@@ -6,13 +6,13 @@ namespace scope {
 	
 	/** Keeps the counters used by TheScope together. */
 	struct ScopeCounters {
-		/** Updated from PipelineController::Run */
+		/** Updated from PipelineController::Run, in coalescing mode */
 		std::vector<ScopeNumber<double>> singleframeprogress;
 
 		/** Updated from ScopeController::RunStack, connected to progress indicator in CStackSettingsPage */
 		ScopeNumber<double> planecounter;
 
-		/** Updated from PipelineController::Run, connected to progress indicator in CTimeSeriesSettingsPage or edit control in CBehaviorSettingsPage */
+		/** Updated from PipelineController::Run (in coalescing mode), connected to progress indicator in CTimeSeriesSettingsPage or edit control in CBehaviorSettingsPage */
 		std::vector<ScopeNumber<double>> framecounter;
 
 		/** Updated from ScopeController::RunTimeseries, connected to progress indicator in CTimeSeriesSettingsPage */
@@ -36,6 +36,12 @@ namespace scope {
 				singleframeprogress.push_back(ScopeNumber<double>(0.0, 0.0, 1.0, L"SingleFrameProgress"));
 				framecounter.push_back(ScopeNumber<double>(0.0, 0.0, 1000000, L"FrameCounter"));
 			}
+			// Set after every chunk, so only notify at the ScopeValueNotifier rate. Not before the vectors are filled, since
+			// registration is per object and the elements move while the vectors grow.
+			for ( uint32_t a = 0 ; a < _nareas ; a++) {
+				singleframeprogress[a].SetCoalescing(true);
+				framecounter[a].SetCoalescing(true);
+			}
 		}
 	};
 
@@ -17,11 +17,11 @@ namespace scope {
 		constexpr OutputEnum outputselect = OutputEnum::SimpleDAQmx; // SimpleDAQmx, TwoCardDAQmx, SimpleDAQmx_Resonance
 		constexpr uint32_t nchannels = 2;
 		typedef uint16_t daqdatatype;
-		constexpr InputEnum inputselect = InputEnum::DAQmx; //DAQmx, FPGA_NoiseOutput, FPGA_Photoncounter, FPGA_Digitaldemultiplexer, FPGA_Analogintegrator, FPGA_Analogdemultiplexer, FPGA_Resonancescanner, FPGA_ResonancescannerNI5771
+		constexpr InputEnum inputselect = InputEnum::DAQmx; //DAQmx, FPGA_NoiseOutput, FPGA_Photoncounter, FPGA_Digitaldemultiplexer, FPGA_Analogintegrator, FPGA_Analogdemultiplexer, FPGA_Resonancescanner, FPGA_ResonancescannerNI5771, Simulated
 		constexpr DaqChunkEnum daqchunkselect = DaqChunkEnum::Regular; // Regular, Resonance
 		constexpr FPUXYStageEnum fpuxystageselect = FPUXYStageEnum::None; // None, Standa
 		constexpr FPUZStageEnum fpuzstageselect = FPUZStageEnum::None; // None, ETL
-		constexpr XYZStageEnum xyzstageselect = XYZStageEnum::None; // None, Galil, Sutter
+		constexpr XYZStageEnum xyzstageselect = XYZStageEnum::None; // None, Galil, Sutter, Simulated
 		constexpr StimulationsEnum stimulations = StimulationsEnum::DAQmx; // DAQmx
 		constexpr MultiImageEnum multiimage = MultiImageEnum::Regular; // Regular, ResonanceSW
 		constexpr OverlayEnum overlay = OverlayEnum::Regular; // Regular, ResonanceSW
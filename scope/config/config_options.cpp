@@ -3,6 +3,7 @@
 #include "devices\Inputs.h"
 #include "devices\InputsDAQmx.h"
 #include "devices\InputsFPGA.h"
+#include "devices\InputsSimulated.h"
 #include "devices\Outputs.h"
 #include "devices\OutputsDAQmx.h"
 #include "devices\OutputsDAQmxLineClock.h"
@@ -22,6 +23,7 @@
 #include "devices\xyz\XYZControl.h"
 #include "devices\xyz\XYZControlGalil.h"
 #include "devices\xyz\XYZControlSutter.h"
+#include "devices\xyz\XYZControlSimulated.h"
 #include "parameters\Inputs.h"
 #include "parameters\Outputs.h"
 #include "parameters\Devices.h"
@@ -14,6 +14,7 @@ namespace scope {
 	class ZeroOutputsDAQmxResonanceSlave;
 	class InputsDAQmx;
 	class InputsFPGA;
+	class InputsSimulated;
 	template<uint32_t NCHANNELS, uint32_t NAREAS, class DATA_T> class DaqMultiChunk;
 	template<uint32_t NCHANNELS, uint32_t NAREAS, class DATA_T> class DaqMultiChunkResonance;
 	class FPGANoiseOutput;
@@ -31,6 +32,7 @@ namespace scope {
 	class XYZControl;
 	class XYZControlGalil;
 	class XYZControlSutter;
+	class XYZControlSimulated;
 	class ScopeMultiImage;
 	class ScopeMultiImageResonanceSW;
 	typedef std::shared_ptr<ScopeMultiImage> ScopeMultiImagePtr;
@@ -49,6 +51,7 @@ namespace scope {
 		class OutputsDAQmxResonance;
 		class OutputsDAQmxResonanceSlave;
 		class InputsDAQmx;
+		class InputsSimulated;
 		class InputsFPGANoiseOutput;
 		class InputsFPGAPhotonCounter;
 		class InputsFPGADigitalDemultiplexer;
@@ -62,10 +65,12 @@ namespace scope {
 		class XYZControl;
 		class XYZControlGalil;
 		class XYZControlSutter;
+		class XYZControlSimulated;
 	}
 	
 	namespace gui {
 		class CDAQmxPage;
+		class CSimulatedInputsPage;
 		class CFPGANoiseOutputPage;
 		class CFPGAPhotonCounterPage;
 		class CFPGADigitalDemultiplexerPage;
@@ -146,7 +151,8 @@ namespace scope {
 			FPGA_Analogintegrator,
 			FPGA_Analogdemultiplexer,
 			FPGA_Resonancescanner,
-			FPGA_ResonancescannerNI5771
+			FPGA_ResonancescannerNI5771,
+			Simulated
 		};
 
 		template<InputEnum>
@@ -213,6 +219,14 @@ namespace scope {
 			typedef gui::CFPGAResonanceScannerNI5771Page type_guipage;
 		};
 
+		template<>
+		struct InputTypeSelector<InputEnum::Simulated> {
+			typedef InputsSimulated type;
+			typedef parameters::InputsSimulated type_parameters;
+			typedef FPGANoiseOutput type_fpga;
+			typedef gui::CSimulatedInputsPage type_guipage;
+		};
+
 		enum class DaqChunkEnum {
 			Regular,
 			Resonance
@@ -267,7 +281,8 @@ namespace scope {
 		enum class XYZStageEnum {
 			None,
 			Galil,
-			Sutter
+			Sutter,
+			Simulated
 		};
 
 		template<XYZStageEnum>
@@ -287,6 +302,12 @@ namespace scope {
 			typedef XYZControlSutter type;
 			typedef parameters::XYZControlSutter type_parameters;
 		};
+
+		template<>
+		struct XYZStageTypeSelector<XYZStageEnum::Simulated> {
+			typedef XYZControlSimulated type;
+			typedef parameters::XYZControlSimulated type_parameters;
+		};
 		
 		enum class StimulationsEnum {
 			DAQmx
@@ -9,15 +9,39 @@ namespace scope {
 		, stops(_nactives)
 	{
 		ATLASSERT(_nactives > 0);
+		for (uint32_t a = 0; a < nactives; a++)
+			workers.push_back(std::make_unique<WorkerThread>(WorkerThreadSettings(L"Controller worker " + std::to_wstring(a))));
+	}
+
+	void BaseController::StartWorker(const uint32_t& _a, std::function<ControllerReturnStatus(void)> _job) {
+		ATLASSERT(_a < nactives);
+		// A worker thread runs one worker function at a time, stop a previous one that is still running
+		if (workers[_a]->Busy()) {
+			DBOUT(L"BaseController::StartWorker - previous worker function still running, stopping it\n");
+			stops[_a].Set(true);
+			workers[_a]->WaitIdle();
+		}
+		stops[_a].Set(false);
+		auto promise = std::make_shared<std::promise<ControllerReturnStatus>>();
+		futures[_a] = promise->get_future().share();
+		workers[_a]->Execute([promise, _job]() {
+			try {
+				promise->set_value(_job());
+			}
+			catch (...) { promise->set_exception(std::current_exception()); }
+		});
+	}
+
+	void BaseController::ConfigureWorkers(const std::wstring& _name, const int32_t& _priority, const uint64_t& _affinity) {
+		for (uint32_t a = 0; a < nactives; a++)
+			workers[a]->Configure(WorkerThreadSettings(_name + L" " + std::to_wstring(a), _priority, _affinity));
 	}
 
 	void BaseController::Start() {
 		DBOUT(L"BaseController::Start\n");
-		for (uint32_t a = 0; a < nactives; a++) {
-			stops[a].Set(false);
-			// Let "Run" run asynchronously and get its future
-			futures[a] = std::async(std::bind(&BaseController::Run, this, &stops[a], a));
-		}
+		// Let "Run" run in the worker threads and get the futures
+		for (uint32_t a = 0; a < nactives; a++)
+			StartWorker(a, std::bind(&BaseController::Run, this, &stops[a], a));
 	}
 
 	void BaseController::StopOne(const uint32_t& _a) {
@@ -67,4 +91,12 @@ namespace scope {
 		return totalresult;
 	}
 
+	bool BaseController::Running() const {
+		for (const auto& f : futures) {
+			if (f.valid() && (f.wait_for(std::chrono::milliseconds(0)) != std::future_status::ready))
+				return true;
+		}
+		return false;
+	}
+
 }
\ No newline at end of file
@@ -2,6 +2,7 @@
 
 #include "helpers\helpers.h"
 #include "helpers/ScopeDatatypes.h"
+#include "helpers/WorkerThread.h"
  
 namespace scope {
 
@@ -19,7 +20,22 @@ protected:
 	/** handed to the asynchronous Run worker functions */
 	std::vector<StopCondition> stops;
 
+	/** long-lived threads the Run worker functions execute in, one for each active (declare after futures, so the threads are ended first) */
+	std::vector<std::unique_ptr<WorkerThread>> workers;
+
 protected:
+	/** Executes a worker function in worker thread _a and puts its ControllerReturnStatus into futures[_a]. If the worker thread still runs
+	* the previous worker function, that one is stopped and waited for first. Resets stops[_a] before executing _job.
+	* @param[in] _a which worker thread to use
+	* @param[in] _job the worker function */
+	void StartWorker(const uint32_t& _a, std::function<ControllerReturnStatus(void)> _job);
+
+	/** Sets name, priority and CPU affinity of all worker threads, applied before their next worker function
+	* @param[in] _name the threads are named _name plus their number
+	* @param[in] _priority Windows thread priority
+	* @param[in] _affinity CPU affinity mask, 0 for all CPUs */
+	void ConfigureWorkers(const std::wstring& _name, const int32_t& _priority = THREAD_PRIORITY_NORMAL, const uint64_t& _affinity = 0);
+
 	/** The worker function that will run asynchronously.
 	* @warning Every work function should regularly check the stop condition and should return on a boost::thread_interrupted exception.
 	* @return since this is only a dummy, always returns ControllerReturnStatus(error). */
@@ -40,7 +56,7 @@ public:
 	// Disable assignment
 	BaseController operator=(const BaseController& _other) = delete;
 
-	/** Execute the Run worker functions asynchronously, give them a reference to a StopCondition and get their ControllerReturnStatus futures. */
+	/** Execute the Run worker functions in the worker threads, give them a reference to a StopCondition and get their ControllerReturnStatus futures. */
 	virtual void Start();
 
 	/** Request one async worker function to stop by settings its StopCondition to true.
@@ -60,6 +76,9 @@ public:
 	* @param[in] _wait_time time in milliseconds to wait for the async worker function to return, if -1 wait indefinitely
 	* @return the cumulated (or'ed) ControllerReturnStatus' from all async worker functions' futures */
 	virtual ControllerReturnStatus WaitForAll(const int32_t& _wait_time);
+
+	/** @return true if at least one async worker function has not returned yet */
+	bool Running() const;
 };
 
 }
\ No newline at end of file
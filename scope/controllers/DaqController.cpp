@@ -1,8 +1,41 @@
 #include "stdafx.h"
 #include "DaqController.h"
+#include "helpers/ScopeTrace.h"
+#include "helpers/DiagnosticLog.h"
 
 namespace scope {
 
+	StartLatencyStatistics::StartLatencyStatistics() {
+		Reset();
+	}
+
+	void StartLatencyStatistics::Reset() {
+		std::lock_guard<std::mutex> lock(mutex);
+		count.fill(0);
+		sum.fill(0.0);
+		max.fill(0.0);
+	}
+
+	void StartLatencyStatistics::Add(const double& _ms, const bool& _warm) {
+		std::lock_guard<std::mutex> lock(mutex);
+		const size_t i = _warm ? 1 : 0;
+		count[i]++;
+		sum[i] += _ms;
+		max[i] = std::max(max[i], _ms);
+	}
+
+	std::wstring StartLatencyStatistics::Summary() const {
+		std::lock_guard<std::mutex> lock(mutex);
+		std::wostringstream summary;
+		summary << std::fixed << std::setprecision(1) << L"Start latency";
+		const wchar_t* const names[] = { L" cold: ", L"; warm: " };
+		for ( size_t i = 0 ; i < 2 ; i++ ) {
+			summary << names[i] << L"n " << count[i];
+			if ( count[i] > 0 )
+				summary << L", mean " << sum[i] / count[i] << L" ms, max " << max[i] << L" ms";
+		}
+		return summary.str();
+	}
 	
 	DaqController::DaqController(const uint32_t& _nmasters
 		, const uint32_t& _nslaves
@@ -22,8 +55,13 @@ namespace scope {
 		, shutters(nmasters + nslaves)
 		, switches(nmasters + nslaves)
 		, scannervecs(nmasters + nslaves)
-		, chunksizes(nmasters + nslaves, 16000)
+		, stackvectors(nmasters + nslaves)
+		, backlogstatistics(nmasters)
+		, armed(false)
+		, warmstart(false)
+		, setupcounter(0)
 		, online_update_done_flag(false)
+		, online_update_switchsample(0)
 	{
 		for (uint32_t a = 0; a < shutters.size(); a++) {
 			shutters[a].Initialize(ctrlparams.allareas[a]->daq.shutterline());
@@ -44,11 +82,27 @@ namespace scope {
 		ControllerReturnStatus returnstatus(ControllerReturnStatus::none);
 
 		const DaqMode requested_mode = ctrlparams.requested_mode();
-		uint32_t chunksize = inputs[_masterarea]->StandardChunkSize();					// pixels per channel per chunk
+		const uint32_t masterareainallareas = _masterarea * (slavespermaster + 1);
+		const parameters::Inputs& inputparams = *ctrlparams.allareas[masterareainallareas]->daq.inputs;
+
+		// Chunk sizes have to be multiples of the oversampling factor, otherwise the PipelineController cannot downsample them
+		uint32_t oversampling = 1;
+		if ( inputparams.oversampling() )
+			oversampling = std::max(1u, round2ui32(ctrlparams.allareas[masterareainallareas]->daq.pixeltime() / inputparams.MinimumPixeltime()));
+		// The maximum chunk must fit into the device buffer (with room for the backlog)
+		const uint32_t maxchunksize = std::min(inputparams.maxchunksize(), inputs[_masterarea]->MaximumChunkSize());
+		AdaptiveChunkSize adaptivechunksize(inputs[_masterarea]->StandardChunkSize(), std::min(inputparams.minchunksize(), maxchunksize), maxchunksize
+			, oversampling, inputparams.adaptivechunksize());
+		InputBacklogStatistics& backlogstats(backlogstatistics[_masterarea]);
+		backlogstats.Reset();
+		backlogstats.chunksize = adaptivechunksize.Current();
+
+		uint32_t chunksize = adaptivechunksize.Current();								// pixels per channel per chunk
 		const uint32_t requested_samples = inputs[_masterarea]->RequestedSamples();		// total pixels per channel
 		uint32_t readsamples = 0;
 		int32_t currentlyread = 0;
 		bool timedout = false;
+		bool firstchunk = true;
 
 		// Main acquisition loop
 		while (!sc->IsSet()) {
@@ -66,22 +120,60 @@ namespace scope {
 			currentlyread = 0;
 			do {
 				// Read data from inputs into the chunk. Timeout 1 second.
+				ScopeTraceSpan span("Inputs::Read", _masterarea);
 				currentlyread = inputs[_masterarea]->Read(*chunk, timedout, 1);
-				DBOUT(L"DaqController::Run read");
+				SCOPE_DIAG_TRACE("DaqController::Run masterarea {} read {} timed out {}", _masterarea, currentlyread, timedout);
 				// In case of timeout attempt to read as long as stop condition is not set
 			} while (timedout && !sc->IsSet());
 			timedout = false;
 
+			// Measure the start latency
+			if ( firstchunk && (currentlyread > 0) ) {
+				firstchunk = false;
+				const double latency = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - starttime).count();
+				startlatencies.Add(latency, warmstart);
+				SCOPE_DIAG_INFO("DaqController::Run masterarea {} start to first chunk {} ms, warm start {}", _masterarea, latency, warmstart);
+			}
+
 			ScopeMessage<config::DaqChunkPtrType> msg;
 			msg.tag = ScopeMessageTag::nothing;
 			msg.cargo = chunk;
 
-			// ...and put it in the queue
-			output_queues->at(_masterarea).Enqueue(msg);
+			// ...and put it in the queue (the span timestamp lets the trace show the queueing delay to the pipeline)
+			{
+				ScopeTraceSpan span("DaqController::Enqueue", _masterarea);
+				output_queues->at(_masterarea).Enqueue(msg);
+			}
 
 			// advance number of read pixels
 			readsamples += currentlyread;
-			DBOUT(L"DaqController::Run masterarea " << _masterarea << L" read " << readsamples << L" of requested " << requested_samples);
+			SCOPE_DIAG_DEBUG("DaqController::Run masterarea {} read {} of requested {}", _masterarea, readsamples, requested_samples);
+
+			// Record the device backlog and adapt the chunk size to it
+			const int64_t backlog = inputs[_masterarea]->Backlog();
+			if ( backlog >= 0 )
+				backlogstats.Add(static_cast<uint32_t>(std::min<int64_t>(backlog, UINT32_MAX)));
+			const int32_t change = adaptivechunksize.Update(backlog);
+			if ( change != 0 ) {
+				chunksize = adaptivechunksize.Current();
+				backlogstats.chunksize = chunksize;
+				if ( change > 0 )
+					++backlogstats.grown;
+				else
+					++backlogstats.shrunk;
+				SCOPE_DIAG_DEBUG("DaqController::Run masterarea {} backlog {}, chunk size now {}", _masterarea, backlog, chunksize);
+			}
+
+			// A streaming output that failed would leave the scanners standing, stop the acquisition with an error then
+			try {
+				outputs[masterareainallareas]->ThrowIfFailed();
+				for (uint32_t sa = 0; sa < slavespermaster; sa++)
+					outputs[masterareainallareas + 1 + sa]->ThrowIfFailed();
+			} catch (...) {
+				ScopeExceptionHandler(__FUNCTION__, true, true);
+				returnstatus = ControllerReturnStatus::error;
+				sc->Set(true);
+			}
 
 			// Check if we read enough samples (if not live scanning)
 			if ((requested_mode == DaqModeHelper::nframes) && (readsamples == requested_samples)) {
@@ -93,7 +185,6 @@ namespace scope {
 		}
 
 		// Force abort of online update
-		const uint32_t masterareainallareas = _masterarea * (slavespermaster + 1);
 		outputs[masterareainallareas]->AbortWrite();
 		for (uint32_t sa = 0; sa < slavespermaster; sa++)
 			outputs[masterareainallareas + 1 + sa]->AbortWrite();
@@ -104,6 +195,10 @@ namespace scope {
 
 		inputs[_masterarea]->Stop();
 
+		// Stop the stimulation so that an armed DaqController can restart it
+		if ( (_masterarea == 0) && (stimulation != nullptr) )
+			stimulation->Stop();
+
 		// Close the shutters
 		for (auto& s : shutters)
 			s.Close();
@@ -116,9 +211,7 @@ namespace scope {
 		return returnstatus;
 	}
 
-	void DaqController::Start(const parameters::Scope& _params) {
-		DBOUT(L"DaqController:::Start");
-
+	void DaqController::Setup(const parameters::Scope& _params) {
 		ctrlparams = _params;
 
 		// Reset outputs and inputs (configures tasks etc. inside them)
@@ -129,7 +222,16 @@ namespace scope {
 		uint32_t a = 0;
 		for (uint32_t ma = 0; ma < nmasters; ma++) {
 			outputs.push_back(std::make_unique<config::OutputType>(a, *dynamic_cast<config::OutputParametersType*>(ctrlparams.allareas[a]->daq.outputs.get()), ctrlparams));
-			inputs.push_back(std::make_unique<config::InputType>(a, dynamic_cast<config::InputParametersType*>(ctrlparams.allareas[a]->daq.inputs.get()), ctrlparams));
+			// Read from the hardware or replay a recording, possibly record what is read
+			const parameters::Daq& daqparams = ctrlparams.allareas[a]->daq;
+			std::unique_ptr<Inputs> input;
+			if ( !daqparams.replayfile().empty() )
+				input = std::make_unique<InputsReplay>(a, daqparams.replayfile(), daqparams.replayrealtime(), daqparams.replayloop(), ctrlparams);
+			else
+				input = std::make_unique<config::InputType>(a, dynamic_cast<config::InputParametersType*>(daqparams.inputs.get()), ctrlparams);
+			if ( !daqparams.recordfile().empty() )
+				input = std::make_unique<InputsRecorder>(a, std::move(input), daqparams.recordfile(), setupcounter);
+			inputs.push_back(std::move(input));
 			a++;
 			// Create only outputs for the slaves
 			for (uint32_t sa = 0; sa < slavespermaster; sa++) {
@@ -138,26 +240,80 @@ namespace scope {
 			}
 		}
 
+		setupcounter++;
+
 		// Calculate and write stimulationvector to device
 		if (ctrlparams.stimulation.enable()) {
 			stimulation = std::make_unique<config::StimulationsType>(ctrlparams);
 			stimvec.SetParameters(ctrlparams.stimulation);
 			stimulation->Write(stimvec.GetVector());
-			stimulation->Start();
 		}
 		else
 			stimulation.reset(nullptr);
+	}
 
-		// Write scannervectors to devices
-		a = 0;
-		for (uint32_t ma = 0; ma < nmasters; ma++) {
-			outputs[a]->Write(*scannervecs[a]->GetInterleavedVector(), 1);
-			a++;
-			for (uint32_t sa = 0; sa < slavespermaster; sa++) {
-				outputs[a]->Write(*scannervecs[a]->GetInterleavedVector(), 1);
-				a++;
+	void DaqController::WriteOutputVectors() {
+		// Write scannervectors (or the precalculated stack vectors) to devices, stack vectors are only needed until they are in the device buffer
+		for (uint32_t a = 0; a < outputs.size(); a++) {
+			// Stop of the previous run leaves an abort request
+			outputs[a]->ClearAbortWrite();
+			if (stackvectors[a] != nullptr) {
+				outputs[a]->Write(*stackvectors[a], 1);
+				stackvectors[a].reset(nullptr);
+			}
+			// Streaming outputs generate their samples from the scanner vector's stream tables while running
+			else if (outputs[a]->Streaming()) {
+				if (!scannervecs[a]->Streaming())
+					throw ScopeException("Streaming outputs need a full frame sawtooth or bidirectional scanner vector");
+				outputs[a]->SetGenerator(scannervecs[a]);
 			}
+			else
+				outputs[a]->Write(*scannervecs[a]->GetInterleavedVector(), 1);
+		}
+	}
+
+	void DaqController::Arm(const parameters::Scope& _params) {
+		DBOUT(L"DaqController::Arm");
+		Setup(_params);
+		// After an explicit commit the tasks return to the committed state on Stop and restart quickly
+		try {
+			for (auto& o : outputs)
+				o->Commit();
+			for (auto& i : inputs)
+				i->Commit();
+			armed = true;
+		}
+		catch (...) { ScopeExceptionHandler(__FUNCTION__); }
+	}
+
+	void DaqController::Disarm() {
+		DBOUT(L"DaqController::Disarm");
+		// Make sure the Run threads are done with outputs and inputs
+		if (Running()) {
+			StopAll();
+			WaitForAll(2000);
 		}
+		armed = false;
+		outputs.clear();
+		inputs.clear();
+		stimulation.reset(nullptr);
+	}
+
+	void DaqController::Start(const parameters::Scope& _params) {
+		DBOUT(L"DaqController:::Start");
+		starttime = std::chrono::high_resolution_clock::now();
+		warmstart = armed;
+
+		// If armed everything is set up already
+		if (armed)
+			ctrlparams = _params;
+		else
+			Setup(_params);
+
+		WriteOutputVectors();
+
+		if (stimulation != nullptr)
+			stimulation->Start();
 
 		// Open shutters
 		for (auto& s : shutters)
@@ -196,16 +352,13 @@ namespace scope {
 			start_inputs();
 		}
 
-		// Let "Run" run asynchronously, one thread for each area
-		for (uint32_t ma = 0; ma < nmasters; ma++) {
-			// Reset the stop condition
-			stops[ma].Set(false);
-			// Get the async's future
-			futures[ma] = std::async(std::bind(&DaqController::Run, this, &stops[ma], ma));
-		}
+		// Let "Run" run in the worker threads, one for each area
+		ConfigureWorkers(L"DaqController", ctrlparams.threads.daqpriority(), ctrlparams.threads.daqaffinity());
+		for (uint32_t ma = 0; ma < nmasters; ma++)
+			StartWorker(ma, std::bind(&DaqController::Run, this, &stops[ma], ma));
 	}
 
-	void DaqController::OnlineParameterUpdate(const uint32_t& _area, const parameters::BaseArea& _areaparameters) {
+	uint64_t DaqController::OnlineParameterUpdate(const uint32_t& _area, const parameters::BaseArea& _areaparameters) {
 		// update parameters
 		*ctrlparams.allareas[_area].get() = _areaparameters;
 		// Note: scannervector was updated already from ScopeController
@@ -220,6 +373,7 @@ namespace scope {
 		// wait until async WorkerOnlineParameterUpdate is done or aborted in  
 		while (!online_update_done_flag)
 			online_update_done.wait(lock);
+		return online_update_switchsample;
 	}
 
 	void DaqController::WorkerOnlineParameterUpdate(const uint32_t _area) {
@@ -230,12 +384,27 @@ namespace scope {
 		// Number of blocks => around 4 blocks per second frame time
 		uint32_t blocks = round2ui32(4.0 * ctrlparams.allareas[_area]->FrameTime());
 
+		// Blocks of about 10 ms for the write aligned to a frame boundary
+		const uint32_t blocksize = std::max(1024u, round2ui32(1E4 / ctrlparams.allareas[_area]->daq.pixeltime()));
+
 		DBOUT(L"WorkerOnlineParameterUpdate blocks" << blocks);
 		online_update_done_flag = false;
+		online_update_switchsample = 0;
 
-		// Write updated scannervector to output
+		// Write updated scannervector to output, if possible so that the new frame starts exactly at a frame boundary
 		//If we call outputs[_area]->AbortWrite this Write exits prematurely
-		outputs[_area]->Write(*scannervec, blocks);
+		// A streaming output generates the updated stream tables from the first frame start it had not generated yet, which is
+		// counted from the output's start like the switch sample of WriteAtFrameBoundary
+		if (outputs[_area]->Streaming())
+			online_update_switchsample = scannervecs[_area]->StreamSwitchSample();
+		else {
+			// The output counts from its task start, which is the common start trigger of this run, so the pipeline can use the sample as is
+			uint64_t switchsample = 0;
+			if (outputs[_area]->WriteAtFrameBoundary(*scannervec, blocksize, switchsample))
+				online_update_switchsample = switchsample;
+			else
+				outputs[_area]->Write(*scannervec, blocks);
+		}
 
 		// when update is done, signal the waiting condition_variable in OnlineParameterUpdate
 		online_update_done_flag = true;
@@ -250,6 +419,7 @@ namespace scope {
 
 	void DaqController::ZeroGalvoOutputs() {
 		// Cancel all currently configured tasks
+		armed = false;
 		for (auto& o : outputs) {
 			if (o.get() != nullptr)
 				o.reset(nullptr);
@@ -273,6 +443,10 @@ namespace scope {
 		scannervecs[_area] = _sv;
 	}
 
+	void DaqController::SetStackVector(const uint32_t& _area, std::unique_ptr<std::vector<int16_t>> _stackvec) {
+		stackvectors[_area] = std::move(_stackvec);
+	}
+
 	void DaqController::OpenCloseShutter(const uint32_t& _area, const bool& _open) {
 		shutters[_area].Set(_open);
 	}
@@ -289,5 +463,9 @@ namespace scope {
 	bool DaqController::GetSwitchResonanceState(const uint32_t& _area) const {
 		return switches[_area].GetState();
 	}
+
+	const InputBacklogStatistics& DaqController::BacklogStatistics(const uint32_t& _masterarea) const {
+		return backlogstatistics.at(_masterarea);
+	}
 	
 }
\ No newline at end of file
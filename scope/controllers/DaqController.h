@@ -11,17 +11,50 @@
 #include "scanmodes/ScannerVectorFrameBasic.h"
 #include "helpers/ScopeDatatypes.h"
 #include "helpers/DaqChunks.h"
+#include "helpers/AdaptiveChunkSize.h"
 #include "devices/OutputsDAQmx.h"
 #include "devices/OutputsDAQmxLineClock.h"
 #include "devices/OutputsDAQmxResonance.h"
 #include "devices/OutputsDAQmxSlave.h"
 #include "devices/InputsDAQmx.h"
 #include "devices/InputsFPGA.h"
+#include "devices/InputsRecorder.h"
+#include "devices/InputsReplay.h"
 #include "devices/StimulationsDAQmx.h"
 #include "devices/GaterDAQmx.h"
 
 namespace scope {
 
+	/** Latencies from DaqController::Start until the first chunk of samples is read, separately for cold starts (tasks are created)
+	* and warm starts (DaqController was armed, tasks are only restarted).
+	* @ingroup ScopeControl */
+	struct StartLatencyStatistics {
+		/** protects the statistics, written by the Run threads of all master areas */
+		mutable std::mutex mutex;
+
+		/** number of starts, [0] cold, [1] warm */
+		std::array<uint32_t, 2> count;
+
+		/** sum of the latencies in milliseconds */
+		std::array<double, 2> sum;
+
+		/** maximum latency in milliseconds */
+		std::array<double, 2> max;
+
+		StartLatencyStatistics();
+
+		/** Sets everything to zero */
+		void Reset();
+
+		/** Adds the latency of one start
+		* @param[in] _ms latency in milliseconds
+		* @param[in] _warm true if the DaqController was armed */
+		void Add(const double& _ms, const bool& _warm);
+
+		/** @return e.g. "Start latency cold: n 1, mean 350.2 ms, max 350.2 ms; warm: n 9, mean 12.1 ms, max 15.3 ms" */
+		std::wstring Summary() const;
+	};
+
 	/** @ingroup ScopeControl
 	* The DaqController controls the data acquisition hardware, both outputs for scanners as well as input from PMTs.
 	* When working with National Instruments DAQmx library:\n
@@ -63,8 +96,26 @@ namespace scope {
 		/** stimulation */
 		StimulationVector stimvec;
 
-		/** size of a read chunk in samples per channel */
-		std::vector<uint32_t> chunksizes;
+		/** precalculated output vectors of a continuous fast z stack, written instead of the scanner vectors on the next Start and released afterwards */
+		std::vector<std::unique_ptr<std::vector<int16_t>>> stackvectors;
+
+		/** input backlog and read chunk size statistics for every master area */
+		std::vector<InputBacklogStatistics> backlogstatistics;
+
+		/** if true, outputs, inputs and stimulation are set up and committed, Start only restarts them */
+		bool armed;
+
+		/** true if the current run was started while armed */
+		bool warmstart;
+
+		/** number of the next cold Setup, numbers the input recordings (see InputsRecorder) */
+		uint32_t setupcounter;
+
+		/** time of the last call to Start */
+		std::chrono::high_resolution_clock::time_point starttime;
+
+		/** start to first chunk latencies */
+		StartLatencyStatistics startlatencies;
 
 		/** condition variable to wait for until online updates is done (new frame is completely written to buffer or aborted) */
 		std::condition_variable online_update_done;
@@ -74,9 +125,19 @@ namespace scope {
 
 		/** mutex for the condition variables */
 		std::mutex online_update_done_mutex;
+
+		/** sample (counted from the common start trigger) from which on the outputs generate the scanner vector of the last online update, 0 if unknown */
+		std::atomic<uint64_t> online_update_switchsample;
 	
 		parameters::Scope ctrlparams;
 
+	protected:
+		/** Creates outputs, inputs and the stimulation (configures their tasks) and writes the stimulation vector */
+		void Setup(const parameters::Scope& _params);
+
+		/** Writes the scannervectors (or the precalculated stack vectors) to the outputs */
+		void WriteOutputVectors();
+
 	public:
 		/** Sets the output queues, generates initial ScannerVectors and initializes the shutters and the resonance scanner switches
 		* @param[in] _oqueues output queues
@@ -101,10 +162,27 @@ namespace scope {
 		* starts all Run methods asynchronously and gets their futures.
 		* @param[in] _params ScopeParameter set to work with */
 		void Start(const parameters::Scope& _params);
+
+		/** Sets up and commits outputs, inputs and stimulation and keeps them (and the scanner vectors) until Disarm. Following calls to Start
+		* only rewrite the scanner vectors (they could have changed, e.g. alternating timeseries planes) and restart the tasks, this saves
+		* the setup time on every timeseries repeat or behavior trial. Only call when not running.
+		* @param[in] _params ScopeParameter set to work with, the task relevant parameters must not change until Disarm */
+		void Arm(const parameters::Scope& _params);
+
+		/** Releases outputs, inputs and stimulation, the next Start sets them up again. Only call when not running. */
+		void Disarm();
+
+		/** @return true if armed */
+		bool Armed() const { return armed; }
+
+		/** @return the start to first chunk latencies */
+		const StartLatencyStatistics& StartLatencies() const { return startlatencies; }
 		
 		/** Handles update of parameters during scanning
-		* @post online update is done or aborted */
-		void OnlineParameterUpdate(const uint32_t& _area, const parameters::BaseArea& _areaparameters);
+		* @post online update is done or aborted
+		* @return the sample (counted from the common start trigger of inputs and outputs) from which on the outputs generate the updated
+		* scanner vector (for streaming outputs see ScannerVectorFrameBasic::StreamSwitchSample), 0 if unknown (then the next frame is the best guess) */
+		uint64_t OnlineParameterUpdate(const uint32_t& _area, const parameters::BaseArea& _areaparameters);
 		
 			/** Does the actual writing to device for an online update */
 		void WorkerOnlineParameterUpdate(const uint32_t _area);
@@ -119,6 +197,9 @@ namespace scope {
 		/** Sets a scanner vector. Only called on startup. */
 		void SetScannerVector(const uint32_t& _area, ScannerVectorFrameBasicPtr _sv);
 
+		/** Sets an output vector with all planes of a continuous fast z stack (see ScannerVectorFrameBasic::GetStackVector). Only used for the next Start. */
+		void SetStackVector(const uint32_t& _area, std::unique_ptr<std::vector<int16_t>> _stackvec);
+
 		/** Opens/closes the shutter. */
 		void OpenCloseShutter(const uint32_t& _area, const bool& _open);
 
@@ -130,6 +211,9 @@ namespace scope {
 
 		/** @return current resonance scanner relay state */
 		bool GetSwitchResonanceState(const uint32_t& _area) const;
+
+		/** @return the input backlog and chunk size statistics of a master area since the last Start */
+		const InputBacklogStatistics& BacklogStatistics(const uint32_t& _masterarea) const;
 		
 	};
 
@@ -1,5 +1,7 @@
 #include "StdAfx.h"
 #include "DisplayController.h"
+#include "helpers/ScopeTrace.h"
+#include "helpers/ScopeImage.h"
 #include "gui\HistogramFrame.h"
 
 namespace scope {
@@ -12,6 +14,7 @@ namespace scope {
 		, histogramframes(_nactives)
 		, histogramframes_mutexe(_nactives)
 		, ctrlparams(_parameters) {
+		ConfigureWorkers(L"DisplayController");
 	}
 
 	/** Stops and interrupts thread if necessary*/
@@ -30,7 +33,9 @@ namespace scope {
 		DBOUT(L"DisplayController::Run beginning\n");
 		uint32_t area = 0;
 		config::MultiImagePtrType current_frame;
-		size_t num_planes = 1;
+		// for multi plane scans (e.g. plane hopping) the last frame of every plane
+		std::vector<std::vector<config::MultiImagePtrType>> planeframes(nactives);
+		std::vector<uint32_t> num_planes(nactives, 1);
 		
 		ControllerReturnStatus returnstatus(ControllerReturnStatus::none);
 		std::vector<uint32_t> framecounts(nactives);
@@ -44,6 +49,8 @@ namespace scope {
 		std::vector<std::unique_lock<std::mutex>> histogramframes_locks(nactives);
 		for ( uint32_t a = 0 ; a < ctrlparams.allareas.size() ; a++ ) {
 			requested_frames[a] = ctrlparams.allareas[a]->daq.requested_frames();
+			num_planes[a] = ctrlparams.allareas[a]->Currentframe().Planes();
+			planeframes[a].resize(num_planes[a]);
 			channelframes_locks[a] = std::unique_lock<std::mutex>(channelframes_mutexe[a],std::defer_lock);
 			histogramframes_locks[a] = std::unique_lock<std::mutex>(histogramframes_mutexe[a],std::defer_lock);
 		}
@@ -54,7 +61,11 @@ namespace scope {
 		// Dequeue and distribute loop
 		while ( !sc->IsSet() ) {
 			// Dequeue
-			ScopeMessage<config::MultiImagePtrType> msg(input_queue->Dequeue());
+			ScopeMessage<config::MultiImagePtrType> msg;
+			{
+				ScopeTraceSpan span("DisplayController::Dequeue");
+				msg = input_queue->Dequeue();
+			}
 
 			// If message has abort tag, break from while loop
 			if ( msg.tag == ScopeMessageTag::abort ) {
@@ -64,12 +75,22 @@ namespace scope {
 
 			current_frame = msg.cargo;
 			area = current_frame->Area();
-			//if ( SCOPE_USE_RESONANCESCANNER )
-			//	num_planes = scope_controller.GuiParameters.areas[area]->FrameResonance().planes.size()?scope_controller.GuiParameters.areas[area]->FrameResonance().planes.size():1;
+
+			// Planes arrive in order, collect them and display all planes (one below the other) when the last one is complete. Stacking copies
+			// all planes, thus not for every chunk of the last plane (no running update of multi plane scans).
+			if ( num_planes[area] > 1 ) {
+				planeframes[area][std::min(current_frame->Plane(), num_planes[area] - 1)] = current_frame;
+				if ( (current_frame->Plane() + 1 < num_planes[area])
+					|| !current_frame->IsCompleteFrame()
+					|| std::any_of(std::begin(planeframes[area]), std::end(planeframes[area]), [](const config::MultiImagePtrType& _f) { return _f == nullptr; }) )
+					continue;
+				ScopeTraceSpan span("DisplayController::StackPlanes", area);
+				current_frame = StackPlanes(planeframes[area]);
+			}
 
 			// To resize the Displays according to number of planes defined in the GUI
 			for ( auto cframe : channelframes[area] )
-				cframe->OnMultSize(1, num_planes);	
+				cframe->OnMultSize(1, num_planes[area]);
 
 			// Increase framecount if a complete frame was received
 			if ( current_frame->IsCompleteFrame() && current_frame->IsCompleteAvg() ) {
@@ -78,9 +99,9 @@ namespace scope {
 			}
 
 			// Distribute current_frame to attached CChannelFrames and render the stuff in CChannelFrame's Active's thread
+			ScopeTraceSpan span("DisplayController::Distribute", area);
 			channelframes_locks[area].lock();
 			for ( auto cframe : channelframes[area] )
-				//cframe->OnMultSize(1, num_planes);
 				cframe->LayOverAndRender(current_frame);					
 			channelframes_locks[area].unlock();
 
@@ -122,6 +143,28 @@ namespace scope {
 		}
 	}
 
+	config::MultiImagePtrType DisplayController::StackPlanes(const std::vector<config::MultiImagePtrType>& _planes) const {
+		const config::MultiImagePtrType& last = _planes.back();
+		const size_t planepixels = last->Pixels();
+		auto stacked = std::make_shared<config::MultiImageType>(last->Area(), last->Channels(), last->Lines() * static_cast<uint32_t>(_planes.size()), last->Linewidth());
+		for ( size_t c = 0 ; c < last->Channels() ; c++ ) {
+			ScopeImageAccessU16 stackeddata(*stacked->GetChannel(c));
+			uint16_t* const out = stackeddata.GetPointer();
+			// Snapshots, so we do not block the pixel mapping
+			for ( size_t p = 0 ; p < _planes.size() ; p++ ) {
+				ScopeImageSnapshotU16 planedata(*_planes[p]->GetChannel(c));
+				std::copy(std::begin(*planedata.GetConstData()), std::end(*planedata.GetConstData()), out + p * planepixels);
+			}
+		}
+		stacked->SetAvgCount(last->GetAvgCount());
+		stacked->SetAvgMax(last->GetAvgMax());
+		stacked->SetCompleteAvg(last->IsCompleteAvg());
+		stacked->SetImageNumber(last->GetImageNumber());
+		stacked->SetCompleteFrame(last->IsCompleteFrame());
+		stacked->SetPercentComplete(last->PercentComplete());
+		return stacked;
+	}
+
 	void DisplayController::StopOne(const uint32_t& _a) {
 		BaseController::StopOne(_a);
 		ScopeMessage<config::MultiImagePtrType> stopmsg(ScopeMessageTag::abort, nullptr);
@@ -67,6 +67,11 @@ namespace scope {
 			/** Calls CChannelFrame::UpdateStatus and CHistogramFrame::UpdateStatus in all attached frames*/
 			void UpdateStatusInFrames(const RunState& _rs);
 
+			/** Puts the planes of a multi plane scan one below the other into one image for display
+			* @param[in] _planes the frames of all planes of one area, in plane order
+			* @return a new image with the planes' lines, properties are those of the last plane */
+			config::MultiImagePtrType StackPlanes(const std::vector<config::MultiImagePtrType>& _planes) const;
+
 		public:
 			/** Connect queue and get parameters */
 			DisplayController(const uint32_t& _nactives, const parameters::Scope& _parameters, SynchronizedQueue<ScopeMessage<config::MultiImagePtrType>>* const _iqueue);
@@ -1,5 +1,6 @@
 #include "stdafx.h"
 #include "PipelineController.h"
+#include "helpers/ScopeTrace.h"
 
 namespace scope {
 
@@ -20,6 +21,9 @@ namespace scope {
 		, scannervecs(_nactives)
 		, online_update_mutexe(_nactives)
 		, online_updates(_nactives)
+		, online_update_lookups(_nactives)
+		, online_update_samples(_nactives, 0)
+		, framesoverride(0)
 	{
 		DBOUT(L"PipelineController::PipelineController");
 	}
@@ -29,10 +33,19 @@ namespace scope {
 		WaitForAll(-1);
 	}
 
+	void PipelineController::Start() {
+		ConfigureWorkers(L"PipelineController", guiparameters.threads.pipelinepriority(), guiparameters.threads.pipelineaffinity());
+		BaseController::Start();
+	}
+
 	ControllerReturnStatus PipelineController::Run(StopCondition* const sc, const uint32_t& _area) {
 		ATLTRACE(L"PipelineController::Run beginning\n");
 		uint32_t framecount = 0;
 		uint32_t avgcount = 0;
+		// Pixels of all completely mapped frames, for switching to online updates at the same frame as the outputs. Counts from the common
+		// start trigger like the outputs' switch sample: inputs and outputs start on it with every run, the first chunk begins with its
+		// first sample, and one output sample is one (downsampled) pixel.
+		uint64_t mappedsamples = 0;
 
 		std::unique_lock<std::mutex> online_update_lock(online_update_mutexe[_area], std::defer_lock);
 		online_updates[_area] = false;
@@ -42,21 +55,23 @@ namespace scope {
 		const uint32_t downsampling = (guiparameters.allareas[_area]->daq.inputs->oversampling())?round2ui32(guiparameters.allareas[_area]->daq.pixeltime() / guiparameters.allareas[_area]->daq.inputs->MinimumPixeltime()):1;
 		// Get some values as locals, avoid the mutexed access to parameters later on (really necessary??)
 		const DaqMode requested_mode = guiparameters.requested_mode();
-		const uint32_t requested_frames = guiparameters.allareas[_area]->daq.requested_frames();
+		const uint32_t requested_frames = (framesoverride > 0) ? framesoverride.load() : guiparameters.allareas[_area]->daq.requested_frames();
 		const uint32_t requested_averages = guiparameters.allareas[_area]->daq.averages();
-		const double totalframepixels = guiparameters.allareas[_area]->Currentframe().XTotalPixels() * guiparameters.allareas[_area]->Currentframe().YTotalLines();
-
-		//size_t num_planes = 1;
-		//if ( SCOPE_USE_RESONANCESCANNER )
-		//	num_planes = guiparameters.areas[_area].frameresonance.planes.size()?guiparameters.areas[_area].frameresonance.planes.size():1;
+		const double totalframepixels = guiparameters.allareas[_area]->Currentframe().TotalPixels();
+		// Multi plane scans (e.g. plane hopping) map every plane into its own frame
+		const uint32_t planes = guiparameters.allareas[_area]->Currentframe().Planes();
 
+		// One frame per area and plane, area by area and in each area plane by plane
 		std::vector<config::MultiImagePtrType> current_frames(0);
-		current_frames.reserve(config::slavespermaster+1);
+		current_frames.reserve((config::slavespermaster+1) * planes);
 		for (uint32_t a = 0; a < config::slavespermaster + 1; a++) {
-			current_frames.push_back(std::make_shared<config::MultiImageType>(_area+a
-				, guiparameters.allareas[_area]->daq.inputs->channels()
-				, guiparameters.allareas[_area]->Currentframe().yres()	// * num_planes
-				, guiparameters.allareas[_area]->Currentframe().xres()));
+			for (uint32_t p = 0; p < planes; p++) {
+				current_frames.push_back(std::make_shared<config::MultiImageType>(_area+a
+					, guiparameters.allareas[_area]->daq.inputs->channels()
+					, guiparameters.allareas[_area]->Currentframe().yres()
+					, guiparameters.allareas[_area]->Currentframe().xres()));
+				current_frames.back()->SetPlane(p);
+			}
 		}
 
 		std::vector<config::MultiImagePtrType> next_frames(current_frames);
@@ -66,8 +81,10 @@ namespace scope {
 
 		//current_frame->InitializeCurrentLineData(5*guiparameters.areas[_area]->currentframe->XTotalPixels());
 
+		// Map with a copy of the lookup vector, online updates change the scanner vector's one before the outputs switch to the updated frame
+		std::vector<uint32_t> lookup(*scannervecs[_area]->GetLookupVector());
 		std::unique_ptr<PixelmapperBasic<>> pixel_mapper(PixelmapperBasic<config::nchannels, 1+config::slavespermaster>::Factory(config::scannerselect, guiparameters.allareas[_area]->scanmode()));
-		pixel_mapper->SetLookupVector(scannervecs[_area]->GetLookupVector());
+		pixel_mapper->SetLookupVector(&lookup);
 		pixel_mapper->SetParameters(scannervecs[_area]->GetSVParameters());
 		pixel_mapper->SetCurrentFrames(current_frames);
 
@@ -89,7 +106,11 @@ namespace scope {
 		// Dequeue and pixelmap loop
 		while ( !sc->IsSet() ) {
 			// Dequeue
-			ScopeMessage<config::DaqChunkPtrType> msg(input_queues->at(_area).Dequeue());
+			ScopeMessage<config::DaqChunkPtrType> msg;
+			{
+				ScopeTraceSpan span("PipelineController::Dequeue", _area);
+				msg = input_queues->at(_area).Dequeue();
+			}
 
 			// If message has abort tag, break from while loop
 			if ( msg.tag == ScopeMessageTag::abort ) {
@@ -99,13 +120,19 @@ namespace scope {
 			auto chunk = msg.cargo;
 
 			// If we oversampled during acquisition, now downsample to pixeltime
-			chunk->Downsample(downsampling);
+			{
+				ScopeTraceSpan span("DaqChunk::Downsample", _area);
+				chunk->Downsample(downsampling);
+			}
 
 			// Map until the whole data chunk is mapped (could be overlapping the end of a frame)
 			do {
 				// Map the chunk into the current_frame
-				// Attention: this blocks ScopeOverlay::Create in CChannelFrame since we need write access to the image here!
-				pixelmapper_result = pixel_mapper->LookupChunk(*chunk, (uint16_t)avgcount);
+				// We need write access to the image here. ScopeOverlay::Create and ScopeHistogram::Calculate only use snapshots, so they do not block us (and vice versa)
+				{
+					ScopeTraceSpan span("Pixelmapper::LookupChunk", _area);
+					pixelmapper_result = pixel_mapper->LookupChunk(*chunk, (uint16_t)avgcount);
+				}
 
 				// Set progress and frame properties
 				counters.singleframeprogress[_area] += 100.0 * chunk->PerChannel() / totalframepixels;
@@ -116,15 +143,27 @@ namespace scope {
 				}
 
 				// Put current_frames in outgoing messages
-				std::array<ScopeMessage<config::MultiImagePtrType>, config::slavespermaster+1> outmsgs;
-				for ( uint32_t a = 0; a < config::slavespermaster +1 ; a++)
-					outmsgs[a].cargo = current_frames[a];
+				std::vector<ScopeMessage<config::MultiImagePtrType>> outmsgs(current_frames.size());
+				for ( size_t f = 0; f < current_frames.size() ; f++)
+					outmsgs[f].cargo = current_frames[f];
 
 				// If one frame is mapped completely...
 				if ( (pixelmapper_result & FrameComplete) != 0 ) {
 					for (auto& cf : current_frames)
 						cf->SetCompleteFrame(true);
 					counters.singleframeprogress[_area] = 0.0;
+
+					// Switch to a pending online update exactly at the frame the outputs switched (rest of the chunk belongs to the new frame already)
+					mappedsamples += lookup.size();
+					online_update_lock.lock();
+					if ( online_updates[_area] && (requested_mode == DaqModeHelper::continuous) && (mappedsamples >= online_update_samples[_area]) ) {
+						DBOUT(L"PipelineController::Run online update at sample " << mappedsamples << L"\n");
+						lookup.swap(online_update_lookups[_area]);
+						pixel_mapper->SetLookupVector(&lookup);
+						pixel_mapper->SetParameters(scannervecs[_area]->GetSVParameters());
+						online_updates[_area] = false;
+					}
+					online_update_lock.unlock();
 					
 					// If all the averages for one frame have been done...
 					if ( ++avgcount == requested_averages ) {							
@@ -133,8 +172,11 @@ namespace scope {
 							cf->SetCompleteAvg(true);
 						
 						// the next frame is a copy of the old (allows for continuous updating effect, no black pixels in new frame)
-						for (uint32_t a = 0; a < config::slavespermaster + 1; a++)
-							next_frames[a] = std::make_shared<config::MultiImageType>(*current_frames[a]);
+						{
+							ScopeTraceSpan span("PipelineController::CopyFrame", _area);
+							for (size_t f = 0; f < current_frames.size(); f++)
+								next_frames[f] = std::make_shared<config::MultiImageType>(*current_frames[f]);
+						}
 
 						// Enqueue frame for storage
 						for ( auto& o : outmsgs)
@@ -167,18 +209,6 @@ namespace scope {
 			// while loop ends with end of  chunk of if stop condition is set (this allows abort during mapping of one chunk)
 			} while ( ((pixelmapper_result & EndOfChunk) != EndOfChunk) && !sc->IsSet() );
 
-			// Check if an online parameter update was requested and we have to update the LookupVector etc
-			// Only really needed for scannerdelay change (since zoom etc. leave the lookup vector untouched)
-			online_update_lock.lock();
-			if ( online_updates[_area] && (requested_mode == DaqModeHelper::continuous) ) {
-				DBOUT(L"PipelineController::Run online update\n");
-				// Give pixelmapper the current lookup vector
-				pixel_mapper->SetLookupVector(scannervecs[_area]->GetLookupVector());
-				pixel_mapper->SetParameters(scannervecs[_area]->GetSVParameters());
-				online_updates[_area] = false;
-			}
-			online_update_lock.unlock();
-
 			// Check if we read enough samples (if not live scanning)
 			if ( (requested_mode == DaqModeHelper::nframes) && (requested_frames == framecount) ) {	// are we done?
 				returnstatus = finished;
@@ -202,16 +232,20 @@ namespace scope {
 		input_queues->at(_a).Enqueue(stopmsg);
 	}
 
-	void PipelineController::OnlineParameterUpdate(const parameters::MasterArea& _areaparameters) {
-		const uint32_t area = _areaparameters.area();
-		std::lock_guard<std::mutex> lock(online_update_mutexe[area]);		// lock, thus worker thread waits and we can safely update parameters
+	void PipelineController::OnlineParameterUpdate(const uint32_t& _area, const uint64_t& _switchsample) {
+		std::lock_guard<std::mutex> lock(online_update_mutexe[_area]);		// lock, thus worker thread waits and we can safely update parameters
 		// update parameters not needed since we have a reference to TheScope's guiparameters
-		//*parameters.areas[area] = _areaparameters;
-		online_updates[area] = true;	
+		online_update_lookups[_area] = *scannervecs[_area]->GetLookupVector();
+		online_update_samples[_area] = _switchsample;
+		online_updates[_area] = true;	
 	}
 
 	void PipelineController::SetScannerVector(const uint32_t& _area, ScannerVectorFrameBasicPtr _sv) {
 		scannervecs[_area] = _sv;
 	}
+
+	void PipelineController::SetRequestedFrames(const uint32_t& _frames) {
+		framesoverride = _frames;
+	}
 	
 }
\ No newline at end of file
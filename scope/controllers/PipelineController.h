@@ -42,6 +42,16 @@ namespace scope {
 
 		/** trigger for online updates during live scanning */
 		std::vector<bool> online_updates;
+
+		/** for each area the lookup vector of the pending online update (a copy, the scanner vector's one changes right away, the mapping
+		* only when the outputs switch to the new scanner vector) */
+		std::vector<std::vector<uint32_t>> online_update_lookups;
+
+		/** for each area the sample (counted from the common start trigger) from which on the pending online update applies */
+		std::vector<uint64_t> online_update_samples;
+
+		/** if not zero, the number of frames to process in nframes mode instead of the requested frames from the parameters */
+		std::atomic<uint32_t> framesoverride;
 		
 	protected:
 		/** disable copy */
@@ -65,13 +75,24 @@ namespace scope {
 			
 		~PipelineController();
 		
+		/** Applies the thread settings from the parameters and starts the Run worker functions */
+		void Start() override;
+
 		void StopOne(const uint32_t& _a) override;
 		
-		/** Handles update of parameters during scanning */
-		void OnlineParameterUpdate(const parameters::MasterArea& _areaparameters);
+		/** Handles update of parameters during scanning. The pixel mapper switches to the updated lookup vector and parameters at the beginning
+		* of the frame starting at sample _switchsample (or at the next frame boundary, if that one is already mapped).
+		* @param[in] _area the master area
+		* @param[in] _switchsample sample (counted from the common start trigger) from which on the outputs generate the updated scanner vector, see DaqController::OnlineParameterUpdate */
+		void OnlineParameterUpdate(const uint32_t& _area, const uint64_t& _switchsample);
 
 		/** Sets the pointers to the scanner vector. Only called on startup. */
 		void SetScannerVector(const uint32_t& _area, ScannerVectorFrameBasicPtr _sv);
+
+		/** Overrides the number of frames to process in nframes mode for the next runs, e.g. one frame per plane for a continuous fast z stack.
+		* Frames leave the pipeline in order, so the image number of a frame is its plane number.
+		* @param[in] _frames number of frames, 0 to use the requested frames from the parameters again */
+		void SetRequestedFrames(const uint32_t& _frames);
 	};
 
 }
\ No newline at end of file
@@ -0,0 +1,392 @@
+#include "stdafx.h"
+#include "ScopeBenchmark.h"
+#include "config\config_choices.h"
+#include "DaqController.h"
+#include "PipelineController.h"
+#include "StorageController.h"
+#include "TheScopeCounters.h"
+#include "parameters/Scope.h"
+#include "parameters/Inputs.h"
+#include "devices/InputsSimulated.h"
+#include "helpers/ScopeImageBenchmark.h"
+#include "scanmodes/ScannerVectorCheck.h"
+#include "helpers/ScopeTrace.h"
+#include "helpers/ScopeException.h"
+
+namespace scope {
+
+	namespace {
+		/** @return CPU time (user plus kernel) the calling thread has consumed so far, in seconds */
+		double ThreadCPUTime() {
+			FILETIME creation, exit, kernel, user;
+			if ( !GetThreadTimes(GetCurrentThread(), &creation, &exit, &kernel, &user) )
+				return 0.0;
+			ULARGE_INTEGER k, u;
+			k.LowPart = kernel.dwLowDateTime;
+			k.HighPart = kernel.dwHighDateTime;
+			u.LowPart = user.dwLowDateTime;
+			u.HighPart = user.dwHighDateTime;
+			return static_cast<double>(k.QuadPart + u.QuadPart) * 100E-9;
+		}
+
+		/** Wraps the Run worker functions of a controller and accumulates the CPU time they use.
+		* Measured as a difference, since the controllers reuse their worker threads. */
+		template<class CONTROLLER>
+		class CPUTimed
+			: public CONTROLLER {
+
+		protected:
+			/** CPU time in seconds used by each Run worker function, only read after the workers returned */
+			std::vector<double> cputimes;
+
+			ControllerReturnStatus Run(StopCondition* const _sc, const uint32_t& _n) override {
+				const double start = ThreadCPUTime();
+				const ControllerReturnStatus result = CONTROLLER::Run(_sc, _n);
+				cputimes[_n] += ThreadCPUTime() - start;
+				return result;
+			}
+
+		public:
+			template<class... ARGS>
+			CPUTimed(const uint32_t& _nactives, ARGS&&... _args)
+				: CONTROLLER(_nactives, std::forward<ARGS>(_args)...)
+				, cputimes(_nactives, 0.0) {
+			}
+
+			/** @return CPU time in seconds summed over all Run worker functions */
+			double CPUTime() const {
+				return std::accumulate(std::begin(cputimes), std::end(cputimes), 0.0);
+			}
+		};
+
+		/** Stands in for the DisplayController, only drains the display queue and counts the frames */
+		class NullDisplayController
+			: public BaseController {
+
+		protected:
+			/** queue from the PipelineController */
+			SynchronizedQueue<ScopeMessage<config::MultiImagePtrType>>* const input_queue;
+
+			/** number of dequeued (partial) frames */
+			std::atomic<uint64_t> frames;
+
+			ControllerReturnStatus Run(StopCondition* const _sc, const uint32_t& _n) override {
+				while ( !_sc->IsSet() ) {
+					ScopeMessage<config::MultiImagePtrType> msg(input_queue->Dequeue());
+					if ( msg.tag == ScopeMessageTag::abort )
+						return ControllerReturnStatus::stopped;
+					++frames;
+				}
+				return ControllerReturnStatus::stopped;
+			}
+
+		public:
+			NullDisplayController(const uint32_t& _nactives, SynchronizedQueue<ScopeMessage<config::MultiImagePtrType>>* const _iqueue)
+				: BaseController(_nactives)
+				, input_queue(_iqueue)
+				, frames(0) {
+			}
+
+			~NullDisplayController() {
+				StopAll();
+				WaitForAll(-1);
+			}
+
+			/** Puts an abort message into the queue, since Run could wait in Dequeue */
+			void StopOne(const uint32_t& _a) override {
+				BaseController::StopOne(_a);
+				input_queue->Enqueue(ScopeMessage<config::MultiImagePtrType>(ScopeMessageTag::abort, nullptr));
+			}
+
+			/** @return number of dequeued (partial) frames */
+			uint64_t Frames() const { return frames; }
+		};
+
+		/** DaqController that gives access to the counters of the simulated inputs */
+		class BenchmarkDaqController
+			: public CPUTimed<DaqController> {
+
+		public:
+			template<class... ARGS>
+			BenchmarkDaqController(ARGS&&... _args)
+				: CPUTimed<DaqController>(std::forward<ARGS>(_args)...) {
+			}
+
+			/** @return the simulated input of a master area or nullptr if another input type is configured */
+			const InputsSimulated* SimulatedInput(const uint32_t& _masterarea) const {
+				return (_masterarea < inputs.size()) ? dynamic_cast<const InputsSimulated*>(inputs[_masterarea].get()) : nullptr;
+			}
+		};
+
+		/** Running statistics of a queue depth */
+		struct DepthStatistics {
+			uint64_t samples;
+			double sum;
+			size_t max;
+			DepthStatistics() : samples(0), sum(0), max(0) { }
+			void Add(const size_t& _depth) {
+				++samples;
+				sum += _depth;
+				max = std::max(max, _depth);
+			}
+			double Mean() const { return (samples > 0) ? sum / samples : 0.0; }
+		};
+
+		/** @return the scanner vector fill type that TheScope uses for an area */
+		ScannerVectorFillType FillType(const parameters::BaseArea& _area) {
+			const config::FramevectorFillEnum ft = (_area.areatype() == AreaTypeHelper::Slave) ? config::framevectorfill_slave : config::framevectorfill_master;
+			switch ( ft ) {
+			case config::FramevectorFillEnum::LineXPColumnYZ:
+				return ScannerVectorFillTypeHelper::LineXPColumnYZ;
+			case config::FramevectorFillEnum::LineZP:
+				return ScannerVectorFillTypeHelper::LineZP;
+			default:
+				return ScannerVectorFillTypeHelper::FullframeXYZP;
+			}
+		}
+	}
+
+	ScopeBenchmarkOptions::ScopeBenchmarkOptions()
+		: parameterfile(L"")
+		, duration(10)
+		, xres(512)
+		, yres(512)
+		, channels(2)
+		, areas(1)
+		, averages(1)
+		, chunksize(0)
+		, adaptive(false)
+		, realtime(false)
+		, save(false)
+		, contention(false)
+		, vectorcheck(false)
+		, reportfile(L"")
+		, tracefile(L"") {
+	}
+
+	ScopeBenchmarkOptions ScopeBenchmarkOptions::Parse(const std::wstring& _cmdline) {
+		ScopeBenchmarkOptions opts;
+
+		for ( const auto& arg : SplitCommandLine(_cmdline) ) {
+			if ( arg[0] != L'/' ) {
+				opts.parameterfile = arg;
+				continue;
+			}
+			const size_t eq = arg.find(L'=');
+			const std::wstring key(arg.substr(1, eq - 1));
+			const std::wstring value((eq == std::wstring::npos) ? L"" : arg.substr(eq + 1));
+			try {
+				if ( key == L"benchmark" )
+					continue;
+				else if ( key == L"seconds" )
+					opts.duration = std::stod(value);
+				else if ( key == L"xres" )
+					opts.xres = std::stoul(value);
+				else if ( key == L"yres" )
+					opts.yres = std::stoul(value);
+				else if ( key == L"channels" )
+					opts.channels = std::stoul(value);
+				else if ( key == L"areas" )
+					opts.areas = std::stoul(value);
+				else if ( key == L"averages" )
+					opts.averages = std::stoul(value);
+				else if ( key == L"chunksize" )
+					opts.chunksize = std::stoul(value);
+				else if ( key == L"adaptive" )
+					opts.adaptive = value.empty() || (std::stoul(value) != 0);
+				else if ( key == L"realtime" )
+					opts.realtime = value.empty() || (std::stoul(value) != 0);
+				else if ( key == L"save" )
+					opts.save = value.empty() || (std::stoul(value) != 0);
+				else if ( key == L"contention" )
+					opts.contention = true;
+				else if ( key == L"vectorcheck" )
+					opts.vectorcheck = true;
+				else if ( key == L"report" )
+					opts.reportfile = value;
+				else if ( key == L"trace" )
+					opts.tracefile = value;
+				else
+					throw ScopeException("Unknown benchmark option");
+			}
+			catch ( std::logic_error& ) {
+				throw ScopeException("Invalid value for benchmark option");
+			}
+		}
+		return opts;
+	}
+
+	ScopeBenchmark::ScopeBenchmark(const ScopeBenchmarkOptions& _options)
+		: options(_options) {
+	}
+
+	std::wstring ScopeBenchmark::Run() {
+		std::wostringstream report;
+
+		// Slave areas are read together with their master, thus we can only reduce the number of areas without slaves
+		const uint32_t nmasters = (config::slavespermaster == 0) ? std::max(1u, std::min(options.areas, config::nmasters)) : config::nmasters;
+		const uint32_t nslaves = nmasters * config::slavespermaster;
+		const uint32_t nareas = nmasters + nslaves;
+
+		// Set up parameters like ScopeController does for a live scan
+		parameters::Scope params(config::nmasters, config::nslaves);
+		if ( !options.parameterfile.empty() )
+			params.Load(options.parameterfile);
+		params.requested_mode = DaqModeHelper::continuous;
+		params.run_state = RunStateHelper::RunningContinuous;
+		params.storage.autosave = options.save;
+		params.storage.savelive = options.save;
+		params.stimulation.enable = false;
+		for ( auto& area : params.allareas ) {
+			area->Currentframe().xres = options.xres;
+			area->Currentframe().yres = options.yres;
+			area->daq.averages = options.averages;
+			area->daq.inputs->channels = std::max(1u, std::min(options.channels, config::nchannels));
+			area->daq.inputs->adaptivechunksize = options.adaptive;
+			auto siminputs = dynamic_cast<parameters::InputsSimulated*>(area->daq.inputs.get());
+			if ( siminputs != nullptr ) {
+				siminputs->realtime = options.realtime;
+				siminputs->chunksize = options.chunksize;
+			}
+		}
+
+		// Wire the controllers like TheScope does, the display is replaced by a sink
+		std::vector<SynchronizedQueue<ScopeMessage<config::DaqChunkPtrType>>> daq_to_pipeline(nmasters);
+		SynchronizedQueue<ScopeMessage<config::MultiImagePtrType>> pipeline_to_storage;
+		SynchronizedQueue<ScopeMessage<config::MultiImagePtrType>> pipeline_to_display;
+		ScopeCounters counters(config::totalareas);
+
+		BenchmarkDaqController daq(nmasters, nslaves, config::slavespermaster, params, &daq_to_pipeline);
+		CPUTimed<PipelineController> pipeline(nmasters, params, counters, &daq_to_pipeline, &pipeline_to_storage, &pipeline_to_display);
+		CPUTimed<StorageController> storage(config::threads_storage, params, &pipeline_to_storage);
+		CPUTimed<NullDisplayController> display(config::threads_display, &pipeline_to_display);
+
+		std::vector<ScannerVectorFrameBasicPtr> scannervecs(nareas);
+		for ( uint32_t a = 0 ; a < nareas ; a++ ) {
+			scannervecs[a] = ScannerVectorFrameBasic::Factory(params.allareas[a]->scanmode(), FillType(*params.allareas[a]));
+			scannervecs[a]->SetParameters(&params.allareas[a]->daq, &params.allareas[a]->Currentframe(), &params.allareas[a]->fpuzstage);
+			daq.SetScannerVector(a, scannervecs[a]);
+			pipeline.SetScannerVector(a, scannervecs[a]);
+		}
+
+		// Trace only the run itself
+		ScopeTracer& tracer(ScopeTracer::GetInstance());
+		if ( !options.tracefile.empty() ) {
+			tracer.Clear();
+			tracer.Enable(true);
+		}
+
+		// Start in the same order as ScopeController::StartAllControllers
+		const auto starttime = std::chrono::high_resolution_clock::now();
+		display.Start();
+		storage.Start();
+		pipeline.Start();
+		daq.Start(params);
+
+		// Sample queue depths while running
+		std::vector<DepthStatistics> daqdepths(nmasters);
+		DepthStatistics storagedepth;
+		DepthStatistics displaydepth;
+		const auto endtime = starttime + std::chrono::duration_cast<std::chrono::high_resolution_clock::duration>(std::chrono::duration<double>(options.duration));
+		while ( std::chrono::high_resolution_clock::now() < endtime ) {
+			for ( uint32_t a = 0 ; a < nmasters ; a++ )
+				daqdepths[a].Add(daq_to_pipeline[a].Size());
+			storagedepth.Add(pipeline_to_storage.Size());
+			displaydepth.Add(pipeline_to_display.Size());
+			std::this_thread::sleep_for(std::chrono::milliseconds(10));
+		}
+
+		// Stop the acquisition first (the inputs and their counters persist until the DaqController is destroyed)
+		daq.StopAll();
+		daq.WaitForAll(-1);
+		const double elapsed = std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - starttime).count();
+
+		// Whatever the pipeline did not map until the acquisition stopped counts as backlog
+		std::vector<size_t> daqbacklog(nmasters);
+		for ( uint32_t a = 0 ; a < nmasters ; a++ )
+			daqbacklog[a] = daq_to_pipeline[a].Size();
+		pipeline.StopAll();
+		pipeline.WaitForAll(-1);
+		const size_t storagebacklog = pipeline_to_storage.Size();
+		storage.StopAll();
+		storage.WaitForAll(-1);
+		display.StopAll();
+		display.WaitForAll(-1);
+		tracer.Enable(false);
+
+		report << std::fixed << std::setprecision(1);
+		report << L"Scope benchmark: " << nmasters << L" master area(s), " << nslaves << L" slave area(s), " << options.xres << L"x" << options.yres
+			<< L" pixels, " << params.allareas[0]->daq.inputs->channels() << L" channel(s), " << options.averages << L" average(s), "
+			<< (options.realtime ? L"realtime" : L"as fast as possible") << (options.adaptive ? L", adaptive chunk size" : L"") << (options.save ? L", saving" : L"") << L"\n";
+		report << L"Run time " << elapsed << L" s\n";
+
+		uint64_t totalsamples = 0;
+		uint64_t totalchunks = 0;
+		uint64_t totaldropped = 0;
+		for ( uint32_t a = 0 ; a < nmasters ; a++ ) {
+			const uint32_t area = a * (config::slavespermaster + 1);
+			const uint32_t downsampling = params.allareas[area]->daq.inputs->oversampling()
+				? round2ui32(params.allareas[area]->daq.pixeltime() / params.allareas[area]->daq.inputs->MinimumPixeltime()) : 1;
+			report << L"Area " << area << L"\n";
+			const InputsSimulated* const input = daq.SimulatedInput(a);
+			if ( input != nullptr ) {
+				totalsamples += input->Delivered();
+				totalchunks += input->Chunks();
+				totaldropped += input->Dropped();
+				report << L"  chunks/s " << input->Chunks() / elapsed
+					<< L", samples/s per channel " << input->Delivered() / elapsed
+					<< L", pixels/s per channel " << input->Delivered() / std::max(1u, downsampling) / elapsed << L"\n";
+				report << L"  dropped samples per channel " << input->Dropped() << L"\n";
+			}
+			else
+				report << L"  no simulated input configured, no input counters available\n";
+			report << L"  frames mapped " << counters.framecounter[area].Value()
+				<< L" (" << counters.framecounter[area].Value() / elapsed << L" frames/s, " << params.allareas[area]->FrameTime() * 1000 << L" ms per frame configured)\n";
+			const InputBacklogStatistics& backlog = daq.BacklogStatistics(a);
+			if ( backlog.reads > 0 )
+				report << L"  input backlog per channel mean " << backlog.Mean() << L", max " << backlog.max << L" samples\n";
+			report << L"  chunk size " << backlog.chunksize << L" samples per channel (grown " << backlog.grown << L"x, shrunk " << backlog.shrunk << L"x)\n";
+			report << L"  DaqController->PipelineController queue depth mean " << daqdepths[a].Mean() << L", max " << daqdepths[a].max
+				<< L", unmapped chunks at stop " << daqbacklog[a] << L"\n";
+		}
+		report << L"PipelineController->StorageController queue depth mean " << storagedepth.Mean() << L", max " << storagedepth.max
+			<< L", unsaved frames at stop " << storagebacklog << L"\n";
+		report << L"PipelineController->Display queue depth mean " << displaydepth.Mean() << L", max " << displaydepth.max
+			<< L", frames drained " << display.Frames() << L"\n";
+		report << std::setprecision(3);
+		report << L"CPU time (s): DaqController " << daq.CPUTime() << L", PipelineController " << pipeline.CPUTime()
+			<< L", StorageController " << storage.CPUTime() << L", display sink " << display.CPUTime() << L"\n";
+		report << L"Total: " << totalchunks << L" chunks, " << totalsamples << L" samples per channel, " << totaldropped << L" dropped\n";
+
+		if ( options.contention ) {
+			report << std::setprecision(2);
+			for ( const auto& mode : { ScopeImageReadMode::ConstAccess, ScopeImageReadMode::Snapshot } ) {
+				const ScopeImageContentionResult result = ScopeImageContentionBenchmark(mode);
+				report << L"ScopeImage contention (" << ((mode == ScopeImageReadMode::ConstAccess) ? L"ConstAccess" : L"Snapshot") << L"): "
+					<< result.chunks << L" chunks, " << result.reads << L" reads, writer wait mean " << result.meanwait << L" us, max " << result.maxwait << L" us\n";
+			}
+		}
+
+		if ( options.vectorcheck ) {
+			for ( const auto& type : { ScannerVectorTypeHelper::Sawtooth, ScannerVectorTypeHelper::Bidirectional } ) {
+				for ( const auto& filltype : { ScannerVectorFillTypeHelper::FullframeXYZP, ScannerVectorFillTypeHelper::LineXPColumnYZ, ScannerVectorFillTypeHelper::LineZP } ) {
+					const ScannerVectorCheckResult result = ScannerVectorIncrementalCheck(type, filltype);
+					report << L"Scanner vector check (" << ScannerVectorTypeHelper::NameOf(type) << L", " << ScannerVectorFillTypeHelper::NameOf(filltype) << L"): "
+						<< result.steps << L" changes, " << result.vectormismatches << L" vector and " << result.lookupmismatches << L" lookup mismatches with full recalculation\n";
+				}
+				const ScannerVectorStreamCheckResult streamresult = ScannerVectorStreamSwitchCheck(type, 1024);
+				report << L"Scanner vector stream check (" << ScannerVectorTypeHelper::NameOf(type) << L"): " << streamresult.updates << L" online updates, "
+					<< streamresult.switchmisses << L" switches not at an upcoming frame start, " << streamresult.samplemismatches << L" mismatching samples\n";
+			}
+		}
+
+		if ( !options.tracefile.empty() ) {
+			tracer.ExportChromeTrace(options.tracefile);
+			report << L"Stage latencies (trace written to " << options.tracefile << L")\n" << tracer.Summary();
+		}
+
+		DBOUT(report.str());
+		return report.str();
+	}
+
+}
@@ -0,0 +1,85 @@
+#pragma once
+
+#include "helpers/ScopeDatatypes.h"
+
+namespace scope {
+
+	/** Options for a headless benchmark run, usually parsed from the command line */
+	struct ScopeBenchmarkOptions {
+		/** parameter file to start from, if empty the default parameters are used */
+		std::wstring parameterfile;
+
+		/** run time in seconds */
+		double duration;
+
+		/** x resolution of all areas */
+		uint32_t xres;
+
+		/** y resolution of all areas */
+		uint32_t yres;
+
+		/** number of channels to acquire (at most config::nchannels) */
+		uint32_t channels;
+
+		/** number of master areas to run (at most config::nmasters, all areas if slave areas are configured) */
+		uint32_t areas;
+
+		/** number of averages per frame */
+		uint32_t averages;
+
+		/** samples per channel per read chunk, 0 for the automatic chunk size of the input */
+		uint32_t chunksize;
+
+		/** if true the DaqController adapts the chunk size to the input backlog (see parameters::Inputs::adaptivechunksize) */
+		bool adaptive;
+
+		/** if true the simulated input delivers data paced at the pixel rate, if false as fast as possible */
+		bool realtime;
+
+		/** if true the StorageController saves the frames (as during a saved live scan) */
+		bool save;
+
+		/** if true the ScopeImage contention benchmark is appended to the report */
+		bool contention;
+
+		/** if true the partial scanner vector updates are compared with full recalculations (see ScannerVectorIncrementalCheck), the online updates
+		* of streamed scanner vectors are checked (see ScannerVectorStreamSwitchCheck), and the results are appended to the report */
+		bool vectorcheck;
+
+		/** if not empty the report is also written into this file */
+		std::wstring reportfile;
+
+		/** if not empty the stages are traced with ScopeTracer, the trace is written into this file (Chrome trace JSON) and summarized in the report */
+		std::wstring tracefile;
+
+		/** Sets the defaults: 10 seconds, 512x512 pixels, 2 channels, 1 area, no averaging, automatic chunk size, as fast as possible, no saving */
+		ScopeBenchmarkOptions();
+
+		/** Parses options of the form /seconds=10 /xres=512 /yres=512 /channels=2 /areas=1 /averages=1 /chunksize=0 /adaptive=0 /realtime=0 /save=0 /contention /vectorcheck /report=file.txt /trace=file.json
+		* An argument not starting with / is taken as the parameter file. Unknown options throw a ScopeException.
+		* @param[in] _cmdline the command line (without the program name) */
+		static ScopeBenchmarkOptions Parse(const std::wstring& _cmdline);
+	};
+
+	/** @ingroup ScopeControl
+	* Headless end-to-end benchmark of the acquisition chain. Wires DaqController, PipelineController and StorageController with their queues
+	* (as TheScope does) and a display sink that only drains its queue. Runs a live scan for the requested duration, then reports throughput,
+	* queue depths, CPU time per stage and dropped data.\n
+	* Use it with the simulated input (config::InputEnum::Simulated) to get reproducible numbers without any hardware. With DAQmx outputs
+	* and no device present, the output tasks fail (non-fatally if DAQMX_THROW_EXCEPTION is false) and the inputs are unaffected. */
+	class ScopeBenchmark {
+
+	protected:
+		/** the options of this run */
+		const ScopeBenchmarkOptions options;
+
+	public:
+		/** @param[in] _options the options for the run */
+		explicit ScopeBenchmark(const ScopeBenchmarkOptions& _options);
+
+		/** Runs the benchmark (blocks for the duration of the run)
+		* @return the report as human readable text */
+		std::wstring Run();
+	};
+
+}
@@ -1,6 +1,7 @@
 #include "stdafx.h"
 #include "ScopeController.h"
 #include "devices\xyz\XYZControl.h"
+#include "scanmodes\ScannerVectorCache.h"
 
 namespace scope {
 
@@ -35,6 +36,7 @@ namespace scope {
 		, onlineupdate_running(false)
 		, time(0)
 	{
+		ConfigureWorkers(L"ScopeController");
 	}
 
 	ScopeController::~ScopeController() {
@@ -117,8 +119,13 @@ namespace scope {
 
 	void ScopeController::SetScannerVectorParameters() {
 		DBOUT(L"ScopeControllerImpl::SetScannerVectorParameters");
-		for (uint32_t a = 0; a < nareas; a++)
+		for (uint32_t a = 0; a < nareas; a++) {
+			// Continuous scans on streaming outputs need only the stream tables, not the full frame vector
+			framescannervecs[a]->SetStreaming(ctrlparams.allareas[a]->daq.outputs->Streaming() && (ctrlparams.requested_mode() == DaqModeHelper::continuous));
+			// Vectors at the start of runs, of stack and of timeseries planes are likely revisited
+			framescannervecs[a]->SetCaching(true);
 			framescannervecs[a]->SetParameters(&ctrlparams.allareas[a]->daq, &ctrlparams.allareas[a]->Currentframe(), &ctrlparams.allareas[a]->fpuzstage);
+		}
 	}
 
 	ControllerReturnStatus ScopeController::RunLive(StopCondition* const sc) {
@@ -144,6 +151,15 @@ namespace scope {
 		LogRun();
 		SetScannerVectorParameters();
 
+		// Acquire fast z stacks without restarting everything on every plane if possible
+		if (ctrlparams.stack.ContinuousFastZ()) {
+			if (ContinuousStackPossible())
+				return RunStackContinuous(sc);
+			ScopeLogger::GetInstance().Log(L"Continuous fast z stack not possible with these outputs/scan settings, acquiring plane by plane", log_warning);
+			// Outputs configure their buffers according to this
+			ctrlparams.stack.continuousfastz.Set(false, false, false);
+		}
+
 		// We do the same number of planes in each area (if fast z and not that many planes in range in one area, Pockels was set to zero in parameters::stack::UpdatePlanes)
 		for (auto& a : ctrlparams.allareas)
 			a->daq.requested_frames = ctrlparams.stack.planes.size();
@@ -160,16 +176,18 @@ namespace scope {
 		// Set scale for the progress indicator
 		counters.planecounter.SetWithLimits(0, 0, ctrlparams.stack.planes.size());
 
+		// Stage position is the same for all areas, no of slices thus also the same. Start moving to the first plane.
+		const bool zstage = (ctrlparams.stack.zdevicetype().t == ZDeviceHelper::ZStage);
+		const double stagex = zstage ? theStage.CurrentXPosition() : 0.0;
+		const double stagey = zstage ? theStage.CurrentYPosition() : 0.0;
+		if (zstage)
+			theStage.MoveAbsoluteAsync(stagex, stagey, ctrlparams.stack.planes[0][0].position());
+
 		// Go through all the precalculated planes
 		for (uint32_t p = 0; p < ctrlparams.stack.planes.size(); p++) {
 
-			// Move to precalculated position (stage position is the same for all areas, no of slices thus also the same)
-			if (ctrlparams.stack.zdevicetype().t == ZDeviceHelper::ZStage) {
-				theStage.MoveAbsolute(theStage.CurrentXPosition(), theStage.CurrentYPosition(), ctrlparams.stack.planes[p][0].position());
-				// Wait one second for movement to complete
-				std::this_thread::sleep_for(std::chrono::milliseconds(1000));
-			}
-			else if (ctrlparams.stack.zdevicetype().t == ZDeviceHelper::FastZ) {
+			// Set fast z to precalculated position
+			if (ctrlparams.stack.zdevicetype().t == ZDeviceHelper::FastZ) {
 				for (uint32_t a = 0; a < nareas; a++) {
 					ctrlparams.allareas[a]->Currentframe().fastz = ctrlparams.stack.planes[p][a].position();
 					// Also change guiparameters so the users sees what is happening during stacking
@@ -187,12 +205,23 @@ namespace scope {
 			// Calculate scanner vectors
 			SetScannerVectorParameters();
 
+			// Wait until the stage arrived at the precalculated position and settled
+			if (zstage && !theStage.WaitForMotion(&repeat_abort) && !repeat_abort.IsSet())
+				ScopeLogger::GetInstance().Log(L"Stage did not report motion complete for plane " + std::to_wstring(p) + L" in time", log_warning);
+			if (repeat_abort.IsSet())
+				break;
+
 			// Start
 			theDaq.Start(ctrlparams);
 			thePipeline.Start();
 
 			// and wait for them to end
 			theDaq.WaitForAll(400);
+
+			// Acquisition of this plane is done, move on to the next plane while the pipeline still works on this one
+			if (zstage && (p + 1 < ctrlparams.stack.planes.size()) && !repeat_abort.IsSet())
+				theStage.MoveAbsoluteAsync(stagex, stagey, ctrlparams.stack.planes[p + 1][0].position());
+
 			thePipeline.WaitForAll(400);
 
 			// Stop the stack if abort requested
@@ -208,6 +237,70 @@ namespace scope {
 		ClearAfterStop();
 
 		counters.planecounter = 0;
+		ScopeLogger::GetInstance().Log(ScannerVectorCache::GetInstance().Summary(), log_info);
+
+		return ControllerReturnStatus::finished;
+	}
+
+	bool ScopeController::ContinuousStackPossible() const {
+		if ((config::outputselect != config::OutputEnum::SimpleDAQmx) || ctrlparams.stack.planes.empty())
+			return false;
+		size_t bytes = 0;
+		for (uint32_t a = 0; a < nareas; a++) {
+			if (framescannervecs[a]->FillType() == ScannerVectorFillTypeHelper::LineXPColumnYZ)
+				return false;
+			bytes += framescannervecs[a]->GetInterleavedVector()->size() * sizeof(int16_t) * ctrlparams.stack.planes.size() * ctrlparams.allareas[a]->daq.averages();
+		}
+		return bytes <= maxstackvectorbytes;
+	}
+
+	ControllerReturnStatus ScopeController::RunStackContinuous(StopCondition* const sc) {
+		const uint32_t planes = static_cast<uint32_t>(ctrlparams.stack.planes.size());
+
+		// One frame (with averages) per plane, all in one nframes run of all controllers
+		for (auto& a : ctrlparams.allareas)
+			a->daq.requested_frames = planes;
+
+		// Precalculate the fast z and Pockels values of all planes into one output vector per area. Afterwards the scanner vectors are
+		// those of the last plane, but x/y and thus the lookup vectors for the pipeline are the same for all planes.
+		for (uint32_t a = 0; a < nareas; a++) {
+			std::vector<double> fastz(planes);
+			std::vector<double> pockels(planes);
+			for (uint32_t p = 0; p < planes; p++) {
+				fastz[p] = ctrlparams.stack.planes[p][a].position();
+				pockels[p] = ctrlparams.stack.planes[p][a].pockels();
+			}
+			framescannervecs[a]->SetCaching(true);
+			theDaq.SetStackVector(a, framescannervecs[a]->GetStackVector(fastz, pockels, ctrlparams.allareas[a]->daq.averages()));
+		}
+
+		counters.planecounter.SetWithLimits(0, 0, planes);
+		thePipeline.SetRequestedFrames(planes);
+		StartAllControllers();
+
+		// Follow the progress, frames leave the pipeline plane after plane
+		uint32_t shownplane = planes;
+		while (thePipeline.Running() && !repeat_abort.IsSet()) {
+			std::this_thread::sleep_for(std::chrono::milliseconds(100));
+			const uint32_t done = static_cast<uint32_t>(counters.framecounter[0].Value());
+			counters.planecounter = done;
+			// Let the user see which plane is currently acquired
+			const uint32_t p = std::min(done, planes - 1);
+			if (p != shownplane) {
+				for (uint32_t a = 0; a < nareas; a++) {
+					guiparameters.allareas[a]->Currentframe().fastz = ctrlparams.stack.planes[p][a].position();
+					guiparameters.allareas[a]->Currentframe().pockels = ctrlparams.stack.planes[p][a].pockels();
+				}
+				shownplane = p;
+			}
+		}
+
+		WaitForAllControllers();
+		thePipeline.SetRequestedFrames(0);
+		ClearAfterStop();
+
+		counters.planecounter = 0;
+		ScopeLogger::GetInstance().Log(ScannerVectorCache::GetInstance().Summary(), log_info);
 
 		return ControllerReturnStatus::finished;
 	}
@@ -220,6 +313,9 @@ namespace scope {
 		// Set repeat counter limits (for progress bar display)
 		counters.repeatcounter.SetWithLimits(1, 1, ctrlparams.timeseries.repeats());
 
+		// Set up the tasks only once, every repeat just restarts them
+		theDaq.Arm(ctrlparams);
+
 		// Go through all repeats
 		for (uint32_t t = 0; t < ctrlparams.timeseries.repeats(); t++) {
 			counters.repeatcounter = t + 1;
@@ -253,6 +349,9 @@ namespace scope {
 			}
 		}
 
+		theDaq.Disarm();
+		ScopeLogger::GetInstance().Log(theDaq.StartLatencies().Summary(), log_info);
+		ScopeLogger::GetInstance().Log(ScannerVectorCache::GetInstance().Summary(), log_info);
 		ClearAfterStop();
 		return ControllerReturnStatus::finished;
 	}
@@ -279,6 +378,10 @@ namespace scope {
 			ctrlparams.run_state = RunStateHelper::RunningContinuous;
 			ctrlparams.storage.savelive = true;
 
+			// Set up the tasks on the first trial, all following trials just restart them
+			if (!theDaq.Armed())
+				theDaq.Arm(ctrlparams);
+
 			StartAllControllers();
 			// Update time
 			counters.totaltime = static_cast<double>(::timeGetTime() - starttime) / 1000;
@@ -294,6 +397,8 @@ namespace scope {
 			counters.totaltime = static_cast<double>(::timeGetTime() - starttime) / 1000;
 		}
 
+		theDaq.Disarm();
+		ScopeLogger::GetInstance().Log(theDaq.StartLatencies().Summary(), log_info);
 		ClearAfterStop();
 		return ControllerReturnStatus::finished;
 	}
@@ -315,8 +420,7 @@ namespace scope {
 			guiparameters.time.Set(GetCurrentTimeString());
 			ctrlparams = guiparameters;
 			//SetGuiCtrlState();
-			stops[0].Set(false);
-			futures[0] = std::async(std::bind(&ScopeController::RunLive, this, &stops[0]));
+			StartWorker(0, std::bind(&ScopeController::RunLive, this, &stops[0]));
 			futures[0].wait();				// Wait here, because RunLive should quickly return
 		}
 	}
@@ -329,8 +433,7 @@ namespace scope {
 			guiparameters.run_state.Set(RunStateHelper::Mode::RunningStack);
 			ctrlparams = guiparameters;
 			//SetGuiCtrlState();
-			stops[0].Set(false);
-			futures[0] = std::async(std::bind(&ScopeController::RunStack, this, &stops[0]));
+			StartWorker(0, std::bind(&ScopeController::RunStack, this, &stops[0]));
 		}
 	}
 
@@ -342,8 +445,7 @@ namespace scope {
 			guiparameters.time.Set(GetCurrentTimeString());
 			ctrlparams = guiparameters;
 			//SetGuiCtrlState();
-			stops[0].Set(false);
-			futures[0] = std::async(std::bind(&ScopeController::RunSingle, this, &stops[0]));
+			StartWorker(0, std::bind(&ScopeController::RunSingle, this, &stops[0]));
 		}
 	}
 
@@ -361,8 +463,7 @@ namespace scope {
 			
 			ctrlparams = guiparameters;
 			//SetGuiCtrlState();
-			stops[0].Set(false);
-			futures[0] = std::async(std::bind(&ScopeController::RunTimeseries, this, &stops[0]));
+			StartWorker(0, std::bind(&ScopeController::RunTimeseries, this, &stops[0]));
 		}
 	}
 
@@ -374,8 +475,7 @@ namespace scope {
 			guiparameters.time.Set(GetCurrentTimeString());
 			ctrlparams = guiparameters;
 			//SetGuiCtrlState();
-			stops[0].Set(false);
-			futures[0] = std::async(std::bind(&ScopeController::RunBehavior, this, &stops[0]));
+			StartWorker(0, std::bind(&ScopeController::RunBehavior, this, &stops[0]));
 		}
 	}
 
@@ -439,13 +539,18 @@ namespace scope {
 					}
 
 					DBOUT(L"ScopeController::UpdateAreaParametersFromGui guioffset " << guiparameters.allareas[_area]->Currentframe().xoffset() << L" " << guiparameters.allareas[_area]->Currentframe().yoffset());
-					// This is the expensive step, the recalculation of the scannervector
+					// This is the expensive step, the recalculation of the scannervector. Do not fill the vector cache with every slider tick.
+					framescannervecs[_area]->SetCaching(false);
 					framescannervecs[_area]->SetParameters(&ctrlparams.allareas[_area]->daq, &ctrlparams.allareas[_area]->Currentframe(), &ctrlparams.allareas[_area]->fpuzstage);
 
 					// Fix for online pockel cell update: somehow in this function the currentframe is always framesaw, so I added an if statement to go straight for frameresonance parameters in the resonance scanmode (Karlis)
 					//framescannervecs[_area]->SetParameters(&parameters.areas[_area]->daq, SCOPE_USE_RESONANCESCANNER?&parameters.areas[_area]->frameresonance:parameters.areas[_area]->currentframe, &parameters.areas[_area]->fpuzstage);
 					// This returns only after the updated scannervec is written to the device buffer or the whole update write is aborted
-					theDaq.OnlineParameterUpdate(_area, *ctrlparams.allareas[_area].get());
+					const uint64_t switchsample = theDaq.OnlineParameterUpdate(_area, *ctrlparams.allareas[_area].get());
+
+					// The pipeline switches to the new lookup vector at the same frame as the outputs
+					if ( ctrlparams.allareas[_area]->areatype() == AreaTypeHelper::Master )
+						thePipeline.OnlineParameterUpdate(_area, switchsample);
 
 					theDisplay.ResolutionChange(*ctrlparams.allareas[_area].get());
 				}
@@ -15,6 +15,10 @@
 #include "scanmodes/ScannerVectorFramePlaneHopper.h"
 #include "scanmodes/ScannerVectorFrameResonanceBiDi.h"
 #include "scanmodes/ScannerVectorFrameResonanceHopper.h"
+#include "scanmodes/ScannerVectorFrameMultiROI.h"
+#include "scanmodes/ScannerVectorLine.h"
+#include "scanmodes/ScannerVectorFrameVolume.h"
+#include "scanmodes/ScannerVectorTrajectory.h"
 #include "helpers/ScopeMultiImage.h"
 #include "helpers/ScopeMultiImageResonanceSW.h"
 #include "helpers/ScopeException.h"
@@ -104,6 +108,9 @@ namespace scope {
 			/** stores the time to run a scan */
 			DWORD time;
 
+			/** upper limit for the memory of all precalculated output vectors of a continuous fast z stack */
+			static const size_t maxstackvectorbytes = 512 * 1024 * 1024;
+
 		public:
 			/** Scanner vectors
 			* @{ */
@@ -139,6 +146,12 @@ namespace scope {
 			/** Worker function to control a stack scan */
 			ControllerReturnStatus RunStack(StopCondition* const sc);
 
+			/** Acquires a fast z stack in one continuous nframes run, called from RunStack if parameters::Stack::ContinuousFastZ */
+			ControllerReturnStatus RunStackContinuous(StopCondition* const sc);
+
+			/** @return true if the current outputs and scanner vectors allow a continuous fast z stack (full frame vectors, fit into memory) */
+			bool ContinuousStackPossible() const;
+
 			/** Worker function to control a timeseries scan */
 			ControllerReturnStatus RunTimeseries(StopCondition* const sc);
 
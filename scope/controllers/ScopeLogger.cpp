@@ -4,20 +4,36 @@
 #include "parameters/Windows.h"
 
 namespace scope {
+
+	const std::chrono::milliseconds ScopeLogger::journalmaxage(1000);
 	
 	ScopeLogger::ScopeLogger()
 		: file_path(L"")
 		, filepath_set(false)
+		, journal_path(L"")
+		, journalpending(0)
+		, logbookpending(0)
+		, journalsize(0)
+		, journalnumber(0)
 		, file_messages(log_all)
 		, console_message(log_all)
 		, logframe_message(log_all)
 		, logframe(nullptr)
 		, logbookentries(1, L"")
-		, logbooktext(L"") {
+		, logbooktext(L"")
+		, quitflusher(false) {
+		journalbatch.reserve(journalbatchsize);
+		flusher = std::thread(&ScopeLogger::RunFlusher, this);
 		Log(L"Logbook started", log_info);
 	}
 
 	ScopeLogger::~ScopeLogger() {
+		quitflusher = true;
+		flusherwakeup.notify_all();
+		if ( flusher.joinable() )
+			flusher.join();
+		if ( journalfile.is_open() )
+			journalfile.close();
 		if ( userlogfile.is_open() )
 			userlogfile.close();
 	}
@@ -32,23 +48,112 @@ namespace scope {
 		return ControllerReturnStatus::finished;
 	}
 		
+	void ScopeLogger::RunFlusher() {
+		while ( !quitflusher ) {
+			{
+				std::unique_lock<std::mutex> lock(flushermutex);
+				flusherwakeup.wait_for(lock, journalmaxage, [this]() { return quitflusher.load(); });
+			}
+			// Entries logged during a quiet period would otherwise wait for the next Log call
+			if ( !quitflusher && ((journalpending > 0) || (logbookpending > 0)) )
+				Flush();
+		}
+	}
+
+	void ScopeLogger::OpenJournal() {
+		if ( journalfile.is_open() )
+			journalfile.close();
+		std::wstring name(journal_path);
+		if ( journalnumber > 0 )
+			name += L"_" + std::to_wstring(journalnumber);
+		journalfile.open(name + L".txt", std::ios_base::out | std::ios_base::app);
+		if ( !journalfile.is_open() )
+			DBOUT(L"ScopeLogger::OpenJournal unable to open " << name.c_str());
+		journalnumber++;
+		journalsize = 0;
+	}
+
+	void ScopeLogger::TrimLogbookText() {
+		if ( logbooktext.length() <= maxlogbooktext )
+			return;
+		// Cut to three quarters, so that we do not have to trim again on the next entry
+		size_t cut = logbooktext.find(L"\r\n", logbooktext.length() - maxlogbooktext * 3 / 4);
+		cut = (cut == std::wstring::npos) ? logbooktext.length() - maxlogbooktext * 3 / 4 : cut + 2;
+		logbooktext.erase(0, cut);
+	}
+
 	ControllerReturnStatus ScopeLogger::WriteToLogbox(StopCondition* const sc, const std::wstring message, const log_message_type msgtype) {
 		logbookentries.push_back(message+L"\r\n");
+		if ( logbookentries.size() > maxlogbookentries )
+			logbookentries.pop_front();
 
-		// Get current logbook stuff from log window
-		if ( logframe != nullptr )
-			logbooktext = logframe->GetLogText();
-		
-		// Add linebreak if needed
-		if ( logbooktext.length() > 2 )
-			if ( logbooktext.substr(logbooktext.length()-2, 2) != L"\r\n" )
-				logbooktext += L"\r\n";
-		
-		// Add message
-		logbooktext += message+L"\r\n";
-		
-		// Flush to disk and log window
-		FlushLogbox(sc);
+		const auto now = std::chrono::steady_clock::now();
+		const bool urgent = (msgtype & (log_warning | log_error)) != 0;
+
+		// Machine generated entries go into the append-only journal, in batches
+		if ( (msgtype & file_messages) != 0 ) {
+			if ( journalbatch.empty() )
+				journalbatchstart = now;
+			journalbatch.push_back(message);
+			journalpending = journalbatch.size();
+			if ( (journalbatch.size() >= journalbatchsize) || urgent || (now - journalbatchstart >= journalmaxage) )
+				FlushJournal(sc);
+		}
+
+		// Append to the log window without touching what the user wrote there, the window is the logbook text while attached
+		if ( logframe != nullptr ) {
+			logframe->AppendLogText(message+L"\r\n");
+			if ( logframe->GetLogTextLength() > maxlogbooktext ) {
+				logbooktext = logframe->GetLogText();
+				TrimLogbookText();
+				logframe->ReplaceLogText(logbooktext);
+			}
+		}
+		else {
+			// Add linebreak if needed
+			if ( logbooktext.length() > 2 )
+				if ( logbooktext.substr(logbooktext.length()-2, 2) != L"\r\n" )
+					logbooktext += L"\r\n";
+
+			// Add message
+			logbooktext += message+L"\r\n";
+			TrimLogbookText();
+		}
+
+		// The user logbook on disk follows on the same schedule as the journal
+		if ( logbookpending++ == 0 )
+			logbookbatchstart = now;
+		if ( (logbookpending >= journalbatchsize) || urgent || (now - logbookbatchstart >= journalmaxage) )
+			FlushUserLogbook(sc);
+
+		return ControllerReturnStatus::finished;
+	}
+
+	ControllerReturnStatus ScopeLogger::FlushJournal(StopCondition* const sc) {
+		if ( journalbatch.empty() )
+			return ControllerReturnStatus::finished;
+
+		if ( !journalfile.is_open() ) {
+			// No file yet (before SetFilepath), keep only the most recent entries
+			if ( journalbatch.size() > maxlogbookentries )
+				journalbatch.erase(std::begin(journalbatch), std::end(journalbatch) - maxlogbookentries);
+			journalpending = journalbatch.size();
+			return ControllerReturnStatus::finished;
+		}
+
+		// One write for the whole batch
+		std::wstring block;
+		block.reserve(journalbatch.size() * 64);
+		for ( const auto& e : journalbatch )
+			block += e + L"\n";
+		journalfile << block;
+		journalfile.flush();
+		journalsize += block.length();
+		journalbatch.clear();
+		journalpending = 0;
+
+		if ( journalsize > journalrotatesize )
+			OpenJournal();
 
 		return ControllerReturnStatus::finished;
 	}
@@ -57,14 +162,29 @@ namespace scope {
 		if ( logframe != nullptr )
 			logframe->ReplaceLogText(logbooktext);
 		
+		WriteUserLogfile();
+		
+		return ControllerReturnStatus::finished;
+	}
+
+	ControllerReturnStatus ScopeLogger::FlushUserLogbook(StopCondition* const sc) {
+		if ( logbookpending == 0 )
+			return ControllerReturnStatus::finished;
+		// While attached the window is the logbook text (with the user's edits)
+		if ( logframe != nullptr )
+			logbooktext = logframe->GetLogText();
+		WriteUserLogfile();
+		return ControllerReturnStatus::finished;
+	}
+
+	void ScopeLogger::WriteUserLogfile() {
 		if ( filepath_set ) {
 			if ( !userlogfile.is_open() )
 				userlogfile.open(file_path, std::ios_base::out | std::ios_base::trunc);	// Trunc: overwrite
 			userlogfile << logbooktext;
 			userlogfile.close();
 		}
-		
-		return ControllerReturnStatus::finished;
+		logbookpending = 0;
 	}
 
 	void ScopeLogger::SetLoggingTypes(const log_message_type& filem, const log_message_type& consolem, const log_message_type& logframem) {
@@ -76,6 +196,7 @@ namespace scope {
 	void ScopeLogger::SetFilepath(const std::wstring& _filepath) {
 		if ( !filepath_set ) {
 			file_path = _filepath + L"\\log_" + GetCurrentDateString() + L"_" + GetCurrentTimeString(true) + L".txt";
+			journal_path = _filepath + L"\\journal_" + GetCurrentDateString() + L"_" + GetCurrentTimeString(true);
 
 			userlogfile.open(file_path);
 			if ( userlogfile.bad() )
@@ -84,6 +205,12 @@ namespace scope {
 
 			filepath_set = true;
 
+			// Opened in the Active's thread, the only one touching the journal. Entries logged before are written with the next batch.
+			active.Send([this](StopCondition* const sc) {
+				OpenJournal();
+				return ControllerReturnStatus::finished;
+			});
+
 			Log(L"Logfile started", log_info);
 		}
 	}
@@ -95,10 +222,15 @@ namespace scope {
 		logmsg << st.wHour << L":" << std::setfill(L'0') << std::setw(2) << st.wMinute << L"::" << st.wSecond << L" - ";
 		logmsg << message;
 		active.Send(std::bind(&ScopeLogger::WriteToConsole, this, std::placeholders::_1, logmsg.str()));
-		// Writing to disk (FlushLogBox) is called in WriteToLogbox because user entries in LogView need also to be written to disk
+		// WriteToLogbox also writes the user logbook to disk (batched like the journal), so user entries in LogView get there too
 		active.Send(std::bind(&ScopeLogger::WriteToLogbox, this, std::placeholders::_1, logmsg.str(), msgtype));
 	}
 
+	void ScopeLogger::Flush() {
+		active.Send(std::bind(&ScopeLogger::FlushJournal, this, std::placeholders::_1));
+		active.Send(std::bind(&ScopeLogger::FlushUserLogbook, this, std::placeholders::_1));
+	}
+
 	void ScopeLogger::AttachLogFrame(gui::CLogFrame* const _logframe) {
 		logframe = _logframe;
 		active.Send(std::bind(&ScopeLogger::FlushLogbox, this, std::placeholders::_1));
@@ -127,6 +259,12 @@ namespace scope {
 	}
 
 	void ScopeLogger::Shutdown() {
+		quitflusher = true;
+		flusherwakeup.notify_all();
+		if ( flusher.joinable() )
+			flusher.join();
+		Flush();
+		active.Send(std::bind(&ScopeLogger::FlushLogbox, this, std::placeholders::_1));
 		active.Quit();
 	}
 
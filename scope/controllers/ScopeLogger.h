@@ -31,6 +31,33 @@ namespace scope {
 			/** File with user comments and logging of performed scans etc */
 			std::wofstream userlogfile;
 
+			/** base path of the journal files (without the rotation number and extension) */
+			std::wstring journal_path;
+
+			/** Append-only journal of all machine generated log entries, written in batches */
+			std::wofstream journalfile;
+
+			/** entries not yet written to the journal */
+			std::vector<std::wstring> journalbatch;
+
+			/** number of entries in journalbatch, for the flusher thread */
+			std::atomic<size_t> journalpending;
+
+			/** time the oldest entry in journalbatch was logged */
+			std::chrono::steady_clock::time_point journalbatchstart;
+
+			/** number of entries logged since the user logbook was last written to disk, for the flusher thread */
+			std::atomic<size_t> logbookpending;
+
+			/** time the oldest of these entries was logged */
+			std::chrono::steady_clock::time_point logbookbatchstart;
+
+			/** characters written to the current journal file */
+			uint64_t journalsize;
+
+			/** number of the current journal file, counts rotations */
+			uint32_t journalnumber;
+
 			/** which message types to save to disk */
 			std::atomic<log_message_type> file_messages;
 
@@ -46,20 +73,68 @@ namespace scope {
 			/** the complete log text as a string */
 			std::wstring logbooktext;
 
-			/** a vector of all log entries done by scope */
+			/** the most recent log entries done by scope (at most maxlogbookentries, the journal has all of them) */
 			std::list<std::wstring> logbookentries;
 
+			/** signals the flusher thread to quit */
+			std::atomic<bool> quitflusher;
+
+			/** to wake up the flusher thread early */
+			std::condition_variable flusherwakeup;
+
+			/** mutex for flusherwakeup */
+			std::mutex flushermutex;
+
+			/** thread that makes sure batched journal entries reach the disk after at most journalmaxage */
+			std::thread flusher;
+
+			/** the journal batch is written when it has that many entries... */
+			static const size_t journalbatchsize = 64;
+
+			/** ...or when its oldest entry is that old (warnings and errors are written immediately) */
+			static const std::chrono::milliseconds journalmaxage;
+
+			/** a new journal file is started when the current one grows beyond that many characters */
+			static const uint64_t journalrotatesize = 16 * 1024 * 1024;
+
+			/** number of entries kept in logbookentries */
+			static const size_t maxlogbookentries = 1000;
+
+			/** the logbook text (and window) is trimmed at the front when it grows beyond that many characters */
+			static const size_t maxlogbooktext = 1024 * 1024;
+
 			ScopeLogger();
 
+			/** Loop of the flusher thread */
+			void RunFlusher();
+
+			/** Opens the next journal file and increments journalnumber */
+			void OpenJournal();
+
+			/** Cuts the logbook text at the front (at a line break) if it is longer than maxlogbooktext */
+			void TrimLogbookText();
+
 			/** Writes message to debug console */
 			ControllerReturnStatus WriteToConsole(StopCondition* const sc, const std::wstring message);
 			
-			/** Writes message to the logbook window */
+			/** Appends message to the logbook window and to the journal batch. Writes the journal batch and the user logbook to disk
+			* when the batch is full, its oldest entry is older than journalmaxage, or message is a warning or an error. */
 			ControllerReturnStatus WriteToLogbox(StopCondition* const sc, const std::wstring message, const log_message_type msgtype);
 			
 			/** Updates the logbook window , writes complete logbook to disk, overwrites the old logbook on disk.
-			* Since user can edit logbook everywhere, we always have to (over)write everything */
+			* Since user can edit logbook everywhere, we always have to (over)write everything. Called on user input, when
+			* the log window is attached, and on shutdown. */
 			ControllerReturnStatus FlushLogbox(StopCondition* const sc);
+
+			/** Writes the user logbook to disk if entries were logged since the last write, takes the text from the logbook window
+			* if attached (with the user's edits). Called by WriteToLogbox and Flush on the journal's schedule. */
+			ControllerReturnStatus FlushUserLogbook(StopCondition* const sc);
+
+			/** Overwrites the user log file with logbooktext (if the file path is set) */
+			void WriteUserLogfile();
+
+			/** Appends the journal batch to the journal file in one write, rotates the journal file if it grew too big */
+			ControllerReturnStatus FlushJournal(StopCondition* const sc);
 				
 		public:	
 			/** disable copy */
@@ -75,12 +150,15 @@ namespace scope {
 			/** Sets which types of message will be logged to file, console, and logframe.*/
 			void SetLoggingTypes(const log_message_type& filem, const log_message_type& consolem, const log_message_type& logframem);
 			
-			/** Sets the filepath and creates logfile */
+			/** Sets the filepath and creates logfile and the first journal file */
 			void SetFilepath(const std::wstring& _filepath = L"C:\\ScopeData");
 
 			/** Logs a message.*/
 			void Log(const std::wstring& message, const log_message_type& msgtype);
 
+			/** Writes pending journal entries and the user logbook to disk now (asynchronously) */
+			void Flush();
+
 			/** Attaches a CLogFrame as the logbook window.*/
 			void AttachLogFrame(gui::CLogFrame* const _logframe);
 
@@ -96,7 +174,7 @@ namespace scope {
 			/** Detaches a CLogFrame.*/
 			void DetachLogFrame();
 
-			/** Shutdown the Active, called from Run in scope.cpp.
+			/** Writes pending journal entries and the logbook, stops the flusher thread and shuts down the Active, called from Run in scope.cpp.
 			* avoids a dangling async thread from the ScopeLogger.*/
 			void Shutdown();
 	};
@@ -1,5 +1,6 @@
 #include "stdafx.h"
 #include "StorageController.h"
+#include "helpers/ScopeTrace.h"
 
 namespace scope {
 
@@ -9,7 +10,9 @@ namespace scope {
 		, input_queue(_iqueue)
 		, runcounter(0)
 		, filenames(_nactives)
-		, encoders(_nactives) {
+		, encoders(_nactives)
+		, linewriters(_nactives) {
+		ConfigureWorkers(L"StorageController");
 	}
 
 	StorageController::~StorageController() {
@@ -27,6 +30,7 @@ namespace scope {
 		DBOUT(L"StorageController::Run beginning\n");
 		ControllerReturnStatus returnstatus(ControllerReturnStatus::none);
 		uint32_t framearea = 0;
+		uint32_t frameplane = 0;
 		std::wstring foldername(L"");
 		std::vector<ScopeMultiImagePtr> current_frames(ctrlparams.allareas.size());
 		const DaqMode requested_mode = ctrlparams.requested_mode();
@@ -60,7 +64,11 @@ namespace scope {
 		// dequeue and save loop
 		while ( !sc->IsSet() ) {
 			// Dequeue
-			ScopeMessage<config::MultiImagePtrType> msg(input_queue->Dequeue());
+			ScopeMessage<config::MultiImagePtrType> msg;
+			{
+				ScopeTraceSpan span("StorageController::Dequeue");
+				msg = input_queue->Dequeue();
+			}
 
 			// If message has abort tag, break from while loop
 			if ( msg.tag == ScopeMessageTag::abort ) {
@@ -70,23 +78,31 @@ namespace scope {
 			DBOUT(L"StorageController::impl::Run dequeued\n");
 
 			framearea = msg.cargo->Area();
+			frameplane = std::min(msg.cargo->Plane(), static_cast<uint32_t>(encoders[framearea].size()) - 1);
 			current_frames[framearea] = msg.cargo;
 
 			// otherwise something is seriously wrong:
 			assert(ctrlparams.allareas[framearea]->daq.inputs->channels() == current_frames[framearea]->Channels());
 
 			// Create new frame on disk (Frames are only actually saved if encoder was created with dosave=true)
-			encoders[framearea]->NewFrame();
+			encoders[framearea][frameplane]->NewFrame();
 			// and write into it
-			encoders[framearea]->WriteFrame(current_frames[framearea]);
+			{
+				ScopeTraceSpan span("ScopeMultiImageEncoder::WriteFrame", framearea);
+				encoders[framearea][frameplane]->WriteFrame(current_frames[framearea]);
+			}
+			if ( linewriters[framearea] ) {
+				ScopeTraceSpan span("ScopeLineStreamWriter::WriteLines", framearea);
+				linewriters[framearea]->WriteLines(current_frames[framearea]);
+			}
 
 			reqEqual = false;
 			framecountEqual = false;
 			const uint32_t maxframes = 3000000000 / ( current_frames[framearea]->Linewidth()*current_frames[framearea]->Lines()*16/8 );
-			// Preparation for the conditions below
+			// Preparation for the conditions below (planes arrive in order, a daq frame is stored when its last plane is stored)
 			for ( uint32_t i = 0; i < nactives; i++ ){
-				reqEqual = reqEqual || ( requested_frames.at(i) == encoders.at(i)->Framecount() + totalframecount.at(i) );
-				framecountEqual = framecountEqual || ( encoders.at(i)->Framecount() == maxframes );
+				reqEqual = reqEqual || ( requested_frames.at(i) == encoders.at(i).back()->Framecount() + totalframecount.at(i) );
+				framecountEqual = framecountEqual || ( encoders.at(i).back()->Framecount() == maxframes );
 			}
 
 			// Check if in nframes mode if we have already stored all requested frames for all areas
@@ -100,11 +116,13 @@ namespace scope {
 			// Check if the old file has to be closed and a new one opened
 			if ( framecountEqual ) {
 				for ( uint32_t i = 0; i < nactives; i++ ) {
-					totalframecount.at(i)+= encoders.at(i)->Framecount();
+					totalframecount.at(i)+= encoders.at(i).back()->Framecount();
 
 					// This calls encoders destructors, thus all files are closed and can be TIFF-fixed
 					for ( auto& e : encoders )
-						e.reset(nullptr);
+						e.clear();
+					for ( auto& w : linewriters )
+						w.reset(nullptr);
 
 					// Fix the tiff tags if wanted
 					if ( dosave && ctrlparams.storage.usetifftags() )
@@ -118,7 +136,9 @@ namespace scope {
 
 		// This calls encoders destructors, thus all files are closed and can be TIFF-fixed
 		for ( auto& e : encoders )
-			e.reset(nullptr);
+			e.clear();
+		for ( auto& w : linewriters )
+			w.reset(nullptr);
 
 		// Fix the tiff tags if wanted
 		if ( dosave && ctrlparams.storage.usetifftags() )
@@ -166,17 +186,31 @@ namespace scope {
 
 	void StorageController::InitializeEncoders(const bool& _dosave, const std::wstring& _foldername) {
 		for ( uint32_t a = 0 ; a < ctrlparams.allareas.size(); a++ ) {
-			// Make a new multi image encoder for that area
-			encoders[a] = std::unique_ptr<ScopeMultiImageEncoder>(new ScopeMultiImageEncoder(_dosave, ctrlparams.allareas[a]->daq.inputs->channels(), ctrlparams.storage.compresstiff()));
-			filenames[a].resize(ctrlparams.allareas[a]->daq.inputs->channels());
-			// Construct the filenames for all channels
-			for ( uint32_t c = 0 ; c < ctrlparams.allareas[a]->daq.inputs->channels() ; c++ ) {
-				std::wstringstream stream;
-				stream << _foldername << ctrlparams.storage.basename() << L"_A" << a << L"_Ch" << c << L"_ " << std::setfill(L'0') << std::setw(4) << runcounter << L".tif";
-				filenames[a][c] = stream.str();
+			// Line scans go into continuous raw line streams, the TIFF encoder then only counts the frames
+			const bool linescan = (ctrlparams.allareas[a]->scanmode().t == ScannerVectorTypeHelper::LineStraight);
+			// Multi plane scans get one file per plane and channel
+			const uint32_t planes = ctrlparams.allareas[a]->Currentframe().Planes();
+			linewriters[a].reset(linescan ? new ScopeLineStreamWriter(_dosave, ctrlparams.allareas[a]->daq.inputs->channels()) : nullptr);
+			encoders[a].clear();
+			filenames[a].resize(planes);
+			for ( uint32_t p = 0 ; p < planes ; p++ ) {
+				// Make a new multi image encoder for that area and plane
+				encoders[a].push_back(std::unique_ptr<ScopeMultiImageEncoder>(new ScopeMultiImageEncoder(_dosave && !linescan, ctrlparams.allareas[a]->daq.inputs->channels(), ctrlparams.storage.compresstiff())));
+				filenames[a][p].resize(ctrlparams.allareas[a]->daq.inputs->channels());
+				// Construct the filenames for all channels
+				for ( uint32_t c = 0 ; c < ctrlparams.allareas[a]->daq.inputs->channels() ; c++ ) {
+					std::wstringstream stream;
+					stream << _foldername << ctrlparams.storage.basename() << L"_A" << a;
+					if ( planes > 1 )
+						stream << L"_P" << p;
+					stream << L"_Ch" << c << L"_ " << std::setfill(L'0') << std::setw(4) << runcounter << (linescan ? L".raw" : L".tif");
+					filenames[a][p][c] = stream.str();
+				}
+				// Give the filenames to the encoder
+				encoders[a][p]->Initialize(filenames[a][p]);
 			}
-			// Give the filenames to the encoder
-			encoders[a]->Initialize(filenames[a]);
+			if ( linescan )
+				linewriters[a]->Initialize(filenames[a][0]);
 		}
 	}
 
@@ -205,6 +239,9 @@ namespace scope {
 
 		// Go through all areas (run exiftool.exe once per area)
 		for ( uint32_t a = 0 ; a < ctrlparams.allareas.size() ; a++ ) {
+			// Line streams are raw files without tags
+			if ( ctrlparams.allareas[a]->scanmode().t == ScannerVectorTypeHelper::LineStraight )
+				continue;
 			std::wstringstream cmd;
 			cmd << cmdbase.str();
 			// Add timeseries stuff
@@ -217,8 +254,9 @@ namespace scope {
 			cmd << L"-XResolution=" << 1/ctrlparams.allareas[a]->micronperpixelx() << L" -YResolution=" << 1/ctrlparams.allareas[a]->micronperpixely() << L" ";
 
 			// Add the filenames
-			for ( uint32_t c = 0 ; c < ctrlparams.allareas[a]->daq.inputs->channels() ; c++ )
-				cmd << L"\"" << filenames[a][c] << L"\" ";
+			for ( const auto& planefilenames : filenames[a] )
+				for ( const auto& f : planefilenames )
+					cmd << L"\"" << f << L"\" ";
 
 			// Run exiftool.exe
 			DBOUT(L"Cmd: " << cmd.str());
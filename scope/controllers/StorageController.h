@@ -10,6 +10,7 @@
 #include "helpers/ScopeMultiImageResonanceSW.h"
 #include "helpers/hresult_exception.h"
 #include "helpers/ScopeMultiImageEncoder.h"
+#include "helpers/ScopeLineStreamWriter.h"
 #include "helpers/ScopeException.h"
 #include "ScopeLogger.h"
 
@@ -29,11 +30,14 @@ namespace scope {
 		/** for continuous file numbering */
 		uint32_t runcounter;
 
-		/** Keep track of filenames */
-		std::vector<std::vector<std::wstring>> filenames;
+		/** Keep track of filenames, per area, plane, and channel */
+		std::vector<std::vector<std::vector<std::wstring>>> filenames;
 
-		/** the encoders (encapsulating the WIC stuff) */
-		std::vector<std::unique_ptr<ScopeMultiImageEncoder>> encoders;
+		/** the encoders (encapsulating the WIC stuff), per area and plane (multi plane scans store every plane in its own files) */
+		std::vector<std::vector<std::unique_ptr<ScopeMultiImageEncoder>>> encoders;
+
+		/** continuous line streams for areas in line scan mode (nullptr for the other areas, their frames go to TIFF) */
+		std::vector<std::unique_ptr<ScopeLineStreamWriter>> linewriters;
 
 		parameters::Scope& ctrlparams;
 	
@@ -50,7 +54,7 @@ namespace scope {
 		/** Create folder.Fformat is: "folder/date/time_runmode/" */
 		std::wstring StorageController::CreateFolder();
 	
-		/** Creates and initializes the encoders */
+		/** Creates and initializes the encoders, and the line streams for areas in line scan mode */
 		void InitializeEncoders(const bool& _dosave, const std::wstring& _foldername);
 	
 		/** Write correct Tiff flags into files (fix the ones that are by default written by the WIC.
@@ -26,12 +26,22 @@ namespace scope {
 			/** Stops task. */
 			virtual void Stop() = 0;
 
+			/** Commits the tasks to the hardware, so that they can be stopped and restarted quickly (see DaqController::Arm). */
+			virtual void Commit() { }
+
 			/** @return the total number of samples that should be read for that area. */
 			virtual uint32_t RequestedSamples() const;
 
 			/** @return the standard size of a read chunk (per channel) */
 			virtual uint32_t StandardChunkSize() const { return 128u*128u; }
 
+			/** @return the largest read chunk (samples per channel) the device buffer takes safely, the adaptive chunk size stays below */
+			virtual uint32_t MaximumChunkSize() const { return UINT32_MAX; }
+
+			/** @return samples per channel already acquired by the device but not yet read (FIFO or buffer occupancy after the last Read),
+			* or -1 if the device cannot tell */
+			virtual int64_t Backlog() const { return -1; }
+
 			/** Reads one chunk of samples for one area.
 			* @param[in,out] _chunk multichunk to fill with the read data
 			* @param[out] _timedout true if read timed out
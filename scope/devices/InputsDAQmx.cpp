@@ -8,7 +8,9 @@
 namespace scope {
 
 	InputsDAQmx::InputsDAQmx(const uint32_t& _area, const parameters::InputsDAQmx* const _inputparams, const parameters::Scope& _params)
-		: Inputs(_area) {
+		: Inputs(_area)
+		, backlog(0)
+		, buffersize(0) {
 
 		assert(_area == 0);
 
@@ -47,6 +49,17 @@ namespace scope {
 		if ( DaqTimingHelper::Mode::ReferenceClock == _inputparams->daq_timing() )
 			task.ConfigureReferenceClock(_inputparams->referenceclocksource, _inputparams->referenceclockrate());
 
+		// In continuous mode DAQmx sizes the host buffer by the samples per channel given above, i.e. one frame. For small frames the adaptive
+		// chunk size could grow beyond that, thus make the buffer hold at least four maximum chunks.
+		buffersize = requested_samples;
+		if ( (samplingtype == DAQmx_Val_ContSamps) && _inputparams->adaptivechunksize() ) {
+			const uint64_t wanted = 4ull * oversampling * ((_inputparams->maxchunksize() + oversampling - 1) / oversampling);
+			if ( wanted > buffersize ) {
+				buffersize = static_cast<uint32_t>(std::min<uint64_t>(wanted, UINT32_MAX));
+				task.ConfigureBuffer(buffersize);
+			}
+		}
+
 		task.ConfigureDigStartTrigger(commontrig, DAQmx_Val_Rising);
 
 		// Size of data chunks to readm should be between 64^2 and 128^2
@@ -66,10 +79,22 @@ namespace scope {
 		task.Stop();
 	}
 
+	void InputsDAQmx::Commit() {
+		task.Commit();
+	}
+
 	uint32_t InputsDAQmx::StandardChunkSize() const {
 		return standardchunksize;
 	}
 
+	uint32_t InputsDAQmx::MaximumChunkSize() const {
+		return buffersize / 4;
+	}
+
+	int64_t InputsDAQmx::Backlog() const {
+		return backlog;
+	}
+
 	int32_t InputsDAQmx::Read(DaqMultiChunk<2, 1, uint16_t>& _chunk, bool& _timedout, const double& _timeout) {
 		int32_t read = 0;
 		bool timedout = false;
@@ -77,6 +102,7 @@ namespace scope {
 			auto start = _chunk.GetDataStart(0);
 			auto end = start + 2 * _chunk.PerChannel();
 			read = task.ReadU16(start, end, _chunk.PerChannel(), 2, timedout, _timeout);
+			backlog = task.AvailableSamples();
 		}
 		catch (...) { ScopeExceptionHandler(__FUNCTION__); }
 		return read;
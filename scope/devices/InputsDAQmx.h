@@ -26,6 +26,12 @@ namespace scope {
 		/** the standard chunk size per channel for Read */
 		uint32_t standardchunksize;
 
+		/** samples per channel left in the input buffer after the last Read */
+		uint32_t backlog;
+
+		/** size of the host input buffer in samples per channel */
+		uint32_t buffersize;
+
 	public:
 		/** Creates a task for PMT signal acquisition with NI DAQmx.\n
 		* Configure sample timings for output tasks.
@@ -44,8 +50,16 @@ namespace scope {
 
 		void Stop() override;
 
+		void Commit() override;
+
 		uint32_t StandardChunkSize() const override;
 
+		/** @return a quarter of the host input buffer, so that reading can fall behind by a few chunks before the buffer overflows */
+		uint32_t MaximumChunkSize() const override;
+
+		/** @return the samples per channel left in the DAQmx input buffer after the last Read */
+		int64_t Backlog() const override;
+
 		int32_t Read(DaqMultiChunk<2, 1, uint16_t>& _chunk, bool& _timedout, const double& _timeout) override;
 	};
 
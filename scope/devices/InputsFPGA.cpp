@@ -13,6 +13,7 @@
 #include "parameters\Inputs.h"
 #include "parameters\Scope.h"
 #include "helpers\ScopeException.h"
+#include "helpers/DiagnosticLog.h"
 
 namespace scope {
 
@@ -71,6 +72,7 @@ namespace scope {
 
 	void InputsFPGA::Start(void) {
 		try {
+			theFPGA().ResetFIFORemaining();
 			theFPGA().StartAcquisition();
 		} catch (...) { ScopeExceptionHandler(__FUNCTION__); }
 	}
@@ -81,14 +83,18 @@ namespace scope {
 		} catch (...) { ScopeExceptionHandler(__FUNCTION__); }
 	}
 
+	int64_t InputsFPGA::Backlog() const {
+		uint32_t backlog = 0;
+		for ( uint32_t a = 0 ; a <= config::slavespermaster ; a++ )
+			backlog = std::max(backlog, theFPGA().FIFORemaining(masterarea + a));
+		return backlog;
+	}
+
 	int32_t InputsFPGA::Read(DaqMultiChunk<2, 1, uint16_t>& _chunk, bool& _timedout, const double& _timeout) {
 		int32_t read = 0;
 		try {
 			read = theFPGA().ReadPixels(masterarea, _chunk, _timeout, _timedout);
-			if (_timedout) {
-				DBOUT(L"InputsFPGA::Read area " << masterarea << L" timed out");
-			}
-			DBOUT(L"InputsFPGA::Read area " << masterarea << L" read " << read);
+			SCOPE_DIAG_DEBUG("InputsFPGA::Read area {} read {} timed out {} FIFO remaining {}", masterarea, read, _timedout, Backlog());
 			theFPGA().CheckFPGADiagnosis();
 		}
 		catch (...) { ScopeExceptionHandler(__FUNCTION__); }
@@ -99,10 +105,7 @@ namespace scope {
 		int32_t read = 0;
 		try {
 			read = theFPGA().ReadPixels(masterarea, _chunk, _timeout, _timedout);
-			if (_timedout) {
-				DBOUT(L"InputsFPGA::Read area " << masterarea << L" timed out");
-			}
-			DBOUT(L"InputsFPGA::Read area " << masterarea << L" read " << read);
+			SCOPE_DIAG_DEBUG("InputsFPGA::Read area {} read {} timed out {} FIFO remaining {}", masterarea, read, _timedout, Backlog());
 			theFPGA().CheckFPGADiagnosis();
 		}
 		catch (...) { ScopeExceptionHandler(__FUNCTION__); }
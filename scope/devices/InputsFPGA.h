@@ -46,6 +46,9 @@ namespace scope {
 
 		void Stop() override;
 
+		/** @return the elements remaining in the DMA FIFOs of the master area and its slaves after the last read (the largest, they are read together) */
+		int64_t Backlog() const override;
+
 		int32_t Read(DaqMultiChunk<2, 1, uint16_t>& _chunk, bool& _timedout, const double& _timeout) override;
 
 		int32_t Read(DaqMultiChunk<2, 2, uint16_t>& _chunk, bool& _timedout, const double& _timeout) override;
@@ -0,0 +1,189 @@
+#include "stdafx.h"
+#include "InputsRecorder.h"
+#include "helpers/ScopeException.h"
+
+namespace scope {
+
+	namespace {
+		/** Writes a value binary to a stream */
+		template<class T>
+		void WriteValue(std::ostream& _stream, const T& _value) {
+			_stream.write(reinterpret_cast<const char*>(&_value), sizeof(T));
+		}
+
+		/** Reads a value binary from a stream */
+		template<class T>
+		void ReadValue(std::istream& _stream, T& _value) {
+			_stream.read(reinterpret_cast<char*>(&_value), sizeof(T));
+		}
+	}
+
+	const char InputsRecordingHeader::magic[8] = { 'S', 'C', 'O', 'P', 'E', 'R', 'E', 'C' };
+
+	InputsRecordingHeader::InputsRecordingHeader()
+		: version(currentversion)
+		, channels(0)
+		, areas(0)
+		, hassync(0)
+		, standardchunksize(0)
+		, requestedsamples(0) {
+	}
+
+	void InputsRecordingHeader::Write(std::ostream& _stream) const {
+		_stream.write(magic, sizeof(magic));
+		WriteValue(_stream, version);
+		WriteValue(_stream, channels);
+		WriteValue(_stream, areas);
+		WriteValue(_stream, hassync);
+		WriteValue(_stream, standardchunksize);
+		WriteValue(_stream, requestedsamples);
+	}
+
+	void InputsRecordingHeader::Read(std::istream& _stream) {
+		char filemagic[sizeof(magic)];
+		_stream.read(filemagic, sizeof(filemagic));
+		if ( !_stream || !std::equal(std::begin(magic), std::end(magic), filemagic) )
+			throw ScopeException("Not a Scope input recording");
+		ReadValue(_stream, version);
+		if ( version != currentversion )
+			throw ScopeException("Unsupported version of Scope input recording");
+		ReadValue(_stream, channels);
+		ReadValue(_stream, areas);
+		ReadValue(_stream, hassync);
+		ReadValue(_stream, standardchunksize);
+		ReadValue(_stream, requestedsamples);
+		if ( !_stream )
+			throw ScopeException("Truncated Scope input recording");
+	}
+
+	InputsRecordingChunk::InputsRecordingChunk()
+		: time(0)
+		, perchannel(0)
+		, read(0) {
+	}
+
+	bool InputsRecordingChunk::Read(std::istream& _stream, const InputsRecordingHeader& _header) {
+		ReadValue(_stream, time);
+		ReadValue(_stream, perchannel);
+		ReadValue(_stream, read);
+		if ( !_stream )
+			return false;
+		data.resize(_header.areas * _header.channels * perchannel);
+		_stream.read(reinterpret_cast<char*>(data.data()), data.size() * sizeof(uint16_t));
+		if ( _header.hassync != 0 ) {
+			std::vector<uint8_t> filesync(perchannel);
+			_stream.read(reinterpret_cast<char*>(filesync.data()), filesync.size());
+			sync.assign(std::begin(filesync), std::end(filesync));
+		}
+		else
+			sync.clear();
+		return !_stream.fail();
+	}
+
+	std::wstring InputsRecorder::NumberedFilename(const std::wstring& _filename, const uint32_t& _number) {
+		// Only a dot after the last path separator starts an extension
+		const size_t separator = _filename.find_last_of(L"\\/");
+		size_t dot = _filename.find_last_of(L'.');
+		if ( (dot == std::wstring::npos) || ((separator != std::wstring::npos) && (dot < separator)) )
+			dot = _filename.size();
+		std::wostringstream stream;
+		stream << _filename.substr(0, dot) << L"_" << std::setfill(L'0') << std::setw(4) << _number << _filename.substr(dot);
+		return stream.str();
+	}
+
+	InputsRecorder::InputsRecorder(const uint32_t& _area, std::unique_ptr<Inputs> _inputs, const std::wstring& _filename, const uint32_t& _number)
+		: Inputs(_area)
+		, inputs(std::move(_inputs))
+		, file(NumberedFilename(_filename, _number), std::ios::binary | std::ios::trunc)
+		, headerwritten(false) {
+		if ( !file.is_open() )
+			throw ScopeException("InputsRecorder could not open the recording file");
+	}
+
+	InputsRecorder::~InputsRecorder() {
+		file.close();
+	}
+
+	void InputsRecorder::Start() {
+		starttime = std::chrono::high_resolution_clock::now();
+		inputs->Start();
+	}
+
+	void InputsRecorder::Stop() {
+		inputs->Stop();
+		file.flush();
+	}
+
+	void InputsRecorder::Commit() {
+		inputs->Commit();
+	}
+
+	uint32_t InputsRecorder::RequestedSamples() const {
+		return inputs->RequestedSamples();
+	}
+
+	uint32_t InputsRecorder::StandardChunkSize() const {
+		return inputs->StandardChunkSize();
+	}
+
+	uint32_t InputsRecorder::MaximumChunkSize() const {
+		return inputs->MaximumChunkSize();
+	}
+
+	int64_t InputsRecorder::Backlog() const {
+		return inputs->Backlog();
+	}
+
+	template<uint32_t NAREAS>
+	void InputsRecorder::Record(DaqMultiChunk<2, NAREAS, uint16_t>& _chunk, const int32_t& _read) {
+		// Timed out reads without data are not recorded, the replay waits according to the timestamps anyway.
+		// After a write error the file is closed and recording ends.
+		if ( (_read <= 0) || !file.is_open() )
+			return;
+
+		auto reschunk = dynamic_cast<DaqMultiChunkResonance<2, NAREAS, uint16_t>*>(&_chunk);
+		if ( !headerwritten ) {
+			InputsRecordingHeader header;
+			header.channels = 2;
+			header.areas = NAREAS;
+			header.hassync = (reschunk != nullptr) ? 1 : 0;
+			header.standardchunksize = inputs->StandardChunkSize();
+			header.requestedsamples = inputs->RequestedSamples();
+			header.Write(file);
+			headerwritten = true;
+		}
+
+		const uint64_t time = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::high_resolution_clock::now() - starttime).count();
+		WriteValue(file, time);
+		WriteValue(file, _chunk.PerChannel());
+		WriteValue(file, _read);
+		file.write(reinterpret_cast<const char*>(_chunk.data.data()), _chunk.data.size() * sizeof(uint16_t));
+		if ( reschunk != nullptr ) {
+			std::vector<uint8_t> sync(std::begin(reschunk->resSync), std::end(reschunk->resSync));
+			file.write(reinterpret_cast<const char*>(sync.data()), sync.size());
+		}
+		if ( !file ) {
+			file.close();
+			throw ScopeException("InputsRecorder could not write to the recording file, recording stopped");
+		}
+	}
+
+	int32_t InputsRecorder::Read(DaqMultiChunk<2, 1, uint16_t>& _chunk, bool& _timedout, const double& _timeout) {
+		const int32_t read = inputs->Read(_chunk, _timedout, _timeout);
+		try {
+			Record<1>(_chunk, read);
+		}
+		catch (...) { ScopeExceptionHandler(__FUNCTION__); }
+		return read;
+	}
+
+	int32_t InputsRecorder::Read(DaqMultiChunk<2, 2, uint16_t>& _chunk, bool& _timedout, const double& _timeout) {
+		const int32_t read = inputs->Read(_chunk, _timedout, _timeout);
+		try {
+			Record<2>(_chunk, read);
+		}
+		catch (...) { ScopeExceptionHandler(__FUNCTION__); }
+		return read;
+	}
+
+}
@@ -0,0 +1,127 @@
+#pragma once
+
+#include "Inputs.h"
+
+namespace scope {
+
+	/** File header of a raw input recording. All values are written in little endian binary without padding.\n
+	* After the header follow the chunk records: uint64_t time in microseconds since Start, uint32_t samples per channel,
+	* int32_t samples per channel actually read, the chunk data as uint16_t (area by area, channel by channel, see DaqMultiChunk),
+	* and if hassync one uint8_t per sample with the resonance sync signal. */
+	struct InputsRecordingHeader {
+		/** identifies the file type */
+		static const char magic[8];
+
+		/** current version of the file format */
+		static const uint32_t currentversion = 1;
+
+		/** version of the file format */
+		uint32_t version;
+
+		/** number of channels per area in each chunk */
+		uint32_t channels;
+
+		/** number of areas in each chunk */
+		uint32_t areas;
+
+		/** 1 if the chunks carry the resonance sync signal (DaqMultiChunkResonance) */
+		uint32_t hassync;
+
+		/** the standard chunk size of the recorded input (samples per channel) */
+		uint32_t standardchunksize;
+
+		/** the requested samples of the recorded input (samples per channel) */
+		uint32_t requestedsamples;
+
+		InputsRecordingHeader();
+
+		/** Writes the header to a binary stream */
+		void Write(std::ostream& _stream) const;
+
+		/** Reads the header from a binary stream, throws a ScopeException if it is not a valid recording */
+		void Read(std::istream& _stream);
+	};
+
+	/** One chunk record of a raw input recording, as read back by InputsReplay */
+	struct InputsRecordingChunk {
+		/** time in microseconds since Start when the chunk was read */
+		uint64_t time;
+
+		/** samples per channel in the chunk */
+		uint32_t perchannel;
+
+		/** samples per channel actually read into the chunk */
+		int32_t read;
+
+		/** the chunk data (area by area, channel by channel) */
+		std::vector<uint16_t> data;
+
+		/** the resonance sync signal (empty if the recording has none) */
+		std::vector<bool> sync;
+
+		InputsRecordingChunk();
+
+		/** Reads the next chunk record from a binary stream
+		* @param[in] _stream the stream positioned at a chunk record
+		* @param[in] _header the header of the recording
+		* @return false if the end of the recording was reached (or the last record is truncated) */
+		bool Read(std::istream& _stream, const InputsRecordingHeader& _header);
+	};
+
+	/** Decorator around another Inputs that writes every chunk read (with its timing) to a file, to be played back later by InputsReplay.
+	* Each cold Start of the DaqController creates new inputs and thus a new recording, the DaqController numbers them (e.g. for every plane
+	* of a plane by plane stack) so that they do not overwrite each other. While the DaqController is armed (timeseries repeats, behavior trials)
+	* the inputs are reused and the recording continues, timestamps are relative to the latest Start. */
+	class InputsRecorder
+		: public Inputs {
+
+	protected:
+		/** the decorated inputs, they do the actual reading */
+		const std::unique_ptr<Inputs> inputs;
+
+		/** the recording file */
+		std::ofstream file;
+
+		/** true after the header was written (on the first Read, when the chunk type is known) */
+		bool headerwritten;
+
+		/** time of Start, timestamps are relative to this */
+		std::chrono::high_resolution_clock::time_point starttime;
+
+	protected:
+		/** Writes one chunk into the file (and the header before the first chunk) */
+		template<uint32_t NAREAS>
+		void Record(DaqMultiChunk<2, NAREAS, uint16_t>& _chunk, const int32_t& _read);
+
+	public:
+		/** @param[in] _area the master area
+		* @param[in] _inputs the inputs to decorate, the recorder takes ownership
+		* @param[in] _filename the file to record to, _number is appended (see NumberedFilename), an existing file is overwritten
+		* @param[in] _number number of the recording */
+		InputsRecorder(const uint32_t& _area, std::unique_ptr<Inputs> _inputs, const std::wstring& _filename, const uint32_t& _number);
+
+		/** @return _filename with the four digit _number appended before the extension, e.g. C:\rec.dat and 3 give C:\rec_0003.dat */
+		static std::wstring NumberedFilename(const std::wstring& _filename, const uint32_t& _number);
+
+		~InputsRecorder();
+
+		void Start() override;
+
+		void Stop() override;
+
+		void Commit() override;
+
+		uint32_t RequestedSamples() const override;
+
+		uint32_t StandardChunkSize() const override;
+
+		uint32_t MaximumChunkSize() const override;
+
+		int64_t Backlog() const override;
+
+		int32_t Read(DaqMultiChunk<2, 1, uint16_t>& _chunk, bool& _timedout, const double& _timeout) override;
+
+		int32_t Read(DaqMultiChunk<2, 2, uint16_t>& _chunk, bool& _timedout, const double& _timeout) override;
+	};
+
+}
@@ -0,0 +1,177 @@
+#include "stdafx.h"
+#include "InputsReplay.h"
+#include "config\config_choices.h"
+#include "parameters/Scope.h"
+#include "controllers/ScopeLogger.h"
+#include "helpers/ScopeException.h"
+
+namespace scope {
+
+	InputsReplay::InputsReplay(const uint32_t& _area, const std::wstring& _filename, const bool& _realtime, const bool& _loop, const parameters::Scope& _params)
+		: Inputs(_area)
+		, realtime(_realtime)
+		, loop(_loop)
+		, loopduration(0)
+		, record(0)
+		, offset(0)
+		, passes(0)
+		, running(false) {
+
+		std::ifstream file(_filename, std::ios::binary);
+		if ( !file.is_open() )
+			throw ScopeException("InputsReplay could not open the recording file");
+		header.Read(file);
+		// A recording holds the chunks of a master area together with its slaves, thus it can only be replayed with the same number of slaves per master
+		if ( header.areas != config::slavespermaster + 1 ) {
+			std::ostringstream msg;
+			msg << "InputsReplay: the recording has " << header.areas << " areas per chunk, but this Scope is configured for "
+				<< config::slavespermaster + 1 << " (one master and " << config::slavespermaster << " slaves, see config::slavespermaster)";
+			throw ScopeException(msg.str().c_str());
+		}
+		if ( header.channels != 2 ) {
+			std::ostringstream msg;
+			msg << "InputsReplay: the recording has " << header.channels << " channels per area, only 2 are supported";
+			throw ScopeException(msg.str().c_str());
+		}
+		InputsRecordingChunk chunk;
+		while ( chunk.Read(file, header) ) {
+			if ( chunk.perchannel > 0 )
+				records.push_back(std::move(chunk));
+		}
+		if ( records.empty() )
+			throw ScopeException("InputsReplay: the recording contains no data");
+
+		// One pass lasts until the last chunk plus a mean chunk interval, so looping keeps the pace
+		loopduration = records.back().time + records.back().time / records.size();
+
+		// Calculate the number of samples to acquire the same way the hardware inputs do
+		const parameters::BaseArea& area = *_params.allareas[_area];
+		uint32_t oversampling = 1;
+		if ( area.daq.inputs->oversampling() )
+			oversampling = std::max(1u, round2ui32(area.daq.pixeltime() / area.daq.inputs->MinimumPixeltime()));
+		const uint32_t framesamples = oversampling * area.Currentframe().TotalPixels();
+		requested_samples = framesamples;
+		if ( _params.requested_mode() == DaqModeHelper::nframes )
+			requested_samples *= area.daq.requested_frames() * area.daq.averages();
+
+		// The pixel mapping only makes sense with the parameters the recording was made with
+		if ( (framesamples == 0) || (header.requestedsamples % framesamples != 0) ) {
+			std::wstringstream msg;
+			msg << L"Input recording " << _filename << L" does not match the current frame parameters of area " << _area;
+			ScopeLogger::GetInstance().Log(msg.str(), log_warning);
+		}
+	}
+
+	InputsReplay::~InputsReplay() {
+		Stop();
+	}
+
+	void InputsReplay::Start() {
+		record = 0;
+		offset = 0;
+		passes = 0;
+		starttime = std::chrono::high_resolution_clock::now();
+		running = true;
+	}
+
+	void InputsReplay::Stop() {
+		running = false;
+	}
+
+	uint32_t InputsReplay::StandardChunkSize() const {
+		return header.standardchunksize;
+	}
+
+	template<uint32_t NAREAS>
+	int32_t InputsReplay::Fill(DaqMultiChunk<2, NAREAS, uint16_t>& _chunk, bool& _timedout, const double& _timeout) {
+		_timedout = false;
+		const uint32_t n = _chunk.PerChannel();
+		const auto timeout = std::chrono::duration_cast<std::chrono::high_resolution_clock::duration>(std::chrono::duration<double>(_timeout));
+
+		// Like a real device we time out if not running or if the recording is over
+		if ( !running || (record == records.size()) ) {
+			std::this_thread::sleep_for(timeout);
+			_timedout = true;
+			return 0;
+		}
+
+		// The data of the chunk is available at the time the record with its last sample was recorded
+		if ( realtime ) {
+			size_t r = record;
+			uint32_t o = offset;
+			uint64_t p = passes;
+			uint32_t needed = n;
+			while ( needed > records[r].perchannel - o ) {
+				needed -= records[r].perchannel - o;
+				o = 0;
+				if ( ++r == records.size() ) {
+					if ( !loop ) {
+						r = records.size() - 1;
+						break;
+					}
+					r = 0;
+					++p;
+				}
+			}
+			const auto due = starttime + std::chrono::microseconds(records[r].time + p * loopduration);
+			if ( due - std::chrono::high_resolution_clock::now() > timeout ) {
+				std::this_thread::sleep_for(timeout);
+				_timedout = true;
+				return 0;
+			}
+			std::this_thread::sleep_until(due);
+		}
+
+		// Copy area by area and channel by channel, chunk boundaries do not have to match the recorded ones
+		auto reschunk = dynamic_cast<DaqMultiChunkResonance<2, NAREAS, uint16_t>*>(&_chunk);
+		uint32_t filled = 0;
+		while ( (filled < n) && (record < records.size()) ) {
+			const InputsRecordingChunk& rec = records[record];
+			const uint32_t count = std::min(n - filled, rec.perchannel - offset);
+			for ( uint32_t ac = 0 ; ac < NAREAS * 2 ; ac++ ) {
+				auto source = std::begin(rec.data) + ac * rec.perchannel + offset;
+				std::copy(source, source + count, std::begin(_chunk.data) + ac * n + filled);
+			}
+			if ( (reschunk != nullptr) && !rec.sync.empty() ) {
+				auto source = std::begin(rec.sync) + offset;
+				std::copy(source, source + count, std::begin(reschunk->resSync) + filled);
+			}
+			filled += count;
+			offset += count;
+			if ( offset == rec.perchannel ) {
+				offset = 0;
+				if ( (++record == records.size()) && loop ) {
+					record = 0;
+					++passes;
+				}
+			}
+		}
+
+		// Only at the end of a recording without looping the chunk is not filled completely
+		if ( filled < n ) {
+			for ( uint32_t ac = 0 ; ac < NAREAS * 2 ; ac++ )
+				std::fill(std::begin(_chunk.data) + ac * n + filled, std::begin(_chunk.data) + (ac + 1) * n, 0);
+			DBOUT(L"InputsReplay::Fill end of recording");
+		}
+		return static_cast<int32_t>(filled);
+	}
+
+	int32_t InputsReplay::Read(DaqMultiChunk<2, 1, uint16_t>& _chunk, bool& _timedout, const double& _timeout) {
+		int32_t read = 0;
+		try {
+			read = Fill<1>(_chunk, _timedout, _timeout);
+		}
+		catch (...) { ScopeExceptionHandler(__FUNCTION__); }
+		return read;
+	}
+
+	int32_t InputsReplay::Read(DaqMultiChunk<2, 2, uint16_t>& _chunk, bool& _timedout, const double& _timeout) {
+		int32_t read = 0;
+		try {
+			read = Fill<2>(_chunk, _timedout, _timeout);
+		}
+		catch (...) { ScopeExceptionHandler(__FUNCTION__); }
+		return read;
+	}
+
+}
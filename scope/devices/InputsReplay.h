@@ -0,0 +1,80 @@
+#pragma once
+
+#include "Inputs.h"
+#include "InputsRecorder.h"
+
+// Forward declarations
+namespace scope {
+	namespace parameters {
+		class Scope;
+	}
+}
+
+namespace scope {
+
+	/** Plays back a raw input recording made by InputsRecorder, so that pixel mapping, storage and display can be run on identical data
+	* (for benchmarks and golden image tests). The whole recording is loaded into memory on construction, thus reading from disk
+	* does not disturb the timing. Data is delivered either as fast as possible or at the recorded pace, chunk sizes do not have
+	* to match the recorded ones. The recording has to be made with the same frame and pixel time parameters it is replayed with. */
+	class InputsReplay
+		: public Inputs {
+
+	protected:
+		/** the header of the recording */
+		InputsRecordingHeader header;
+
+		/** all chunk records of the recording */
+		std::vector<InputsRecordingChunk> records;
+
+		/** if true data is delivered at the recorded pace, otherwise as fast as possible */
+		const bool realtime;
+
+		/** if true replay starts over at the end of the recording, otherwise the input times out from then on */
+		const bool loop;
+
+		/** duration of one pass through the recording in microseconds (for pacing when looping) */
+		uint64_t loopduration;
+
+		/** record of the next sample to deliver */
+		size_t record;
+
+		/** position of the next sample to deliver inside record */
+		uint32_t offset;
+
+		/** number of completed passes through the recording */
+		uint64_t passes;
+
+		/** time of Start, for pacing */
+		std::chrono::high_resolution_clock::time_point starttime;
+
+		/** true between Start and Stop */
+		std::atomic<bool> running;
+
+	protected:
+		/** Copies samples from the records into the chunk, waits for the pacing if necessary */
+		template<uint32_t NAREAS>
+		int32_t Fill(DaqMultiChunk<2, NAREAS, uint16_t>& _chunk, bool& _timedout, const double& _timeout);
+
+	public:
+		/** Loads the recording and checks it against the parameters
+		* @param[in] _area the master area
+		* @param[in] _filename the recording to play back
+		* @param[in] _realtime deliver at the recorded pace
+		* @param[in] _loop start over at the end of the recording
+		* @param[in] _params the complete parameter set */
+		InputsReplay(const uint32_t& _area, const std::wstring& _filename, const bool& _realtime, const bool& _loop, const parameters::Scope& _params);
+
+		~InputsReplay();
+
+		void Start() override;
+
+		void Stop() override;
+
+		uint32_t StandardChunkSize() const override;
+
+		int32_t Read(DaqMultiChunk<2, 1, uint16_t>& _chunk, bool& _timedout, const double& _timeout) override;
+
+		int32_t Read(DaqMultiChunk<2, 2, uint16_t>& _chunk, bool& _timedout, const double& _timeout) override;
+	};
+
+}
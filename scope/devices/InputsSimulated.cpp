@@ -0,0 +1,272 @@
+#include "stdafx.h"
+#include "InputsSimulated.h"
+#include "parameters/Inputs.h"
+#include "parameters/Scope.h"
+#include "scanmodes/ScannerVectorFrameBasic.h"
+#include "helpers/ScopeException.h"
+
+namespace scope {
+
+	namespace {
+		/** resolution of the rendered specimen (pixels per side) */
+		const uint32_t specimenres = 512;
+
+		/** Renders a specimen of Gaussian beads with random positions and brightness
+		* @param[in] _beads number of beads
+		* @param[in] _sigma width of the beads in specimen pixels
+		* @param[in] _generator the random number generator to use
+		* @return specimenres x specimenres brightness values in [0, 1] */
+		std::vector<float> RenderBeads(const uint32_t& _beads, const double& _sigma, std::mt19937& _generator) {
+			std::vector<float> specimen(specimenres*specimenres, 0.0f);
+			std::uniform_real_distribution<double> posdist(0, specimenres);
+			std::uniform_real_distribution<double> brightdist(0.3, 1.0);
+			const int32_t halfwidth = static_cast<int32_t>(std::ceil(3*_sigma));
+			for ( uint32_t b = 0 ; b < _beads ; b++ ) {
+				const double bx = posdist(_generator);
+				const double by = posdist(_generator);
+				const double brightness = brightdist(_generator);
+				for ( int32_t y = std::max(0, static_cast<int32_t>(by)-halfwidth) ; y < std::min<int32_t>(specimenres, static_cast<int32_t>(by)+halfwidth+1) ; y++ ) {
+					for ( int32_t x = std::max(0, static_cast<int32_t>(bx)-halfwidth) ; x < std::min<int32_t>(specimenres, static_cast<int32_t>(bx)+halfwidth+1) ; x++ ) {
+						const double r2 = (x-bx)*(x-bx) + (y-by)*(y-by);
+						float& pix = specimen[y*specimenres + x];
+						pix = std::min(1.0f, pix + static_cast<float>(brightness * std::exp(-r2/(2*_sigma*_sigma))));
+					}
+				}
+			}
+			return specimen;
+		}
+
+		/** @return specimen value at normalized position _x,_y in [-1, 1] (nearest neighbour) */
+		float SpecimenAt(const std::vector<float>& _specimen, const double& _x, const double& _y) {
+			const uint32_t sx = std::min(specimenres-1, static_cast<uint32_t>(std::max(0.0, (_x+1)*0.5*specimenres)));
+			const uint32_t sy = std::min(specimenres-1, static_cast<uint32_t>(std::max(0.0, (_y+1)*0.5*specimenres)));
+			return _specimen[sy*specimenres + sx];
+		}
+	}
+
+	InputsSimulated::InputsSimulated(const uint32_t& _area, const parameters::InputsSimulated* const _inputparams, const parameters::Scope& _params)
+		: Inputs(_area)
+		, simparameters(new parameters::InputsSimulated(*_inputparams))
+		, nchannels(std::max(1u, std::min(2u, _inputparams->channels())))
+		, acquired(0)
+		, delivered(0)
+		, chunks(0)
+		, dropped(0)
+		, running(false)
+		, generator(_inputparams->seed()) {
+
+		// Calculate pixelrate/samplerate if oversampling and number of pixels/samples to acquire (same as for InputsDAQmx)
+		const double pixelrate = 1/(_params.allareas[_area]->daq.pixeltime()*1E-6);
+		inputrate = pixelrate;
+		if ( simparameters->oversampling() )
+			inputrate = 1/(simparameters->MinimumPixeltime()*1E-6);
+		oversampling = std::max(1u, round2ui32(inputrate/pixelrate));
+		inputrate = pixelrate * oversampling;
+
+		uint32_t pixelsperchan = _params.allareas[_area]->Currentframe().TotalPixels();
+		if ( _params.requested_mode() == DaqModeHelper::nframes )
+			pixelsperchan *= _params.allareas[_area]->daq.requested_frames() * _params.allareas[_area]->daq.averages();
+		requested_samples = oversampling * pixelsperchan;
+
+		standardchunksize = oversampling * std::max(64u*64u, std::min(_params.allareas[_area]->Currentframe().TotalPixels() >> 2, 128u*128u));
+		if ( simparameters->chunksize() > 0 )
+			standardchunksize = simparameters->chunksize();
+		buffersamples = static_cast<uint64_t>(simparameters->buffertime() * inputrate);
+
+		// The slaves of a master follow it in allareas (see DaqController::Setup)
+		const uint32_t nareas = std::min<uint32_t>(config::slavespermaster + 1, static_cast<uint32_t>(_params.allareas.size()) - _area);
+		expected.resize(nareas);
+		positions.assign(nareas, 0);
+		for ( uint32_t a = 0 ; a < nareas ; a++ )
+			RenderFrame(_area + a, _params, expected[a]);
+	}
+
+	InputsSimulated::~InputsSimulated() {
+		Stop();
+	}
+
+	void InputsSimulated::RenderFrame(const uint32_t& _area, const parameters::Scope& _params, std::vector<std::vector<float>>& _expected) {
+		// Use our own copy of the area parameters since the scanner vector needs non-const pointers
+		parameters::BaseArea area(*_params.allareas[_area]);
+		auto scanvec = ScannerVectorFrameBasic::Factory(area.scanmode(), ScannerVectorFillTypeHelper::FullframeXYZP);
+		scanvec->SetParameters(&area.daq, &area.Currentframe(), &area.fpuzstage);
+		const std::vector<int16_t>& vec = *scanvec->GetInterleavedVector();
+
+		const size_t framepixels = area.Currentframe().TotalPixels();
+		const size_t entries = vec.size() / 4;
+		if ( (framepixels == 0) || (entries == 0) )
+			throw ScopeException("InputsSimulated: empty scanner vector");
+		// Galvo scanners have one vector entry per pixel. For a resonance scanner one entry spans a forward and a backward line.
+		const bool resonant = (config::scannerselect == config::ScannerEnum::ResonantGalvo);
+		const size_t pixelsperentry = std::max<size_t>(1, framepixels / entries);
+		const size_t framesamples = framepixels * oversampling;
+		const size_t lag = round2ui32(simparameters->scannerlag() * 1E-6 * inputrate);
+
+		// Channel 1 sees all beads, channel 2 only half of them plus some diffuse background
+		std::mt19937 specimengenerator(simparameters->seed() + _area);
+		const std::vector<float> beads1 = RenderBeads(simparameters->beads(), 3, specimengenerator);
+		const std::vector<float> beads2 = RenderBeads(simparameters->beads()/2, 6, specimengenerator);
+
+		// Pockels is scaled relative to its maximum in the vector (this keeps the retrace blanked). Without Pockels signal the laser is always on.
+		int16_t maxpockels = 0;
+		for ( size_t e = 0 ; e < entries ; e++ )
+			maxpockels = std::max(maxpockels, vec[4*e + 3]);
+
+		const double photonspersample = simparameters->photonrate() * 1E6 / inputrate;
+		const double backgroundpersample = simparameters->backgroundrate() * 1E6 / inputrate;
+
+		const bool ismaster = (_area == masterarea);
+		_expected.assign(nchannels, std::vector<float>(framesamples, 0.0f));
+		if ( ismaster )
+			sync.assign(framesamples, false);
+
+		double lastx = 0;
+		for ( size_t s = 0 ; s < framesamples ; s++ ) {
+			// The scanners lag behind their command signal
+			const size_t commanded = (s + framesamples - (lag % framesamples)) % framesamples;
+			const size_t pixel = commanded / oversampling;
+			const size_t entry = std::min(entries - 1, pixel / pixelsperentry);
+			double x = static_cast<double>(vec[4*entry]) / INT16_MAX;
+			const double y = static_cast<double>(vec[4*entry + 1]) / INT16_MAX;
+			bool forward = (x >= lastx);
+			if ( resonant ) {
+				// Sinusoidal x movement, forward during the first half of the entry
+				const double phase = static_cast<double>(commanded % (pixelsperentry * oversampling)) / (pixelsperentry * oversampling);
+				x = -std::cos(2 * M_PI * phase);
+				forward = phase < 0.5;
+			}
+			lastx = x;
+			const double pockels = (maxpockels > 0) ? static_cast<double>(std::max<int16_t>(0, vec[4*entry + 3])) / maxpockels : 1.0;
+			const double bright1 = SpecimenAt(beads1, x, y);
+			const double bright2 = 0.1 * (1 + std::sin(3 * M_PI * x) * std::sin(2 * M_PI * y)) + SpecimenAt(beads2, x, y);
+			_expected[0][s] = static_cast<float>(backgroundpersample + pockels * photonspersample * bright1);
+			if ( nchannels > 1 )
+				_expected[1][s] = static_cast<float>(backgroundpersample + pockels * photonspersample * std::min(1.0, bright2));
+			if ( ismaster )
+				sync[s] = forward;
+		}
+	}
+
+	void InputsSimulated::Start() {
+		acquired = 0;
+		delivered = 0;
+		chunks = 0;
+		dropped = 0;
+		starttime = std::chrono::high_resolution_clock::now();
+		running = true;
+	}
+
+	void InputsSimulated::Stop() {
+		running = false;
+	}
+
+	uint32_t InputsSimulated::StandardChunkSize() const {
+		return standardchunksize;
+	}
+
+	int64_t InputsSimulated::Backlog() const {
+		if ( !simparameters->realtime() || !running )
+			return -1;
+		const double elapsed = std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - starttime).count();
+		const int64_t available = static_cast<int64_t>(elapsed * inputrate);
+		return std::max<int64_t>(0, std::min<int64_t>(available - static_cast<int64_t>(acquired), buffersamples));
+	}
+
+	template<uint32_t NAREAS>
+	int32_t InputsSimulated::Fill(DaqMultiChunk<2, NAREAS, uint16_t>& _chunk, bool& _timedout, const double& _timeout) {
+		_timedout = false;
+		const uint32_t n = _chunk.PerChannel();
+		const auto timeout = std::chrono::duration_cast<std::chrono::high_resolution_clock::duration>(std::chrono::duration<double>(_timeout));
+
+		// Like a real device we wait until the samples are "acquired"
+		if ( !running ) {
+			std::this_thread::sleep_for(timeout);
+			_timedout = true;
+			return 0;
+		}
+		if ( simparameters->realtime() ) {
+			// If we fell behind by more than the device buffer, the oldest samples are lost (like a buffer overrun on a real device)
+			const double elapsed = std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - starttime).count();
+			const uint64_t available = static_cast<uint64_t>(elapsed * inputrate);
+			if ( available > acquired + buffersamples + n ) {
+				const uint64_t lost = available - acquired - buffersamples - n;
+				acquired += lost;
+				dropped += lost;
+				for ( uint32_t a = 0 ; a < positions.size() ; a++ )
+					positions[a] = (positions[a] + lost) % expected[a][0].size();
+				DBOUT(L"InputsSimulated::Fill buffer overrun, dropped " << lost << L" samples");
+			}
+			const auto due = starttime + std::chrono::duration_cast<std::chrono::high_resolution_clock::duration>(std::chrono::duration<double>((acquired + n) / inputrate));
+			if ( due - std::chrono::high_resolution_clock::now() > timeout ) {
+				std::this_thread::sleep_for(timeout);
+				_timedout = true;
+				return 0;
+			}
+			std::this_thread::sleep_until(due);
+		}
+
+		const double gain = simparameters->countsperphoton();
+		std::poisson_distribution<uint32_t> poisson;
+		for ( uint32_t a = 0 ; a < NAREAS ; a++ ) {
+			auto it = _chunk.GetDataStart(a);
+			// Areas this input was not set up for and channels without simulated signal read zero
+			if ( a >= expected.size() ) {
+				std::fill(it, it + 2 * n, 0);
+				continue;
+			}
+			const size_t framesamples = expected[a][0].size();
+			for ( uint32_t c = 0 ; c < 2 ; c++ ) {
+				if ( c >= nchannels ) {
+					std::fill(it, it + n, 0);
+					it += n;
+					continue;
+				}
+				size_t pos = positions[a];
+				for ( uint32_t i = 0 ; i < n ; i++, ++it ) {
+					const float mean = expected[a][c][pos];
+					const uint32_t photons = (mean > 0) ? poisson(generator, std::poisson_distribution<uint32_t>::param_type(mean)) : 0;
+					*it = static_cast<uint16_t>(std::min(65535.0, photons * gain));
+					if ( ++pos == framesamples )
+						pos = 0;
+				}
+			}
+		}
+
+		// Generate the resonance sync signal if the chunk has one
+		auto reschunk = dynamic_cast<DaqMultiChunkResonance<2, NAREAS, uint16_t>*>(&_chunk);
+		if ( reschunk != nullptr ) {
+			size_t pos = positions[0];
+			for ( auto itsync = std::begin(reschunk->resSync) ; itsync != std::end(reschunk->resSync) ; ++itsync ) {
+				*itsync = sync[pos];
+				if ( ++pos == sync.size() )
+					pos = 0;
+			}
+		}
+
+		for ( uint32_t a = 0 ; a < positions.size() ; a++ )
+			positions[a] = (positions[a] + n) % expected[a][0].size();
+		acquired += n;
+		delivered += n;
+		++chunks;
+		return static_cast<int32_t>(n);
+	}
+
+	int32_t InputsSimulated::Read(DaqMultiChunk<2, 1, uint16_t>& _chunk, bool& _timedout, const double& _timeout) {
+		int32_t read = 0;
+		try {
+			read = Fill<1>(_chunk, _timedout, _timeout);
+		}
+		catch (...) { ScopeExceptionHandler(__FUNCTION__); }
+		return read;
+	}
+
+	int32_t InputsSimulated::Read(DaqMultiChunk<2, 2, uint16_t>& _chunk, bool& _timedout, const double& _timeout) {
+		int32_t read = 0;
+		try {
+			read = Fill<2>(_chunk, _timedout, _timeout);
+		}
+		catch (...) { ScopeExceptionHandler(__FUNCTION__); }
+		return read;
+	}
+
+}
@@ -0,0 +1,118 @@
+#pragma once
+
+#include "Inputs.h"
+#include "config\config_choices.h"
+#include "helpers/ScopeDatatypes.h"
+
+// Forward declarations
+namespace scope {
+	namespace parameters {
+		class InputsSimulated;
+		class Scope;
+	}
+}
+
+namespace scope {
+
+	/** Hardware-free signal input. Renders a synthetic specimen (fluorescent beads) through the actual scanner vector geometry of the area
+	* (including cutoff/retrace, a scanner lag to be compensated by the scannerdelay, oversampling) and adds Poisson photon noise.
+	* The master and every slave area are rendered through their own scanner vector, only the configured number of channels gets a signal.
+	* For a resonance scanner the x position is a sinusoid and the resonance sync bit is generated (if the chunk type has one).
+	* Data is delivered paced at the configured pixel rate or as fast as possible. Needs no hardware at all, thus the complete
+	* DaqController->PipelineController->StorageController chain can be run headless. */
+	class InputsSimulated
+		: public Inputs {
+
+	protected:
+		/** a copy of the simulation parameters */
+		const std::unique_ptr<parameters::InputsSimulated> simparameters;
+
+		/** number of input samples per pixel */
+		uint32_t oversampling;
+
+		/** input sampling rate in Hz */
+		double inputrate;
+
+		/** the standard chunk size per channel for Read */
+		uint32_t standardchunksize;
+
+		/** number of channels with a simulated signal (inputs->channels(), at most 2), the other channels of a chunk stay zero */
+		uint32_t nchannels;
+
+		/** for every area (master first, then its slaves) and every simulated channel: expected number of photons for every input sample of one frame */
+		std::vector<std::vector<std::vector<float>>> expected;
+
+		/** resonance sync bit (true while the master area's scanner moves forward) for every input sample of one frame */
+		std::vector<bool> sync;
+
+		/** for every area the position in its frame of the next sample to deliver */
+		std::vector<size_t> positions;
+
+		/** number of samples per channel "acquired" by the simulated device since Start (delivered plus dropped), for pacing */
+		uint64_t acquired;
+
+		/** number of samples per channel delivered since Start */
+		std::atomic<uint64_t> delivered;
+
+		/** number of chunks delivered since Start */
+		std::atomic<uint64_t> chunks;
+
+		/** number of samples per channel dropped since Start because reading fell behind by more than the device buffer */
+		std::atomic<uint64_t> dropped;
+
+		/** size of the simulated device buffer in samples per channel */
+		uint64_t buffersamples;
+
+		/** time of Start, for pacing */
+		std::chrono::high_resolution_clock::time_point starttime;
+
+		/** true between Start and Stop */
+		std::atomic<bool> running;
+
+		/** random number generator for the photon noise */
+		std::mt19937 generator;
+
+	protected:
+		/** Renders the specimen through the scanner vector of the area into expected (and sync for the master area)
+		* @param[in] _area the area in the complete parameter set
+		* @param[in] _params the complete parameter set
+		* @param[out] _expected expected number of photons for every simulated channel and every input sample of one frame */
+		void RenderFrame(const uint32_t& _area, const parameters::Scope& _params, std::vector<std::vector<float>>& _expected);
+
+		/** Fills the chunk for all its areas with simulated samples, waits for the pacing if necessary */
+		template<uint32_t NAREAS>
+		int32_t Fill(DaqMultiChunk<2, NAREAS, uint16_t>& _chunk, bool& _timedout, const double& _timeout);
+
+	public:
+		/** Calculates rates and sizes and renders one frame for the master area and each of its slaves
+		* @param[in] _area the master area
+		* @param[in] _inputparams the simulation parameters
+		* @param[in] _params the complete parameter set */
+		InputsSimulated(const uint32_t& _area, const parameters::InputsSimulated* const _inputparams, const parameters::Scope& _params);
+
+		~InputsSimulated();
+
+		void Start() override;
+
+		void Stop() override;
+
+		uint32_t StandardChunkSize() const override;
+
+		/** @return the samples per channel the simulated device acquired but were not read yet (only in realtime mode, otherwise -1) */
+		int64_t Backlog() const override;
+
+		int32_t Read(DaqMultiChunk<2, 1, uint16_t>& _chunk, bool& _timedout, const double& _timeout) override;
+
+		int32_t Read(DaqMultiChunk<2, 2, uint16_t>& _chunk, bool& _timedout, const double& _timeout) override;
+
+		/** @return number of samples per channel delivered since Start */
+		uint64_t Delivered() const { return delivered; }
+
+		/** @return number of chunks delivered since Start */
+		uint64_t Chunks() const { return chunks; }
+
+		/** @return number of samples per channel dropped since Start (buffer overruns) */
+		uint64_t Dropped() const { return dropped; }
+	};
+
+}
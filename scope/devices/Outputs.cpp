@@ -17,6 +17,10 @@ void Outputs::AbortWrite() {
 	writeabort = true;
 }
 
+void Outputs::ClearAbortWrite() {
+	writeabort = false;
+}
+
 
 
 }
\ No newline at end of file
@@ -2,6 +2,9 @@
 
 namespace scope {
 
+// Forward declaration
+class WaveformGenerator;
+
 /** Wraps hardware connection for signal output to scanners, fast z control, and pockels cell. */
 class Outputs {
 
@@ -24,6 +27,9 @@ public:
 	/** Stops task. */
 	virtual void Stop() { }
 
+	/** Commits the tasks to the hardware, so that they can be stopped and restarted quickly (see DaqController::Arm). */
+	virtual void Commit() { }
+
 	/** Writes values for one frame of X-Y-fastZ and pockels data to the device buffer.
 	* Depending on the implementation in the derived classes, this _xyzp can be a complete frame or e.g. only one x line (for x and p), one y column (for y and fast z)
 	* , which are then repeated by the device.
@@ -31,9 +37,31 @@ public:
 	* @param[in] _blocks in how many blocks should the scannervector be written (more blocks faster update, since smaller blocksize -> buffer for this is free earlier), see "DAQmx quick buffer update.vi" */
 	virtual int32_t Write(std::vector<int16_t>& _xyzp, const uint32_t& _blocks = 1) { return 0; }
 
+	/** Writes a complete frame so that the outputs switch to it exactly at a frame boundary, as early as possible. Only for outputs that
+	* regenerate a buffer of exactly one frame.
+	* @param[in] _xyzp the scannervector with xyzp data to write to device
+	* @param[in] _blocksize samples per channel written at once
+	* @param[out] _switchsample the sample (counted from the start of the output, i.e. from the start trigger shared with the inputs) from
+	* which on the new frame is generated
+	* @return false if the output cannot do this, then nothing was written */
+	virtual bool WriteAtFrameBoundary(std::vector<int16_t>& _xyzp, const uint32_t& _blocksize, uint64_t& _switchsample) { return false; }
+
 	/** Aborts a running Write by setting writeabort to true (which is checked on every block-write of Write) */
 	virtual void AbortWrite();
 
+	/** Clears a pending abort (e.g. left over from Stop), so that the next Write writes the complete vector */
+	void ClearAbortWrite();
+
+	/** @return true if the output streams, i.e. pulls its samples block by block from a WaveformGenerator while running instead of
+	* getting a complete vector by Write */
+	virtual bool Streaming() const { return false; }
+
+	/** Rethrows an error that happened while the output ran on its own (e.g. in a streaming thread), does nothing otherwise */
+	virtual void ThrowIfFailed() const { }
+
+	/** Sets the generator a streaming output pulls its samples from. Call before Start. */
+	virtual void SetGenerator(std::shared_ptr<const WaveformGenerator> _generator) { }
+
 };
 
 }
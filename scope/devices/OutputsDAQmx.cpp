@@ -4,11 +4,21 @@
 #include "parameters/Scope.h"
 #include "helpers/ScopeDatatypes.h"
 #include "helpers/ScopeException.h"
+#include "helpers/DiagnosticLog.h"
 
 namespace scope  {
 
 OutputsDAQmx::OutputsDAQmx(const uint32_t& _area, const parameters::OutputsDAQmx& _outputparams, const parameters::Scope& _params)
-	: Outputs(_area) {
+	: Outputs(_area)
+	, pixeltime(_params.allareas[_area]->daq.pixeltime())
+	, buffersamples(0)
+	, streaming(_outputparams.streaming() && (_params.requested_mode() == DaqModeHelper::continuous))
+	, streamblocksize(_outputparams.streamblocksize())
+	, streambufferblocks(_outputparams.streambufferblocks())
+	, streamtimeout(static_cast<int32_t>(std::ceil(2E-6 * _outputparams.streamblocksize() * _params.allareas[_area]->daq.pixeltime())) + 1)
+	, streamposition(0)
+	, streamstop(false)
+	, streamfailed(false) {
 
 	int32_t samplingtype = (_params.requested_mode()==DaqModeHelper::continuous)?DAQmx_Val_ContSamps:DAQmx_Val_FiniteSamps;
 	
@@ -38,7 +48,17 @@ OutputsDAQmx::OutputsDAQmx(const uint32_t& _area, const parameters::OutputsDAQmx
 		//DBOUT(L"DaqTimingHelper::Mode::ReferenceClock ==_outputparams.daq_timing()");
 		task.ConfigureReferenceClock(_outputparams.referenceclocksource(), _outputparams.referenceclockrate());
 
-	task.ConfigureBuffer( _params.allareas[area]->Currentframe().TotalPixels());
+	// A continuous fast z stack writes the frames of all planes at once, the buffer has to hold all of them
+	if ( (_params.run_state() == RunStateHelper::Mode::RunningStack) && _params.stack.ContinuousFastZ() )
+		buffersamples = task.ConfigureBuffer(pixelsperchan);
+	// Streaming needs only a few blocks, new samples are generated as soon as the device made room for them
+	else if ( streaming ) {
+		buffersamples = task.ConfigureBuffer(streamblocksize * streambufferblocks);
+		task.SetRegeneration(false);
+		streamblock.resize(4 * static_cast<size_t>(streamblocksize));
+	}
+	else
+		buffersamples = task.ConfigureBuffer( _params.allareas[area]->Currentframe().TotalPixels());
 
 	// Regenerate frame samples if we are in nframes mode
 	if ( _params.requested_mode() == DaqModeHelper::nframes )
@@ -65,12 +85,62 @@ OutputsDAQmx::~OutputsDAQmx() {
 }
 
 void OutputsDAQmx::Start() {
+	if ( streaming ) {
+		if ( generator == nullptr )
+			throw ScopeException("OutputsDAQmx streaming without a waveform generator");
+		// Without regeneration the device buffer has to be full before the start
+		streamposition = 0;
+		for ( uint32_t b = 0 ; b < streambufferblocks ; b++ )
+			WriteStreamBlock();
+	}
 	task.Start();
+	if ( streaming ) {
+		streamstop = false;
+		streamfailed = false;
+		streamerror = nullptr;
+		streamer = std::thread(&OutputsDAQmx::Stream, this);
+	}
 }
 
 void OutputsDAQmx::Stop() {
 	writeabort = true;
+	streamstop = true;
 	task.Stop();
+	// Stopping the task also ends a write that is waiting for room in the buffer
+	if ( streamer.joinable() )
+		streamer.join();
+}
+
+void OutputsDAQmx::SetGenerator(std::shared_ptr<const WaveformGenerator> _generator) {
+	generator = _generator;
+}
+
+void OutputsDAQmx::WriteStreamBlock() {
+	generator->Generate(streamposition, streamblocksize, streamblock.data());
+	task.WriteAnalogI16(streamblock.data(), streamblocksize, false, streamtimeout, DAQmx_Val_GroupByScanNumber);
+	streamposition += streamblocksize;
+}
+
+void OutputsDAQmx::Stream() {
+	try {
+		while ( !streamstop )
+			WriteStreamBlock();
+	} catch (...) {
+		// Write errors because of Stop are expected, others are handed to the DaqController (see ThrowIfFailed)
+		if ( !streamstop ) {
+			streamerror = std::current_exception();
+			streamfailed = true;
+		}
+	}
+}
+
+void OutputsDAQmx::ThrowIfFailed() const {
+	if ( streamfailed )
+		std::rethrow_exception(streamerror);
+}
+
+void OutputsDAQmx::Commit() {
+	task.Commit();
 }
 
 int32_t OutputsDAQmx::Write(std::vector<int16_t>& _xyzp, const uint32_t& _blocks) {
@@ -97,6 +167,47 @@ int32_t OutputsDAQmx::Write(std::vector<int16_t>& _xyzp, const uint32_t& _blocks
 	return written;
 }
 
+bool OutputsDAQmx::WriteAtFrameBoundary(std::vector<int16_t>& _xyzp, const uint32_t& _blocksize, uint64_t& _switchsample) {
+	const uint64_t framesamples = _xyzp.size() / 4;
+	// Only if the device regenerates a buffer of exactly this one frame
+	if ( streaming || (framesamples == 0) || (framesamples != buffersamples) )
+		return false;
+	const uint64_t blocksize = std::max<uint64_t>(1, std::min<uint64_t>(_blocksize, framesamples));
+	uint32_t lateblocks = 0;
+	_switchsample = 0;
+	try {
+		// The device fetches samples from the buffer ahead of the generation, up to its onboard buffer size
+		const uint64_t onboard = task.OnboardBufferSize();
+		// First block has to be in the buffer before the device fetches it, leave room for writing two blocks
+		_switchsample = ((task.TotalSamplesGenerated() + onboard + 2 * blocksize) / framesamples + 1) * framesamples;
+		for ( uint64_t k = 0 ; k < framesamples ; k += blocksize ) {
+			const uint64_t samples = std::min(blocksize, framesamples - k);
+			// Wait until the device fetched the old samples at these positions for the last frame before the switch
+			const uint64_t ready = _switchsample - framesamples + k + samples;
+			uint64_t fetched = task.TotalSamplesGenerated() + onboard;
+			while ( (fetched < ready) && !writeabort ) {
+				const double waitus = std::min(10000.0, (ready - fetched) * pixeltime);
+				std::this_thread::sleep_for(std::chrono::microseconds(static_cast<int64_t>(waitus) + 1));
+				fetched = task.TotalSamplesGenerated() + onboard;
+			}
+			if ( writeabort == true ) {
+				DBOUT(L"OutputsDAQmx::WriteAtFrameBoundary writeabort");
+				break;
+			}
+			// Too late, the device already fetched the old samples for the first new frame
+			if ( fetched > _switchsample + k )
+				lateblocks++;
+			task.SetWriteOffset(static_cast<int32>(k));
+			task.WriteAnalogI16(_xyzp.data() + 4*k, static_cast<int32>(samples), false, 2, DAQmx_Val_GroupByScanNumber);
+		}
+	} catch (...) { ScopeExceptionHandler(__FUNCTION__); }
+	if ( lateblocks > 0 )
+		SCOPE_DIAG_WARNING("OutputsDAQmx::WriteAtFrameBoundary area {} {} blocks late for the switch at sample {}", area, lateblocks, _switchsample);
+	SCOPE_DIAG_DEBUG("OutputsDAQmx::WriteAtFrameBoundary area {} switches at sample {}", area, _switchsample);
+	writeabort = false;
+	return true;
+}
+
 ZeroOutputsDAQmx::ZeroOutputsDAQmx(const parameters::OutputsDAQmx& _params) {
 	DAQmx::CDAQmxAnalogOutTask task;
 	try {
@@ -3,6 +3,7 @@
 #include "Outputs.h"
 #include "devices/daqmx/DAQmxTask.h"
 #include "helpers/ScopeDatatypes.h"
+#include "helpers/WaveformGenerator.h"
 
 // Forward declarations
 namespace scope {
@@ -22,6 +23,51 @@ protected:
 	/** The DAQmx task for x/y-scanners/fast z/Pockels clocked by a pixel clock */
 	DAQmx::CDAQmxAnalogOutTask task;
 
+	/** pixel/sample time in microseconds */
+	const double pixeltime;
+
+	/** actual size of the device buffer in samples per channel */
+	uint32_t buffersamples;
+
+	/** true if this output streams (continuous mode and parameters::OutputsDAQmx::streaming) */
+	const bool streaming;
+
+	/** samples per channel per generated block when streaming */
+	const uint32_t streamblocksize;
+
+	/** size of the device buffer in blocks when streaming */
+	const uint32_t streambufferblocks;
+
+	/** timeout in seconds for writing one block when streaming (the device needs one block time to make room) */
+	const int32_t streamtimeout;
+
+	/** where the samples come from when streaming */
+	std::shared_ptr<const WaveformGenerator> generator;
+
+	/** position of the next sample to generate, counted from Start */
+	uint64_t streamposition;
+
+	/** buffer for one generated block */
+	std::vector<int16_t> streamblock;
+
+	/** tells the streaming thread to stop */
+	std::atomic<bool> streamstop;
+
+	/** set by the streaming thread if writing a block failed (streamerror is valid then) */
+	std::atomic<bool> streamfailed;
+
+	/** the error that ended the streaming thread */
+	std::exception_ptr streamerror;
+
+	/** generates blocks and writes them while the device makes room in its buffer */
+	std::thread streamer;
+
+	/** Generates the next block and writes it to the device buffer (waits until there is room) */
+	void WriteStreamBlock();
+
+	/** Loop of the streaming thread */
+	void Stream();
+
 public:
 	/** Creates the task for scanner, pockels, and fast-z output with NI DAQmx.\n
 	* Configure sample timings for output tasks.
@@ -29,18 +75,22 @@ public:
 	*  synchronized to the PXI 10MHz backplane clock used as reference clock.
 	* Read http://www.ni.com/white-paper/3615/en, "M Series Synchronization with LabVIEW and NI-DAQmx" at NI Developer Zone.\n
 	* Configures the triggering for the output tasks. Since all output&input tasks have to start synchronously, the start trigger for all
-	* is the /ao/StartTrigger signal of the first area's analog output task */
+	* is the /ao/StartTrigger signal of the first area's analog output task.\n
+	* When streaming, the buffer holds only streambufferblocks blocks and regeneration is off. */
 	OutputsDAQmx(const uint32_t& _area, const parameters::OutputsDAQmx& _outputparams, const parameters::Scope& _params);
 
 	/** Stop and clear output task. */
 	~OutputsDAQmx();
 
-	/** Start task, last the first output task (all other are waiting for it as their start trigger). */
+	/** Start task, last the first output task (all other are waiting for it as their start trigger).
+	* When streaming, fills the device buffer from the generator first and then starts the streaming thread. */
 	void Start() override;
 
-	/** Stop task */
+	/** Stop task (and the streaming thread) */
 	void Stop() override;
 
+	void Commit() override;
+
 	/** Writes values for one frame of X-Y-fastZ and pockels data to the device buffer.
 	* Use several WriteAnalogI16 commands with small parts (blocks) of the whole ScannerVectorFrame to
 	* speed up the update (do not have to wait until the complete buffer is empty/ready for writing into).
@@ -48,6 +98,18 @@ public:
 	* @param[in] _blocks in how many blocks should the scannervector be written (more blocks faster update, since smaller blocksize -> buffer for this is free earlier), see "DAQmx quick buffer update.vi" */
 	int32_t Write(std::vector<int16_t>& _xyzp, const uint32_t& _blocks = 1) override;
 
+	/** Writes the frame in blocks of _blocksize. Picks the first frame boundary that can still be reached (taking into account the samples
+	* the device already fetched into its onboard buffer), then writes every block as soon as the device fetched the old samples at these
+	* buffer positions for the last old frame. Thus the old frame is never torn and the new one starts at most about a frame later. */
+	bool WriteAtFrameBoundary(std::vector<int16_t>& _xyzp, const uint32_t& _blocksize, uint64_t& _switchsample) override;
+
+	bool Streaming() const override { return streaming; }
+
+	/** Rethrows the error that ended the streaming thread, so that the DaqController can stop the acquisition */
+	void ThrowIfFailed() const override;
+
+	void SetGenerator(std::shared_ptr<const WaveformGenerator> _generator) override;
+
 };
 
 /** Wraps hardware connection for zeroing signal output to scanners, fast z control, and pockels cell with NI-DAQmx. */
@@ -79,6 +79,11 @@ void OutputsDAQmxLineClock::Stop(void) {
 	yzout_task.Stop();
 }
 
+void OutputsDAQmxLineClock::Commit() {
+	xpout_task.Commit();
+	yzout_task.Commit();
+}
+
 int32_t OutputsDAQmxLineClock::Write(std::vector<int16_t>& _xyzp, const uint32_t& _blocks) {
 	int32_t written = 0;
 
@@ -42,6 +42,8 @@ public:
 
 	void Stop() override;
 
+	void Commit() override;
+
 	int32_t Write(std::vector<int16_t>& _xyzp, const uint32_t& _blocks) override;
 };
 
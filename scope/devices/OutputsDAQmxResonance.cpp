@@ -80,6 +80,11 @@ void OutputsDAQmxResonance::Stop() {
 	taskResonanceZoom.Stop();
 }
 
+void OutputsDAQmxResonance::Commit() {
+	task.Commit();
+	taskResonanceZoom.Commit();
+}
+
 int32_t OutputsDAQmxResonance::Write(std::vector<int16_t>& _xyzp, const uint32_t& _blocks) {
 	int32_t written = 0;
 	assert(_blocks!=0);
@@ -44,6 +44,8 @@ public:
 	/** Stop task */
 	void Stop() override;
 
+	void Commit() override;
+
 	/** Writes values for one frame of X-Y-fastZ and pockels data to the device buffer.
 	* Use several WriteAnalogI16 commands with small parts (blocks) of the whole ScannerVectorFrame to
 	* speed up the update (do not have to wait until the complete buffer is empty/ready for writing into).
@@ -69,6 +69,10 @@ void OutputsDAQmxResonanceSlave::Stop() {
 	zpout_task.Stop();
 }
 
+void OutputsDAQmxResonanceSlave::Commit() {
+	zpout_task.Commit();
+}
+
 int32_t OutputsDAQmxResonanceSlave::Write(std::vector<int16_t>& _zp, const uint32_t& _blocks) {
 	int32_t written = 0;
 	assert(_blocks!=0);
@@ -32,6 +32,8 @@ public:
 
 	void Stop() override;
 
+	void Commit() override;
+
 	/** we also take a std::vector<int16_t> but for the slave area it has only samples for z&p ! */
 	int32_t Write(std::vector<int16_t>& _xyzp, const uint32_t& _blocks) override;
 };
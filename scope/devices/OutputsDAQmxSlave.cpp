@@ -39,7 +39,11 @@ namespace scope {
 		if ( DaqTimingHelper::Mode::ReferenceClock ==_outputparams.timing() )
 			zpout_task.ConfigureReferenceClock(_outputparams.referenceclocksource(), _outputparams.referenceclockrate());
 
-		zpout_task.ConfigureBuffer(_params.allareas[area]->Currentframe().XTotalPixels());
+		// A continuous fast z stack writes the frames of all planes at once, the buffer has to hold all of them
+		if ( (_params.run_state() == RunStateHelper::Mode::RunningStack) && _params.stack.ContinuousFastZ() )
+			zpout_task.ConfigureBuffer(pixelsperchan);
+		else
+			zpout_task.ConfigureBuffer(_params.allareas[area]->Currentframe().XTotalPixels());
 
 		// Regenerate frame samples if we are in nframes mode
 		if ( _params.requested_mode() == DaqModeHelper::nframes )
@@ -65,6 +69,10 @@ namespace scope {
 		zpout_task.Stop();
 	}
 
+	void OutputsDAQmxSlave::Commit() {
+		zpout_task.Commit();
+	}
+
 	int32_t OutputsDAQmxSlave::Write(std::vector<int16_t>& _zp, const uint32_t& _blocks) {
 		int32_t written = 0;
 		assert(_blocks!=0);
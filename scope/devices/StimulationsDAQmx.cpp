@@ -31,6 +31,10 @@ namespace scope {
 		task.Start();
 	}
 
+	void StimulationsDAQmx::Stop() {
+		task.Stop();
+	}
+
 	int32_t StimulationsDAQmx::Write(std::shared_ptr<const std::vector<uint8_t>> const _stimvec) {
 		int32_t written = -1;
 		try {
@@ -29,6 +29,9 @@ public:
 	/** Start stimulation task, waits on first output task sample clock */
 	void Start();
 
+	/** Stop stimulation task, it can be started again with the written vector */
+	void Stop();
+
 	/** Write the stimulation vector to the digital stimulation task
 	* @return the number of samples per channel actually written, -1 in case of error */
 	virtual int32_t Write(std::shared_ptr<const std::vector<uint8_t>> const _stimvec);
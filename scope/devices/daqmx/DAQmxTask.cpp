@@ -149,6 +149,10 @@ void CDAQmxTask::Stop(void) {
 	CheckError(DAQmxStopTask(task_handle));
 }
 
+void CDAQmxTask::Commit(void) {
+	CheckError(DAQmxTaskControl(task_handle, DAQmx_Val_Task_Commit));
+}
+
 void CDAQmxTask::Clear(void) {
 	CheckError(DAQmxClearTask(task_handle));
 }
@@ -215,6 +219,18 @@ uInt32 CDAQmxAnalogOutTask::ConfigureOnboardBuffer(const uInt32& _sampsperchanne
 	return bufsize;
 }
 
+uInt32 CDAQmxAnalogOutTask::OnboardBufferSize() {
+	uInt32 bufsize = 0;
+	CheckError(DAQmxGetBufOutputOnbrdBufSize(task_handle, &bufsize));
+	return bufsize;
+}
+
+uInt64 CDAQmxAnalogOutTask::TotalSamplesGenerated() {
+	uInt64 value = 0;
+	CheckError(DAQmxGetWriteTotalSampPerChanGenerated(task_handle, &value));
+	return value;
+}
+
 void CDAQmxAnalogOutTask::UseOnlyOnboardMemory(const std::wstring& _channel) {
 	CW2A char_channel(_channel.c_str());
 	CheckError(DAQmxSetAOUseOnlyOnBrdMem(task_handle, char_channel, true));
@@ -336,6 +352,12 @@ void CDAQmxAnalogInTask::ConfigureBuffer(const uInt32& _sampsperchannel) {
 	DBOUT(L"CDAQmxAnalogInTask::ConfigureBuffer buffer size " << value);
 }
 
+uInt32 CDAQmxAnalogInTask::AvailableSamples() {
+	uInt32 value = 0;
+	CheckError(DAQmxGetReadAvailSampPerChan(task_handle, &value));
+	return value;
+}
+
 int32 CDAQmxAnalogInTask::ReadU16(std::vector<uint16_t>::iterator& _databegin, std::vector<uint16_t>::iterator& _dataend, const int32& _sampsperchan, const uint32_t& _channels,  bool& _timedout, const float64& _timeout) {
 	int32 readsamples = 0;
 	int32_t status = DAQmxReadBinaryU16(task_handle
@@ -98,6 +98,10 @@ namespace DAQmx {
 			/** Stops the task */
 			void Stop(void);
 
+			/** Commits the task (programs the hardware with all settings). After an explicit commit, Stop returns the task to the
+			* committed state, thus a later Start is much faster than from the verified state. */
+			void Commit(void);
+
 			/** Clear the task */
 			void Clear(void);
 
@@ -163,6 +167,12 @@ namespace DAQmx {
 			* @return the actual buffer size */
 			uInt32 ConfigureOnboardBuffer(const uInt32& _sampsperchannel);
 
+			/** @return the size of the output buffer on the device hardware in samples per channel */
+			uInt32 OnboardBufferSize();
+
+			/** @return the total number of samples per channel generated since the task started */
+			uInt64 TotalSamplesGenerated();
+
 			/** Configures the task to use only the devices' onboard memory. Write operations do not use a DAQmx buffer on the PC but write directly to onboard memory.
 			* @warning You cannot write to the device after the start was started. This is only possible with DAQmx buffer on the PC.
 			* @param[in] _channel The channel(s) for which this is configured */
@@ -289,6 +299,8 @@ namespace DAQmx {
 			* @param[in] _sampsperchannel buffersize per channel */
 			void ConfigureBuffer(const uInt32& _sampsperchannel);
 
+			/** @return number of samples per channel acquired into the input buffer but not yet read */
+			uInt32 AvailableSamples();
 			
 			/** Reads from a device as signed 16bit integers
 			* @param[in,out] _databegin iterator of uint16_t vector where read into should start
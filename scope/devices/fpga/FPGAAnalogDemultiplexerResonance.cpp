@@ -1,5 +1,6 @@
 #include "StdAfx.h"
 #include "FPGAAnalogDemultiplexerResonance.h"
+#include "helpers/DiagnosticLog.h"
 #include "parameters/Inputs.h"
 
 namespace scope {
@@ -149,12 +150,13 @@ namespace scope {
 				, &remaining);
 			_timedout = (stat == NiFpga_Status_FifoTimeout);
 
-			DBOUT(L"FPGAAnalogDemultiplexerResonance::ReadPixels area " << a << L" remaining: " << remaining);
+			SCOPE_DIAG_TRACE("FPGAAnalogDemultiplexerResonance::ReadPixels area {} remaining {}", a, remaining);
 
 			// avoid throwing exception on time out (since FpgaStatus status could throw on all errors)
 			if (_timedout)
 				return -1;
 			status = stat;
+			SetFIFORemaining(_area + a, remaining);
 
 			// U64 from FIFO has Ch1 in the higher 32 bits, Ch2 in the lower 32 bits
 			auto itch1 = _chunk.GetDataStart(a);
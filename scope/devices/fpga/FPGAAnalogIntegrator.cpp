@@ -136,6 +136,7 @@ namespace scope {
 
 			// this could throw on error (if we would use FPGAStatus instead of FPGAStatusSafe)
 			status = stat;
+			SetFIFORemaining(_area, remaining);
 
 			std::transform(std::begin(u32data), std::end(u32data), _chunk.GetDataStart(0)+c*_chunk.PerChannel(), [&](const uint32_t& u32) {
 				return static_cast<uint16_t>(u32 >> bitshift[c]);
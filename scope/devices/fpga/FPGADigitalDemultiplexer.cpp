@@ -153,6 +153,7 @@ namespace scope {
 				if (_timedout)
 					return -1;
 				status = stat;
+				SetFIFORemaining(_area + a, remaining);
 			}
 		}
 		
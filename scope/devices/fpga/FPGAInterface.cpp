@@ -8,11 +8,28 @@ namespace scope {
 		: status(NiFpga_Status_Success)
 		, session(0)
 		, initialized(false) {
+		ResetFIFORemaining();
 	}
 
 	FPGAInterface::~FPGAInterface() {
 	}
 
+	void FPGAInterface::SetFIFORemaining(const uint32_t& _area, const size_t& _remaining) {
+		if ( _area >= maxfifoareas )
+			return;
+		const uint32_t remaining = static_cast<uint32_t>(std::min<size_t>(_remaining, UINT32_MAX));
+		fiforemaining[_area] = remaining;
+		if ( remaining > maxfiforemaining[_area] )
+			maxfiforemaining[_area] = remaining;
+	}
+
+	void FPGAInterface::ResetFIFORemaining() {
+		for ( uint32_t a = 0 ; a < maxfifoareas ; a++ ) {
+			fiforemaining[a] = 0;
+			maxfiforemaining[a] = 0;
+		}
+	}
+
 	int32_t FPGAInterface::ReadPixels(const uint32_t& _area, DaqChunk<uint16_t>& _chunk, const double& _timeout, bool& _timedout) {
 		return -1;
 	}
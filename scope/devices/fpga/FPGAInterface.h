@@ -31,6 +31,21 @@ namespace scope {
 			/** true if already initialized */
 			bool initialized;
 
+			/** maximum number of areas an FPGA program acquires */
+			static const uint32_t maxfifoareas = 4;
+
+			/** for every area: elements left in the host memory part of the DMA FIFO after the last read (one element per sample and channel in all FPGA
+			* programs, thus this is the backlog in samples per channel) */
+			std::array<std::atomic<uint32_t>, maxfifoareas> fiforemaining;
+
+			/** for every area: maximum of fiforemaining since StartAcquisition */
+			std::array<std::atomic<uint32_t>, maxfifoareas> maxfiforemaining;
+
+			/** Records the remaining elements reported by a NiFpga_ReadFifo call, to be called by derived classes after every FIFO read
+			* @param[in] _area the area the FIFO belongs to
+			* @param[in] _remaining the remaining elements reported */
+			void SetFIFORemaining(const uint32_t& _area, const size_t& _remaining);
+
 		public:
 			FPGAInterface();
 	
@@ -121,6 +136,15 @@ namespace scope {
 
 			/** @return the current FPGA status */
 			FPGAStatusSafe CurrentStatus() const { return status; }
+
+			/** @return elements left in the DMA FIFO of _area after the last read, i.e. the backlog in samples per channel */
+			uint32_t FIFORemaining(const uint32_t& _area) const { return (_area < maxfifoareas) ? fiforemaining[_area].load() : 0; }
+
+			/** @return maximum backlog of _area in samples per channel since the last StartAcquisition (how close we came to a FIFO overflow) */
+			uint32_t MaxFIFORemaining(const uint32_t& _area) const { return (_area < maxfifoareas) ? maxfiforemaining[_area].load() : 0; }
+
+			/** Resets the FIFO backlog statistics, called from InputsFPGA::Start */
+			void ResetFIFORemaining();
 	};
 
 }
\ No newline at end of file
@@ -109,6 +109,7 @@ namespace scope {
 
 			// this could throw on error (if we would use FPGAStatus instead of FPGAStatusSafe)
 			status = stat;
+			SetFIFORemaining(_area, remaining);
 		}
 
 		if ( status.Success() )
@@ -142,6 +143,7 @@ namespace scope {
 
 				// this could throw on error (if we would use FPGAStatus instead of FPGAStatusSafe)
 				status = stat;
+				SetFIFORemaining(_area + a, remaining);
 			}
 		}
 
@@ -117,6 +117,7 @@ namespace scope {
 			if ( _timedout )
 				return -1;													// avoid throwing exception on time out (since FpgaStatus status could throw on all errors)
 			status = stat;
+			SetFIFORemaining(_area, remaining);
 		}
 
 		if ( status.Success() )
@@ -121,6 +121,7 @@ namespace scope {
 
 			// this could throw on error (if we would use FPGAStatus instead of FPGAStatusSafe)
 			status = stat;
+			SetFIFORemaining(_area, remaining);
 
 			// Isolate pixel uint16 from uint32
 			std::transform(std::begin(u32data), std::end(u32data), std::begin(_chunk.data) + c*_chunk.PerChannel(), [](const uint32_t& _u32) {
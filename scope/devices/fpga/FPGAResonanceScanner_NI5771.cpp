@@ -141,6 +141,7 @@ namespace scope {
 
 			// this could throw on error (if we would use FPGAStatus instead of FPGAStatusSafe)
 			status = stat;
+			SetFIFORemaining(_area, remaining);
 
 			// isolate pixel uint16 from uint32
 			auto itdata = std::begin(_chunk.data) + c * _chunk.PerChannel();
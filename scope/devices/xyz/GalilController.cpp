@@ -45,6 +45,29 @@ double GalilController::CommandValue(const std::wstring& _cmd) {
 	return Ctrl().commandValue(cmd);
 }
 
+void GalilController::StartRecords(const double& _periodms) {
+	std::lock_guard<std::mutex> lock(mutex);
+	Ctrl().recordsStart(_periodms);
+}
+
+void GalilController::StopRecords() {
+	std::lock_guard<std::mutex> lock(mutex);
+	Ctrl().command("DR 0");
+}
+
+std::vector<double> GalilController::RecordValues(const std::wstring& _method, const std::vector<std::wstring>& _sources) {
+	std::lock_guard<std::mutex> lock(mutex);
+	std::string method = CW2A(_method.c_str());
+	const std::vector<char> record(Ctrl().record(method));
+	std::vector<double> values;
+	values.reserve(_sources.size());
+	for ( const auto& s : _sources ) {
+		std::string source = CW2A(s.c_str());
+		values.push_back(Ctrl().sourceValue(record, source));
+	}
+	return values;
+}
+
 Galil& GalilController::Ctrl() {
 	try {
 		std::string str = CW2A(comstring.c_str());
@@ -50,6 +50,18 @@ public:
 	/** Send command to the Galil controller and get a number back */
 	double CommandValue(const std::wstring& _cmd);
 
+	/** Arms the data records (DR), afterwards the controller sends a record every _periodms without being asked */
+	void StartRecords(const double& _periodms);
+
+	/** Stops the data records */
+	void StopRecords();
+
+	/** Gets a data record and reads values from it
+	* @param[in] _method "DR" takes the latest record the armed controller sent (no round trip), "QR" asks the controller for one
+	* @param[in] _sources the record sources to read, e.g. "_TPX" for the encoder position of the x axis
+	* @return the values in the order of _sources */
+	std::vector<double> RecordValues(const std::wstring& _method, const std::vector<std::wstring>& _sources);
+
 protected:
 	/** @return reference to the static instance (local variable inside CreateInstance) */
 	Galil& Ctrl();
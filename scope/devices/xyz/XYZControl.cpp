@@ -6,7 +6,11 @@ namespace scope {
 
 XYZControl::XYZControl()
 	: initialized(false)
-	, pollinterval(1000) {
+	, pollinterval(1000)
+	, settletime(0.0)
+	, settletimeperum(0.0)
+	, movetimeout(5000)
+	, lastmovedistance(0.0) {
 }
 
 XYZControl::~XYZControl() {
@@ -18,6 +22,9 @@ void XYZControl::Initialize(parameters::XYZControl& _params) {
 	xyzpos[1] = &_params.ypos;
 	xyzpos[2] = &_params.zpos;
 	pollinterval = round2ui32(_params.pollinterval());
+	settletime = _params.settletime();
+	settletimeperum = _params.settletimeperum();
+	movetimeout = round2ui32(_params.movetimeout());
 	// Polling more frequently will most definitely lead to problems...
 	if ( pollinterval > 100 ) {
 		// we need to call from the this pointer to call the most derived version of StartPolling
@@ -46,6 +53,37 @@ void XYZControl::UpdatePositionValues() {
 	// Do nothing
 }
 
+void XYZControl::MoveAbsoluteAsync(const double& _xabs, const double& _yabs, const double& _zabs) {
+	// The last known positions are good enough for the settle time model
+	lastmovedistance = 0.0;
+	if ( initialized )
+		lastmovedistance = std::max({ std::abs(_xabs - xyzpos[0]->Value()), std::abs(_yabs - xyzpos[1]->Value()), std::abs(_zabs - xyzpos[2]->Value()) });
+	StartMoveAbsolute(_xabs, _yabs, _zabs);
+}
+
+double XYZControl::SettleTime(const double& _distance) const {
+	return settletime + settletimeperum * _distance;
+}
+
+bool XYZControl::WaitForMotion(StopCondition* const _abort) {
+	const auto start = std::chrono::steady_clock::now();
+	const auto timeout = std::chrono::milliseconds(movetimeout);
+	bool complete = false;
+	try {
+		while ( !(complete = MotionComplete()) ) {
+			if ( ((_abort != nullptr) && _abort->IsSet()) || (std::chrono::steady_clock::now() - start > timeout) )
+				return false;
+			std::this_thread::sleep_for(std::chrono::milliseconds(motionpollinterval));
+		}
+
+		// Let the stage settle
+		std::this_thread::sleep_for(std::chrono::microseconds(round2i64(1000 * SettleTime(lastmovedistance))));
+		UpdatePositionValues();
+	}
+	catch (...) { ScopeExceptionHandler(__FUNCTION__, true, true); }
+	return complete;
+}
+
 void XYZControl::SetZero() {
 	SetZeroXAxis();
 	SetZeroYAxis();
@@ -29,6 +29,21 @@ protected:
 	/** interval (in milliseconds) to poll device */
 	uint32_t pollinterval;
 
+	/** constant part of the settle time in milliseconds */
+	double settletime;
+
+	/** distance dependent part of the settle time in milliseconds per micrometer */
+	double settletimeperum;
+
+	/** maximum time in milliseconds WaitForMotion waits for the device to report motion complete */
+	uint32_t movetimeout;
+
+	/** largest distance of all axes in micrometer of the last move started by MoveAbsoluteAsync */
+	double lastmovedistance;
+
+	/** interval in milliseconds to ask the device for motion complete in WaitForMotion */
+	static const uint32_t motionpollinterval = 5;
+
 protected:
 	/** disable copy */
 	XYZControl(XYZControl&) = delete;
@@ -36,6 +51,10 @@ protected:
 	/** disable assignment */
 	XYZControl operator=(XYZControl) = delete;
 
+	/** Starts an absolute movement in um and returns immediately if the device supports that. This default implementation
+	* does the (blocking) MoveAbsolute, thus motion is already complete when it returns. */
+	virtual void StartMoveAbsolute(const double& _xabs, const double& _yabs, const double& _zabs) { MoveAbsolute(_xabs, _yabs, _zabs); }
+
 public:
 	XYZControl();
 
@@ -84,6 +103,21 @@ public:
 
 	/** Absolute movement in um */
 	virtual void MoveAbsolute(const double& _xabs, const double& _yabs, const double& _zabs) {}
+
+	/** Starts an absolute movement in um and returns without waiting for it to complete (if the device supports that).
+	* Use MotionComplete or WaitForMotion to find out when the stage arrived. */
+	void MoveAbsoluteAsync(const double& _xabs, const double& _yabs, const double& _zabs);
+
+	/** @return true if the device reports that the last movement is complete. Asks the device immediately. */
+	virtual bool MotionComplete() { return true; }
+
+	/** @return the modelled settle time in milliseconds after a move over _distance micrometers */
+	double SettleTime(const double& _distance) const;
+
+	/** Waits until the device reports motion complete and then for the settle time of the last move started with MoveAbsoluteAsync
+	* @param[in] _abort waiting is aborted if this is set (e.g. when a stack scan is stopped), may be nullptr
+	* @return false if the device did not report motion complete within the move timeout or waiting was aborted */
+	bool WaitForMotion(StopCondition* const _abort = nullptr);
 };
 
 }
\ No newline at end of file
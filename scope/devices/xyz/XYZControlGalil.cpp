@@ -13,11 +13,18 @@ XYZControlGalil::XYZControlGalil()
 	: gc(nullptr)
 	, xcountspermicron(1.0)
 	, ycountspermicron(1.0) 
-	, zcountspermicron(1.0) {
+	, zcountspermicron(1.0)
+	, recordsarmed(false) {
 }
 
 XYZControlGalil::~XYZControlGalil() {
 	StopPolling();
+	if ( recordsarmed ) {
+		try {
+			gc->StopRecords();
+		}
+		catch (...) { ScopeExceptionHandler(__FUNCTION__); }
+	}
 }
 
 void XYZControlGalil::Initialize(parameters::XYZControlGalil& _params) {
@@ -38,6 +45,14 @@ void XYZControlGalil::Initialize(parameters::XYZControlGalil& _params) {
 		gc->Command(L"SB1");				// SB: sets bit 1 -> loosens z axis brake
 		gc->Command(L"WT500");				// WT: wait 500ms for the brake to loose				
 
+		// Arm the data records once, polls and position reads then only take the latest record the controller sent
+		try {
+			gc->StartRecords(recordinterval);
+			recordsarmed = true;
+		} catch (...) {
+			scope_logger.Log(L"XYZControlGalil could not arm data records, asking the controller for a record on every position read", log_warning);
+		}
+
 		// call base class Initialize, which connects ScopeValues, sets initialized to true and starts the polling thread
 		XYZControl::Initialize(_params);
 
@@ -51,20 +66,22 @@ void XYZControlGalil::Initialize(parameters::XYZControlGalil& _params) {
 	SetZero();
 }
 
+std::array<double, 3> XYZControlGalil::ReadEncoders() {
+	// _TPn: tell position = encoder position of axis n. DR: latest record sent by the armed controller, QR: query a record
+	const std::vector<double> counts(gc->RecordValues(recordsarmed ? L"DR" : L"QR", { L"_TPX", L"_TPY", L"_TPZ" }));
+	return { counts[0]/xcountspermicron, counts[1]/ycountspermicron, counts[2]/zcountspermicron };
+}
+
 void XYZControlGalil::UpdatePositionValues() {
-	double p = gc->CommandValue(L"PAX=?");					// PAX=?: Position absolute x
-	xyzpos[0]->Set(p/xcountspermicron);
-	p = gc->CommandValue(L"PAY=?");							// PAY=?: Position absolute y
-	xyzpos[1]->Set(p/ycountspermicron);
-	p = gc->CommandValue(L"PAZ=?");							// PAZ=?: Position absolute z
-	xyzpos[2]->Set(p/zcountspermicron);
+	const std::array<double, 3> pos(ReadEncoders());
+	for ( uint32_t a = 0 ; a < 3 ; a++ )
+		xyzpos[a]->Set(pos[a]);
 }
 
 double XYZControlGalil::CurrentXPosition() {
 	double pos = 0;
 	try {
-		pos = gc->CommandValue(L"PAX=?");		// PAX=?: gives position absolute x
-		pos /= xcountspermicron;
+		pos = ReadEncoders()[0];
 		xyzpos[0]->Set(pos);
 	} catch (...) { ScopeExceptionHandler(__FUNCTION__, true, true); }
 	return pos;
@@ -73,8 +90,7 @@ double XYZControlGalil::CurrentXPosition() {
 double XYZControlGalil::CurrentYPosition() {
 	double pos = 0;
 	try {
-		pos = gc->CommandValue(L"PAY=?");		// PAY=?: gives position absolute y
-		pos /= ycountspermicron;
+		pos = ReadEncoders()[1];
 		xyzpos[1]->Set(pos);
 	} catch (...) { ScopeExceptionHandler(__FUNCTION__, true, true); }
 	return pos;
@@ -83,8 +99,7 @@ double XYZControlGalil::CurrentYPosition() {
 double XYZControlGalil::CurrentZPosition() {
 	double pos = 0;
 	try {
-		pos = gc->CommandValue(L"PAZ=?");		// PAZ=?: gives position absolute z
-		pos /= zcountspermicron;
+		pos = ReadEncoders()[2];
 		xyzpos[2]->Set(pos);
 	} catch (...) { ScopeExceptionHandler(__FUNCTION__, true, true); }
 	return pos;
@@ -149,6 +164,25 @@ void XYZControlGalil::MoveAbsolute(const double& _xabs, const double& _yabs, con
 	UpdatePositionValues();
 }
 
+void XYZControlGalil::StartMoveAbsolute(const double& _xabs, const double& _yabs, const double& _zabs) {
+	try {
+		if ( (abs(_xabs) > 20000) || (abs(_yabs) > 20000) || (abs(_zabs) > 20000) )
+			throw ScopeException("XYZControlGalil::StartMoveAbsolute travel range too large");
+		int32_t countsx = round2i32(static_cast<double>(xcountspermicron) * _xabs);
+		int32_t countsy = round2i32(static_cast<double>(ycountspermicron) * _yabs);
+		int32_t countsz = round2i32(static_cast<double>(zcountspermicron) * _zabs);
+		std::wstringstream cmd;										// PA: Position absolute = move absolute, in encoder counts
+		cmd << L"PA " << countsx << L"," << countsy << L"," << countsz;
+		gc->Command(cmd.str());
+		gc->Command(L"BG");										// BG: Begin move, completion is polled with MotionComplete
+	} catch (...) { ScopeExceptionHandler(__FUNCTION__, true, true); }
+}
+
+bool XYZControlGalil::MotionComplete() {
+	// _BGn is 1 while axis n is moving
+	return (gc->CommandValue(L"MG _BGX") == 0.0) && (gc->CommandValue(L"MG _BGY") == 0.0) && (gc->CommandValue(L"MG _BGZ") == 0.0);
+}
+
 }
 
 #endif
\ No newline at end of file
@@ -33,6 +33,19 @@ protected:
 	/** conversion factor between encoder counts and micrometers for z axis*/
 	double zcountspermicron;
 
+	/** true if the data records were armed in Initialize, then the encoder positions are read from the latest record the controller sent */
+	bool recordsarmed;
+
+	/** interval in milliseconds at which the armed controller sends data records */
+	static const uint32_t recordinterval = 10;
+
+protected:
+	/** @return the x, y, and z encoder positions in micrometers, from the latest data record if armed, otherwise from one queried record */
+	std::array<double, 3> ReadEncoders();
+
+	/** Sends the absolute position and begins the move, does not wait for motion complete */
+	void StartMoveAbsolute(const double& _xabs, const double& _yabs, const double& _zabs) override;
+
 public:
 	XYZControlGalil();
 	~XYZControlGalil();
@@ -57,6 +70,9 @@ public:
 	void MoveRelative(const double& _xrel, const double& _yrel, const double& _zrel) override;
 
 	void MoveAbsolute(const double& _xabs, const double& _yabs, const double& _zabs) override;
+
+	/** @return true if no axis is in motion (_BGn operands of the Galil controller) */
+	bool MotionComplete() override;
 };
 
 }
@@ -0,0 +1,113 @@
+#include "stdafx.h"
+#include "XYZControlSimulated.h"
+#include "parameters/Devices.h"
+#include "controllers/ScopeLogger.h"
+
+namespace scope {
+
+XYZControlSimulated::XYZControlSimulated()
+	: movestart(std::chrono::steady_clock::now())
+	, moveduration(0)
+	, velocity(500.0) {
+	startposition.fill(0.0);
+	targetposition.fill(0.0);
+}
+
+XYZControlSimulated::~XYZControlSimulated() {
+	StopPolling();
+}
+
+void XYZControlSimulated::Initialize(parameters::XYZControlSimulated& _params) {
+	velocity = _params.velocity();
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		startposition = { _params.xpos(), _params.ypos(), _params.zpos() };
+		targetposition = startposition;
+	}
+
+	// call base class Initialize, which connects ScopeValues, sets initialized to true and starts the polling thread
+	XYZControl::Initialize(_params);
+
+	ScopeLogger::GetInstance().Log(L"Initialized XYZControlSimulated", log_info);
+}
+
+double XYZControlSimulated::Position(const uint32_t& _axis) const {
+	std::lock_guard<std::mutex> lock(mutex);
+	const auto elapsed = std::chrono::steady_clock::now() - movestart;
+	if ( (moveduration.count() == 0) || (elapsed >= moveduration) )
+		return targetposition[_axis];
+	const double fraction = std::chrono::duration<double>(elapsed).count() / std::chrono::duration<double>(moveduration).count();
+	return startposition[_axis] + fraction * (targetposition[_axis] - startposition[_axis]);
+}
+
+void XYZControlSimulated::StartMoveAbsolute(const double& _xabs, const double& _yabs, const double& _zabs) {
+	// Start from wherever we are right now (also in the middle of a movement)
+	const std::array<double, 3> current = { Position(0), Position(1), Position(2) };
+	std::lock_guard<std::mutex> lock(mutex);
+	startposition = current;
+	targetposition = { _xabs, _yabs, _zabs };
+	double distance = 0.0;
+	for ( uint32_t a = 0 ; a < 3 ; a++ )
+		distance = std::max(distance, std::abs(targetposition[a] - startposition[a]));
+	movestart = std::chrono::steady_clock::now();
+	moveduration = std::chrono::microseconds(round2i64(1E6 * distance / velocity));
+}
+
+void XYZControlSimulated::SetZeroAxis(const uint32_t& _axis) {
+	const std::array<double, 3> current = { Position(0), Position(1), Position(2) };
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		startposition = current;
+		targetposition = current;
+		startposition[_axis] = 0.0;
+		targetposition[_axis] = 0.0;
+		moveduration = std::chrono::microseconds(0);
+	}
+	UpdatePositionValues();
+}
+
+void XYZControlSimulated::UpdatePositionValues() {
+	for ( uint32_t a = 0 ; a < 3 ; a++ )
+		xyzpos[a]->Set(Position(a));
+}
+
+double XYZControlSimulated::CurrentXPosition() {
+	return Position(0);
+}
+
+double XYZControlSimulated::CurrentYPosition() {
+	return Position(1);
+}
+
+double XYZControlSimulated::CurrentZPosition() {
+	return Position(2);
+}
+
+void XYZControlSimulated::SetZeroXAxis() {
+	SetZeroAxis(0);
+}
+
+void XYZControlSimulated::SetZeroYAxis() {
+	SetZeroAxis(1);
+}
+
+void XYZControlSimulated::SetZeroZAxis() {
+	SetZeroAxis(2);
+}
+
+void XYZControlSimulated::MoveRelative(const double& _xrel, const double& _yrel, const double& _zrel) {
+	MoveAbsolute(Position(0) + _xrel, Position(1) + _yrel, Position(2) + _zrel);
+}
+
+void XYZControlSimulated::MoveAbsolute(const double& _xabs, const double& _yabs, const double& _zabs) {
+	// Blocking like the real stages
+	MoveAbsoluteAsync(_xabs, _yabs, _zabs);
+	WaitForMotion();
+}
+
+bool XYZControlSimulated::MotionComplete() {
+	std::lock_guard<std::mutex> lock(mutex);
+	return (std::chrono::steady_clock::now() - movestart) >= moveduration;
+}
+
+}
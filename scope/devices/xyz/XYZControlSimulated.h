@@ -0,0 +1,76 @@
+#pragma once
+
+#include "XYZControl.h"
+
+// Forward declaration
+namespace scope {
+	namespace parameters {
+		class XYZControlSimulated;
+	}
+}
+
+namespace scope {
+
+/** Simulates an xyz stage without hardware. Moves with constant velocity along the straight line to the target, motion is complete
+* when the target is reached. Lets you test stack acquisition (MoveAbsoluteAsync, WaitForMotion) without a stage.
+* @ingroup ScopeComponentsHardware */
+class XYZControlSimulated :
+	public XYZControl {
+
+protected:
+	/** protects the movement model */
+	mutable std::mutex mutex;
+
+	/** position in um at the start of the current movement */
+	std::array<double, 3> startposition;
+
+	/** target position in um of the current movement */
+	std::array<double, 3> targetposition;
+
+	/** time the current movement started */
+	std::chrono::steady_clock::time_point movestart;
+
+	/** duration of the current movement */
+	std::chrono::microseconds moveduration;
+
+	/** velocity in um/s */
+	double velocity;
+
+	/** @return the modelled position of axis _axis now */
+	double Position(const uint32_t& _axis) const;
+
+	/** Starts the simulated movement and returns immediately */
+	void StartMoveAbsolute(const double& _xabs, const double& _yabs, const double& _zabs) override;
+
+	/** Sets one axis to zero (stops a movement of that axis) */
+	void SetZeroAxis(const uint32_t& _axis);
+
+public:
+	XYZControlSimulated();
+	~XYZControlSimulated();
+
+	/** Initialize with parameters. Not an override of base clase method, because different parameter type! */
+	void Initialize(parameters::XYZControlSimulated& _params);
+
+	void UpdatePositionValues() override;
+
+	double CurrentXPosition() override;
+
+	double CurrentYPosition() override;
+
+	double CurrentZPosition() override;
+
+	void SetZeroXAxis() override;
+
+	void SetZeroYAxis() override;
+
+	void SetZeroZAxis() override;
+
+	void MoveRelative(const double& _xrel, const double& _yrel, const double& _zrel) override;
+
+	void MoveAbsolute(const double& _xabs, const double& _yabs, const double& _zabs) override;
+
+	bool MotionComplete() override;
+};
+
+}
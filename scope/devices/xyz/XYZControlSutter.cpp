@@ -180,6 +180,34 @@ void XYZControlSutter::MoveAbsolute(const double& _xabs, const double& _yabs, co
 	UpdatePositionValues();
 }
 
+void XYZControlSutter::StartMoveAbsolute(const double& _xabs, const double& _yabs, const double& _zabs) {
+	// Finish a previous move first, the controller does not accept commands while moving anyway
+	if ( movefuture.valid() )
+		movefuture.wait();
+
+	std::string cmd("m");
+	cmd.append(reinterpret_cast<char*>(Int32ToBytes(round2ui32(_xabs*microstepspermicron)).data()));
+	cmd.append(reinterpret_cast<char*>(Int32ToBytes(round2ui32(_yabs*microstepspermicron)).data()));
+	cmd.append(reinterpret_cast<char*>(Int32ToBytes(round2ui32(_zabs*microstepspermicron)).data()));
+	cmd.append("\r");
+
+	movefuture = std::async(std::launch::async, [this, cmd]() {
+		try {
+			sc->Command(cmd, 1);								// returns the CR when the move is complete
+		}
+		catch (...) { ScopeExceptionHandler(__FUNCTION__); }
+	});
+}
+
+bool XYZControlSutter::MotionComplete() {
+	if ( !movefuture.valid() )
+		return true;
+	if ( movefuture.wait_for(std::chrono::milliseconds(0)) != std::future_status::ready )
+		return false;
+	movefuture.get();
+	return true;
+}
+
 
 }
 
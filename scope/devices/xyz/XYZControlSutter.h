@@ -60,6 +60,12 @@ protected:
 	/** Sets movement velocity in micron/s, usually called once from Initialize */
 	void SetVelocity(const uint16_t& _vel);
 
+	/** the controller answers a move command only when the move is complete, StartMoveAbsolute waits for that answer in here */
+	std::future<void> movefuture;
+
+	/** Sends the move command from another thread and returns immediately */
+	void StartMoveAbsolute(const double& _xabs, const double& _yabs, const double& _zabs) override;
+
 public:
 	XYZControlSutter(void);
 
@@ -77,6 +83,9 @@ public:
 
 	void MoveAbsolute(const double& _xabs, const double& _yabs, const double& _zabs) override;
 
+	/** @return true if the controller answered the last move command started by StartMoveAbsolute */
+	bool MotionComplete() override;
+
 };
 
 }
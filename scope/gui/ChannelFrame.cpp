@@ -7,6 +7,7 @@
 #include "helpers/Lut.h"
 #include "controllers/ScopeController.h"
 #include "controls/ScopeColorComboCtrl.h"
+#include "helpers/ScopeTrace.h"
 #include "resource.h"
 
 namespace scope {
@@ -76,8 +77,15 @@ namespace scope {
 			if ( (_multi->Linewidth() != overlay.Linewidth()) || (_multi->Lines() != overlay.Lines()) )
 				overlay.Resize(_multi->Lines(), _multi->Linewidth());
 
-			overlay.Create(_multi, channel_colors);
-			overlay.ToD2Bitmap(view.GetBitmap());
+			{
+				ScopeTraceSpan span("ScopeOverlay::Create", _multi->Area());
+				overlay.Create(_multi, channel_colors);
+			}
+			{
+				ScopeTraceSpan span("ScopeOverlay::ToD2Bitmap", _multi->Area());
+				overlay.ToD2Bitmap(view.GetBitmap());
+			}
+			ScopeTraceSpan span("CChannelView::Render", _multi->Area());
 			view.Render();
 
 			return true;
@@ -304,7 +312,7 @@ namespace scope {
 		void CChannelFrame::LayOverAndRender(config::MultiImageCPtrType const _multi) {
 			current_frame = _multi;
 			// More than 6 elements in queue -> just throw away what is coming now...
-			if ( ptq.Size() < 7 ) {
+			if ( Pending() < 7 ) {
 				Send(std::bind(&CChannelFrame::RunLayOverAndRender, this, std::placeholders::_1, current_frame));
 				Send(std::bind(&CChannelFrame::RunUpdateStatusbar, this, std::placeholders::_1, current_frame));
 			}
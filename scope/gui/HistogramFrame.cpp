@@ -3,6 +3,7 @@
 #include "helpers/ScopeMultiImage.h"
 #include "helpers/ScopeMultiImageResonanceSW.h"
 #include "controllers/ScopeController.h"
+#include "helpers/ScopeTrace.h"
 #include "resource.h"
 #include "parameters/Inputs.h"
 
@@ -140,10 +141,13 @@ namespace scope {
 		void CHistogramFrame::HistoGramAndRender(config::MultiImageCPtrType const _multi) {
 			framecount = _multi->GetImageNumber();
 			// More than 6 elements in queue -> just throw away what is coming now...
-			if ( ptq.Size() < 7 ) {
+			if ( Pending() < 7 ) {
 				Send([=](StopCondition* const sc) {
 					// This calls the actual histogram calculation
-					view.SetCurrentFrame(_multi, loghist);
+					{
+						ScopeTraceSpan span("CHistogramView::SetCurrentFrame", _multi->Area());
+						view.SetCurrentFrame(_multi, loghist);
+					}
 
 					// This causes a WM_PAINT message, and CHistogramView's OnPaint calls the D2 renderer
 					view.Invalidate(false);
@@ -64,5 +64,9 @@ namespace scope {
 			return std::wstring(buffer.begin(), buffer.end()-1);
 		}
 
+		size_t CLogFrame::GetLogTextLength() {
+			return view.GetWindowTextLength();
+		}
+
 	}
 }
\ No newline at end of file
@@ -44,6 +44,7 @@ namespace scope {
 			void AppendLogText(const std::wstring& _text);
 			void ReplaceLogText(const std::wstring& _text);
 			std::wstring GetLogText();
+			size_t GetLogTextLength();
 			/** @} */
 		};
 
@@ -135,6 +135,14 @@ namespace scope {
 						case ScannerVectorTypeHelper::ResonanceHopper:
 							scanpages[a] = std::make_unique<CFrameScanResonancePage>(a, allareas[a].get(), fpubuttons[a]);
 							break;
+						// Regions of interest, line scan paths, volumes and trajectories are set in the parameters file or presets, no dedicated pages yet
+						case ScannerVectorTypeHelper::MultiROI:
+						case ScannerVectorTypeHelper::LineStraight:
+						case ScannerVectorTypeHelper::Volume:
+						case ScannerVectorTypeHelper::Lissajous:
+						case ScannerVectorTypeHelper::Spiral:
+							scanpages[a] = std::make_unique<CNoScanBasePage>(a, allareas[a].get(), fpubuttons[a]);
+							break;
 						}
 				}
 				AddPage(*scanpages[a]);
@@ -5,6 +5,7 @@
 #include "StimulationSettingsPage.h"
 #include "MovementPage.h"
 #include "DAQmxPage.h"
+#include "SimulatedInputsPage.h"
 #include "FPGAPhotonCounterPage.h"
 #include "FPGADigitalDemultiplexerPage.h"
 #include "FPGAAnalogIntegratorPage.h"
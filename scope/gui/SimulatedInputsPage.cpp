@@ -0,0 +1,28 @@
+#include "stdafx.h"
+#include "SimulatedInputsPage.h"
+#include "parameters\Inputs.h"
+
+namespace scope {
+	namespace gui {
+
+CSimulatedInputsPage::CSimulatedInputsPage(parameters::InputsSimulated& _parameters)
+	: photonrate_edit(_parameters.photonrate, true, true)
+	, backgroundrate_edit(_parameters.backgroundrate, true, true)
+	, countsperphoton_edit(_parameters.countsperphoton, true, true)
+	, scannerlag_edit(_parameters.scannerlag, true, true)
+	, beads_edit(_parameters.beads, true, true)
+	, realtime_checkbox(_parameters.realtime, true, true) {
+}
+
+BOOL CSimulatedInputsPage::OnInitDialog(CWindow wndFocus, LPARAM lInitParam) {
+	photonrate_edit.AttachToDlgItem(GetDlgItem(IDC_PHOTONRATE_EDIT));
+	backgroundrate_edit.AttachToDlgItem(GetDlgItem(IDC_BACKGROUNDRATE_EDIT));
+	countsperphoton_edit.AttachToDlgItem(GetDlgItem(IDC_COUNTSPERPHOTON_EDIT));
+	scannerlag_edit.AttachToDlgItem(GetDlgItem(IDC_SCANNERLAG_EDIT));
+	beads_edit.AttachToDlgItem(GetDlgItem(IDC_BEADS_EDIT));
+	realtime_checkbox.AttachToDlgItem(GetDlgItem(IDC_REALTIME_CHECK));
+
+	return 0;
+}
+
+}}
@@ -0,0 +1,51 @@
+#pragma once
+
+#include "controls/ScopeEditCtrl.h"
+#include "controls/ScopeCheckBoxCtrl.h"
+#include "controllers/ScopeController.h"
+#include "resource.h"
+
+// Forward declaration
+namespace scope {
+	namespace parameters {
+		class InputsSimulated;
+	}
+}
+
+namespace scope {
+	namespace gui {
+
+/** Class for the simulated inputs property page */
+class CSimulatedInputsPage :
+	public CPropertyPageImpl<CSimulatedInputsPage> {
+
+protected:
+
+public:
+	enum { IDD = IDD_SIMULATEDINPUTS_PROPPAGE };
+
+	/** @name Controls for the simulation parameters
+	* @{ */
+	CScopeEditCtrl<double> photonrate_edit;
+	CScopeEditCtrl<double> backgroundrate_edit;
+	CScopeEditCtrl<double> countsperphoton_edit;
+	CScopeEditCtrl<double> scannerlag_edit;
+	CScopeEditCtrl<uint32_t> beads_edit;
+	CScopeCheckBoxCtrl realtime_checkbox;
+	/** @} */
+
+	/** Connect to the simulation parameters */
+	CSimulatedInputsPage(parameters::InputsSimulated& _parameters);
+
+	BEGIN_MSG_MAP(CSimulatedInputsPage)
+		MSG_WM_INITDIALOG(OnInitDialog);
+		REFLECT_NOTIFICATIONS()
+	END_MSG_MAP()
+
+	/** @name Called via Win32 messages
+	* @{ */
+	BOOL OnInitDialog(CWindow wndFocus, LPARAM lInitParam);
+	/** @} */
+};
+
+}}
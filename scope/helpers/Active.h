@@ -1,32 +1,64 @@
 #pragma once
 
 #include "SyncQueues.h"
+#include "ThreadPool.h"
 #include "helpers.h"
+#include "ScopeException.h"
 
 /** An active object implementation.
 * I got most of the stuff from Herb Sutters column in Dr. Dobbs: http://www.drdobbs.com/parallel/prefer-using-active-objects-instead-of-n/225700095 .\n
-* I did some pimping with packaged tasks and futures...
+* I did some pimping with packaged tasks and futures...\n
+* The worker functions do not run in an own thread but in a scope::Strand on the shared scope::ThreadPool, thus they are still executed one
+* after the other and in the order they were sent, but many mostly idle Actives (e.g. channel windows) do not need a thread each.
 * @ingroup HELPERS */
 template<class RT>
 class Active {
 
 public:
-	/** Type of the worker function to be executed in Active's thread.
+	/** Type of the worker function to be executed in Active's strand.
 	* It should monitor the StopCondition and return an RT if the StopCondition is true. */
 	typedef std::function<RT(StopCondition* const sc)> Command;
 
 protected:
+	/** One sent worker function together with the promise for its return value */
+	class Message
+		: public scope::StrandTask {
+
+	protected:
+		Active<RT>& active;
+		Command cmd;
+		std::promise<RT> promise;
+
+	public:
+		Message(Active<RT>& _active, const Command& _cmd)
+			: active(_active)
+			, cmd(_cmd) {
+		}
+
+		std::future<RT> GetFuture() { return promise.get_future(); }
+
+		/** Instead of running, sets a ScopeException as result */
+		void Reject(const char* _reason) {
+			promise.set_exception(std::make_exception_ptr(scope::ScopeException(_reason)));
+		}
+
+		void Run() override {
+			active.stop.Set(false);
+			try {
+				promise.set_value(cmd(&active.stop));
+			}
+			catch (...) { promise.set_exception(std::current_exception()); }
+		}
+	};
+
 	/** the abort signal */
 	StopCondition stop;
 
-	/** this is set to quit the worker thread */
-	bool done;
-
-	/** synchronized queue of worker functions/packaged tasks that are executed in the Active' thread (see lambda in constructor). */
-	SynchronizedQueue<std::function<void(StopCondition* const sc)>> ptq;
+	/** this is set after Quit, further worker functions are not executed */
+	std::atomic<bool> done;
 
-	/** a thread in which Run runs */
-	std::thread thread;
+	/** executes the worker functions serially on the shared thread pool */
+	scope::Strand strand;
 
 protected:
 	/** disable copy */
@@ -35,52 +67,46 @@ protected:
 	/** disable assignment */
 	void operator=(const Active&);
 
-protected:
-
 public:
-	/** The thread execution loop is created from a lambda */
 	Active()
 		: stop()
-		, done(false)
-		, ptq()
-		, thread([=]() {while ( !done ) {
-			stop.Set(false);
-			ptq.Dequeue()(&stop); }
-			DBOUT(L"Active::thread ended"); }) {
+		, done(false) {
 	}
 
 	~Active() {
 		Quit();
 	}
 
-	/** Sends a worker function/packaged task to the queue to be executed in the Active's thread
+	/** Sends a worker function/packaged task to the strand to be executed after all previously sent ones
 	* @param[in] _cmd The worker function/packaged task to be queued 
-	* @return the future for the return value of the worker function */
+	* @return the future for the return value of the worker function. After Quit the worker function is not executed, get() on the future
+	* then throws a ScopeException. */
 	std::future<RT> Send(const Command& _cmd) {
-		// make a shared_ptr to the promise (we need this since promise it non-copyable
-		auto p = std::make_shared<std::promise<RT>>();
-
-		// get the future of the promise to return it at the end
-		std::future<RT> ret = std::future<RT>(std::move(p->get_future()));
-
-		// the promise pointer is caught by the lambda, thus outlives the Send function
-		ptq.Enqueue([=](StopCondition* const sc) {
-			p->set_value(_cmd(sc));
-		});
-
+		// The message owns the promise, one allocation per message
+		Message* const msg = new Message(*this, _cmd);
+		std::unique_ptr<scope::StrandTask> task(msg);
+		std::future<RT> ret(msg->GetFuture());
+		// The strand checks for Quit under its lock, thus a Send racing with Quit is either executed before Quit returns or rejected
+		if ( done || !strand.Post(task) )
+			msg->Reject("Active: worker function sent after Quit");
 		return ret;
 	}
 
+	/** @return number of worker functions sent but not yet started */
+	size_t Pending() const {
+		return strand.Pending();
+	}
+
 	/** Aborts the currently executed worker function */
 	void AbortCurrent() {
 		stop.Set(true);
 	}
 
-	/** Send lambda with done=true to the worker, join the worker thread, and clear the packaged task queue */
+	/** Waits until all worker functions sent so far are done, further ones are not executed anymore */
 	void Quit() {
-		ptq.Enqueue( [=] (StopCondition* const sc)	{ done = true; DBOUT(L"Active::Quit enqueued\n");} );
-		if ( thread.joinable() )	// This is not unfallably safe, could get unjoinable right after if?!
-			thread.join();
+		done = true;
+		strand.Close();
+		strand.WaitIdle();
 		DBOUT(L"Active::Quitted\n");
 	}
 };
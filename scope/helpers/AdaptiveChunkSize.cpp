@@ -0,0 +1,78 @@
+#include "stdafx.h"
+#include "AdaptiveChunkSize.h"
+
+namespace scope {
+
+	InputBacklogStatistics::InputBacklogStatistics()
+		: last(0)
+		, max(0)
+		, sum(0)
+		, reads(0)
+		, chunksize(0)
+		, grown(0)
+		, shrunk(0) {
+	}
+
+	void InputBacklogStatistics::Reset() {
+		last = 0;
+		max = 0;
+		sum = 0;
+		reads = 0;
+		chunksize = 0;
+		grown = 0;
+		shrunk = 0;
+	}
+
+	void InputBacklogStatistics::Add(const uint32_t& _backlog) {
+		last = _backlog;
+		if ( _backlog > max )
+			max = _backlog;
+		sum += _backlog;
+		++reads;
+	}
+
+	double InputBacklogStatistics::Mean() const {
+		const uint64_t n = reads;
+		return (n == 0) ? 0.0 : static_cast<double>(sum) / n;
+	}
+
+	AdaptiveChunkSize::AdaptiveChunkSize(const uint32_t& _standard, const uint32_t& _minimum, const uint32_t& _maximum, const uint32_t& _granularity, const bool& _enabled)
+		: enabled(_enabled)
+		, granularity(std::max(1u, _granularity))
+		, minimum(std::max(granularity, (_minimum + granularity - 1) / granularity * granularity))
+		, maximum(std::max(minimum, _maximum / granularity * granularity))
+		, current(_standard)
+		, lowcount(0) {
+		if ( enabled )
+			current = Coerce(_standard);
+	}
+
+	uint32_t AdaptiveChunkSize::Coerce(const uint32_t& _size) const {
+		return std::min(maximum, std::max(minimum, _size / granularity * granularity));
+	}
+
+	int32_t AdaptiveChunkSize::Update(const int64_t& _backlog) {
+		if ( !enabled || (_backlog < 0) )
+			return 0;
+
+		// Falling behind, more than one chunk is waiting
+		if ( (_backlog > current) && (current < maximum) ) {
+			lowcount = 0;
+			current = Coerce(2 * current);
+			return 1;
+		}
+
+		// Keeping up easily
+		if ( (_backlog < current / 4) && (current > minimum) ) {
+			if ( ++lowcount >= shrinkafter ) {
+				lowcount = 0;
+				current = Coerce(current / 2);
+				return -1;
+			}
+		}
+		else
+			lowcount = 0;
+		return 0;
+	}
+
+}
@@ -0,0 +1,92 @@
+#pragma once
+
+namespace scope {
+
+	/** Statistics of the input backlog (samples per channel acquired by the device but not yet read) and of the read chunk size.
+	* Updated by DaqController after every read, may be read from other threads.
+	* @ingroup HELPERS */
+	struct InputBacklogStatistics {
+		/** backlog after the last read */
+		std::atomic<uint32_t> last;
+
+		/** maximum backlog since Reset */
+		std::atomic<uint32_t> max;
+
+		/** sum of the backlogs of all reads since Reset, for the mean */
+		std::atomic<uint64_t> sum;
+
+		/** number of reads since Reset */
+		std::atomic<uint64_t> reads;
+
+		/** current read chunk size (samples per channel) */
+		std::atomic<uint32_t> chunksize;
+
+		/** how often the chunk size was increased since Reset */
+		std::atomic<uint32_t> grown;
+
+		/** how often the chunk size was decreased since Reset */
+		std::atomic<uint32_t> shrunk;
+
+		InputBacklogStatistics();
+
+		/** Sets everything to zero */
+		void Reset();
+
+		/** Adds the backlog after one read */
+		void Add(const uint32_t& _backlog);
+
+		/** @return mean backlog per read since Reset */
+		double Mean() const;
+	};
+
+	/** Adapts the read chunk size to the input backlog. If more than one chunk is waiting in the device buffer after a read, reading falls
+	* behind and the chunk size is doubled (fewer, bigger reads for throughput). If the backlog stays below a quarter chunk for a while, the
+	* chunk size is halved (smaller chunks reach the display earlier). The chunk size always stays a multiple of the granularity (the
+	* oversampling factor, so that DaqChunk::Downsample works) and within the bounds.
+	* @ingroup HELPERS */
+	class AdaptiveChunkSize {
+
+	protected:
+		/** if false the chunk size stays constant */
+		const bool enabled;
+
+		/** chunk sizes are multiples of this */
+		const uint32_t granularity;
+
+		/** lower bound for the chunk size */
+		const uint32_t minimum;
+
+		/** upper bound for the chunk size */
+		const uint32_t maximum;
+
+		/** the current chunk size */
+		uint32_t current;
+
+		/** number of consecutive reads with low backlog */
+		uint32_t lowcount;
+
+		/** the chunk size is halved after that many consecutive reads with low backlog (hysteresis against oscillation) */
+		static const uint32_t shrinkafter = 16;
+
+	protected:
+		/** @return _size rounded down to a multiple of granularity and clamped to the bounds */
+		uint32_t Coerce(const uint32_t& _size) const;
+
+	public:
+		/** @param[in] _standard the initial chunk size (usually Inputs::StandardChunkSize)
+		* @param[in] _minimum lower bound
+		* @param[in] _maximum upper bound
+		* @param[in] _granularity chunk sizes are multiples of this
+		* @param[in] _enabled if false the chunk size stays at _standard */
+		AdaptiveChunkSize(const uint32_t& _standard, const uint32_t& _minimum, const uint32_t& _maximum, const uint32_t& _granularity, const bool& _enabled);
+
+		/** @return the current chunk size */
+		uint32_t Current() const { return current; }
+
+		/** Adapts the chunk size to the backlog after a read
+		* @param[in] _backlog samples per channel left in the device buffer after the last read, negative if the device cannot tell (then nothing changes)
+		* @return 1 if the chunk size was increased, -1 if decreased, 0 if unchanged */
+		int32_t Update(const int64_t& _backlog);
+	};
+
+}
@@ -0,0 +1,161 @@
+#include "stdafx.h"
+#include "DiagnosticLog.h"
+#include "controllers/ScopeLogger.h"
+
+namespace scope {
+
+	namespace {
+		/** how often the background thread drains the buffer */
+		const std::chrono::milliseconds draininterval(20);
+
+		/** names of the levels for the formatted output */
+		const char* const levelnames[] = { "trace", "debug", "info", "warning", "error" };
+	}
+
+	DiagnosticLog::DiagnosticLog()
+		: slots(new Slot[capacity])
+		, head(0)
+		, tail(0)
+		, dropped(0)
+		, reporteddropped(0)
+		, minlevel(static_cast<uint8_t>(DiagLevel::trace))
+		, epoch(std::chrono::high_resolution_clock::now())
+		, quit(false) {
+		GetLocalTime(&epochwallclock);
+		for ( uint64_t i = 0 ; i < capacity ; i++ )
+			slots[i].sequence.store(i, std::memory_order_relaxed);
+		drainer = std::thread(&DiagnosticLog::Run, this);
+	}
+
+	DiagnosticLog::~DiagnosticLog() {
+		Shutdown();
+	}
+
+	DiagnosticLog& DiagnosticLog::GetInstance() {
+		static DiagnosticLog instance;
+		return instance;
+	}
+
+	void DiagnosticLog::SetLevel(const DiagLevel& _level) {
+		minlevel = static_cast<uint8_t>(_level);
+	}
+
+	void DiagnosticLog::SetFilepath(const std::wstring& _folder) {
+		std::lock_guard<std::mutex> lock(filemutex);
+		if ( file.is_open() )
+			return;
+		file.open(_folder + L"\\diagnostics_" + GetCurrentDateString() + L"_" + GetCurrentTimeString(true) + L".txt");
+		if ( !file.is_open() )
+			ScopeLogger::GetInstance().Log(L"Unable to open the diagnostics file", log_warning);
+	}
+
+	void DiagnosticLog::Enqueue(const DiagRecord& _record) {
+		// Bounded multi-producer queue: a producer claims a position by advancing head, the sequence of the slot tells
+		// if the consumer is done with it (sequence == position) and when the record is completely written (sequence == position + 1)
+		uint64_t pos = head.load(std::memory_order_relaxed);
+		Slot* slot = nullptr;
+		for (;;) {
+			slot = &slots[pos & (capacity - 1)];
+			const uint64_t seq = slot->sequence.load(std::memory_order_acquire);
+			const int64_t diff = static_cast<int64_t>(seq) - static_cast<int64_t>(pos);
+			if ( diff == 0 ) {
+				if ( head.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed) )
+					break;
+			}
+			else if ( diff < 0 ) {
+				// Full, the consumer did not get this slot yet
+				dropped.fetch_add(1, std::memory_order_relaxed);
+				return;
+			}
+			else
+				pos = head.load(std::memory_order_relaxed);
+		}
+		slot->record = _record;
+		slot->sequence.store(pos + 1, std::memory_order_release);
+	}
+
+	bool DiagnosticLog::Pop(DiagRecord& _record) {
+		Slot& slot = slots[tail & (capacity - 1)];
+		if ( slot.sequence.load(std::memory_order_acquire) != tail + 1 )
+			return false;
+		_record = slot.record;
+		slot.sequence.store(tail + capacity, std::memory_order_release);
+		++tail;
+		return true;
+	}
+
+	std::string DiagnosticLog::Format(const DiagRecord& _record) const {
+		std::ostringstream line;
+
+		// Timestamp as wall clock time with microseconds
+		const uint64_t us = _record.time / 1000 + epochwallclock.wMilliseconds * 1000ull;
+		const uint64_t s = us / 1000000 + epochwallclock.wSecond + 60ull * (epochwallclock.wMinute + 60ull * epochwallclock.wHour);
+		line << std::setfill('0') << std::setw(2) << (s / 3600) % 24 << ":" << std::setw(2) << (s / 60) % 60 << ":" << std::setw(2) << s % 60
+			<< "." << std::setw(6) << us % 1000000 << std::setfill(' ');
+		line << " [" << levelnames[static_cast<size_t>(_record.level)] << "] " << _record.threadid << " ";
+
+		// Replace the placeholders one by one
+		size_t arg = 0;
+		for ( const char* c = _record.format ; *c != '\0' ; ++c ) {
+			if ( (c[0] == '{') && (c[1] == '}') && (arg < DiagRecord::maxarguments) ) {
+				const DiagArgument& a = _record.arguments[arg++];
+				switch ( a.type ) {
+				case DiagArgument::Type::signedint: line << a.i; break;
+				case DiagArgument::Type::unsignedint: line << a.u; break;
+				case DiagArgument::Type::floating: line << a.d; break;
+				case DiagArgument::Type::literal: line << a.s; break;
+				default: line << "{}";
+				}
+				++c;
+			}
+			else
+				line << *c;
+		}
+		return line.str();
+	}
+
+	void DiagnosticLog::Drain() {
+		DiagRecord record;
+		std::lock_guard<std::mutex> lock(filemutex);
+		while ( Pop(record) ) {
+			const std::string line(Format(record));
+			if ( file.is_open() )
+				file << line << "\n";
+			DBOUT(CA2W(line.c_str()));
+			if ( record.level >= DiagLevel::warning )
+				ScopeLogger::GetInstance().Log(std::wstring(CA2W(line.c_str())), (record.level == DiagLevel::error) ? log_error : log_warning);
+		}
+		const uint64_t drops = dropped;
+		if ( drops > reporteddropped ) {
+			std::ostringstream msg;
+			msg << "DiagnosticLog dropped " << drops - reporteddropped << " records, buffer full";
+			reporteddropped = drops;
+			if ( file.is_open() )
+				file << msg.str() << "\n";
+			DBOUT(CA2W(msg.str().c_str()));
+		}
+		if ( file.is_open() )
+			file.flush();
+	}
+
+	void DiagnosticLog::Run() {
+		while ( !quit ) {
+			{
+				std::unique_lock<std::mutex> lock(wakeupmutex);
+				wakeup.wait_for(lock, draininterval, [this]() { return quit.load(); });
+			}
+			Drain();
+		}
+	}
+
+	void DiagnosticLog::Shutdown() {
+		{
+			std::lock_guard<std::mutex> lock(wakeupmutex);
+			quit = true;
+		}
+		wakeup.notify_all();
+		if ( drainer.joinable() )
+			drainer.join();
+	}
+
+}
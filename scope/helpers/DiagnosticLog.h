@@ -0,0 +1,219 @@
+#pragma once
+
+/** @file DiagnosticLog.h Structured diagnostic logging for hot paths. Use the SCOPE_DIAG_... macros, e.g.
+* SCOPE_DIAG_DEBUG("DaqController::Run masterarea {} read {}", _masterarea, readsamples);\n
+* Levels below SCOPE_DIAG_MIN_LEVEL are removed at compile time (arguments are not even evaluated). The other calls copy the format
+* string pointer and up to four numeric arguments into a lock-free ring buffer, formatting happens later in a background thread. */
+
+/** Compile time minimum level of the SCOPE_DIAG_... macros (0 trace, 1 debug, 2 info, 3 warning, 4 error). Trace (per sample or
+* per pixel stuff) is only compiled into debug builds, per chunk diagnostics on debug level stay in release builds. */
+#ifndef SCOPE_DIAG_MIN_LEVEL
+#ifdef _DEBUG
+#define SCOPE_DIAG_MIN_LEVEL 0
+#else
+#define SCOPE_DIAG_MIN_LEVEL 1
+#endif
+#endif
+
+/** Logs a diagnostic record if _LEVEL passes the compile time and the runtime level. The first argument after _LEVEL is the format, a string
+* literal with {} placeholders, followed by the values. */
+#define SCOPE_DIAG(_LEVEL, ...) \
+	do { \
+		if ( (static_cast<int>(_LEVEL) >= SCOPE_DIAG_MIN_LEVEL) && scope::DiagnosticLog::GetInstance().IsEnabled(_LEVEL) ) \
+			scope::DiagnosticLog::GetInstance().Push(_LEVEL, __VA_ARGS__); \
+	} while ( false )
+
+#define SCOPE_DIAG_TRACE(...) SCOPE_DIAG(scope::DiagLevel::trace, __VA_ARGS__)
+#define SCOPE_DIAG_DEBUG(...) SCOPE_DIAG(scope::DiagLevel::debug, __VA_ARGS__)
+#define SCOPE_DIAG_INFO(...) SCOPE_DIAG(scope::DiagLevel::info, __VA_ARGS__)
+#define SCOPE_DIAG_WARNING(...) SCOPE_DIAG(scope::DiagLevel::warning, __VA_ARGS__)
+#define SCOPE_DIAG_ERROR(...) SCOPE_DIAG(scope::DiagLevel::error, __VA_ARGS__)
+
+namespace scope {
+
+	/** Levels of diagnostic records */
+	enum class DiagLevel : uint8_t {
+		trace = 0,
+		debug = 1,
+		info = 2,
+		warning = 3,
+		error = 4
+	};
+
+	/** One argument of a diagnostic record, stored binary and formatted later
+	* @ingroup HELPERS */
+	struct DiagArgument {
+		/** the type of the stored value */
+		enum class Type : uint8_t { none, signedint, unsignedint, floating, literal } type;
+
+		union {
+			int64_t i;
+			uint64_t u;
+			double d;
+			/** has to be a string literal or otherwise outlive the record */
+			const char* s;
+		};
+
+		DiagArgument() : type(Type::none), u(0) {}
+
+		/** from any signed integral type */
+		template<class T, typename std::enable_if<std::is_integral<T>::value && std::is_signed<T>::value, int>::type = 0>
+		DiagArgument(const T& _v) : type(Type::signedint), i(_v) {}
+
+		/** from any unsigned integral type (and bool) */
+		template<class T, typename std::enable_if<std::is_integral<T>::value && std::is_unsigned<T>::value, int>::type = 0>
+		DiagArgument(const T& _v) : type(Type::unsignedint), u(_v) {}
+
+		/** from any floating point type */
+		template<class T, typename std::enable_if<std::is_floating_point<T>::value, int>::type = 0>
+		DiagArgument(const T& _v) : type(Type::floating), d(_v) {}
+
+		/** from a string literal */
+		DiagArgument(const char* _v) : type(Type::literal), s(_v) {}
+	};
+
+	/** One diagnostic record, fixed size and trivially copyable
+	* @ingroup HELPERS */
+	struct DiagRecord {
+		/** maximum number of arguments per record */
+		static const size_t maxarguments = 4;
+
+		/** time since the log was created in nanoseconds */
+		uint64_t time;
+
+		/** the format string, has to be a string literal (only the pointer is stored) */
+		const char* format;
+
+		/** id of the logging thread */
+		uint32_t threadid;
+
+		/** the level */
+		DiagLevel level;
+
+		/** the arguments */
+		std::array<DiagArgument, maxarguments> arguments;
+	};
+
+	/** Structured, levelled diagnostic logging with deferred formatting. Records go into a bounded lock-free multi-producer ring buffer,
+	* a background thread drains it every few milliseconds, formats the records and writes them to the diagnostics file and the debug console.
+	* Records on warning and error level are also passed on to the ScopeLogger. If the buffer is full, records are dropped and counted
+	* (logging must never block acquisition).
+	* @ingroup HELPERS */
+	class DiagnosticLog {
+
+	protected:
+		/** one slot of the ring buffer, sequence tells producers and the consumer whose turn it is */
+		struct Slot {
+			std::atomic<uint64_t> sequence;
+			DiagRecord record;
+		};
+
+		/** number of slots, a power of two */
+		static const uint64_t capacity = 16384;
+
+		/** the ring buffer */
+		std::unique_ptr<Slot[]> slots;
+
+		/** next position to write to */
+		std::atomic<uint64_t> head;
+
+		/** next position to read from (only touched by the background thread) */
+		uint64_t tail;
+
+		/** number of records dropped because the buffer was full */
+		std::atomic<uint64_t> dropped;
+
+		/** dropped records already reported in the output (only touched by the background thread) */
+		uint64_t reporteddropped;
+
+		/** runtime minimum level */
+		std::atomic<uint8_t> minlevel;
+
+		/** time point all record times are relative to */
+		const std::chrono::high_resolution_clock::time_point epoch;
+
+		/** wall clock time at epoch, for the printed timestamps */
+		SYSTEMTIME epochwallclock;
+
+		/** protects file */
+		std::mutex filemutex;
+
+		/** the diagnostics file */
+		std::ofstream file;
+
+		/** signals the background thread to drain and quit */
+		std::atomic<bool> quit;
+
+		/** to wake up the background thread early */
+		std::condition_variable wakeup;
+
+		/** mutex for wakeup */
+		std::mutex wakeupmutex;
+
+		/** the background thread draining and formatting */
+		std::thread drainer;
+
+		DiagnosticLog();
+
+		/** Takes the oldest record from the buffer (background thread only)
+		* @return false if the buffer is empty */
+		bool Pop(DiagRecord& _record);
+
+		/** Formats one record into a line */
+		std::string Format(const DiagRecord& _record) const;
+
+		/** Drains the buffer and writes the formatted records */
+		void Drain();
+
+		/** Loop of the background thread */
+		void Run();
+
+		/** Copies the record into the buffer or drops it if full */
+		void Enqueue(const DiagRecord& _record);
+
+	public:
+		/** disable copy */
+		DiagnosticLog(const DiagnosticLog&) = delete;
+
+		/** disable assignment */
+		DiagnosticLog& operator=(const DiagnosticLog&) = delete;
+
+		~DiagnosticLog();
+
+		static DiagnosticLog& GetInstance();
+
+		/** @return true if records of _level are logged at runtime */
+		bool IsEnabled(const DiagLevel& _level) const { return static_cast<uint8_t>(_level) >= minlevel.load(std::memory_order_relaxed); }
+
+		/** Sets the runtime minimum level (the compile time SCOPE_DIAG_MIN_LEVEL still applies) */
+		void SetLevel(const DiagLevel& _level);
+
+		/** Opens the diagnostics file diagnostics_date_time.txt in the folder
+		* @param[in] _folder the folder for the file */
+		void SetFilepath(const std::wstring& _folder);
+
+		/** Logs a record, use the SCOPE_DIAG_... macros instead of calling this directly
+		* @param[in] _level the level of the record
+		* @param[in] _format a string literal with one {} placeholder for every argument
+		* @param[in] _args up to DiagRecord::maxarguments integral, floating point, bool or string literal arguments */
+		template<class... Args>
+		void Push(const DiagLevel& _level, const char* _format, const Args&... _args) {
+			static_assert(sizeof...(Args) <= DiagRecord::maxarguments, "Too many arguments for a diagnostic record");
+			DiagRecord record;
+			record.time = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::high_resolution_clock::now() - epoch).count();
+			record.format = _format;
+			record.threadid = GetCurrentThreadId();
+			record.level = _level;
+			const DiagArgument arguments[] = { DiagArgument(), DiagArgument(_args)... };
+			std::copy(std::begin(arguments) + 1, std::end(arguments), std::begin(record.arguments));
+			Enqueue(record);
+		}
+
+		/** @return number of records dropped so far because the buffer was full */
+		uint64_t Dropped() const { return dropped; }
+
+		/** Drains the remaining records and stops the background thread, called from Run in scope.cpp before the ScopeLogger shuts down */
+		void Shutdown();
+	};
+
+}
@@ -36,7 +36,7 @@ std::vector<ScannerVectorTypeHelper::Mode> ScannerSupportedVectors::List(const c
 	switch (_scannertype) {
 		default:
 		case config::ScannerEnum::RegularGalvo:
-			{ ScannerVectorTypeHelper::Mode ret[] = {ScannerVectorTypeHelper::Mode::Sawtooth, ScannerVectorTypeHelper::Mode::Bidirectional };
+			{ ScannerVectorTypeHelper::Mode ret[] = {ScannerVectorTypeHelper::Mode::Sawtooth, ScannerVectorTypeHelper::Mode::Bidirectional, ScannerVectorTypeHelper::Mode::Planehopper, ScannerVectorTypeHelper::Mode::MultiROI, ScannerVectorTypeHelper::Mode::LineStraight, ScannerVectorTypeHelper::Mode::Volume, ScannerVectorTypeHelper::Mode::Lissajous, ScannerVectorTypeHelper::Mode::Spiral };
 			return std::vector<ScannerVectorTypeHelper::Mode>(ret, ret + sizeof(ret) / sizeof(ret[0]) ); }
 		case config::ScannerEnum::ResonantGalvo:
 			{ ScannerVectorTypeHelper::Mode ret[] = {ScannerVectorTypeHelper::Mode::ResonanceBiDi, ScannerVectorTypeHelper::Mode::ResonanceHopper };
@@ -12,7 +12,11 @@ namespace scope {
 		class ScannerVectorFramePlaneHopper;
 		class ScannerVectorFrameResonance;
 		class ScannerVectorFrameResonanceHopper;
+		class ScannerVectorFrameMultiROI;
 		class ScannerVectorLine;
+		class ScannerVectorFrameVolume;
+		class ScannerVectorLissajous;
+		class ScannerVectorSpiral;
 	}
 }
 
@@ -323,11 +327,15 @@ namespace scope {
 				Planehopper,
 				LineStraight,
 				ResonanceBiDi,
-				ResonanceHopper
+				ResonanceHopper,
+				MultiROI,
+				Volume,
+				Lissajous,
+				Spiral
 			};
 
 			/** Number of enumerators */
-			static const uint32_t S = 7;
+			static const uint32_t S = 11;
 
 			/** @return name of enumerator */
 			static std::wstring NameOf(const uint32_t& _n) {
@@ -338,7 +346,11 @@ namespace scope {
 					, L"Planehopper"
 					, L"LineStraight"
 					, L"ResonanceBiDi"
-					, L"ResonanceHopper" };
+					, L"ResonanceHopper"
+					, L"MultiROI"
+					, L"Volume"
+					, L"Lissajous"
+					, L"Spiral" };
 				return names[_n];
 			}
 	};
@@ -379,12 +391,36 @@ namespace scope {
 		typedef parameters::ScannerVectorFrameResonanceHopper type;
 	};
 
+	template<>
+	class ScannerVectorTypeSelector<ScannerVectorTypeHelper::Mode::MultiROI> {
+	public:
+		typedef parameters::ScannerVectorFrameMultiROI type;
+	};
+
 	template<>
 	class ScannerVectorTypeSelector<ScannerVectorTypeHelper::Mode::LineStraight> {
 	public:
 		typedef parameters::ScannerVectorLine type;
 	};
 
+	template<>
+	class ScannerVectorTypeSelector<ScannerVectorTypeHelper::Mode::Volume> {
+	public:
+		typedef parameters::ScannerVectorFrameVolume type;
+	};
+
+	template<>
+	class ScannerVectorTypeSelector<ScannerVectorTypeHelper::Mode::Lissajous> {
+	public:
+		typedef parameters::ScannerVectorLissajous type;
+	};
+
+	template<>
+	class ScannerVectorTypeSelector<ScannerVectorTypeHelper::Mode::Spiral> {
+	public:
+		typedef parameters::ScannerVectorSpiral type;
+	};
+
 	/** Describes the scanner vector type */
 	typedef ScopeDatatypeBase<ScannerVectorTypeHelper> ScannerVectorType;
 
@@ -34,9 +34,9 @@ void ScopeHistogram::Calculate(ScopeImageU16CPtr const _img, const bool& _loghis
 	const uint16_t high(range);
 
 	// Do the histogram
-	// With const we have shared access to the image data, good for parallelism...
+	// With a snapshot we do not block the pixelmapper, good for parallelism...
 	{
-	ScopeImageConstAccessU16 imagedata(*_img);
+	ScopeImageSnapshotU16 imagedata(*_img);
 	std::for_each(std::begin(*imagedata.GetConstData()), std::end(*imagedata.GetConstData()), [&](const uint16_t& val) {
 		// The static_cast<size_t> does floor double -> fill in the lowest bin
 		if ( (val >= low) && (val <= high) )
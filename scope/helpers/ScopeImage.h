@@ -13,12 +13,17 @@ namespace scope {
 	template<class T>
 	class ScopeImageConstAccess;
 
+	template<class T>
+	class ScopeImageSnapshot;
+
 	/** A general image class.
 	* Templatized for data type, in Scope usually uint16_t. Data is in one vector data order is linewise:\n
 	* 1234\n
 	* 5678\n
 	* 9...\n
-	* The can only be accessed via ScopeImageAccess and ScopeImageConstAccess. */
+	* The can only be accessed via ScopeImageAccess, ScopeImageConstAccess and ScopeImageSnapshot.\n
+	* Writers take pixelmutex exclusively, const readers take it shared. Readers that only need the last complete state (display, histogram)
+	* should use ScopeImageSnapshot, which never holds a lock after construction and thus never blocks the pixel mapping. */
 	template<class T>
 	class ScopeImage {
 			/** give accessor classes friend access to the data */
@@ -27,6 +32,9 @@ namespace scope {
 			/** give accessor classes friend access to the data */
 			friend ScopeImageConstAccess<T>;
 
+			/** give accessor classes friend access to the data */
+			friend ScopeImageSnapshot<T>;
+
 		public:
 			/** pair of two iterators over the data vector */
 			typedef std::pair<typename std::vector<T>::iterator, typename std::vector<T>::iterator> datapart_t;
@@ -65,14 +73,20 @@ namespace scope {
 			/** range of freshly inserted pixels */
 			datapart_t newpart;
 
-			/** mutex for protection of pixel operations */
-			mutable std::mutex pixelmutex;
+			/** mutex for protection of pixel operations, exclusive for writing, shared for reading */
+			mutable std::shared_timed_mutex pixelmutex;
+
+			/** incremented after every write access to the pixel data */
+			std::atomic<uint64_t> version;
+
+			/** last published copy of the pixel data, handed out by ScopeImageSnapshot */
+			mutable std::shared_ptr<const std::vector<T>> snapshot;
 
-			/** >0 if someone got a pointer to the const datavector */
-			mutable std::atomic<int16_t> reading_access;
+			/** version of the data in snapshot */
+			mutable uint64_t snapshotversion;
 
-			/** condition variable for read access */
-			mutable std::condition_variable readcond;
+			/** protects snapshot and snapshotversion */
+			mutable std::mutex snapshotmutex;
 
 		public:
 			/** Initialize with zeros */
@@ -86,7 +100,8 @@ namespace scope {
 				, data(_lines*_linewidth, T(0))
 				, inserter(data.begin())
 				, newpart(data.begin(), data.begin())
-				, reading_access(0) {
+				, version(0)
+				, snapshotversion(0) {
 			}
 
 			/** Safe copy. Inserter and newpart are not  copied! */
@@ -97,7 +112,8 @@ namespace scope {
 				, complete_frame(_si.complete_frame)
 				, percent_complete(_si.percent_complete)
 				, complete_avg(_si.complete_avg)
-				, reading_access(0) {
+				, version(0)
+				, snapshotversion(0) {
 				ScopeImageConstAccess<T> acc(_si);
 				data = *acc.GetConstData();
 				inserter = data.begin();
@@ -114,10 +130,12 @@ namespace scope {
 					complete_frame = _si.complete_frame;
 					percent_complete = _si.percent_complete;
 					complete_avg = _si.complete_avg;
-					ScopeImageAccess<T> acc(_si);
-					data = *acc.GetData();
+					ScopeImageConstAccess<T> acc(_si);
+					std::lock_guard<std::shared_timed_mutex> lock(pixelmutex);
+					data = *acc.GetConstData();
 					inserter = data.begin();
 					newpart = datapart_t(data.begin(), data.begin());
+					++version;
 				}
 				return *this;
 			}
@@ -146,44 +164,64 @@ namespace scope {
 				return acc.GetConstData()->at(_line * linewidth + _column);
 			}
 
+			/** @return number of write accesses so far, changes whenever the pixel data may have changed */
+			uint64_t Version() const { return version; }
+
 			/** Fills the complete image with random pixel data */
 			void FillRandom() {
-				std::lock_guard<std::mutex> lock(pixelmutex);
+				std::lock_guard<std::shared_timed_mutex> lock(pixelmutex);
 				std::mt19937 mt;
 				mt.seed(static_cast<unsigned long>(GetTickCount64()));
 				std::generate( std::begin(data), std::end(data), mt);
 				newpart = std::make_pair(data.begin(), data.end());
+				++version;
 			}
 
 		protected:
 			/** @return a pointer to the pixel vector
-			* @post pixelmutex is locked */
+			* @post pixelmutex is locked exclusively */
 			std::vector<T>* GetData() {
-				std::unique_lock<std::mutex> lock(pixelmutex);
-				while ( reading_access > 0 )
-					readcond.wait(lock);
-				lock.release();			// mutex stays locked
+				pixelmutex.lock();				// waits until all readers are finished
 				return &data;
 			}
 
-			/** @return a const pointer to the pixel vector. Increase reading_access counter */
+			/** @return a const pointer to the pixel vector
+			* @post pixelmutex is locked shared */
 			const std::vector<T>* GetDataConst() const {
-				pixelmutex.lock();				// waits until a write access is finished
-				reading_access++;
-				pixelmutex.unlock();
+				pixelmutex.lock_shared();		// waits until a write access is finished
 				return &data;
 			}
 
-			/** @post pixelmutex is released from lock */
+			/** Increases the version counter.
+			* @post pixelmutex is released from exclusive lock */
 			void ReleaseData() {
+				++version;
 				pixelmutex.unlock();
 			}
 
-			/** Decreases reading_access counter. Notifies waiting threads. */
+			/** @post pixelmutex is released from shared lock */
 			void ReleaseDataConst() const {
-				assert(reading_access > 0);
-				reading_access--;
-				readcond.notify_all();
+				pixelmutex.unlock_shared();
+			}
+
+			/** @return the last published copy of the pixel data. Makes a new copy if the data changed since the last snapshot.
+			* The copy is done blockwise, pixelmutex is only held shared for one block at a time. Thus a writer waits at most for the copy of one
+			* block, at the price of a possibly torn snapshot (some blocks from before, some from after a write), which is fine for display purposes. */
+			std::shared_ptr<const std::vector<T>> GetSnapshot() const {
+				const size_t blocksize = 16384;
+				std::lock_guard<std::mutex> lock(snapshotmutex);
+				const uint64_t current = version;
+				if ( snapshot && (snapshotversion == current) )
+					return snapshot;
+				auto copy = std::make_shared<std::vector<T>>(data.size());
+				for ( size_t pos = 0 ; pos < data.size() ; pos += blocksize ) {
+					std::shared_lock<std::shared_timed_mutex> readlock(pixelmutex);
+					const size_t n = std::min(blocksize, data.size() - pos);
+					std::copy(std::begin(data) + pos, std::begin(data) + pos + n, std::begin(*copy) + pos);
+				}
+				snapshotversion = current;
+				snapshot = copy;
+				return snapshot;
 			}
 	};
 
@@ -220,8 +258,8 @@ namespace scope {
 			}
 	};
 
-	/** Gives RAII safe const access (read-only) to the pixeldata of a ScopeImage. A reading access counter is increased on construction and decreased on destruction of
-	the ScopeImageConstAccess object. This allows concurrent read access. */
+	/** Gives RAII safe const access (read-only) to the pixeldata of a ScopeImage. ScopeImage pixelmutex is locked shared on construction and unlocked on destruction of
+	the ScopeImageConstAccess object. This allows concurrent read access but blocks writers for the lifetime of the object. */
 	template<class T>
 	class ScopeImageConstAccess {
 		protected:
@@ -231,7 +269,7 @@ namespace scope {
 			const std::vector<T>* const pData;
 
 		public:
-			/** Get the data, locks mutex inside ScopeImage */
+			/** Get the data, locks mutex inside ScopeImage shared */
 			ScopeImageConstAccess(const ScopeImage<T>& _image)
 				: image(&_image)
 				, pData(image->GetDataConst()) {
@@ -248,6 +286,26 @@ namespace scope {
 			}
 	};
 
+	/** Gives read-only access to an immutable copy of the pixeldata of a ScopeImage. No lock is held after construction, thus a
+	* ScopeImageSnapshot never blocks a writer (e.g. the pixelmapper). The copy is shared between all snapshots of the same image version. */
+	template<class T>
+	class ScopeImageSnapshot {
+		protected:
+			/** the copy of the ScopeImage's data vector */
+			const std::shared_ptr<const std::vector<T>> pData;
+
+		public:
+			/** Get the last published copy of the data */
+			ScopeImageSnapshot(const ScopeImage<T>& _image)
+				: pData(_image.GetSnapshot()) {
+			}
+
+			/** @return the data pointer */
+			const std::vector<T>* GetConstData() const {
+				return pData.get();
+			}
+	};
+
 	/** shared pointer to a ScopeImage of 16 bit values */
 	typedef std::shared_ptr<ScopeImage<uint16_t>> ScopeImageU16Ptr;
 	/** shared pointer to a const ScopeImage of 16 bit values */
@@ -256,6 +314,8 @@ namespace scope {
 	typedef ScopeImageAccess<uint16_t> ScopeImageAccessU16;
 	/** ScopeImageConstAccess to a ScopeImage of 16 bit values */
 	typedef ScopeImageConstAccess<uint16_t> ScopeImageConstAccessU16;
+	/** ScopeImageSnapshot of a ScopeImage of 16 bit values */
+	typedef ScopeImageSnapshot<uint16_t> ScopeImageSnapshotU16;
 
 	/** Helper function to insert a pixel range into a ScopeImage
 	* Inserts a pixel range from a DaqChunk into the image (replaces existing pixel values)
@@ -0,0 +1,64 @@
+#include "stdafx.h"
+#include "ScopeImageBenchmark.h"
+
+namespace scope {
+
+ScopeImageContentionResult ScopeImageContentionBenchmark(const ScopeImageReadMode& _mode, const uint32_t& _lines, const uint32_t& _linewidth
+	, const uint32_t& _chunksize, const uint32_t& _readers, const uint32_t& _duration) {
+	typedef std::chrono::high_resolution_clock clock;
+	ScopeImage<uint16_t> image(_lines, _linewidth);
+	std::atomic<bool> stop(false);
+	std::atomic<uint64_t> reads(0);
+
+	// Readers do something similar to ScopeOverlay::Create, i.e. one transform over the whole image
+	auto reader = [&]() {
+		std::vector<uint32_t> overlay(_lines*_linewidth, 0);
+		while ( !stop ) {
+			if ( _mode == ScopeImageReadMode::ConstAccess ) {
+				ScopeImageConstAccessU16 imagedata(image);
+				std::transform(std::begin(*imagedata.GetConstData()), std::end(*imagedata.GetConstData()), std::begin(overlay), [](const uint16_t& gray) {
+					return static_cast<uint32_t>(gray) * 0x00010101u | 0xff000000u; } );
+			}
+			else {
+				ScopeImageSnapshotU16 imagedata(image);
+				std::transform(std::begin(*imagedata.GetConstData()), std::end(*imagedata.GetConstData()), std::begin(overlay), [](const uint16_t& gray) {
+					return static_cast<uint32_t>(gray) * 0x00010101u | 0xff000000u; } );
+			}
+			reads++;
+			std::this_thread::sleep_for(std::chrono::milliseconds(1));		// the display does not redraw continuously either
+		}
+	};
+
+	std::vector<std::thread> readers;
+	for ( uint32_t r = 0 ; r < _readers ; r++ )
+		readers.emplace_back(reader);
+
+	// The writer inserts chunks like the pixelmapper does
+	ScopeImageContentionResult result;
+	std::vector<uint16_t> chunk(_chunksize, 0);
+	size_t position = 0;
+	double sumwait = 0;
+	const auto end = clock::now() + std::chrono::milliseconds(_duration);
+	while ( clock::now() < end ) {
+		std::fill(std::begin(chunk), std::end(chunk), static_cast<uint16_t>(result.chunks));
+		const auto before = clock::now();
+		ScopeImageAccessU16 imagedata(image);
+		const double wait = std::chrono::duration<double, std::micro>(clock::now() - before).count();
+		sumwait += wait;
+		result.maxwait = std::max(result.maxwait, wait);
+		const size_t n = std::min<size_t>(_chunksize, imagedata.GetData()->size() - position);
+		std::copy(std::begin(chunk), std::begin(chunk) + n, std::begin(*imagedata.GetData()) + position);
+		position = (position + n) % imagedata.GetData()->size();
+		result.chunks++;
+	}
+
+	stop = true;
+	for ( auto& r : readers )
+		r.join();
+
+	result.reads = reads;
+	result.meanwait = (result.chunks > 0) ? sumwait / result.chunks : 0;
+	return result;
+}
+
+}
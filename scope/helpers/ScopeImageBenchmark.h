@@ -0,0 +1,41 @@
+#pragma once
+
+#include "ScopeImage.h"
+
+namespace scope {
+
+	/** How the reader threads of the contention benchmark access the image */
+	enum class ScopeImageReadMode {
+		ConstAccess,		///< ScopeImageConstAccess, holds the shared lock while reading (like ScopeOverlay::Create did before)
+		Snapshot			///< ScopeImageSnapshot, holds no lock while reading
+	};
+
+	/** Result of a ScopeImage contention benchmark run */
+	struct ScopeImageContentionResult {
+		/** number of chunks the writer inserted */
+		uint64_t chunks;
+
+		/** number of complete passes over the image by all readers */
+		uint64_t reads;
+
+		/** mean time the writer waited for write access (microseconds) */
+		double meanwait;
+
+		/** maximum time the writer waited for write access (microseconds) */
+		double maxwait;
+
+		ScopeImageContentionResult() : chunks(0), reads(0), meanwait(0), maxwait(0) { }
+	};
+
+	/** Reproduces the contention between the pixelmapper (one writer inserting chunks as fast as possible) and
+	* the display (readers doing an overlay-like pass over the whole image). Measures how long the writer has to wait for access.
+	* @param[in] _mode how the readers access the image
+	* @param[in] _lines,_linewidth size of the image
+	* @param[in] _chunksize number of pixels the writer inserts per access
+	* @param[in] _readers number of concurrent reader threads
+	* @param[in] _duration run time of the benchmark in milliseconds
+	* @ingroup HELPERS */
+	ScopeImageContentionResult ScopeImageContentionBenchmark(const ScopeImageReadMode& _mode, const uint32_t& _lines = 1024, const uint32_t& _linewidth = 1024
+		, const uint32_t& _chunksize = 128*128, const uint32_t& _readers = 2, const uint32_t& _duration = 2000);
+
+}
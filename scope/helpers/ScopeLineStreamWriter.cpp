@@ -0,0 +1,42 @@
+#include "StdAfx.h"
+#include "ScopeLineStreamWriter.h"
+#include "ScopeImage.h"
+#include "ScopeException.h"
+
+namespace scope {
+
+ScopeLineStreamWriter::ScopeLineStreamWriter(const bool& _dosave, const uint32_t& _channels)
+	: dosave(_dosave)
+	, channels(_channels)
+	, linecount(0)
+	, files(_channels) {
+}
+
+void ScopeLineStreamWriter::Initialize(const std::vector<std::wstring>& _filenames) {
+	if ( dosave ) {
+		assert(_filenames.size() == channels);
+		for ( size_t c = 0 ; c < channels ; c++ ) {
+			files[c].open(_filenames[c], std::ios::out | std::ios::binary | std::ios::trunc);
+			if ( !files[c].is_open() )
+				throw ScopeException("ScopeLineStreamWriter could not open the line stream file");
+		}
+	}
+}
+
+void ScopeLineStreamWriter::WriteLines(ScopeMultiImagePtr const _multiimage) {
+	assert(_multiimage->IsCompleteAvg());
+	if ( dosave ) {
+		assert(channels == _multiimage->Channels());
+		for ( size_t c = 0 ; c < channels ; c++ ) {
+			// The image is stored linewise, thus the whole data vector is the lines in the order they were scanned
+			ScopeImageConstAccessU16 imagedata(*_multiimage->GetChannel(c));
+			const std::vector<uint16_t>* const data = imagedata.GetConstData();
+			files[c].write(reinterpret_cast<const char*>(data->data()), data->size() * sizeof(uint16_t));
+			if ( !files[c] )
+				throw ScopeException("ScopeLineStreamWriter could not write to the line stream file");
+		}
+	}
+	linecount += _multiimage->Lines();
+}
+
+}
@@ -0,0 +1,48 @@
+#pragma once
+#include "ScopeMultiImage.h"
+
+namespace scope {
+
+/** Writes the lines of line scan frames (kymographs) into one continuous raw stream per channel (16 bit unsigned, little endian, no
+* header). Consecutive line scan frames follow each other without a gap, thus the files contain all scanned lines in order, e.g. for
+* ImageJ File > Import > Raw with width xres and height Linecount. */
+class ScopeLineStreamWriter {
+
+protected:
+	/** do we actually save (true) or only count the lines (false) */
+	const bool dosave;
+
+	/** how many channels to write */
+	const uint32_t channels;
+
+	/** keeping track of how many lines we wrote */
+	uint64_t linecount;
+
+	/** a file for each channel */
+	std::vector<std::ofstream> files;
+
+public:
+	/** disable copy */
+	ScopeLineStreamWriter(const ScopeLineStreamWriter&) = delete;
+
+	/** disable assignment */
+	ScopeLineStreamWriter& operator=(const ScopeLineStreamWriter&) = delete;
+
+	/** @param[in] _dosave if false lines are not actually saved only counted
+	* @param[in] _channels number of channels for saving */
+	ScopeLineStreamWriter(const bool& _dosave, const uint32_t& _channels);
+
+	/** Opens the files
+	* @param[in] _filenames vector with filenames for each channel (since each channel will be written to a separate file) */
+	void Initialize(const std::vector<std::wstring>& _filenames);
+
+	/** Appends all lines of a multi image to the streams. Only complete (averaged) frames may be written, otherwise lines of the previous
+	* frame would be streamed a second time. PipelineController enqueues frames for storage only when they are complete.
+	* @param[in] _multiimage the multi image whose lines to write to disk */
+	void WriteLines(ScopeMultiImagePtr const _multiimage);
+
+	/** @return number of lines written per channel */
+	uint64_t Linecount() const { return linecount; }
+};
+
+}
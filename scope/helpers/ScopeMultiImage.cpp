@@ -14,6 +14,7 @@ ScopeMultiImage::ScopeMultiImage(const uint32_t& _area, const size_t& _nochannel
 	, avg_max(1)
 	, complete_avg(false)
 	, imagenumber(0)
+	, plane(0)
 	, complete_frame(false)
 	, percent_complete(0.0) {
 	// Generate the (blank) images for each channel
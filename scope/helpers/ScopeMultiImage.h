@@ -39,6 +39,9 @@ protected:
 	/** number of this image */
 	uint32_t imagenumber;
 
+	/** plane of a multi plane scan (e.g. plane hopping) this image belongs to */
+	uint32_t plane;
+
 	/** false if frame not complete, allows for partial display during acquisition */
 	bool complete_frame;
 
@@ -77,6 +80,8 @@ public:
 
 	uint32_t GetImageNumber() const { return imagenumber; }
 
+	uint32_t Plane() const { return plane; }
+
 	bool IsCompleteFrame() const { return complete_frame; }
 
 	bool IsCompleteAvg() const { return complete_avg; }
@@ -101,6 +106,9 @@ public:
 	/** Sets the number of this image */
 	void SetImageNumber(const uint32_t& _imagenumber) { imagenumber = _imagenumber; }
 
+	/** Sets the plane of this image */
+	void SetPlane(const uint32_t& _plane) { plane = _plane; }
+
 	/** Sets frame complete */
 	void SetCompleteFrame(const bool& _complete);
 
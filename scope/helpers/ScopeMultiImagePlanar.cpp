@@ -0,0 +1,186 @@
+#include "stdafx.h"
+#include "ScopeMultiImagePlanar.h"
+#include "ScopeMultiImage.h"
+#include "ScopeImage.h"
+
+namespace scope {
+
+namespace {
+	/** number of uint16_t pixels in one alignment block */
+	const size_t pixelsperblock = ScopeMultiImagePlanar::alignment / sizeof(uint16_t);
+
+	/** @return _n rounded up to a multiple of pixelsperblock */
+	size_t RoundUpToBlock(const size_t& _n) {
+		return (_n + pixelsperblock - 1) / pixelsperblock * pixelsperblock;
+	}
+}
+
+ScopeMultiImagePlanar::ScopeMultiImagePlanar(const uint32_t& _area, const size_t& _nochannels, const uint32_t& _lines, const uint32_t& _linewidth, const bool& _padrows)
+	: area(_area)
+	, nochannels(_nochannels)
+	, lines(_lines)
+	, linewidth(_linewidth)
+	, stride(_padrows?static_cast<uint32_t>(RoundUpToBlock(_linewidth)):_linewidth)
+	, planesize(RoundUpToBlock(static_cast<size_t>(stride)*_lines))
+	, data(static_cast<uint16_t*>(_aligned_malloc(_nochannels*planesize*sizeof(uint16_t), alignment)))
+	, avg_count(0)
+	, avg_max(1)
+	, complete_avg(false)
+	, imagenumber(0)
+	, plane(0)
+	, complete_frame(false)
+	, percent_complete(0.0) {
+	if ( data == nullptr )
+		throw std::bad_alloc();
+	std::fill(data.get(), data.get() + nochannels*planesize, static_cast<uint16_t>(0));
+}
+
+ScopeMultiImagePlanar::ScopeMultiImagePlanar(const ScopeMultiImagePlanar& _mi)
+	: area(_mi.area)
+	, nochannels(_mi.nochannels)
+	, lines(_mi.lines)
+	, linewidth(_mi.linewidth)
+	, stride(_mi.stride)
+	, planesize(_mi.planesize)
+	, data(static_cast<uint16_t*>(_aligned_malloc(_mi.nochannels*_mi.planesize*sizeof(uint16_t), alignment)))
+	, avg_count(_mi.avg_count)
+	, avg_max(_mi.avg_max)
+	, complete_avg(_mi.complete_avg)
+	, imagenumber(_mi.imagenumber)
+	, plane(_mi.plane)
+	, complete_frame(_mi.complete_frame)
+	, percent_complete(_mi.percent_complete) {
+	if ( data == nullptr )
+		throw std::bad_alloc();
+	ScopeMultiImagePlanarConstAccess acc(_mi);
+	std::copy(acc.GetConstPointer(0), acc.GetConstPointer(0) + nochannels*planesize, data.get());
+}
+
+uint16_t ScopeMultiImagePlanar::GetPixel(const size_t& _ch, const uint32_t& _x, const uint32_t& _y) const {
+	assert( (_ch < nochannels) && (_x < linewidth) && (_y < lines) );
+	ScopeMultiImagePlanarConstAccess acc(*this);
+	return acc.GetConstLine(_ch, _y)[_x];
+}
+
+std::vector<uint16_t> ScopeMultiImagePlanar::GetMultiPixel(const uint32_t& _x, const uint32_t& _y) const {
+	assert( (_x < linewidth) && (_y < lines) );
+	std::vector<uint16_t> multipix(nochannels);
+	ScopeMultiImagePlanarConstAccess acc(*this);
+	for ( size_t c = 0 ; c < nochannels ; c++ )
+		multipix[c] = acc.GetConstLine(c, _y)[_x];
+	return multipix;
+}
+
+void ScopeMultiImagePlanar::SetAvgMax(const uint32_t& _avg_max) {
+	assert(_avg_max!=0);
+	avg_max = _avg_max;
+}
+
+void ScopeMultiImagePlanar::SetPercentComplete(const double& _percent) {
+	assert(_percent>=0);
+	percent_complete = _percent;
+}
+
+void ScopeMultiImagePlanar::FillRandom() {
+	ScopeMultiImagePlanarAccess acc(*this);
+	std::mt19937 mt;
+	mt.seed(static_cast<unsigned long>(GetTickCount64()));
+	for ( size_t c = 0 ; c < nochannels ; c++ )
+		for ( uint32_t l = 0 ; l < lines ; l++ )
+			std::generate(acc.GetLine(c, l), acc.GetLine(c, l) + linewidth, [&]() { return static_cast<uint16_t>(mt()); } );
+}
+
+void ScopeMultiImagePlanar::CopyFrom(const ScopeMultiImage& _multi) {
+	assert( (_multi.Channels() == nochannels) && (_multi.Lines() == lines) && (_multi.Linewidth() == linewidth) );
+	ScopeMultiImagePlanarAccess acc(*this);
+	for ( size_t c = 0 ; c < nochannels ; c++ ) {
+		ScopeImageConstAccessU16 imagedata(*_multi.GetChannel(c));
+		auto it = imagedata.GetConstData()->cbegin();
+		for ( uint32_t l = 0 ; l < lines ; l++, it += linewidth )
+			std::copy(it, it + linewidth, acc.GetLine(c, l));
+	}
+	CopyProperties(_multi);
+}
+
+void ScopeMultiImagePlanar::CopySnapshotFrom(const ScopeMultiImage& _multi) {
+	assert( (_multi.Channels() == nochannels) && (_multi.Lines() == lines) && (_multi.Linewidth() == linewidth) );
+	ScopeMultiImagePlanarAccess acc(*this);
+	for ( size_t c = 0 ; c < nochannels ; c++ ) {
+		ScopeImageSnapshotU16 imagedata(*_multi.GetChannel(c));
+		auto it = imagedata.GetConstData()->cbegin();
+		for ( uint32_t l = 0 ; l < lines ; l++, it += linewidth )
+			std::copy(it, it + linewidth, acc.GetLine(c, l));
+	}
+	CopyProperties(_multi);
+}
+
+void ScopeMultiImagePlanar::CopyProperties(const ScopeMultiImage& _multi) {
+	avg_count = _multi.GetAvgCount();
+	avg_max = _multi.GetAvgMax();
+	complete_avg = _multi.IsCompleteAvg();
+	imagenumber = _multi.GetImageNumber();
+	plane = _multi.Plane();
+	complete_frame = _multi.IsCompleteFrame();
+	percent_complete = _multi.PercentComplete();
+}
+
+ScopeMultiImagePtr ScopeMultiImagePlanar::ToMultiImage() const {
+	auto multi = std::make_shared<ScopeMultiImage>(area, nochannels, lines, linewidth);
+	{
+		ScopeMultiImagePlanarConstAccess acc(*this);
+		for ( size_t c = 0 ; c < nochannels ; c++ ) {
+			ScopeImageAccessU16 imagedata(*multi->GetChannel(c));
+			auto it = imagedata.GetData()->begin();
+			for ( uint32_t l = 0 ; l < lines ; l++, it += linewidth )
+				std::copy(acc.GetConstLine(c, l), acc.GetConstLine(c, l) + linewidth, it);
+		}
+	}
+	multi->SetAvgCount(avg_count);
+	multi->SetAvgMax(avg_max);
+	multi->SetCompleteAvg(complete_avg);
+	multi->SetImageNumber(imagenumber);
+	multi->SetPlane(plane);
+	multi->SetCompleteFrame(complete_frame);
+	multi->SetPercentComplete(percent_complete);
+	return multi;
+}
+
+ScopeMultiImagePlanarAccess::ScopeMultiImagePlanarAccess(ScopeMultiImagePlanar& _image)
+	: image(&_image) {
+	image->pixelmutex.lock();
+}
+
+ScopeMultiImagePlanarAccess::~ScopeMultiImagePlanarAccess() {
+	image->pixelmutex.unlock();
+}
+
+uint16_t* ScopeMultiImagePlanarAccess::GetPointer(const size_t& _ch) const {
+	assert(_ch < image->nochannels);
+	return image->data.get() + _ch*image->planesize;
+}
+
+uint16_t* ScopeMultiImagePlanarAccess::GetLine(const size_t& _ch, const uint32_t& _line) const {
+	assert(_line < image->lines);
+	return GetPointer(_ch) + static_cast<size_t>(_line)*image->stride;
+}
+
+ScopeMultiImagePlanarConstAccess::ScopeMultiImagePlanarConstAccess(const ScopeMultiImagePlanar& _image)
+	: image(&_image) {
+	image->pixelmutex.lock_shared();
+}
+
+ScopeMultiImagePlanarConstAccess::~ScopeMultiImagePlanarConstAccess() {
+	image->pixelmutex.unlock_shared();
+}
+
+const uint16_t* ScopeMultiImagePlanarConstAccess::GetConstPointer(const size_t& _ch) const {
+	assert(_ch < image->nochannels);
+	return image->data.get() + _ch*image->planesize;
+}
+
+const uint16_t* ScopeMultiImagePlanarConstAccess::GetConstLine(const size_t& _ch, const uint32_t& _line) const {
+	assert(_line < image->lines);
+	return GetConstPointer(_ch) + static_cast<size_t>(_line)*image->stride;
+}
+
+}
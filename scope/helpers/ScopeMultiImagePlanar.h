@@ -0,0 +1,219 @@
+#pragma once
+
+// Forward declarations
+namespace scope {
+class ScopeMultiImage;
+typedef std::shared_ptr<ScopeMultiImage> ScopeMultiImagePtr;
+class ScopeMultiImagePlanarAccess;
+class ScopeMultiImagePlanarConstAccess;
+}
+
+namespace scope {
+
+/** A multichannel image with all channels in one 64 byte aligned, planar allocation.
+* Layout is channel by channel (planar), each channel is lines x stride pixels, linewise like ScopeImage:\n
+* C0L0 C0L1 ... C1L0 C1L1 ...\n
+* Every channel plane starts on a 64 byte boundary. With row padding every line starts on a 64 byte boundary too (stride is then a multiple of 32 pixels),
+* otherwise stride equals linewidth. Padding pixels are always zero.
+* Offers the same accessor and mutator methods as ScopeMultiImage. Pixel data can only be accessed via ScopeMultiImagePlanarAccess and ScopeMultiImagePlanarConstAccess
+* (the counterparts of ScopeImageAccess and ScopeImageConstAccess), which lock all channels at once. */
+class ScopeMultiImagePlanar {
+	/** give accessor classes friend access to the data */
+	friend ScopeMultiImagePlanarAccess;
+
+	/** give accessor classes friend access to the data */
+	friend ScopeMultiImagePlanarConstAccess;
+
+public:
+	/** alignment of the allocation, channel planes and (with padding) lines in bytes */
+	static const size_t alignment = 64;
+
+protected:
+	/** deleter for the aligned allocation */
+	struct AlignedDeleter {
+		void operator()(uint16_t* _p) const { _aligned_free(_p); }
+	};
+
+	/** the area from which the multi image comes */
+	const uint32_t area;
+
+	/** number of channels */
+	const size_t nochannels;
+
+	/** number of lines (y-resolution) */
+	const uint32_t lines;
+
+	/** the linewidth (x-resolution) */
+	const uint32_t linewidth;
+
+	/** distance between the starts of two lines in pixels */
+	const uint32_t stride;
+
+	/** distance between the starts of two channel planes in pixels */
+	const size_t planesize;
+
+	/** the aligned pixel data of all channels */
+	std::unique_ptr<uint16_t[], AlignedDeleter> data;
+
+	/** mutex for protection of pixel operations, exclusive for writing, shared for reading */
+	mutable std::shared_timed_mutex pixelmutex;
+
+	/** this image is the xth average */
+	uint32_t avg_count;
+
+	/** ... of this many to average */
+	uint32_t avg_max;
+
+	/** false if this is a not completely averaged frame, this is then only for display purpose and will not be stored */
+	bool complete_avg;
+
+	/** number of this image */
+	uint32_t imagenumber;
+
+	/** plane of a multi plane scan (e.g. plane hopping) this image belongs to */
+	uint32_t plane;
+
+	/** false if frame not complete, allows for partial display during acquisition */
+	bool complete_frame;
+
+	/** how many percent of the frame are already filled */
+	double percent_complete;
+
+	/** Copies the properties (averages, image number etc.) from a ScopeMultiImage */
+	void CopyProperties(const ScopeMultiImage& _multi);
+
+public:
+	/** Allocates and zeros the pixel data of all channels
+	* @param[in] _area the area
+	* @param[in] _nochannels number of channels
+	* @param[in] _lines,_linewidth resolution
+	* @param[in] _padrows if true, every line is padded to a multiple of 64 bytes */
+	ScopeMultiImagePlanar(const uint32_t& _area = 0, const size_t& _nochannels = 1, const uint32_t& _lines = 256, const uint32_t& _linewidth = 256, const bool& _padrows = false);
+
+	/** Safe copy, copies pixel data and properties */
+	ScopeMultiImagePlanar(const ScopeMultiImagePlanar& _mi);
+
+	/** Not assignable (area, size and layout are const) */
+	ScopeMultiImagePlanar& operator=(const ScopeMultiImagePlanar& _mi) = delete;
+
+	/** @name Several accessor methods */
+	/** @{ */
+	uint32_t Area() const { return area; }
+	size_t Channels() const { return nochannels; }
+	uint32_t Lines() const { return lines; }
+	uint32_t Linewidth() const { return linewidth; }
+	uint32_t Pixels() const { return lines*linewidth; }
+	uint32_t Stride() const { return stride; }
+	size_t PlaneSize() const { return planesize; }
+	bool IsPadded() const { return stride != linewidth; }
+
+	/** @param[in] _ch which channel
+	* @param[in] _x,_y which pixel
+	* @return value of pixel of channel */
+	uint16_t GetPixel(const size_t& _ch, const uint32_t& _x, const uint32_t& _y) const;
+	
+	/** @param[in] _x,_y which pixel
+	* @return vector with pixel value of every channel */
+	std::vector<uint16_t> GetMultiPixel(const uint32_t& _x, const uint32_t& _y) const;
+
+	uint32_t GetAvgCount() const { return avg_count; }
+
+	uint32_t GetAvgMax() const { return avg_max; }
+
+	uint32_t GetImageNumber() const { return imagenumber; }
+
+	uint32_t Plane() const { return plane; }
+
+	bool IsCompleteFrame() const { return complete_frame; }
+
+	bool IsCompleteAvg() const { return complete_avg; }
+
+	double PercentComplete() const { return percent_complete; }
+	/** @} */
+
+	/** @name Several mutator methods */
+	/** @{ */
+	/** Sets the average count of this image */
+	void SetAvgCount(const uint32_t& _avg_count) { avg_count = _avg_count; }
+
+	/** Sets the maximum average count */
+	void SetAvgMax(const uint32_t& _avg_max);
+
+	/** Sets the number of this image */
+	void SetImageNumber(const uint32_t& _imagenumber) { imagenumber = _imagenumber; }
+
+	/** Sets the plane of this image */
+	void SetPlane(const uint32_t& _plane) { plane = _plane; }
+
+	/** Sets frame complete */
+	void SetCompleteFrame(const bool& _complete) { complete_frame = _complete; }
+
+	/** Sets complete average */
+	void SetCompleteAvg(const bool& _complete) { complete_avg = _complete; }
+
+	/** Sets percent complete */
+	void SetPercentComplete(const double& _percent);
+	/** @} */
+
+	/** Fills the multi image with random data (padding stays zero) */
+	void FillRandom();
+
+	/** Copies pixel data and properties from a ScopeMultiImage of the same size */
+	void CopyFrom(const ScopeMultiImage& _multi);
+
+	/** Copies the last published snapshots (see ScopeImageSnapshot) and the properties of a ScopeMultiImage of the same size.
+	* Never blocks the pixel mapping, use this for display purposes. */
+	void CopySnapshotFrom(const ScopeMultiImage& _multi);
+
+	/** @return a new ScopeMultiImage with a copy of the pixel data and properties, e.g. for the overlay, histogram and encoder */
+	ScopeMultiImagePtr ToMultiImage() const;
+};
+
+/** Gives RAII safe access (read&write) to the pixel data of all channels of a ScopeMultiImagePlanar. The pixelmutex is locked exclusively
+* on construction and unlocked on destruction. */
+class ScopeMultiImagePlanarAccess {
+protected:
+	/** pointer to the image */
+	ScopeMultiImagePlanar* const image;
+
+public:
+	/** Locks the image exclusively */
+	ScopeMultiImagePlanarAccess(ScopeMultiImagePlanar& _image);
+
+	/** Unlocks the image */
+	~ScopeMultiImagePlanarAccess();
+
+	/** @return 64 byte aligned pointer to the first pixel of a channel */
+	uint16_t* GetPointer(const size_t& _ch) const;
+
+	/** @return pointer to the first pixel of a line of a channel (64 byte aligned if the image is padded) */
+	uint16_t* GetLine(const size_t& _ch, const uint32_t& _line) const;
+};
+
+/** Gives RAII safe const access (read-only) to the pixel data of all channels of a ScopeMultiImagePlanar. The pixelmutex is locked shared
+* on construction and unlocked on destruction. This allows concurrent read access. */
+class ScopeMultiImagePlanarConstAccess {
+protected:
+	/** pointer to the image */
+	const ScopeMultiImagePlanar* const image;
+
+public:
+	/** Locks the image shared */
+	ScopeMultiImagePlanarConstAccess(const ScopeMultiImagePlanar& _image);
+
+	/** Unlocks the image */
+	~ScopeMultiImagePlanarConstAccess();
+
+	/** @return 64 byte aligned pointer to the first pixel of a channel */
+	const uint16_t* GetConstPointer(const size_t& _ch) const;
+
+	/** @return pointer to the first pixel of a line of a channel (64 byte aligned if the image is padded) */
+	const uint16_t* GetConstLine(const size_t& _ch, const uint32_t& _line) const;
+};
+
+/** Shared pointer to a ScopeMultiImagePlanar */
+typedef std::shared_ptr<ScopeMultiImagePlanar> ScopeMultiImagePlanarPtr;
+/** Shared pointer to a const ScopeMultiImagePlanar */
+typedef std::shared_ptr<const ScopeMultiImagePlanar> ScopeMultiImagePlanarCPtr;
+
+}
@@ -183,16 +183,10 @@ public:
 			// keep the (now possibly changed) value for later outside the protected area
 			tmp = value;
 		}
-		// Following code had to be copied from ScopeValue
 		// call signals after unlocking the mutex to avoid possible deadlock!
-		// Since signals2 is thread-safe we do not have to protect call to signal methods with a mutex.
 		// avoid calling when variable was not changed unless desired.
-		if ( changed || _callatnochange) {
-			if ( _callguisignal )
-				changesiggui();
-			if ( _callothersignal )
-				changesigother();
-		}
+		if ( changed || _callatnochange)
+			CallChangeSignals(_callguisignal, _callothersignal);
 		return tmp;
 	}
 };
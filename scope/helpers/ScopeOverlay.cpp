@@ -2,6 +2,7 @@
 #include "ScopeOverlay.h"
 #include "ScopeImage.h"
 #include "ScopeMultiImage.h"
+#include "ScopeMultiImagePlanar.h"
 #include "helpers.h"
 #include "pixel.h"
 #include "lut.h"
@@ -19,24 +20,42 @@ void ScopeOverlay::Create(ScopeMultiImageCPtr const _multi, const std::vector<Co
 	std::lock_guard<std::mutex> lock(mutex);
 	assert( (_color_props.size() == _multi->Channels()) && (lines==_multi->Lines()) && (linewidth==_multi->Linewidth()) );
 
-	std::fill(std::begin(overlay), std::end(overlay), BGRA8BLACK);					// Clear the overlay
+	if ( (planar == nullptr) || (planar->Channels() != _multi->Channels()) || (planar->Lines() != lines) || (planar->Linewidth() != linewidth) )
+		planar = std::make_shared<ScopeMultiImagePlanar>(_multi->Area(), _multi->Channels(), lines, linewidth);
+	planar->CopySnapshotFrom(*_multi);						// snapshots, do not block the pixelmapper
 
+	// Only the channels with a color (save some time...)
+	std::vector<const uint16_t*> grays;
+	std::vector<ColorEnum> cols;
+	std::vector<uint16_t> lls;
+	std::vector<uint16_t> uls;
+	ScopeMultiImagePlanarConstAccess acc(*planar);
 	for ( size_t ch = 0 ; ch < _multi->Channels() ; ch++ ) {
-		ScopeImageU16CPtr chimage = _multi->GetChannel(ch);
-		if ( _color_props.at(ch).Color() != None ) {						// save some time...
-			ColorEnum col = _color_props.at(ch).Color();
-			uint16_t ll = _color_props.at(ch).LowerLimit();
-			uint16_t ul = _color_props.at(ch).UpperLimit();
+		if ( _color_props.at(ch).Color() != None ) {
+			grays.push_back(acc.GetConstPointer(ch));
+			cols.push_back(_color_props.at(ch).Color());
+			lls.push_back(_color_props.at(ch).LowerLimit());
+			uls.push_back(_color_props.at(ch).UpperLimit());
+		}
+	}
 
-			ScopeImageConstAccessU16 imagedata(*chimage);
-			auto it = imagedata.GetConstData()->begin();
+	// One pass over the overlay for all channels, the channel planes are contiguous and unpadded, thus pixel i of every plane is at grays[c][i]
+	const size_t shown = grays.size();
+	const size_t pixels = overlay.size();
+	BGRA8Pixel* const out = overlay.data();
+	for ( size_t i = 0 ; i < pixels ; i++ ) {
+		BGRA8Pixel pix(BGRA8BLACK);
+		for ( size_t c = 0 ; c < shown ; c++ )
+			pix += U16ToBGRA8Histo(grays[c][i], cols[c], lls[c], uls[c]);
+		out[i] = pix;
+	}
 
+	/** Alternative incarnations I had tried out (channel by channel on the vectors of the channels' snapshots)...
 			// ~  185 ms for 1024x1024 (~ 180 without histogram!)
 			std::transform(std::begin(overlay), std::end(overlay), it, std::begin(overlay), [&](BGRA8Pixel& pix, const uint16_t& gray) {
 				return pix + U16ToBGRA8Histo(gray, col, ll, ul);
 			} );
 
-			/** Alternative incarnations I had tried out...
 			// ~ 230 ms for 1024x1024
 			uint32_t size = overlay.size();
 			for ( uint32_t i = 0 ; i < size ; i++ )
@@ -51,8 +70,6 @@ void ScopeOverlay::Create(ScopeMultiImageCPtr const _multi, const std::vector<Co
 				return pix + U16ToBGRA8Histo(gray, col, ll, ul);
 			} );
 			*/
-		}
-	}
 }
 
 void ScopeOverlay::ToD2Bitmap(ID2D1Bitmap* const _d2bitmap) const {
@@ -8,6 +8,8 @@ namespace scope {
 class ColorProps;
 class ScopeMultiImage;
 typedef std::shared_ptr<const ScopeMultiImage> ScopeMultiImageCPtr;
+class ScopeMultiImagePlanar;
+typedef std::shared_ptr<ScopeMultiImagePlanar> ScopeMultiImagePlanarPtr;
 }
 
 namespace scope {
@@ -26,6 +28,9 @@ protected:
 	/** vector with pixeldata */
 	std::vector<BGRA8Pixel> overlay;
 
+	/** copy of all channels of the last multi image in one aligned allocation, reused as long as the size stays the same */
+	ScopeMultiImagePlanarPtr planar;
+
 	/** mutex for protection */
 	mutable std::mutex mutex;
 
@@ -35,7 +40,8 @@ public:
 	* @param[in] _linewidth initial x resolution */
 	ScopeOverlay(const uint32_t& _lines = 0, const uint32_t& _linewidth = 0);
 
-	/** Creates an overlay from a multi image with the specified color properties per channel
+	/** Creates an overlay from a multi image with the specified color properties per channel.
+	* Copies the snapshots of all channels into the planar image first, then blends all channels in one pass over the overlay.
 	* @param[in] _multi the multi image to create overlay from
 	* @param[in] _color_props the vector with the ColorProps for each channel */
 	virtual void Create(ScopeMultiImageCPtr const _multi, const std::vector<ColorProps>& _color_props);
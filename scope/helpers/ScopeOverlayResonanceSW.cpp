@@ -25,7 +25,7 @@ void ScopeOverlayResonanceSW::Create(ScopeMultiImageResonanceSWCPtr const _multi
 			uint16_t ll = _color_props.at(ch).LowerLimit();
 			uint16_t ul = _color_props.at(ch).UpperLimit();
 
-			ScopeImageConstAccessU16 imagedata(*chimage);
+			ScopeImageSnapshotU16 imagedata(*chimage);			// snapshot, does not block the pixelmapper
 			auto it = imagedata.GetConstData()->begin();
 
 			// if in resonance scanner mode, only the forward lines are shown on the screen
@@ -0,0 +1,182 @@
+#include "stdafx.h"
+#include "ScopeTrace.h"
+#include "ScopeException.h"
+
+namespace scope {
+
+	namespace {
+		/** buffer of the calling thread, registered with the ScopeTracer on first use */
+		thread_local ScopeTraceBuffer* threadbuffer = nullptr;
+
+		/** number of power of two histogram buckets, the last one collects everything above */
+		const size_t histogrambuckets = 24;
+
+		/** Escapes a string for JSON */
+		std::string JSONEscape(const char* _str) {
+			std::string escaped;
+			for ( const char* c = _str ; *c != '\0' ; ++c ) {
+				if ( (*c == '"') || (*c == '\\') )
+					escaped += '\\';
+				escaped += *c;
+			}
+			return escaped;
+		}
+	}
+
+	ScopeTraceBuffer::ScopeTraceBuffer(const uint32_t& _threadid)
+		: threadid(_threadid)
+		, slots(new Slot[capacity])
+		, written(0) {
+		for ( size_t i = 0 ; i < capacity ; i++ )
+			slots[i].sequence.store(0, std::memory_order_relaxed);
+	}
+
+	void ScopeTraceBuffer::Add(const ScopeTraceEvent& _event) {
+		const uint64_t w = written.load(std::memory_order_relaxed);
+		Slot& slot = slots[w % capacity];
+		// Invalidate the slot before the fields change
+		slot.sequence.store(0, std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_release);
+		slot.name.store(_event.name, std::memory_order_relaxed);
+		slot.start.store(_event.start, std::memory_order_relaxed);
+		slot.duration.store(_event.duration, std::memory_order_relaxed);
+		slot.arg.store(_event.arg, std::memory_order_relaxed);
+		slot.sequence.store(w + 1, std::memory_order_release);
+		written.store(w + 1, std::memory_order_release);
+	}
+
+	std::vector<ScopeTraceEvent> ScopeTraceBuffer::Events() const {
+		const uint64_t w = written.load(std::memory_order_acquire);
+		const uint64_t n = std::min<uint64_t>(w, capacity);
+		std::vector<ScopeTraceEvent> result;
+		result.reserve(static_cast<size_t>(n));
+		for ( uint64_t i = w - n ; i < w ; i++ ) {
+			const Slot& slot = slots[i % capacity];
+			if ( slot.sequence.load(std::memory_order_acquire) != i + 1 )
+				continue;
+			ScopeTraceEvent ev;
+			ev.name = slot.name.load(std::memory_order_relaxed);
+			ev.start = slot.start.load(std::memory_order_relaxed);
+			ev.duration = slot.duration.load(std::memory_order_relaxed);
+			ev.arg = slot.arg.load(std::memory_order_relaxed);
+			// The writer got to this slot again while we copied
+			std::atomic_thread_fence(std::memory_order_acquire);
+			if ( slot.sequence.load(std::memory_order_relaxed) != i + 1 )
+				continue;
+			result.push_back(ev);
+		}
+		return result;
+	}
+
+	ScopeTracer::ScopeTracer()
+		: enabled(false)
+		, epoch(std::chrono::high_resolution_clock::now())
+		, clearedat(0) {
+	}
+
+	ScopeTracer& ScopeTracer::GetInstance() {
+		static ScopeTracer instance;
+		return instance;
+	}
+
+	void ScopeTracer::Enable(const bool& _enable) {
+		enabled = _enable;
+	}
+
+	uint64_t ScopeTracer::Now() const {
+		return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::high_resolution_clock::now() - epoch).count();
+	}
+
+	ScopeTraceBuffer* ScopeTracer::ThreadBuffer() {
+		if ( threadbuffer == nullptr ) {
+			std::lock_guard<std::mutex> lock(buffersmutex);
+			buffers.push_back(std::make_unique<ScopeTraceBuffer>(static_cast<uint32_t>(GetCurrentThreadId())));
+			threadbuffer = buffers.back().get();
+		}
+		return threadbuffer;
+	}
+
+	void ScopeTracer::Add(const char* _name, const uint64_t& _start, const uint64_t& _duration, const uint32_t& _arg) {
+		ScopeTraceEvent ev;
+		ev.name = _name;
+		ev.start = _start;
+		ev.duration = _duration;
+		ev.arg = _arg;
+		ThreadBuffer()->Add(ev);
+	}
+
+	void ScopeTracer::Clear() {
+		clearedat = Now();
+	}
+
+	std::vector<std::pair<uint32_t, ScopeTraceEvent>> ScopeTracer::CollectEvents() const {
+		std::vector<std::pair<uint32_t, ScopeTraceEvent>> result;
+		const uint64_t since = clearedat;
+		std::lock_guard<std::mutex> lock(buffersmutex);
+		for ( const auto& b : buffers ) {
+			for ( const auto& ev : b->Events() ) {
+				if ( ev.start >= since )
+					result.push_back(std::make_pair(b->threadid, ev));
+			}
+		}
+		return result;
+	}
+
+	void ScopeTracer::ExportChromeTrace(const std::wstring& _filename) const {
+		std::ofstream file(_filename);
+		if ( !file.is_open() )
+			throw ScopeException("ScopeTracer could not open the trace file");
+		file << std::fixed << std::setprecision(3);
+		file << "{\"traceEvents\":[\n";
+		bool first = true;
+		for ( const auto& tev : CollectEvents() ) {
+			if ( !first )
+				file << ",\n";
+			first = false;
+			file << "{\"name\":\"" << JSONEscape(tev.second.name) << "\",\"cat\":\"scope\",\"ph\":\"X\",\"pid\":0,\"tid\":" << tev.first
+				<< ",\"ts\":" << tev.second.start * 1E-3 << ",\"dur\":" << tev.second.duration * 1E-3
+				<< ",\"args\":{\"arg\":" << tev.second.arg << "}}";
+		}
+		file << "\n],\"displayTimeUnit\":\"ms\"}\n";
+	}
+
+	std::wstring ScopeTracer::Summary() const {
+		// Durations in nanoseconds grouped by span name (sorted by name, not by pointer)
+		std::map<std::string, std::vector<uint64_t>> durations;
+		for ( const auto& tev : CollectEvents() )
+			durations[tev.second.name].push_back(tev.second.duration);
+
+		std::wostringstream summary;
+		summary << std::fixed << std::setprecision(1);
+		for ( auto& d : durations ) {
+			std::vector<uint64_t>& v = d.second;
+			std::sort(std::begin(v), std::end(v));
+			auto percentile = [&v](const double& _p) { return v[std::min(v.size() - 1, static_cast<size_t>(_p * v.size()))] * 1E-3; };
+			const double mean = std::accumulate(std::begin(v), std::end(v), 0.0) / v.size() * 1E-3;
+			summary << std::wstring(CA2W(d.first.c_str())) << L": n " << v.size() << L", mean " << mean << L" us, p50 " << percentile(0.5)
+				<< L" us, p90 " << percentile(0.9) << L" us, p99 " << percentile(0.99) << L" us, max " << v.back() * 1E-3 << L" us\n";
+
+			// Bucket b holds durations in [2^(b-1), 2^b) microseconds, bucket 0 everything below 1 us
+			std::array<uint64_t, histogrambuckets> histogram;
+			histogram.fill(0);
+			for ( const auto& ns : v ) {
+				size_t bucket = 0;
+				for ( uint64_t us = ns / 1000 ; (us > 0) && (bucket < histogrambuckets - 1) ; us >>= 1 )
+					bucket++;
+				histogram[bucket]++;
+			}
+			summary << L"  histogram";
+			for ( size_t b = 0 ; b < histogrambuckets ; b++ ) {
+				if ( histogram[b] == 0 )
+					continue;
+				if ( b == 0 )
+					summary << L" <1us:" << histogram[b];
+				else
+					summary << L" " << (1ull << (b - 1)) << L"us:" << histogram[b];
+			}
+			summary << L"\n";
+		}
+		return summary.str();
+	}
+
+}
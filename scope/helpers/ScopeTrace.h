@@ -0,0 +1,166 @@
+#pragma once
+
+namespace scope {
+
+	/** One traced span
+	* @ingroup HELPERS */
+	struct ScopeTraceEvent {
+		/** name of the span, has to be a string literal (only the pointer is stored) */
+		const char* name;
+
+		/** start in nanoseconds since the tracer was created */
+		uint64_t start;
+
+		/** duration in nanoseconds */
+		uint64_t duration;
+
+		/** an argument to the span, e.g. the area */
+		uint32_t arg;
+	};
+
+	/** Ring buffer for the trace events of one thread. Only its own thread writes into it (no locking), a reader gets the last events.
+	* Every slot works like a seqlock: its sequence number is invalidated while the writer fills it and then set to the event's position + 1.
+	* A reader only accepts an event if the slot's sequence is the expected one before and after copying it, events overwritten during
+	* the copy are skipped. All fields are atomics, thus reading while acquiring is safe (and only costs a few plain stores for the writer on x86).
+	* @ingroup HELPERS */
+	class ScopeTraceBuffer {
+
+	public:
+		/** number of events kept per thread */
+		static const size_t capacity = 65536;
+
+		/** id of the thread owning the buffer */
+		const uint32_t threadid;
+
+	protected:
+		/** one slot of the ring buffer, the fields of a ScopeTraceEvent as atomics */
+		struct Slot {
+			/** position of the event in the slot + 1, 0 while the slot is written */
+			std::atomic<uint64_t> sequence;
+			std::atomic<const char*> name;
+			std::atomic<uint64_t> start;
+			std::atomic<uint64_t> duration;
+			std::atomic<uint32_t> arg;
+		};
+
+		/** the ring buffer */
+		std::unique_ptr<Slot[]> slots;
+
+		/** total number of events written, the next is written to written % capacity */
+		std::atomic<uint64_t> written;
+
+	public:
+		/** @param[in] _threadid id of the owning thread */
+		explicit ScopeTraceBuffer(const uint32_t& _threadid);
+
+		/** Adds an event, only to be called from the owning thread */
+		void Add(const ScopeTraceEvent& _event);
+
+		/** @return copy of the events currently in the buffer, oldest first (without those overwritten while copying), may be called from any thread */
+		std::vector<ScopeTraceEvent> Events() const;
+	};
+
+	/** Lightweight tracing of the time spent in the stages of the acquisition chain. Spans are recorded with ScopeTraceSpan into per-thread
+	* buffers, exported as Chrome trace JSON (open in chrome://tracing or Perfetto) and summarized as latency histograms.
+	* Always compiled in, when disabled a span costs one relaxed atomic load.
+	* @ingroup HELPERS */
+	class ScopeTracer {
+
+	protected:
+		/** tracing on or off */
+		std::atomic<bool> enabled;
+
+		/** time point all timestamps are relative to */
+		const std::chrono::high_resolution_clock::time_point epoch;
+
+		/** events before this timestamp are ignored (set by Clear, avoids touching the buffers of other threads) */
+		std::atomic<uint64_t> clearedat;
+
+		/** protects buffers */
+		mutable std::mutex buffersmutex;
+
+		/** the buffers of all threads that ever traced, they live as long as the tracer */
+		std::vector<std::unique_ptr<ScopeTraceBuffer>> buffers;
+
+		ScopeTracer();
+
+		/** @return the buffer of the calling thread, creates and registers it on first use */
+		ScopeTraceBuffer* ThreadBuffer();
+
+		/** @return all events of all threads since the last Clear, with their thread ids */
+		std::vector<std::pair<uint32_t, ScopeTraceEvent>> CollectEvents() const;
+
+	public:
+		/** disable copy */
+		ScopeTracer(const ScopeTracer&) = delete;
+
+		/** disable assignment */
+		ScopeTracer& operator=(const ScopeTracer&) = delete;
+
+		static ScopeTracer& GetInstance();
+
+		/** Turns tracing on or off */
+		void Enable(const bool& _enable);
+
+		/** @return true if tracing is on */
+		bool IsEnabled() const { return enabled.load(std::memory_order_relaxed); }
+
+		/** @return current time in nanoseconds since the tracer was created */
+		uint64_t Now() const;
+
+		/** Records a span into the buffer of the calling thread */
+		void Add(const char* _name, const uint64_t& _start, const uint64_t& _duration, const uint32_t& _arg);
+
+		/** Forgets all events recorded so far */
+		void Clear();
+
+		/** Writes all events as Chrome trace JSON ("X" complete events, timestamps in microseconds)
+		* @param[in] _filename the file to write */
+		void ExportChromeTrace(const std::wstring& _filename) const;
+
+		/** @return a latency summary per span name: count, mean, percentiles, maximum and a histogram with power of two microsecond buckets */
+		std::wstring Summary() const;
+	};
+
+	/** Traces the lifetime of the object as a span, use as a local variable around the code to trace.
+	* @ingroup HELPERS */
+	class ScopeTraceSpan {
+
+	protected:
+		/** name of the span, has to be a string literal */
+		const char* const name;
+
+		/** argument of the span */
+		const uint32_t arg;
+
+		/** true if tracing was on on construction */
+		const bool active;
+
+		/** start time */
+		uint64_t start;
+
+	public:
+		/** @param[in] _name name of the span, has to be a string literal
+		* @param[in] _arg an argument, e.g. the area */
+		explicit ScopeTraceSpan(const char* _name, const uint32_t& _arg = 0)
+			: name(_name)
+			, arg(_arg)
+			, active(ScopeTracer::GetInstance().IsEnabled())
+			, start(active ? ScopeTracer::GetInstance().Now() : 0) {
+		}
+
+		~ScopeTraceSpan() {
+			if ( active ) {
+				ScopeTracer& tracer(ScopeTracer::GetInstance());
+				tracer.Add(name, start, tracer.Now() - start, arg);
+			}
+		}
+
+		/** disable copy */
+		ScopeTraceSpan(const ScopeTraceSpan&) = delete;
+
+		/** disable assignment */
+		ScopeTraceSpan& operator=(const ScopeTraceSpan&) = delete;
+	};
+
+}
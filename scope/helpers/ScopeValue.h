@@ -26,6 +26,12 @@ namespace scope {
 			, value(_value) {
 		}
 
+		/** Stops coalescing before the value is destroyed */
+		~ScopeValue() {
+			if ( coalescing )
+				UnregisterCoalescing();
+		}
+
 		/** Safe assignment */
 		ScopeValue& operator=(const ScopeValue& v) {
 			// Avoid self-assignment
@@ -82,14 +88,9 @@ namespace scope {
 				tmp = value;
 			}
 			// call signals after unlocking the mutex to avoid possible deadlock!
-			// Since signals2 is thread-safe we do not have to protect call to signal methods with a mutex.
 			// avoid calling when variable was not changed unless desired.
-			if ( changed || _callatnochange) {
-				if ( _callguisignal )
-					changesiggui();
-				if ( _callothersignal )
-					changesigother();
-			}
+			if ( changed || _callatnochange)
+				CallChangeSignals(_callguisignal, _callothersignal);
 			return tmp;
 		}
 
@@ -1,4 +1,26 @@
 #include "StdAfx.h"
 #include "ScopeValueBase.h"
+#include "ScopeValueNotifier.h"
 
+namespace scope {
 
+void ScopeValueBase::UnregisterCoalescing() {
+	// After Unregister the notifier does not touch this value anymore
+	ScopeValueNotifier::GetInstance().Unregister(this);
+	coalescing = false;
+}
+
+void ScopeValueBase::SetCoalescing(const bool& _coalesce) {
+	if ( _coalesce == coalescing )
+		return;
+	if ( _coalesce ) {
+		coalescing = true;
+		ScopeValueNotifier::GetInstance().Register(this);
+	}
+	else {
+		UnregisterCoalescing();
+		CallPendingSignals();
+	}
+}
+
+}
@@ -2,10 +2,14 @@
 
 namespace scope {
 
+class ScopeValueNotifier;
+
 /** Base class for a thread-safe value, with signals that are called on value changes.
 * It uses a mutex to protect the value and boost::signals2 to call connected function. */
 class ScopeValueBase {
 
+	friend class ScopeValueNotifier;
+
 protected:
 	/** the name of the value */
 	std::wstring name;
@@ -31,17 +35,50 @@ protected:
 	/** signal that is called on changes of read/write status */
 	signalstate_t statesig;
 
+	/** if true, change signals are not called in Set but collected and called by the ScopeValueNotifier */
+	std::atomic<bool> coalescing;
+
+	/** change signals collected in coalescing mode, see pendinggui and pendingother */
+	std::atomic<uint8_t> pendingsignals;
+
+	/** bit in pendingsignals for the GUI signal */
+	static const uint8_t pendinggui = 1;
+
+	/** bit in pendingsignals for the other signal */
+	static const uint8_t pendingother = 2;
+
+protected:
+	/** Leaves coalescing mode without calling pending signals (e.g. on destruction) */
+	void UnregisterCoalescing();
+
+	/** Calls the change signals, or in coalescing mode only marks them for the ScopeValueNotifier. Call after unlocking the mutex! */
+	void CallChangeSignals(const bool& _callguisignal, const bool& _callothersignal) {
+		if ( coalescing ) {
+			pendingsignals |= (_callguisignal ? pendinggui : 0) | (_callothersignal ? pendingother : 0);
+			return;
+		}
+		// Since signals2 is thread-safe we do not have to protect call to signal methods with a mutex.
+		if ( _callguisignal )
+			changesiggui();
+		if ( _callothersignal )
+			changesigother();
+	}
+
 public:
 	/** Initialize name and readonly */
 	ScopeValueBase(const std::wstring& _name = L"None")
 		: readwrite(true)
-		, name(_name) {
+		, name(_name)
+		, coalescing(false)
+		, pendingsignals(0) {
 	}
 
-	/** Safe copy. Signals are not copied! */
+	/** Safe copy. Signals and coalescing mode are not copied! */
 	ScopeValueBase(const ScopeValueBase& _svb)
 		: readwrite(_svb.GetRWState())
-		, name(_svb.Name()) {
+		, name(_svb.Name())
+		, coalescing(false)
+		, pendingsignals(0) {
 	}
 
 	/** Safe assignment. Signals are not assigned! */
@@ -57,6 +94,9 @@ public:
 
 	/** Disconnects all slots from signals */
 	virtual ~ScopeValueBase() {
+		// The notifier must not call signals of a destroyed value
+		if ( coalescing )
+			UnregisterCoalescing();
 		std::lock_guard<std::mutex> lock(mutex);
 		// If anything still connected now is the time to let it go...
 		changesiggui.disconnect_all_slots();
@@ -106,6 +146,28 @@ public:
 	boost::signals2::connection ConnectState(signalstate_t::slot_type slot) {
 		return statesig.connect(slot);
 	}
+
+	/** Switches coalescing mode on or off. In coalescing mode Set only updates the value and the change signals are called from the
+	* ScopeValueNotifier thread at most ScopeValueNotifier::Rate times per second (if the value changed since the last time). Use this for values
+	* set at high frequency from acquisition threads, e.g. progress counters. Switching off calls pending signals immediately. */
+	void SetCoalescing(const bool& _coalesce);
+
+	/** @return true if in coalescing mode */
+	bool Coalescing() const { return coalescing; }
+
+	/** Calls the change signals collected in coalescing mode */
+	void CallPendingSignals() {
+		CallSignals(pendingsignals.exchange(0));
+	}
+
+protected:
+	/** Calls the change signals given by the pendinggui and pendingother bits in _pending */
+	void CallSignals(const uint8_t& _pending) {
+		if ( _pending & pendinggui )
+			changesiggui();
+		if ( _pending & pendingother )
+			changesigother();
+	}
 };
 
 }
\ No newline at end of file
@@ -0,0 +1,78 @@
+#include "stdafx.h"
+#include "ScopeValueNotifier.h"
+#include "ScopeValueBase.h"
+
+namespace scope {
+
+	ScopeValueNotifier::ScopeValueNotifier()
+		: inflight(nullptr)
+		, rate(20)
+		, quit(false)
+		, thread(&ScopeValueNotifier::Run, this) {
+	}
+
+	ScopeValueNotifier::~ScopeValueNotifier() {
+		quit = true;
+		if ( thread.joinable() )
+			thread.join();
+		// Values destroyed after the notifier must not unregister anymore
+		std::lock_guard<std::mutex> lock(mutex);
+		for ( auto& v : values )
+			v->coalescing = false;
+		values.clear();
+	}
+
+	ScopeValueNotifier& ScopeValueNotifier::GetInstance() {
+		static ScopeValueNotifier instance;
+		return instance;
+	}
+
+	void ScopeValueNotifier::Register(ScopeValueBase* const _value) {
+		std::lock_guard<std::mutex> lock(mutex);
+		values.insert(_value);
+	}
+
+	void ScopeValueNotifier::Unregister(ScopeValueBase* const _value) {
+		std::unique_lock<std::mutex> lock(mutex);
+		values.erase(_value);
+		// A slot of the value itself may unregister it (e.g. switch coalescing off), do not wait for ourselves then
+		if ( std::this_thread::get_id() != thread.get_id() )
+			dispatched.wait(lock, [this, _value]() { return inflight != _value; });
+	}
+
+	void ScopeValueNotifier::SetRate(const uint32_t& _rate) {
+		rate = std::max(1u, _rate);
+	}
+
+	void ScopeValueNotifier::Run() {
+		while ( !quit ) {
+			std::this_thread::sleep_for(std::chrono::microseconds(1000000 / rate));
+			std::vector<ScopeValueBase*> snapshot;
+			{
+				std::lock_guard<std::mutex> lock(mutex);
+				snapshot.assign(std::begin(values), std::end(values));
+			}
+			for ( auto& v : snapshot ) {
+				// Values may have been unregistered in the meantime (also by slots), so check every value again and take its pending signals under the lock
+				uint8_t pending = 0;
+				{
+					std::lock_guard<std::mutex> lock(mutex);
+					if ( values.count(v) == 0 )
+						continue;
+					pending = v->pendingsignals.exchange(0);
+					if ( pending == 0 )
+						continue;
+					inflight = v;
+				}
+				// Unregister of v waits until we are done, thus v stays alive while its slots run
+				v->CallSignals(pending);
+				{
+					std::lock_guard<std::mutex> lock(mutex);
+					inflight = nullptr;
+				}
+				dispatched.notify_all();
+			}
+		}
+	}
+
+}
@@ -0,0 +1,70 @@
+#pragma once
+
+namespace scope {
+
+	class ScopeValueBase;
+
+	/** Calls the collected change signals of all ScopeValues in coalescing mode (see ScopeValueBase::SetCoalescing) from its own thread, at most
+	* Rate times per second. Thus a value set after every chunk from an acquisition thread costs that thread no signal dispatch, and the GUI
+	* gets only as many updates as it can display.\n
+	* The pending signals of a value are taken under the lock, but the slots are called without holding it. Thus a slot may e.g. SendMessage
+	* to the GUI thread while that thread destroys (and unregisters) other values.
+	* @ingroup HELPERS */
+	class ScopeValueNotifier {
+
+	protected:
+		/** protects values and inflight */
+		std::mutex mutex;
+
+		/** the values in coalescing mode */
+		std::set<ScopeValueBase*> values;
+
+		/** the value whose signals are being called right now (without holding mutex), nullptr if none */
+		ScopeValueBase* inflight;
+
+		/** signalled when inflight is reset */
+		std::condition_variable dispatched;
+
+		/** maximum number of signal calls per value per second */
+		std::atomic<uint32_t> rate;
+
+		/** tells the thread to end */
+		std::atomic<bool> quit;
+
+		/** the notifier thread (initialize last!) */
+		std::thread thread;
+
+	protected:
+		ScopeValueNotifier();
+
+		/** Loop of the notifier thread */
+		void Run();
+
+	public:
+		/** disable copy */
+		ScopeValueNotifier(const ScopeValueNotifier&) = delete;
+
+		/** disable assignment */
+		ScopeValueNotifier& operator=(const ScopeValueNotifier&) = delete;
+
+		/** Ends the thread, the remaining values leave coalescing mode */
+		~ScopeValueNotifier();
+
+		static ScopeValueNotifier& GetInstance();
+
+		/** Adds a value, its pending signals are called from now on */
+		void Register(ScopeValueBase* const _value);
+
+		/** Removes a value, when this returns its signals are not called anymore by the notifier. If the notifier is calling the value's
+		* signals right now, waits until that is done (except when called from one of those slots). Thus a slot must not wait for the thread
+		* that destroys its own value. */
+		void Unregister(ScopeValueBase* const _value);
+
+		/** Sets the maximum number of signal calls per value per second */
+		void SetRate(const uint32_t& _rate);
+
+		/** @return the maximum number of signal calls per value per second */
+		uint32_t Rate() const { return rate; }
+	};
+
+}
@@ -0,0 +1,166 @@
+#include "stdafx.h"
+#include "ThreadPool.h"
+
+namespace scope {
+
+	namespace {
+		/** the pool the calling thread belongs to, nullptr for threads outside of pools */
+		thread_local ThreadPool* threadpool = nullptr;
+
+		/** index of the calling thread (and its deque) in its pool */
+		thread_local size_t threadindex = 0;
+	}
+
+	ThreadPool::ThreadPool(const uint32_t& _nthreads)
+		: pending(0)
+		, next(0)
+		, quit(false) {
+		const uint32_t n = (_nthreads == 0) ? std::max(4u, std::thread::hardware_concurrency()) : _nthreads;
+		for ( uint32_t i = 0 ; i < n ; i++ )
+			queues.push_back(std::make_unique<WorkQueue>());
+		for ( uint32_t i = 0 ; i < n ; i++ )
+			threads.push_back(std::thread(&ThreadPool::Loop, this, i));
+	}
+
+	ThreadPool::~ThreadPool() {
+		{
+			std::lock_guard<std::mutex> lock(idlemutex);
+			quit = true;
+		}
+		idle.notify_all();
+		for ( auto& t : threads )
+			t.join();
+	}
+
+	ThreadPool& ThreadPool::GetInstance() {
+		static ThreadPool instance;
+		return instance;
+	}
+
+	void ThreadPool::Submit(Task _task) {
+		const size_t i = (threadpool == this) ? threadindex : (next++ % queues.size());
+		{
+			std::lock_guard<std::mutex> lock(queues[i]->mutex);
+			queues[i]->tasks.push_back(std::move(_task));
+		}
+		{
+			std::lock_guard<std::mutex> lock(idlemutex);
+			++pending;
+		}
+		idle.notify_one();
+	}
+
+	bool ThreadPool::TryPop(const size_t& _i, Task& _task) {
+		std::lock_guard<std::mutex> lock(queues[_i]->mutex);
+		if ( queues[_i]->tasks.empty() )
+			return false;
+		_task = std::move(queues[_i]->tasks.front());
+		queues[_i]->tasks.pop_front();
+		--pending;
+		return true;
+	}
+
+	bool ThreadPool::TrySteal(const size_t& _i, Task& _task, bool& _missed) {
+		_missed = false;
+		for ( size_t k = 1 ; k < queues.size() ; k++ ) {
+			WorkQueue& victim = *queues[(_i + k) % queues.size()];
+			std::unique_lock<std::mutex> lock(victim.mutex, std::try_to_lock);
+			if ( !lock.owns_lock() ) {
+				_missed = true;
+				continue;
+			}
+			if ( victim.tasks.empty() )
+				continue;
+			_task = std::move(victim.tasks.back());
+			victim.tasks.pop_back();
+			--pending;
+			return true;
+		}
+		return false;
+	}
+
+	void ThreadPool::Loop(const size_t _i) {
+		threadpool = this;
+		threadindex = _i;
+		Task task;
+		bool missed = false;
+		for (;;) {
+			if ( TryPop(_i, task) || TrySteal(_i, task, missed) ) {
+				task();
+				task = nullptr;
+				continue;
+			}
+			// A locked deque may hold a task, try again and let another idle thread try too instead of sleeping
+			if ( missed ) {
+				idle.notify_one();
+				std::this_thread::yield();
+				continue;
+			}
+			// Submit counts a task in pending under idlemutex before notifying, thus no wakeup gets lost
+			std::unique_lock<std::mutex> lock(idlemutex);
+			idle.wait(lock, [this]() { return quit || (pending > 0); });
+			if ( quit && (pending <= 0) )
+				return;
+		}
+	}
+
+	Strand::Strand(ThreadPool& _pool)
+		: pool(_pool)
+		, scheduled(false)
+		, closed(false) {
+	}
+
+	Strand::~Strand() {
+		WaitIdle();
+	}
+
+	bool Strand::Post(std::unique_ptr<StrandTask>& _task) {
+		bool submit = false;
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			if ( closed )
+				return false;
+			tasks.push_back(std::move(_task));
+			submit = !scheduled;
+			scheduled = true;
+		}
+		if ( submit )
+			pool.Submit(std::bind(&Strand::Drain, this));
+		return true;
+	}
+
+	void Strand::Close() {
+		std::lock_guard<std::mutex> lock(mutex);
+		closed = true;
+	}
+
+	void Strand::Drain() {
+		for ( uint32_t n = 0 ; n < batchsize ; n++ ) {
+			std::unique_ptr<StrandTask> task;
+			{
+				std::lock_guard<std::mutex> lock(mutex);
+				if ( tasks.empty() ) {
+					scheduled = false;
+					drained.notify_all();
+					return;
+				}
+				task = std::move(tasks.front());
+				tasks.pop_front();
+			}
+			task->Run();
+		}
+		// Still scheduled, give the other strands a turn and continue later
+		pool.Submit(std::bind(&Strand::Drain, this));
+	}
+
+	void Strand::WaitIdle() {
+		std::unique_lock<std::mutex> lock(mutex);
+		drained.wait(lock, [this]() { return !scheduled; });
+	}
+
+	size_t Strand::Pending() const {
+		std::lock_guard<std::mutex> lock(mutex);
+		return tasks.size();
+	}
+
+}
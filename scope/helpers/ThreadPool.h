@@ -0,0 +1,147 @@
+#pragma once
+
+namespace scope {
+
+	/** A unit of work for a Strand, move-only so that it can own e.g. a promise without an extra shared_ptr
+	* @ingroup HELPERS */
+	class StrandTask {
+	public:
+		virtual ~StrandTask() { }
+
+		/** Executes the work */
+		virtual void Run() = 0;
+	};
+
+	/** A fixed number of threads shared by the whole program. Every thread has its own deque of tasks. Tasks submitted from a pool thread go into
+	* that thread's deque, tasks submitted from outside are distributed round-robin. A thread takes its own tasks oldest first (so that a resubmitted
+	* Strand queues up behind the others) and, if it has none, steals the newest tasks from the other threads.\n
+	* Tasks must not block waiting for other tasks of the pool, since there are only so many threads.
+	* @ingroup HELPERS */
+	class ThreadPool {
+
+	public:
+		/** the type of the tasks */
+		typedef std::function<void(void)> Task;
+
+	protected:
+		/** the deque of one thread */
+		struct WorkQueue {
+			std::mutex mutex;
+			std::deque<Task> tasks;
+		};
+
+		/** one deque for every thread */
+		std::vector<std::unique_ptr<WorkQueue>> queues;
+
+		/** number of submitted tasks not yet taken by a thread */
+		std::atomic<int64_t> pending;
+
+		/** next deque for tasks submitted from outside the pool */
+		std::atomic<uint32_t> next;
+
+		/** protects sleeping and waking up of idle threads */
+		std::mutex idlemutex;
+
+		/** idle threads wait on this */
+		std::condition_variable idle;
+
+		/** tells the threads to end when all tasks are done */
+		bool quit;
+
+		/** the threads */
+		std::vector<std::thread> threads;
+
+	protected:
+		/** @param[in] _nthreads number of threads, 0 for the number of CPUs (at least 4) */
+		ThreadPool(const uint32_t& _nthreads = 0);
+
+		/** Takes the oldest task from deque _i */
+		bool TryPop(const size_t& _i, Task& _task);
+
+		/** Takes the newest task from one of the other deques
+		* @param[out] _missed true if a deque was skipped because it was locked (it may have tasks) */
+		bool TrySteal(const size_t& _i, Task& _task, bool& _missed);
+
+		/** Loop of thread _i */
+		void Loop(const size_t _i);
+
+	public:
+		/** disable copy */
+		ThreadPool(const ThreadPool&) = delete;
+
+		/** disable assignment */
+		ThreadPool& operator=(const ThreadPool&) = delete;
+
+		/** Finishes all tasks and ends the threads */
+		~ThreadPool();
+
+		/** @return the program-wide pool */
+		static ThreadPool& GetInstance();
+
+		/** Queues a task for execution by one of the threads */
+		void Submit(Task _task);
+
+		/** @return the number of threads */
+		size_t Size() const { return threads.size(); }
+	};
+
+	/** Executes tasks serially and in the order they were posted, on the threads of a ThreadPool. Only one task of a strand runs at a
+	* time, different strands run in parallel. Thus a strand behaves like an own thread without needing one.
+	* @ingroup HELPERS */
+	class Strand {
+
+	protected:
+		/** the pool to run on */
+		ThreadPool& pool;
+
+		/** protects tasks, scheduled and closed */
+		mutable std::mutex mutex;
+
+		/** the posted tasks not yet executed */
+		std::deque<std::unique_ptr<StrandTask>> tasks;
+
+		/** true if a drain of this strand is submitted to the pool or running */
+		bool scheduled;
+
+		/** set by Close, Post does not take tasks anymore */
+		bool closed;
+
+		/** signalled when scheduled becomes false */
+		std::condition_variable drained;
+
+		/** at most that many tasks are executed in one go, then the drain is resubmitted to give other strands a turn */
+		static const uint32_t batchsize = 16;
+
+	protected:
+		/** Executes the posted tasks in order, runs on a pool thread */
+		void Drain();
+
+	public:
+		/** @param[in] _pool the pool to run on */
+		Strand(ThreadPool& _pool = ThreadPool::GetInstance());
+
+		/** Waits until all posted tasks are done */
+		~Strand();
+
+		/** disable copy */
+		Strand(const Strand&) = delete;
+
+		/** disable assignment */
+		Strand& operator=(const Strand&) = delete;
+
+		/** Queues a task, it is executed after all previously posted tasks
+		* @param[in,out] _task the task, taken over (and set to nullptr) unless the strand is closed
+		* @return false if the strand is closed, then _task stays with the caller */
+		bool Post(std::unique_ptr<StrandTask>& _task);
+
+		/** Lets Post reject all further tasks. Tasks posted before are still executed (see WaitIdle). */
+		void Close();
+
+		/** Waits until all tasks posted so far are done. Do not call from a task of this strand. */
+		void WaitIdle();
+
+		/** @return number of posted tasks not yet started */
+		size_t Pending() const;
+	};
+
+}
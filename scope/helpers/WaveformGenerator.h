@@ -0,0 +1,20 @@
+#pragma once
+
+namespace scope {
+
+	/** Synthesizes interleaved output samples block by block, for outputs that stream instead of writing one precalculated vector
+	* to a regenerating device buffer (see Outputs::Streaming).
+	* @ingroup HELPERS */
+	class WaveformGenerator {
+	public:
+		virtual ~WaveformGenerator() { }
+
+		/** Fills _samples interleaved xyzp samples (4 * _samples values) of the periodic waveform. May be called from another thread
+		* than the one updating the waveform.
+		* @param[in] _start position of the first sample, counted from the start of the output (wraps around at the period)
+		* @param[in] _samples number of samples per channel
+		* @param[out] _xyzp where to write to */
+		virtual void Generate(const uint64_t& _start, const uint32_t& _samples, int16_t* const _xyzp) const = 0;
+	};
+
+}
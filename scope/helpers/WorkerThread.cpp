@@ -0,0 +1,111 @@
+#include "stdafx.h"
+#include "WorkerThread.h"
+#include "controllers/ScopeLogger.h"
+
+namespace scope {
+
+	WorkerThreadSettings::WorkerThreadSettings(const std::wstring& _name, const int32_t& _priority, const uint64_t& _affinity)
+		: name(_name)
+		, priority(_priority)
+		, affinity(_affinity) {
+	}
+
+	bool WorkerThreadSettings::operator==(const WorkerThreadSettings& _other) const {
+		return (name == _other.name) && (priority == _other.priority) && (affinity == _other.affinity);
+	}
+
+	WorkerThread::WorkerThread(const WorkerThreadSettings& _settings)
+		: busy(false)
+		, quit(false)
+		, settings(_settings)
+		, settingschanged(true)
+		, thread(&WorkerThread::Loop, this) {
+	}
+
+	WorkerThread::~WorkerThread() {
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			quit = true;
+		}
+		wakeup.notify_all();
+		if ( thread.joinable() )
+			thread.join();
+	}
+
+	void WorkerThread::Loop() {
+		std::unique_lock<std::mutex> lock(mutex);
+		for (;;) {
+			wakeup.wait(lock, [this]() { return quit || settingschanged || static_cast<bool>(job); });
+			if ( settingschanged ) {
+				settingschanged = false;
+				const WorkerThreadSettings s(settings);
+				lock.unlock();
+				ApplySettings(s);
+				lock.lock();
+				continue;
+			}
+			// Quit only after a pending job is done
+			if ( !job )
+				return;
+			std::function<void(void)> current;
+			current.swap(job);
+			lock.unlock();
+			current();
+			lock.lock();
+			busy = false;
+			idle.notify_all();
+		}
+	}
+
+	void WorkerThread::ApplySettings(const WorkerThreadSettings& _settings) {
+		const HANDLE self = GetCurrentThread();
+
+		// SetThreadDescription is only available since Windows 10 1607
+		typedef HRESULT(WINAPI *SetThreadDescriptionType)(HANDLE, PCWSTR);
+		static const SetThreadDescriptionType setthreaddescription = reinterpret_cast<SetThreadDescriptionType>(GetProcAddress(GetModuleHandle(L"kernel32.dll"), "SetThreadDescription"));
+		if ( (setthreaddescription != nullptr) && !_settings.name.empty() )
+			setthreaddescription(self, _settings.name.c_str());
+
+		if ( !SetThreadPriority(self, _settings.priority) )
+			ScopeLogger::GetInstance().Log(L"Could not set priority " + std::to_wstring(_settings.priority) + L" of thread " + _settings.name, log_warning);
+
+		DWORD_PTR affinity = static_cast<DWORD_PTR>(_settings.affinity);
+		DWORD_PTR systemaffinity = 0;
+		if ( affinity == 0 )
+			GetProcessAffinityMask(GetCurrentProcess(), &affinity, &systemaffinity);
+		if ( SetThreadAffinityMask(self, affinity) == 0 )
+			ScopeLogger::GetInstance().Log(L"Could not set CPU affinity of thread " + _settings.name, log_warning);
+	}
+
+	void WorkerThread::Configure(const WorkerThreadSettings& _settings) {
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			if ( settings == _settings )
+				return;
+			settings = _settings;
+			settingschanged = true;
+		}
+		wakeup.notify_all();
+	}
+
+	void WorkerThread::Execute(std::function<void(void)> _job) {
+		{
+			std::unique_lock<std::mutex> lock(mutex);
+			idle.wait(lock, [this]() { return !busy; });
+			job = std::move(_job);
+			busy = true;
+		}
+		wakeup.notify_all();
+	}
+
+	void WorkerThread::WaitIdle() {
+		std::unique_lock<std::mutex> lock(mutex);
+		idle.wait(lock, [this]() { return !busy; });
+	}
+
+	bool WorkerThread::Busy() const {
+		std::lock_guard<std::mutex> lock(mutex);
+		return busy;
+	}
+
+}
@@ -0,0 +1,89 @@
+#pragma once
+
+namespace scope {
+
+	/** Name, priority and CPU affinity of a WorkerThread
+	* @ingroup HELPERS */
+	struct WorkerThreadSettings {
+		/** name of the thread, shown in the debugger and in profilers */
+		std::wstring name;
+
+		/** Windows thread priority (THREAD_PRIORITY_IDLE ... THREAD_PRIORITY_TIME_CRITICAL) */
+		int32_t priority;
+
+		/** CPU affinity mask, 0 for all CPUs of the process */
+		uint64_t affinity;
+
+		WorkerThreadSettings(const std::wstring& _name = L"", const int32_t& _priority = THREAD_PRIORITY_NORMAL, const uint64_t& _affinity = 0);
+
+		bool operator==(const WorkerThreadSettings& _other) const;
+	};
+
+	/** A long-lived thread that parks until it gets a job, runs it and parks again. Saves creating a thread on every run and keeps
+	* name, priority and affinity of the thread (see BaseController).
+	* @ingroup HELPERS */
+	class WorkerThread {
+
+	protected:
+		/** protects everything below */
+		mutable std::mutex mutex;
+
+		/** wakes the thread for a new job, new settings or quitting */
+		std::condition_variable wakeup;
+
+		/** signalled when a job is done */
+		std::condition_variable idle;
+
+		/** the next job, empty if none */
+		std::function<void(void)> job;
+
+		/** true from Execute until the job is done */
+		bool busy;
+
+		/** tells the thread to end */
+		bool quit;
+
+		/** the settings to apply */
+		WorkerThreadSettings settings;
+
+		/** true if the settings have to be applied */
+		bool settingschanged;
+
+		/** the thread (initialize last!) */
+		std::thread thread;
+
+	protected:
+		/** Loop of the thread */
+		void Loop();
+
+		/** Sets name, priority and affinity of the calling thread */
+		static void ApplySettings(const WorkerThreadSettings& _settings);
+
+	public:
+		/** Starts the thread, it parks until the first job */
+		WorkerThread(const WorkerThreadSettings& _settings = WorkerThreadSettings());
+
+		/** Waits until a running job is done and ends the thread */
+		~WorkerThread();
+
+		/** disable copy */
+		WorkerThread(const WorkerThread&) = delete;
+
+		/** disable assignment */
+		WorkerThread& operator=(const WorkerThread&) = delete;
+
+		/** Changes the settings, they are applied before the next job (immediately if the thread is idle) */
+		void Configure(const WorkerThreadSettings& _settings);
+
+		/** Hands a job to the thread. If the thread is still busy with the previous job, waits until that one is done.
+		* @param[in] _job has to handle its exceptions itself */
+		void Execute(std::function<void(void)> _job);
+
+		/** Waits until the current job (if any) is done */
+		void WaitIdle();
+
+		/** @return true if a job is pending or running */
+		bool Busy() const;
+	};
+
+}
@@ -19,3 +19,23 @@ std::wstring GetCurrentTimeString(const bool& _filenamecompatible) {
 		stream << std::setfill(L'0') << std::setw(2) << st.wHour << L":" << std::setw(2) << st.wMinute << L":" << std::setw(2) << st.wSecond;
 	return stream.str();
 }
+
+std::vector<std::wstring> SplitCommandLine(const std::wstring& _cmdline) {
+	std::vector<std::wstring> args;
+	std::wstring current(L"");
+	bool quoted = false;
+	for ( const wchar_t& c : _cmdline ) {
+		if ( c == L'"' )
+			quoted = !quoted;
+		else if ( iswspace(c) && !quoted ) {
+			if ( !current.empty() )
+				args.push_back(current);
+			current.clear();
+		}
+		else
+			current += c;
+	}
+	if ( !current.empty() )
+		args.push_back(current);
+	return args;
+}
@@ -58,6 +58,10 @@ std::wstring GetCurrentDateString();
 std::wstring GetCurrentTimeString(const bool& _filenamecompatible = true);
 /** @} */
 
+/** Splits a command line at whitespace, double quotes group arguments with spaces (e.g. paths) and are removed
+* @return the arguments, e.g. /trace="C:\my traces\a.json" /x gives /trace=C:\my traces\a.json and /x */
+std::vector<std::wstring> SplitCommandLine(const std::wstring& _cmdline);
+
 /** Tag for ScopeMessage */
 enum class ScopeMessageTag { nothing, abort };
 
@@ -27,6 +27,10 @@ namespace scope {
 			scannervectorframesmap.emplace(ScannerVectorTypeHelper::Mode::ResonanceBiDi, ScannerVectorFrameBasic::Factory(ScannerVectorTypeHelper::Mode::ResonanceBiDi));
 			scannervectorframesmap.emplace(ScannerVectorTypeHelper::Mode::ResonanceHopper, ScannerVectorFrameBasic::Factory(ScannerVectorTypeHelper::Mode::ResonanceHopper));
 			scannervectorframesmap.emplace(ScannerVectorTypeHelper::Mode::LineStraight, ScannerVectorFrameBasic::Factory(ScannerVectorTypeHelper::Mode::LineStraight));
+			scannervectorframesmap.emplace(ScannerVectorTypeHelper::Mode::MultiROI, ScannerVectorFrameBasic::Factory(ScannerVectorTypeHelper::Mode::MultiROI));
+			scannervectorframesmap.emplace(ScannerVectorTypeHelper::Mode::Volume, ScannerVectorFrameBasic::Factory(ScannerVectorTypeHelper::Mode::Volume));
+			scannervectorframesmap.emplace(ScannerVectorTypeHelper::Mode::Lissajous, ScannerVectorFrameBasic::Factory(ScannerVectorTypeHelper::Mode::Lissajous));
+			scannervectorframesmap.emplace(ScannerVectorTypeHelper::Mode::Spiral, ScannerVectorFrameBasic::Factory(ScannerVectorTypeHelper::Mode::Spiral));
 
 			InitializeConnections();
 		}
@@ -98,7 +102,10 @@ namespace scope {
 			daq.Load(pt.get_child(L"daq"));
 
 			for (auto& sv : scannervectorframesmap) {
-				sv.second->Load(pt.get_child(ScannerVectorTypeHelper::NameOf(sv.first)));
+				// Scan modes added later are missing in older parameter files, they keep their defaults then
+				const auto ptsv = pt.get_child_optional(ScannerVectorTypeHelper::NameOf(sv.first));
+				if ( ptsv )
+					sv.second->Load(*ptsv);
 			}
 
 			fpuzstage.Load(pt.get_child(L"fpuzstage"));
@@ -112,6 +112,26 @@ namespace scope {
 				return dynamic_cast<ScannerVectorFramePlaneHopper*>(scannervectorframesmap.at(ScannerVectorTypeHelper::Planehopper).get());
 			}
 
+			virtual ScannerVectorFrameMultiROI* FrameMultiROI() const {
+				return dynamic_cast<ScannerVectorFrameMultiROI*>(scannervectorframesmap.at(ScannerVectorTypeHelper::MultiROI).get());
+			}
+
+			virtual ScannerVectorLine* Line() const {
+				return dynamic_cast<ScannerVectorLine*>(scannervectorframesmap.at(ScannerVectorTypeHelper::LineStraight).get());
+			}
+
+			virtual ScannerVectorFrameVolume* FrameVolume() const {
+				return dynamic_cast<ScannerVectorFrameVolume*>(scannervectorframesmap.at(ScannerVectorTypeHelper::Volume).get());
+			}
+
+			virtual ScannerVectorLissajous* Lissajous() const {
+				return dynamic_cast<ScannerVectorLissajous*>(scannervectorframesmap.at(ScannerVectorTypeHelper::Lissajous).get());
+			}
+
+			virtual ScannerVectorSpiral* Spiral() const {
+				return dynamic_cast<ScannerVectorSpiral*>(scannervectorframesmap.at(ScannerVectorTypeHelper::Spiral).get());
+			}
+
 
 			void Load(const wptree& pt) override;
 			void Save(wptree& pt) const override;
@@ -21,7 +21,11 @@ namespace parameters {
 			, scannerdelay(0, -500, 500, L"Scannerdelay_us")
 			, averages(1, 1, 32, L"Averages")
 			, requested_frames(1, 1, 10000, L"RequestedFrames")
-			, resonance_frequency(7910, 3000, 10000, L"ResonanceFrequency_Hz") {
+			, resonance_frequency(7910, 3000, 10000, L"ResonanceFrequency_Hz")
+			, recordfile(L"", L"RecordInputsFile")
+			, replayfile(L"", L"ReplayInputsFile")
+			, replayrealtime(true, false, true, L"ReplayRealtime")
+			, replayloop(true, false, true, L"ReplayLoop") {
 
 			// Pixeltime lower limit is maximum of minimum pixel times of inputs and outputs (important for FPGA/DAQmx combinations)
 			pixeltime.SetLimits(std::max(inputs->MinimumPixeltime(), outputs->MinimumPixeltime()), pixeltime.ul());
@@ -38,7 +42,11 @@ namespace parameters {
 			, scannerdelay(_daq.scannerdelay)
 			, averages(_daq.averages)
 			, requested_frames(_daq.requested_frames)
-			, resonance_frequency(_daq.resonance_frequency) {
+			, resonance_frequency(_daq.resonance_frequency)
+			, recordfile(_daq.recordfile)
+			, replayfile(_daq.replayfile)
+			, replayrealtime(_daq.replayrealtime)
+			, replayloop(_daq.replayloop) {
 
 			// Pixeltime lower limit is maximum of minimum pixel times of inputs and outputs (important for FPGA/DAQmx combinations)
 			pixeltime.SetLimits(std::max(inputs->MinimumPixeltime(), outputs->MinimumPixeltime()), pixeltime.ul());
@@ -59,6 +67,10 @@ namespace parameters {
 			averages = _daq.averages;
 			requested_frames = _daq.requested_frames;
 			resonance_frequency = _daq.resonance_frequency;
+			recordfile = _daq.recordfile;
+			replayfile = _daq.replayfile;
+			replayrealtime = _daq.replayrealtime;
+			replayloop = _daq.replayloop;
 
 			// Pixeltime lower limit is maximum of minimum pixel times of inputs and outputs (important for FPGA/DAQmx combinations)
 			pixeltime.SetLimits(std::max(inputs->MinimumPixeltime(), outputs->MinimumPixeltime()), pixeltime.ul());
@@ -84,6 +96,10 @@ namespace parameters {
 			averages.SetFromPropertyTree(_pt);
 			requested_frames.SetFromPropertyTree(_pt);
 			resonance_frequency.SetFromPropertyTree(_pt);
+			recordfile.SetFromPropertyTree(_pt);
+			replayfile.SetFromPropertyTree(_pt);
+			replayrealtime.SetFromPropertyTree(_pt);
+			replayloop.SetFromPropertyTree(_pt);
 			// easier than to connect from samplingtype, maxrateaggregate, and channels
 			pixeltime.SetLimits(std::max(inputs->MinimumPixeltime(), outputs->MinimumPixeltime()), pixeltime.ul());
 		}
@@ -102,6 +118,10 @@ namespace parameters {
 			averages.AddToPropertyTree(_pt);
 			requested_frames.AddToPropertyTree(_pt);
 			resonance_frequency.AddToPropertyTree(_pt);
+			recordfile.AddToPropertyTree(_pt);
+			replayfile.AddToPropertyTree(_pt);
+			replayrealtime.AddToPropertyTree(_pt);
+			replayloop.AddToPropertyTree(_pt);
 		}
 
 		void Daq::SetReadOnlyWhileScanning(const RunState& _runstate) {
@@ -112,6 +132,8 @@ namespace parameters {
 					pixeltime.SetRWState(true);
 					averages.SetRWState(true);
 					scannerdelay.SetRWState(true);
+					recordfile.SetRWState(true);
+					replayfile.SetRWState(true);
 					break;
 				// RESONANCE CODE
 				case RunStateHelper::Mode::RunningSingle:
@@ -128,6 +150,8 @@ namespace parameters {
 				default:
 					pixeltime.SetRWState(false);
 					averages.SetRWState(false);
+					recordfile.SetRWState(false);
+					replayfile.SetRWState(false);
 			}
 		}
 
@@ -64,6 +64,18 @@ public:
 	/** frequency of the resonance scanner used, which is especially the frequency of the synchronization signal */
 	ScopeNumber<uint32_t> resonance_frequency;
 
+	/** if not empty, all chunks read from the inputs are recorded into this file, numbered for every cold start (see InputsRecorder) */
+	ScopeString recordfile;
+
+	/** if not empty, inputs are replayed from this recording instead of read from the hardware (see InputsReplay) */
+	ScopeString replayfile;
+
+	/** replay at the recorded pace if true, as fast as possible if false */
+	ScopeNumber<bool> replayrealtime;
+
+	/** start over at the end of the recording during replay */
+	ScopeNumber<bool> replayloop;
+
 	/** @return the scanner delay in samples */
 	int32_t ScannerDelaySamples(const bool& _respectoversampling) const;
  
@@ -13,7 +13,10 @@ XYZControl::XYZControl()
 	: xpos(0, -10000, 10000, L"XPosition_um")
 	, ypos(0, -10000, 10000, L"YPosition_um")
 	, zpos(0, -10000, 10000, L"ZPosition_um")
-	, pollinterval(1000, 0, 10000, L"PollInterval_ms") {
+	, pollinterval(1000, 0, 10000, L"PollInterval_ms")
+	, settletime(50, 0, 5000, L"SettleTime_ms")
+	, settletimeperum(0, 0, 100, L"SettleTimePerMicrometer_ms")
+	, movetimeout(5000, 100, 60000, L"MoveTimeout_ms") {
 }
 
 void XYZControl::Load(const wptree& pt) {
@@ -21,6 +24,9 @@ void XYZControl::Load(const wptree& pt) {
 	ypos.SetFromPropertyTree(pt);
 	zpos.SetFromPropertyTree(pt);
 	pollinterval.SetFromPropertyTree(pt);
+	settletime.SetFromPropertyTree(pt);
+	settletimeperum.SetFromPropertyTree(pt);
+	movetimeout.SetFromPropertyTree(pt);
 }
 
 void XYZControl::Save(wptree& pt) const {
@@ -28,6 +34,9 @@ void XYZControl::Save(wptree& pt) const {
 	ypos.AddToPropertyTree(pt);
 	zpos.AddToPropertyTree(pt);
 	pollinterval.AddToPropertyTree(pt);
+	settletime.AddToPropertyTree(pt);
+	settletimeperum.AddToPropertyTree(pt);
+	movetimeout.AddToPropertyTree(pt);
 }
 
 XYZControlGalil::XYZControlGalil()
@@ -70,6 +79,20 @@ void XYZControlSutter::Save(wptree& pt) const {
 	microstepspermicron.AddToPropertyTree(pt);
 }
 
+XYZControlSimulated::XYZControlSimulated()
+	: velocity(500, 1, 100000, L"Velocity_umps") {
+}
+
+void XYZControlSimulated::Load(const wptree& pt) {
+	XYZControl::Load(pt);
+	velocity.SetFromPropertyTree(pt);
+}
+
+void XYZControlSimulated::Save(wptree& pt) const {
+	XYZControl::Save(pt);
+	velocity.AddToPropertyTree(pt);
+}
+
 FastZControl::FastZControl()
 	: minoutput(0, -10, 10, L"MinOutput_V")
 	, maxoutput(4, -10, 10, L"MaxOutput_V")
@@ -96,6 +119,18 @@ bool FastZControl::LoadCalibration(const std::wstring& _filepath) {
 }
 
 double FastZControl::PositionToVoltage(const double& _positionum) {
+	const double zvolt = Interpolate(_positionum);
+	DBOUT(L"New ETL voltage: " << zvolt);
+	return zvolt;
+}
+
+std::vector<double> FastZControl::PositionsToVoltages(const std::vector<double>& _positionsum) const {
+	std::vector<double> zvolts(_positionsum.size());
+	std::transform(std::begin(_positionsum), std::end(_positionsum), std::begin(zvolts), [this](const double& _pos) { return Interpolate(_pos); });
+	return zvolts;
+}
+
+double FastZControl::Interpolate(const double& _positionum) const {
 	double zvolt = 0;
 	auto hit = calibration.find(_positionum);
 	if ( hit != calibration.end() ) {
@@ -115,7 +150,6 @@ double FastZControl::PositionToVoltage(const double& _positionum) {
 	double divider = (upper->first - lower->first);
 	divider = (divider==0)?1:divider;							// avoid division by zero
 	zvolt = ((upper->second - lower->second) / divider ) * (_positionum - lower->first) + lower->second;
-	DBOUT(L"New ETL voltage: " << zvolt);
 	return zvolt;
 }
 
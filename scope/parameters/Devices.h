@@ -32,6 +32,18 @@ public:
 	/** interval in milliseconds to poll device, be careful: long intervals slow quitting of Scope (since to stop the polling thread Scope has to wait until the polling thread does something). */
 	ScopeNumber<double> pollinterval;
 
+	/** @name Settle time model: after the device reports motion complete we wait settletime + settletimeperum * distance for vibrations to decay
+	* @{ */
+	/** constant part of the settle time in milliseconds */
+	ScopeNumber<double> settletime;
+
+	/** distance dependent part of the settle time in milliseconds per micrometer */
+	ScopeNumber<double> settletimeperum;
+	/** @} */
+
+	/** maximum time in milliseconds to wait for a move to complete */
+	ScopeNumber<double> movetimeout;
+
 	void Load(const wptree& pt) override;
 	void Save(wptree& pt) const override;
 };
@@ -79,6 +91,21 @@ public:
 	void Save(wptree& pt) const override;
 };
 
+/** Parameters for a simulated XYZ stage without hardware, for testing stack acquisition
+* @ingroup ScopeComponentsHardware
+* @ingroup ScopeParameters */
+class XYZControlSimulated
+	: public XYZControl {
+public:
+	XYZControlSimulated();
+
+	/** velocity of the simulated movement in micrometers per second */
+	ScopeNumber<double> velocity;
+
+	void Load(const wptree& pt) override;
+	void Save(wptree& pt) const override;
+};
+
 /** Parameters for a fast Z drive that is controlled by a voltage. Voltage is only generated during scanning in DaqControllerImpl
 * via OutputsDAQmx. No device initialization etc needed. Parameters handle transformation from micrometer to voltage by a calibration
 * map that can be loaded etc. 
@@ -111,6 +138,18 @@ public:
 	/** Converts a position in micron to voltage */
 	virtual double PositionToVoltage(const double& _positionum);
 
+	/** Converts many positions at once, e.g. one per scan line for a continuous z waveform. Interpolates the calibration like PositionToVoltage
+	* but without the debug output per position.
+	* @param[in] _positionsum positions in micron
+	* @return voltage lookup table, one voltage per position */
+	virtual std::vector<double> PositionsToVoltages(const std::vector<double>& _positionsum) const;
+
+protected:
+	/** @return voltage for _positionum, linearly interpolated between the neighbouring calibration points */
+	double Interpolate(const double& _positionum) const;
+
+public:
+
 	void Load(const wptree& pt) override;
 	void Save(wptree& pt) const override;
 };
@@ -175,6 +175,16 @@ namespace parameters {
 				return (_o==nullptr)?ScannerVectorFramePlaneHopper::Create():ScannerVectorFramePlaneHopper::Create(*dynamic_cast<const ScannerVectorFramePlaneHopper*>(_o));
 			case ScannerVectorTypeHelper::ResonanceBiDi:
 				return (_o == nullptr) ? ScannerVectorFrameResonance::Create() : ScannerVectorFrameResonance::Create(*dynamic_cast<const ScannerVectorFrameResonance*>(_o));
+			case ScannerVectorTypeHelper::MultiROI:
+				return (_o==nullptr)?ScannerVectorFrameMultiROI::Create():ScannerVectorFrameMultiROI::Create(*dynamic_cast<const ScannerVectorFrameMultiROI*>(_o));
+			case ScannerVectorTypeHelper::LineStraight:
+				return (_o==nullptr)?ScannerVectorLine::Create():ScannerVectorLine::Create(*dynamic_cast<const ScannerVectorLine*>(_o));
+			case ScannerVectorTypeHelper::Volume:
+				return (_o==nullptr)?ScannerVectorFrameVolume::Create():ScannerVectorFrameVolume::Create(*dynamic_cast<const ScannerVectorFrameVolume*>(_o));
+			case ScannerVectorTypeHelper::Lissajous:
+				return (_o==nullptr)?ScannerVectorLissajous::Create():ScannerVectorLissajous::Create(*dynamic_cast<const ScannerVectorLissajous*>(_o));
+			case ScannerVectorTypeHelper::Spiral:
+				return (_o==nullptr)?ScannerVectorSpiral::Create():ScannerVectorSpiral::Create(*dynamic_cast<const ScannerVectorSpiral*>(_o));
 			default:
 				return (_o==nullptr)?ScannerVectorFrameBasic::Create():ScannerVectorFrameBasic::Create(*dynamic_cast<const ScannerVectorFrameBasic*>(_o));
 			}
@@ -226,7 +236,8 @@ namespace parameters {
 			: xcutoff(0.1, 0, 0.5, L"XCutoff_Fraction")
 			, ycutoff(0.1, 0, 0.5, L"YCutoff_Fraction")
 			, xretrace(0.1, 0, 0.5, L"XRetrace_Fraction")
-			, yretrace(0.1, 0, 0.5, L"YRetrace_Fraction") {
+			, yretrace(0.1, 0, 0.5, L"YRetrace_Fraction")
+			, linerepeats(1, 1, 64, L"LineRepeats") {
 		}
 
 		std::vector<boost::signals2::connection> ScannerVectorFrameSaw::ConnectCopyTrigger(signalchange_t::slot_type _slot) {
@@ -235,6 +246,7 @@ namespace parameters {
 			conns.push_back(ycutoff.ConnectOther(_slot));
 			conns.push_back(xretrace.ConnectOther(_slot));
 			conns.push_back(yretrace.ConnectOther(_slot));
+			conns.push_back(linerepeats.ConnectOther(_slot));
 			return conns;
 		}
 
@@ -244,6 +256,7 @@ namespace parameters {
 			ycutoff.ConnectOther(_slot);
 			xretrace.ConnectOther(_slot);
 			yretrace.ConnectOther(_slot);
+			linerepeats.ConnectOther(_slot);
 		}
 
 		void ScannerVectorFrameSaw::ConnectMicronPerPixelUpdate(signalchange_t::slot_type _slot) {
@@ -266,7 +279,8 @@ namespace parameters {
 			: xcutoff(0.1, 0, 0.5, L"XCutoff_Fraction")
 			, ycutoff(0.1, 0, 0.5, L"YCutoff_Fraction")
 			, xretrace(0.1, 0, 0.5, L"XRetrace_Fraction")
-			, yretrace(0.1, 0, 0.5, L"YRetrace_Fraction")  {
+			, yretrace(0.1, 0, 0.5, L"YRetrace_Fraction")
+			, linerepeats(1, 1, 64, L"LineRepeats") {
 		}
 
 		void ScannerVectorFrameSaw::Preset::Load(const wptree& pt)  {
@@ -275,6 +289,7 @@ namespace parameters {
 			ycutoff.SetFromPropertyTree(pt);
 			xretrace.SetFromPropertyTree(pt);
 			yretrace.SetFromPropertyTree(pt);
+			linerepeats.SetFromPropertyTree(pt);
 		}
 
 		void ScannerVectorFrameSaw::Preset::Save(wptree& pt) const {
@@ -283,6 +298,7 @@ namespace parameters {
 			ycutoff.AddToPropertyTree(pt);
 			xretrace.AddToPropertyTree(pt);
 			yretrace.AddToPropertyTree(pt);
+			linerepeats.AddToPropertyTree(pt);
 		}
 
 		void ScannerVectorFrameSaw::Load(const wptree& pt) {
@@ -291,6 +307,7 @@ namespace parameters {
 			ycutoff.SetFromPropertyTree(pt);
 			xretrace.SetFromPropertyTree(pt);
 			yretrace.SetFromPropertyTree(pt);
+			linerepeats.SetFromPropertyTree(pt);
 		}
 
 		void ScannerVectorFrameSaw::Save(wptree& pt) const {
@@ -299,6 +316,7 @@ namespace parameters {
 			ycutoff.AddToPropertyTree(pt);
 			xretrace.AddToPropertyTree(pt);
 			yretrace.AddToPropertyTree(pt);
+			linerepeats.AddToPropertyTree(pt);
 		}
 
 		void ScannerVectorFrameSaw::SetReadOnlyWhileScanning(const RunState& _runstate) {
@@ -308,6 +326,7 @@ namespace parameters {
 			ycutoff.SetRWState(enabler);
 			xretrace.SetRWState(enabler);
 			yretrace.SetRWState(enabler);
+			linerepeats.SetRWState(enabler);
 
 		}
 
@@ -327,6 +346,7 @@ namespace parameters {
 			p->ycutoff = ycutoff();
 			p->xretrace = xretrace();
 			p->yretrace = yretrace();
+			p->linerepeats = linerepeats();
 			auto samename = std::find_if(std::begin(presets), std::end(presets), [&](std::shared_ptr<ScannerVectorFrameBasic::Preset> _pres)
 				{ return _pres->name() == _name; } );
 			if  ( presets.end() != samename )
@@ -352,6 +372,7 @@ namespace parameters {
 			ycutoff = dynamic_cast<ScannerVectorFrameSaw::Preset*>(which->get())->ycutoff();
 			xretrace = dynamic_cast<ScannerVectorFrameSaw::Preset*>(which->get())->xretrace();
 			yretrace = dynamic_cast<ScannerVectorFrameSaw::Preset*>(which->get())->yretrace();
+			linerepeats = dynamic_cast<ScannerVectorFrameSaw::Preset*>(which->get())->linerepeats();
 		}
 
 		ScannerVectorFrameBiDi::ScannerVectorFrameBiDi()
@@ -475,7 +496,7 @@ namespace parameters {
 		}
 
 		std::vector<boost::signals2::connection> ScannerVectorFramePlaneHopper::ConnectCopyTrigger(signalchange_t::slot_type _slot) {
-			std::vector<boost::signals2::connection> conns(ScannerVectorFrameBasic::ConnectCopyTrigger(_slot));
+			std::vector<boost::signals2::connection> conns(ScannerVectorFrameSaw::ConnectCopyTrigger(_slot));
 			for ( auto& p : planes ) {
 				conns.push_back(p.pockels.ConnectOther(_slot));
 				conns.push_back(p.position.ConnectOther(_slot));
@@ -484,24 +505,8 @@ namespace parameters {
 			return conns;
 		}
 
-		void ScannerVectorFramePlaneHopper::ConnectRateUpdate(signalchange_t::slot_type _slot) {
-			ScannerVectorFrameBasic::ConnectRateUpdate(_slot);
-			for ( auto& p : planes ) {
-				p.pockels.ConnectOther(_slot);
-				p.position.ConnectOther(_slot);
-			}
-		}
-
-		void ScannerVectorFramePlaneHopper::ConnectMicronPerPixelUpdate(signalchange_t::slot_type _slot) {
-			ScannerVectorFrameBasic::ConnectMicronPerPixelUpdate(_slot);
-			for ( auto& p : planes ) {
-				p.pockels.ConnectOther(_slot);
-				p.position.ConnectOther(_slot);
-			}
-		}
-
 		void ScannerVectorFramePlaneHopper::ConnectOnlineUpdate(signalchange_t::slot_type _slot) {
-			ScannerVectorFrameBasic::ConnectOnlineUpdate(_slot);
+			ScannerVectorFrameSaw::ConnectOnlineUpdate(_slot);
 			for ( auto& p : planes ) {
 				p.pockels.ConnectOther(_slot);
 				p.position.ConnectOther(_slot);
@@ -509,13 +514,27 @@ namespace parameters {
 		}
 
 		void ScannerVectorFramePlaneHopper::Preset::Load(const wptree& pt) {
-			ScannerVectorFrameBasic::Preset::Load(pt);
-	
+			ScannerVectorFrameSaw::Preset::Load(pt);
+			planes.clear();
+			try {
+				// Load until get_child throws
+				for ( uint32_t p = 0 ; p < 100 ; p++ ) {
+					PlaneProperties pl;
+					pl.Load(pt.get_child(boost::str(boost::wformat(L"Plane%d") % p)));
+					planes.push_back(pl);
+				}
+			}
+			catch (...) { }
 		}
 
 		void ScannerVectorFramePlaneHopper::Preset::Save(wptree& pt) const {
-			ScannerVectorFrameBasic::Preset::Save(pt);
-	
+			ScannerVectorFrameSaw::Preset::Save(pt);
+			uint32_t i = 0;
+			for ( const auto& pl : planes ) {
+				wptree wt;
+				pl.Save(wt);
+				pt.add_child(boost::str(boost::wformat(L"Plane%d") % i++), wt);
+			}
 		}
 
 		ScannerVectorFramePlaneHopper::ScannerVectorFramePlaneHopper()
@@ -523,7 +542,8 @@ namespace parameters {
 		}
 
 		void ScannerVectorFramePlaneHopper::Load(const wptree& pt) {
-			ScannerVectorFrameBasic::Load(pt);
+			ScannerVectorFrameSaw::Load(pt);
+			planes.clear();
 			try {
 				// Load until get_child throws
 				for ( uint32_t p = 0 ; p < 100 ; p++ ) {
@@ -536,7 +556,7 @@ namespace parameters {
 		}
 
 		void ScannerVectorFramePlaneHopper::Save(wptree& pt) const {
-			ScannerVectorFrameBasic::Save(pt);
+			ScannerVectorFrameSaw::Save(pt);
 			uint32_t i = 0;
 			for ( const auto& pl : planes ) {
 				wptree wt;
@@ -546,11 +566,12 @@ namespace parameters {
 		}
 
 		void ScannerVectorFramePlaneHopper::SetReadOnlyWhileScanning(const RunState& _runstate) {
-			ScannerVectorFrameBasic::SetReadOnlyWhileScanning(_runstate);
+			// Position and Pockels of the planes can be changed while scanning (online update)
+			ScannerVectorFrameSaw::SetReadOnlyWhileScanning(_runstate);
 		}
 
 		std::unique_ptr<ScannerVectorFrameBasic::Preset> ScannerVectorFramePlaneHopper::MakePreset() const {
-			return std::make_unique<ScannerVectorFrameBasic::Preset>();
+			return std::make_unique<Preset>();
 		}
 
 		void ScannerVectorFramePlaneHopper::SaveToPreset(const std::wstring& _name, const Daq& _daq) {
@@ -561,6 +582,10 @@ namespace parameters {
 			p->averages = _daq.averages();
 			p->xres = xres();
 			p->yres = yres();
+			p->xcutoff = xcutoff();
+			p->ycutoff = ycutoff();
+			p->xretrace = xretrace();
+			p->yretrace = yretrace();
 			p->planes = planes;
 			auto samename = std::find_if(std::begin(presets), std::end(presets), [&](std::shared_ptr<ScannerVectorFrameBasic::Preset> _pres)
 				{ return _pres->name() == _name; } );
@@ -581,7 +606,728 @@ namespace parameters {
 			xres = (*which)->xres();
 			yres = (*which)->yres();
 			// Casting from ScannerVectorFrameBasic::Preset to ScannerVectorFramePlaneHopper::Preset
-			planes = dynamic_cast<ScannerVectorFramePlaneHopper::Preset*>(which->get())->planes;
+			const ScannerVectorFramePlaneHopper::Preset* const preset = dynamic_cast<ScannerVectorFramePlaneHopper::Preset*>(which->get());
+			xcutoff = preset->xcutoff();
+			ycutoff = preset->ycutoff();
+			xretrace = preset->xretrace();
+			yretrace = preset->yretrace();
+			planes = preset->planes;
+		}
+
+		ScannerVectorFrameVolume::Preset::Preset()
+			: slices(10, 1, 100, L"Slices")
+			, zstart(0.0, -1000.0, 1000.0, L"ZStart_um")
+			, zstop(100.0, -1000.0, 1000.0, L"ZStop_um")
+			, continuousz(false, false, true, L"ContinuousZ") {
+		}
+
+		void ScannerVectorFrameVolume::Preset::Load(const wptree& pt) {
+			ScannerVectorFrameSaw::Preset::Load(pt);
+			slices.SetFromPropertyTree(pt);
+			zstart.SetFromPropertyTree(pt);
+			zstop.SetFromPropertyTree(pt);
+			continuousz.SetFromPropertyTree(pt);
+		}
+
+		void ScannerVectorFrameVolume::Preset::Save(wptree& pt) const {
+			ScannerVectorFrameSaw::Preset::Save(pt);
+			slices.AddToPropertyTree(pt);
+			zstart.AddToPropertyTree(pt);
+			zstop.AddToPropertyTree(pt);
+			continuousz.AddToPropertyTree(pt);
+		}
+
+		ScannerVectorFrameVolume::ScannerVectorFrameVolume()
+			: slices(10, 1, 100, L"Slices")
+			, zstart(0.0, -1000.0, 1000.0, L"ZStart_um")
+			, zstop(100.0, -1000.0, 1000.0, L"ZStop_um")
+			, continuousz(false, false, true, L"ContinuousZ") {
+		}
+
+		std::vector<boost::signals2::connection> ScannerVectorFrameVolume::ConnectCopyTrigger(signalchange_t::slot_type _slot) {
+			std::vector<boost::signals2::connection> conns(ScannerVectorFrameSaw::ConnectCopyTrigger(_slot));
+			conns.push_back(slices.ConnectOther(_slot));
+			conns.push_back(zstart.ConnectOther(_slot));
+			conns.push_back(zstop.ConnectOther(_slot));
+			conns.push_back(continuousz.ConnectOther(_slot));
+			return conns;
+		}
+
+		void ScannerVectorFrameVolume::ConnectRateUpdate(signalchange_t::slot_type _slot) {
+			ScannerVectorFrameSaw::ConnectRateUpdate(_slot);
+			slices.ConnectOther(_slot);
+		}
+
+		void ScannerVectorFrameVolume::ConnectOnlineUpdate(signalchange_t::slot_type _slot) {
+			ScannerVectorFrameSaw::ConnectOnlineUpdate(_slot);
+			zstart.ConnectOther(_slot);
+			zstop.ConnectOther(_slot);
+			continuousz.ConnectOther(_slot);
+		}
+
+		double ScannerVectorFrameVolume::SlicePosition(const uint32_t& _slice) const {
+			if ( slices() < 2 )
+				return zstart();
+			return zstart() + (zstop() - zstart()) * static_cast<double>(_slice) / static_cast<double>(slices() - 1);
+		}
+
+		void ScannerVectorFrameVolume::Load(const wptree& pt) {
+			ScannerVectorFrameSaw::Load(pt);
+			slices.SetFromPropertyTree(pt);
+			zstart.SetFromPropertyTree(pt);
+			zstop.SetFromPropertyTree(pt);
+			continuousz.SetFromPropertyTree(pt);
+		}
+
+		void ScannerVectorFrameVolume::Save(wptree& pt) const {
+			ScannerVectorFrameSaw::Save(pt);
+			slices.AddToPropertyTree(pt);
+			zstart.AddToPropertyTree(pt);
+			zstop.AddToPropertyTree(pt);
+			continuousz.AddToPropertyTree(pt);
+		}
+
+		void ScannerVectorFrameVolume::SetReadOnlyWhileScanning(const RunState& _runstate) {
+			// The z range and profile can be changed while scanning (online update), the number of slices changes the frame layout
+			ScannerVectorFrameSaw::SetReadOnlyWhileScanning(_runstate);
+			bool enabler = (static_cast<RunStateHelper::Mode>(_runstate)==RunStateHelper::Mode::Stopped)?true:false;
+			slices.SetRWState(enabler);
+		}
+
+		std::unique_ptr<ScannerVectorFrameBasic::Preset> ScannerVectorFrameVolume::MakePreset() const {
+			return std::make_unique<Preset>();
+		}
+
+		void ScannerVectorFrameVolume::SaveToPreset(const std::wstring& _name, const Daq& _daq) {
+			auto p = std::make_shared<Preset>();
+			p->name = _name;
+			p->pixeltime = _daq.pixeltime();
+			p->scannerdelay = _daq.scannerdelay();
+			p->averages = _daq.averages();
+			p->xres = xres();
+			p->yres = yres();
+			p->xcutoff = xcutoff();
+			p->ycutoff = ycutoff();
+			p->xretrace = xretrace();
+			p->yretrace = yretrace();
+			p->slices = slices();
+			p->zstart = zstart();
+			p->zstop = zstop();
+			p->continuousz = continuousz();
+			auto samename = std::find_if(std::begin(presets), std::end(presets), [&](std::shared_ptr<ScannerVectorFrameBasic::Preset> _pres)
+				{ return _pres->name() == _name; } );
+			if  ( presets.end() != samename )
+				presets.erase(samename);				// If name already exists, delete the old (thus overwrite)
+			presets.push_back(p);
+		}
+
+		void ScannerVectorFrameVolume::LoadFromPreset(const std::wstring& _name, Daq& _daq) {
+			auto which = std::find_if(std::begin(presets), std::end(presets), [&](std::shared_ptr<ScannerVectorFrameBasic::Preset> _pres)
+				{ return _pres->name() == _name; } );
+			if ( which == std::end(presets) )
+				return ;
+			_daq.pixeltime = (*which)->pixeltime();
+			_daq.scannerdelay = (*which)->scannerdelay();
+			_daq.averages = (*which)->averages();
+			xres = (*which)->xres();
+			yres = (*which)->yres();
+			// Casting from ScannerVectorFrameBasic::Preset to ScannerVectorFrameVolume::Preset
+			const ScannerVectorFrameVolume::Preset* const preset = dynamic_cast<ScannerVectorFrameVolume::Preset*>(which->get());
+			xcutoff = preset->xcutoff();
+			ycutoff = preset->ycutoff();
+			xretrace = preset->xretrace();
+			yretrace = preset->yretrace();
+			slices = preset->slices();
+			zstart = preset->zstart();
+			zstop = preset->zstop();
+			continuousz = preset->continuousz();
+		}
+
+		ScannerVectorFrameMultiROI::ScannerVectorFrameMultiROI()
+			: xcutoff(0.1, 0, 0.5, L"XCutoff_Fraction")
+			, xretrace(0.1, 0, 0.5, L"XRetrace_Fraction")
+			, flybackpixels(64, 1, 100000, L"Flyback_Pixels")
+			, rois(1) {
+		}
+
+		std::vector<boost::signals2::connection> ScannerVectorFrameMultiROI::ConnectCopyTrigger(signalchange_t::slot_type _slot) {
+			std::vector<boost::signals2::connection> conns(ScannerVectorFrameBasic::ConnectCopyTrigger(_slot));
+			conns.push_back(xcutoff.ConnectOther(_slot));
+			conns.push_back(xretrace.ConnectOther(_slot));
+			conns.push_back(flybackpixels.ConnectOther(_slot));
+			return conns;
+		}
+
+		void ScannerVectorFrameMultiROI::ConnectRateUpdate(signalchange_t::slot_type _slot) {
+			ScannerVectorFrameBasic::ConnectRateUpdate(_slot);
+			xcutoff.ConnectOther(_slot);
+			xretrace.ConnectOther(_slot);
+			flybackpixels.ConnectOther(_slot);
+		}
+
+		void ScannerVectorFrameMultiROI::ConnectOnlineUpdate(signalchange_t::slot_type _slot) {
+			ScannerVectorFrameBasic::ConnectOnlineUpdate(_slot);
+			xcutoff.ConnectOther(_slot);
+			xretrace.ConnectOther(_slot);
+			flybackpixels.ConnectOther(_slot);
+		}
+
+		std::vector<ScannerVectorFrameMultiROI::ROIGeometry> ScannerVectorFrameMultiROI::ROIGeometries() const {
+			std::vector<ROIGeometry> geometries;
+			for ( const auto& r : rois ) {
+				ROIGeometry g;
+				g.column = round2ui32(r.left() * xres());
+				g.row = round2ui32(r.top() * yres());
+				const uint32_t right = round2ui32(r.Right() * xres());
+				const uint32_t bottom = round2ui32(r.Bottom() * yres());
+				g.pixels = (right > g.column) ? right - g.column : 0;
+				g.lines = (bottom > g.row) ? bottom - g.row : 0;
+				if ( (g.pixels == 0) || (g.lines == 0) )
+					continue;
+				g.cutoff = round2ui32(xcutoff() * g.pixels);
+				g.retrace = round2ui32(xretrace() * g.pixels);
+				geometries.push_back(g);
+			}
+			// Without any usable region scan the whole field
+			if ( geometries.empty() ) {
+				ROIGeometry g;
+				g.column = 0;
+				g.row = 0;
+				g.pixels = xres();
+				g.lines = yres();
+				g.cutoff = round2ui32(xcutoff() * g.pixels);
+				g.retrace = round2ui32(xretrace() * g.pixels);
+				geometries.push_back(g);
+			}
+			return geometries;
+		}
+
+		uint32_t ScannerVectorFrameMultiROI::XTotalPixels() const {
+			uint32_t longest = 0;
+			for ( const auto& g : ROIGeometries() )
+				longest = std::max(longest, g.LineSamples());
+			return longest;
+		}
+
+		uint32_t ScannerVectorFrameMultiROI::YTotalLines() const {
+			uint32_t lines = 0;
+			for ( const auto& g : ROIGeometries() )
+				lines += g.lines;
+			return lines;
+		}
+
+		uint32_t ScannerVectorFrameMultiROI::TotalPixels() const {
+			uint32_t pixels = 0;
+			for ( const auto& g : ROIGeometries() )
+				pixels += g.lines * g.LineSamples() + flybackpixels();
+			return pixels;
+		}
+
+		ScannerVectorFrameMultiROI::Preset::Preset()
+			: xcutoff(0.1, 0, 0.5, L"XCutoff_Fraction")
+			, xretrace(0.1, 0, 0.5, L"XRetrace_Fraction")
+			, flybackpixels(64, 1, 100000, L"Flyback_Pixels")
+			, rois(1) {
+		}
+
+		void ScannerVectorFrameMultiROI::Preset::Load(const wptree& pt) {
+			ScannerVectorFrameBasic::Preset::Load(pt);
+			xcutoff.SetFromPropertyTree(pt);
+			xretrace.SetFromPropertyTree(pt);
+			flybackpixels.SetFromPropertyTree(pt);
+			std::vector<ROIProperties> loaded;
+			try {
+				// Load until get_child throws
+				for ( uint32_t r = 0 ; r < 100 ; r++ ) {
+					ROIProperties roi;
+					roi.Load(pt.get_child(boost::str(boost::wformat(L"ROI%d") % r)));
+					loaded.push_back(roi);
+				}
+			}
+			catch (...) { }
+			if ( !loaded.empty() )
+				rois = loaded;
+		}
+
+		void ScannerVectorFrameMultiROI::Preset::Save(wptree& pt) const {
+			ScannerVectorFrameBasic::Preset::Save(pt);
+			xcutoff.AddToPropertyTree(pt);
+			xretrace.AddToPropertyTree(pt);
+			flybackpixels.AddToPropertyTree(pt);
+			uint32_t i = 0;
+			for ( const auto& roi : rois ) {
+				wptree wt;
+				roi.Save(wt);
+				pt.add_child(boost::str(boost::wformat(L"ROI%d") % i++), wt);
+			}
+		}
+
+		void ScannerVectorFrameMultiROI::Load(const wptree& pt) {
+			ScannerVectorFrameBasic::Load(pt);
+			xcutoff.SetFromPropertyTree(pt);
+			xretrace.SetFromPropertyTree(pt);
+			flybackpixels.SetFromPropertyTree(pt);
+			std::vector<ROIProperties> loaded;
+			try {
+				// Load until get_child throws
+				for ( uint32_t r = 0 ; r < 100 ; r++ ) {
+					ROIProperties roi;
+					roi.Load(pt.get_child(boost::str(boost::wformat(L"ROI%d") % r)));
+					loaded.push_back(roi);
+				}
+			}
+			catch (...) { }
+			// Keep the default full field region if there are none in the file
+			if ( !loaded.empty() )
+				rois = loaded;
+		}
+
+		void ScannerVectorFrameMultiROI::Save(wptree& pt) const {
+			ScannerVectorFrameBasic::Save(pt);
+			xcutoff.AddToPropertyTree(pt);
+			xretrace.AddToPropertyTree(pt);
+			flybackpixels.AddToPropertyTree(pt);
+			uint32_t i = 0;
+			for ( const auto& roi : rois ) {
+				wptree wt;
+				roi.Save(wt);
+				pt.add_child(boost::str(boost::wformat(L"ROI%d") % i++), wt);
+			}
+		}
+
+		void ScannerVectorFrameMultiROI::SetReadOnlyWhileScanning(const RunState& _runstate) {
+			ScannerVectorFrameBasic::SetReadOnlyWhileScanning(_runstate);
+			const bool enabler = (static_cast<RunStateHelper::Mode>(_runstate)==RunStateHelper::Mode::Stopped)?true:false;
+			xcutoff.SetRWState(enabler);
+			xretrace.SetRWState(enabler);
+			flybackpixels.SetRWState(enabler);
+			for ( auto& roi : rois ) {
+				roi.left.SetRWState(enabler);
+				roi.top.SetRWState(enabler);
+				roi.width.SetRWState(enabler);
+				roi.height.SetRWState(enabler);
+			}
+		}
+
+		std::unique_ptr<ScannerVectorFrameBasic::Preset> ScannerVectorFrameMultiROI::MakePreset() const {
+			return std::make_unique<Preset>();
+		}
+
+		void ScannerVectorFrameMultiROI::SaveToPreset(const std::wstring& _name, const Daq& _daq) {
+			auto p = std::make_shared<Preset>();
+			p->name = _name;
+			p->pixeltime = _daq.pixeltime();
+			p->scannerdelay = _daq.scannerdelay();
+			p->averages = _daq.averages();
+			p->xres = xres();
+			p->yres = yres();
+			p->xcutoff = xcutoff();
+			p->xretrace = xretrace();
+			p->flybackpixels = flybackpixels();
+			p->rois = rois;
+			auto samename = std::find_if(std::begin(presets), std::end(presets), [&](std::shared_ptr<ScannerVectorFrameBasic::Preset> _pres)
+				{ return _pres->name() == _name; } );
+			if  ( presets.end() != samename )
+				presets.erase(samename);				// If name already exists, delete the old (thus overwrite)
+			presets.push_back(p);
+		}
+
+		void ScannerVectorFrameMultiROI::LoadFromPreset(const std::wstring& _name, Daq& _daq) {
+			auto which = std::find_if(std::begin(presets), std::end(presets), [&](std::shared_ptr<ScannerVectorFrameBasic::Preset> _pres)
+				{ return _pres->name() == _name; } );
+			if ( which == std::end(presets) )
+				return ;
+			_daq.pixeltime = (*which)->pixeltime();
+			_daq.scannerdelay = (*which)->scannerdelay();
+			_daq.averages = (*which)->averages();
+			// Casting from ScannerVectorFrameBasic::Preset to ScannerVectorFrameMultiROI::Preset
+			const Preset* const preset = dynamic_cast<const Preset*>(which->get());
+			if ( preset == nullptr )
+				return;
+			// Regions first, xres and yres trigger the rate update
+			rois = preset->rois;
+			xcutoff = preset->xcutoff();
+			xretrace = preset->xretrace();
+			flybackpixels = preset->flybackpixels();
+			xres = (*which)->xres();
+			yres = (*which)->yres();
+		}
+
+		ScannerVectorLine::ScannerVectorLine()
+			: xcutoff(0.1, 0, 0.5, L"XCutoff_Fraction")
+			, xretrace(0.1, 0, 0.5, L"XRetrace_Fraction") {
+			// Default is a horizontal line through the center of the field
+			points.push_back(PathPointProperties(0.0, 0.5));
+			points.push_back(PathPointProperties(1.0, 0.5));
+		}
+
+		std::vector<boost::signals2::connection> ScannerVectorLine::ConnectCopyTrigger(signalchange_t::slot_type _slot) {
+			std::vector<boost::signals2::connection> conns(ScannerVectorFrameBasic::ConnectCopyTrigger(_slot));
+			conns.push_back(xcutoff.ConnectOther(_slot));
+			conns.push_back(xretrace.ConnectOther(_slot));
+			return conns;
+		}
+
+		void ScannerVectorLine::ConnectRateUpdate(signalchange_t::slot_type _slot) {
+			ScannerVectorFrameBasic::ConnectRateUpdate(_slot);
+			xcutoff.ConnectOther(_slot);
+			xretrace.ConnectOther(_slot);
+		}
+
+		void ScannerVectorLine::ConnectOnlineUpdate(signalchange_t::slot_type _slot) {
+			ScannerVectorFrameBasic::ConnectOnlineUpdate(_slot);
+			xcutoff.ConnectOther(_slot);
+			xretrace.ConnectOther(_slot);
+		}
+
+		ScannerVectorLine::Preset::Preset()
+			: xcutoff(0.1, 0, 0.5, L"XCutoff_Fraction")
+			, xretrace(0.1, 0, 0.5, L"XRetrace_Fraction") {
+			points.push_back(PathPointProperties(0.0, 0.5));
+			points.push_back(PathPointProperties(1.0, 0.5));
+		}
+
+		void ScannerVectorLine::Preset::Load(const wptree& pt) {
+			ScannerVectorFrameBasic::Preset::Load(pt);
+			xcutoff.SetFromPropertyTree(pt);
+			xretrace.SetFromPropertyTree(pt);
+			std::vector<PathPointProperties> loaded;
+			try {
+				// Load until get_child throws (freehand paths can have a lot of points)
+				for ( uint32_t p = 0 ; p < 1000 ; p++ ) {
+					PathPointProperties point;
+					point.Load(pt.get_child(boost::str(boost::wformat(L"Point%d") % p)));
+					loaded.push_back(point);
+				}
+			}
+			catch (...) { }
+			if ( !loaded.empty() )
+				points = loaded;
+		}
+
+		void ScannerVectorLine::Preset::Save(wptree& pt) const {
+			ScannerVectorFrameBasic::Preset::Save(pt);
+			xcutoff.AddToPropertyTree(pt);
+			xretrace.AddToPropertyTree(pt);
+			uint32_t i = 0;
+			for ( const auto& point : points ) {
+				wptree wt;
+				point.Save(wt);
+				pt.add_child(boost::str(boost::wformat(L"Point%d") % i++), wt);
+			}
+		}
+
+		void ScannerVectorLine::Load(const wptree& pt) {
+			ScannerVectorFrameBasic::Load(pt);
+			xcutoff.SetFromPropertyTree(pt);
+			xretrace.SetFromPropertyTree(pt);
+			std::vector<PathPointProperties> loaded;
+			try {
+				// Load until get_child throws (freehand paths can have a lot of points)
+				for ( uint32_t p = 0 ; p < 1000 ; p++ ) {
+					PathPointProperties point;
+					point.Load(pt.get_child(boost::str(boost::wformat(L"Point%d") % p)));
+					loaded.push_back(point);
+				}
+			}
+			catch (...) { }
+			// Keep the default line if there is no path in the file
+			if ( !loaded.empty() )
+				points = loaded;
+		}
+
+		void ScannerVectorLine::Save(wptree& pt) const {
+			ScannerVectorFrameBasic::Save(pt);
+			xcutoff.AddToPropertyTree(pt);
+			xretrace.AddToPropertyTree(pt);
+			uint32_t i = 0;
+			for ( const auto& point : points ) {
+				wptree wt;
+				point.Save(wt);
+				pt.add_child(boost::str(boost::wformat(L"Point%d") % i++), wt);
+			}
+		}
+
+		void ScannerVectorLine::SetReadOnlyWhileScanning(const RunState& _runstate) {
+			ScannerVectorFrameBasic::SetReadOnlyWhileScanning(_runstate);
+			const bool enabler = (static_cast<RunStateHelper::Mode>(_runstate)==RunStateHelper::Mode::Stopped)?true:false;
+			xcutoff.SetRWState(enabler);
+			xretrace.SetRWState(enabler);
+			for ( auto& point : points ) {
+				point.x.SetRWState(enabler);
+				point.y.SetRWState(enabler);
+			}
+		}
+
+		std::unique_ptr<ScannerVectorFrameBasic::Preset> ScannerVectorLine::MakePreset() const {
+			return std::make_unique<Preset>();
+		}
+
+		void ScannerVectorLine::SaveToPreset(const std::wstring& _name, const Daq& _daq) {
+			auto p = std::make_shared<Preset>();
+			p->name = _name;
+			p->pixeltime = _daq.pixeltime();
+			p->scannerdelay = _daq.scannerdelay();
+			p->averages = _daq.averages();
+			p->xres = xres();
+			p->yres = yres();
+			p->xcutoff = xcutoff();
+			p->xretrace = xretrace();
+			p->points = points;
+			auto samename = std::find_if(std::begin(presets), std::end(presets), [&](std::shared_ptr<ScannerVectorFrameBasic::Preset> _pres)
+				{ return _pres->name() == _name; } );
+			if  ( presets.end() != samename )
+				presets.erase(samename);				// If name already exists, delete the old (thus overwrite)
+			presets.push_back(p);
+		}
+
+		void ScannerVectorLine::LoadFromPreset(const std::wstring& _name, Daq& _daq) {
+			auto which = std::find_if(std::begin(presets), std::end(presets), [&](std::shared_ptr<ScannerVectorFrameBasic::Preset> _pres)
+				{ return _pres->name() == _name; } );
+			if ( which == std::end(presets) )
+				return ;
+			_daq.pixeltime = (*which)->pixeltime();
+			_daq.scannerdelay = (*which)->scannerdelay();
+			_daq.averages = (*which)->averages();
+			// Casting from ScannerVectorFrameBasic::Preset to ScannerVectorLine::Preset
+			const Preset* const preset = dynamic_cast<const Preset*>(which->get());
+			if ( preset == nullptr )
+				return;
+			// Path first, xres and yres trigger the rate update
+			points = preset->points;
+			xcutoff = preset->xcutoff();
+			xretrace = preset->xretrace();
+			xres = (*which)->xres();
+			yres = (*which)->yres();
+		}
+
+
+		ScannerVectorTrajectory::ScannerVectorTrajectory()
+			: samplesperpixel(4.0, 0.1, 100.0, L"SamplesPerPixel") {
+		}
+
+		std::vector<boost::signals2::connection> ScannerVectorTrajectory::ConnectCopyTrigger(signalchange_t::slot_type _slot) {
+			std::vector<boost::signals2::connection> conns(ScannerVectorFrameBasic::ConnectCopyTrigger(_slot));
+			conns.push_back(samplesperpixel.ConnectOther(_slot));
+			return conns;
+		}
+
+		void ScannerVectorTrajectory::ConnectRateUpdate(signalchange_t::slot_type _slot) {
+			ScannerVectorFrameBasic::ConnectRateUpdate(_slot);
+			samplesperpixel.ConnectOther(_slot);
+		}
+
+		ScannerVectorTrajectory::Preset::Preset()
+			: samplesperpixel(4.0, 0.1, 100.0, L"SamplesPerPixel") {
+		}
+
+		void ScannerVectorTrajectory::Preset::Load(const wptree& pt) {
+			ScannerVectorFrameBasic::Preset::Load(pt);
+			samplesperpixel.SetFromPropertyTree(pt);
+		}
+
+		void ScannerVectorTrajectory::Preset::Save(wptree& pt) const {
+			ScannerVectorFrameBasic::Preset::Save(pt);
+			samplesperpixel.AddToPropertyTree(pt);
+		}
+
+		void ScannerVectorTrajectory::Load(const wptree& pt) {
+			ScannerVectorFrameBasic::Load(pt);
+			samplesperpixel.SetFromPropertyTree(pt);
+		}
+
+		void ScannerVectorTrajectory::Save(wptree& pt) const {
+			ScannerVectorFrameBasic::Save(pt);
+			samplesperpixel.AddToPropertyTree(pt);
+		}
+
+		void ScannerVectorTrajectory::SetReadOnlyWhileScanning(const RunState& _runstate) {
+			ScannerVectorFrameBasic::SetReadOnlyWhileScanning(_runstate);
+			const bool enabler = (static_cast<RunStateHelper::Mode>(_runstate)==RunStateHelper::Mode::Stopped)?true:false;
+			samplesperpixel.SetRWState(enabler);
+		}
+
+		ScannerVectorLissajous::ScannerVectorLissajous()
+			: xcycles(256, 1, 10000, L"XCycles")
+			, ycycles(255, 1, 10000, L"YCycles") {
+		}
+
+		std::vector<boost::signals2::connection> ScannerVectorLissajous::ConnectCopyTrigger(signalchange_t::slot_type _slot) {
+			std::vector<boost::signals2::connection> conns(ScannerVectorTrajectory::ConnectCopyTrigger(_slot));
+			conns.push_back(xcycles.ConnectOther(_slot));
+			conns.push_back(ycycles.ConnectOther(_slot));
+			return conns;
+		}
+
+		void ScannerVectorLissajous::ConnectRateUpdate(signalchange_t::slot_type _slot) {
+			ScannerVectorTrajectory::ConnectRateUpdate(_slot);
+			xcycles.ConnectOther(_slot);
+		}
+
+		uint32_t ScannerVectorLissajous::XTotalPixels() const {
+			return std::max(2u, round2ui32(samplesperpixel() * xres() * yres() / YTotalLines()));
+		}
+
+		ScannerVectorLissajous::Preset::Preset()
+			: xcycles(256, 1, 10000, L"XCycles")
+			, ycycles(255, 1, 10000, L"YCycles") {
+		}
+
+		void ScannerVectorLissajous::Preset::Load(const wptree& pt) {
+			ScannerVectorTrajectory::Preset::Load(pt);
+			xcycles.SetFromPropertyTree(pt);
+			ycycles.SetFromPropertyTree(pt);
+		}
+
+		void ScannerVectorLissajous::Preset::Save(wptree& pt) const {
+			ScannerVectorTrajectory::Preset::Save(pt);
+			xcycles.AddToPropertyTree(pt);
+			ycycles.AddToPropertyTree(pt);
+		}
+
+		void ScannerVectorLissajous::Load(const wptree& pt) {
+			ScannerVectorTrajectory::Load(pt);
+			xcycles.SetFromPropertyTree(pt);
+			ycycles.SetFromPropertyTree(pt);
+		}
+
+		void ScannerVectorLissajous::Save(wptree& pt) const {
+			ScannerVectorTrajectory::Save(pt);
+			xcycles.AddToPropertyTree(pt);
+			ycycles.AddToPropertyTree(pt);
+		}
+
+		void ScannerVectorLissajous::SetReadOnlyWhileScanning(const RunState& _runstate) {
+			ScannerVectorTrajectory::SetReadOnlyWhileScanning(_runstate);
+			const bool enabler = (static_cast<RunStateHelper::Mode>(_runstate)==RunStateHelper::Mode::Stopped)?true:false;
+			xcycles.SetRWState(enabler);
+			ycycles.SetRWState(enabler);
+		}
+
+		std::unique_ptr<ScannerVectorFrameBasic::Preset> ScannerVectorLissajous::MakePreset() const {
+			return std::make_unique<Preset>();
+		}
+
+		void ScannerVectorLissajous::SaveToPreset(const std::wstring& _name, const Daq& _daq) {
+			auto p = std::make_shared<Preset>();
+			p->name = _name;
+			p->pixeltime = _daq.pixeltime();
+			p->scannerdelay = _daq.scannerdelay();
+			p->averages = _daq.averages();
+			p->xres = xres();
+			p->yres = yres();
+			p->samplesperpixel = samplesperpixel();
+			p->xcycles = xcycles();
+			p->ycycles = ycycles();
+			auto samename = std::find_if(std::begin(presets), std::end(presets), [&](std::shared_ptr<ScannerVectorFrameBasic::Preset> _pres)
+				{ return _pres->name() == _name; } );
+			if  ( presets.end() != samename )
+				presets.erase(samename);				// If name already exists, delete the old (thus overwrite)
+			presets.push_back(p);
+		}
+
+		void ScannerVectorLissajous::LoadFromPreset(const std::wstring& _name, Daq& _daq) {
+			auto which = std::find_if(std::begin(presets), std::end(presets), [&](std::shared_ptr<ScannerVectorFrameBasic::Preset> _pres)
+				{ return _pres->name() == _name; } );
+			if ( which == std::end(presets) )
+				return ;
+			_daq.pixeltime = (*which)->pixeltime();
+			_daq.scannerdelay = (*which)->scannerdelay();
+			_daq.averages = (*which)->averages();
+			xres = (*which)->xres();
+			yres = (*which)->yres();
+			// Casting from ScannerVectorFrameBasic::Preset to ScannerVectorLissajous::Preset
+			const ScannerVectorLissajous::Preset* const preset = dynamic_cast<ScannerVectorLissajous::Preset*>(which->get());
+			samplesperpixel = preset->samplesperpixel();
+			xcycles = preset->xcycles();
+			ycycles = preset->ycycles();
+		}
+
+		ScannerVectorSpiral::ScannerVectorSpiral()
+			: turns(128, 1, 10000, L"Turns") {
+		}
+
+		std::vector<boost::signals2::connection> ScannerVectorSpiral::ConnectCopyTrigger(signalchange_t::slot_type _slot) {
+			std::vector<boost::signals2::connection> conns(ScannerVectorTrajectory::ConnectCopyTrigger(_slot));
+			conns.push_back(turns.ConnectOther(_slot));
+			return conns;
+		}
+
+		void ScannerVectorSpiral::ConnectRateUpdate(signalchange_t::slot_type _slot) {
+			ScannerVectorTrajectory::ConnectRateUpdate(_slot);
+			turns.ConnectOther(_slot);
+		}
+
+		uint32_t ScannerVectorSpiral::XTotalPixels() const {
+			// the spiral covers the disk inscribed in the field
+			return std::max(2u, round2ui32(samplesperpixel() * M_PI * 0.25 * xres() * yres() / YTotalLines()));
+		}
+
+		ScannerVectorSpiral::Preset::Preset()
+			: turns(128, 1, 10000, L"Turns") {
+		}
+
+		void ScannerVectorSpiral::Preset::Load(const wptree& pt) {
+			ScannerVectorTrajectory::Preset::Load(pt);
+			turns.SetFromPropertyTree(pt);
+		}
+
+		void ScannerVectorSpiral::Preset::Save(wptree& pt) const {
+			ScannerVectorTrajectory::Preset::Save(pt);
+			turns.AddToPropertyTree(pt);
+		}
+
+		void ScannerVectorSpiral::Load(const wptree& pt) {
+			ScannerVectorTrajectory::Load(pt);
+			turns.SetFromPropertyTree(pt);
+		}
+
+		void ScannerVectorSpiral::Save(wptree& pt) const {
+			ScannerVectorTrajectory::Save(pt);
+			turns.AddToPropertyTree(pt);
+		}
+
+		void ScannerVectorSpiral::SetReadOnlyWhileScanning(const RunState& _runstate) {
+			ScannerVectorTrajectory::SetReadOnlyWhileScanning(_runstate);
+			const bool enabler = (static_cast<RunStateHelper::Mode>(_runstate)==RunStateHelper::Mode::Stopped)?true:false;
+			turns.SetRWState(enabler);
+		}
+
+		std::unique_ptr<ScannerVectorFrameBasic::Preset> ScannerVectorSpiral::MakePreset() const {
+			return std::make_unique<Preset>();
+		}
+
+		void ScannerVectorSpiral::SaveToPreset(const std::wstring& _name, const Daq& _daq) {
+			auto p = std::make_shared<Preset>();
+			p->name = _name;
+			p->pixeltime = _daq.pixeltime();
+			p->scannerdelay = _daq.scannerdelay();
+			p->averages = _daq.averages();
+			p->xres = xres();
+			p->yres = yres();
+			p->samplesperpixel = samplesperpixel();
+			p->turns = turns();
+			auto samename = std::find_if(std::begin(presets), std::end(presets), [&](std::shared_ptr<ScannerVectorFrameBasic::Preset> _pres)
+				{ return _pres->name() == _name; } );
+			if  ( presets.end() != samename )
+				presets.erase(samename);				// If name already exists, delete the old (thus overwrite)
+			presets.push_back(p);
+		}
+
+		void ScannerVectorSpiral::LoadFromPreset(const std::wstring& _name, Daq& _daq) {
+			auto which = std::find_if(std::begin(presets), std::end(presets), [&](std::shared_ptr<ScannerVectorFrameBasic::Preset> _pres)
+				{ return _pres->name() == _name; } );
+			if ( which == std::end(presets) )
+				return ;
+			_daq.pixeltime = (*which)->pixeltime();
+			_daq.scannerdelay = (*which)->scannerdelay();
+			_daq.averages = (*which)->averages();
+			xres = (*which)->xres();
+			yres = (*which)->yres();
+			// Casting from ScannerVectorFrameBasic::Preset to ScannerVectorSpiral::Preset
+			const ScannerVectorSpiral::Preset* const preset = dynamic_cast<ScannerVectorSpiral::Preset*>(which->get());
+			samplesperpixel = preset->samplesperpixel();
+			turns = preset->turns();
 		}
 
 
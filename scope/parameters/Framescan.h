@@ -6,6 +6,8 @@
 #include "helpers/helpers.h"
 #include "Base.h"
 #include "Plane.h"
+#include "ROI.h"
+#include "PathPoint.h"
 #include "Daq.h"
 #include "devices/InputsDAQmx.h"
 #include "devices/OutputsDAQmx.h"
@@ -33,12 +35,6 @@ public:
 	virtual uint32_t TotalPixelsOneFrame() const { return 0; }
 };
 
-/** Parameters for a ScannerVectorLine
-* @ingroup ScopeParameters */
-class ScannerVectorLine
-	: public ScannerVector {
-};
-
 /** Parameters for a ScannerVectorFrameBasic
 * @ingroup ScopeParameters */
 class ScannerVectorFrameBasic
@@ -180,6 +176,9 @@ public:
 
 	uint32_t TotalPixelsOneFrame() const override { return xres() * yres(); }
 
+	/** @return number of planes scanned during one daq frame, each plane goes into its own image */
+	virtual uint32_t Planes() const { return 1; }
+
 	void Load(const wptree& pt) override;
 	void Save(wptree& pt) const override;
 	void SetReadOnlyWhileScanning(const RunState& _runstate) override;
@@ -223,6 +222,9 @@ public:
 		/** Cutoff fraction for retrace at end of frame */
 		ScopeNumber<double> yretrace;
 
+		/** how often every image line is scanned before y moves on */
+		ScopeNumber<uint32_t> linerepeats;
+
 		Preset();
 
 		void Load(const wptree& pt) override;
@@ -256,6 +258,10 @@ public:
 	
 	/** Cutoff fraction for retrace at end of frame */
 	ScopeNumber<double> yretrace;											
+
+	/** how often every image line is scanned before y moves on. The repeats of a line are averaged by the pixel mapper, unlike
+	* frame averaging (daq averages) the repeated samples of a pixel are only one line time apart and the frame is complete after one pass. */
+	ScopeNumber<uint32_t> linerepeats;
 	
 	/** @return number of additional cutoff pixels at linestart */
 	uint32_t XCutoffPixels() const { return round2ui32(xcutoff()*static_cast<double>(XImagePixels())); }		
@@ -274,12 +280,18 @@ public:
 	
 	/** @return number of lines during y scan ramp (image lines + cutoff lines) */
 	uint32_t YScanLines() const { return YImageLines() + YCutoffLines(); }
+
+	/** @return how often every image line is scanned. Derived scan types that do not support line repeats return 1. */
+	virtual uint32_t LineRepeats() const { return linerepeats(); }
+
+	/** @return number of lines scanned during the y scan ramp (cutoff lines + repeats of all image lines) */
+	uint32_t YRampLines() const { return YCutoffLines() + YImageLines()*LineRepeats(); }
 	
 	/** @return number of lines during retrace */
 	uint32_t YRetraceLines() const { return round2ui32(yretrace()*static_cast<double>(YImageLines())); }
 	
-	/** @return total number of y pixels/lines (image lines + cutoff lines + retrace lines) */
-	uint32_t YTotalLines() const override { return YCutoffLines()+YImageLines()+YRetraceLines(); }
+	/** @return total number of y pixels/lines (cutoff lines + image lines with repeats + retrace lines) */
+	uint32_t YTotalLines() const override { return YRampLines()+YRetraceLines(); }
 	
 	/** @return total number of pixels (final image + cutoff portions + retrace portions) */
 	uint32_t TotalPixels() const override { return TotalPixelsOneFrame(); }
@@ -382,15 +394,16 @@ public:
 	void LoadFromPreset(const std::wstring& _name, Daq& _daq) override;
 };
 
-/** Parameters for a ScannerVectorFramePlaneHopper
+/** Parameters for a ScannerVectorFramePlaneHopper. One daq frame consists of one sawtooth frame per plane, each with its own fast z
+* position and Pockels value. Without planes the frame's fastz and pockels are used (thus one plane).
 * @ingroup ScopeParameters */
 class ScannerVectorFramePlaneHopper
-	: public ScannerVectorFrameBasic {
+	: public ScannerVectorFrameSaw {
 
 public:
 	/** The class for presets */
 	class Preset
-		: public ScannerVectorFrameBasic::Preset {
+		: public ScannerVectorFrameSaw::Preset {
 	public:
 		/** vector with properties for all planes.  */
 		std::vector<PlaneProperties> planes;
@@ -411,14 +424,433 @@ public:
 
 	std::vector<boost::signals2::connection> ConnectCopyTrigger(signalchange_t::slot_type _slot) override;
 
+	void ConnectOnlineUpdate(signalchange_t::slot_type _slot) override;
+
+	/** vector with properties for all planes */
+	std::vector<PlaneProperties> planes;
+
+	/** @return number of planes, at least one */
+	uint32_t Planes() const override { return std::max(1u, static_cast<uint32_t>(planes.size())); }
+
+	/** @return 1, plane hopping does not repeat lines */
+	uint32_t LineRepeats() const override { return 1; }
+
+	/** @return total number of pixels of all planes */
+	uint32_t TotalPixels() const override { return TotalPixelsOneFrame() * Planes(); }
+
+	void Load(const wptree& pt) override;
+	void Save(wptree& pt) const override;
+	void SetReadOnlyWhileScanning(const RunState& _runstate) override;
+
+	std::unique_ptr<ScannerVectorFrameBasic::Preset> MakePreset() const override;
+
+	void SaveToPreset(const std::wstring& _name, const Daq& _daq) override;
+	void LoadFromPreset(const std::wstring& _name, Daq& _daq) override;
+};
+
+/** Parameters for a ScannerVectorFrameVolume. One daq frame is a volume of sawtooth frames (slices) between zstart and zstop. The fast z
+* either steps from slice to slice during the y retrace (staircase) or moves continuously line by line through the whole volume (sawtooth,
+* then the lines of one slice lie at slightly different depths but the ETL never has to settle).
+* @ingroup ScopeParameters */
+class ScannerVectorFrameVolume
+	: public ScannerVectorFrameSaw {
+
+public:
+	/** The class for presets */
+	class Preset
+		: public ScannerVectorFrameSaw::Preset {
+	public:
+		/** number of slices per volume */
+		ScopeNumber<uint32_t> slices;
+
+		/** fast z position of the first slice */
+		ScopeNumber<double> zstart;
+
+		/** fast z position of the last slice */
+		ScopeNumber<double> zstop;
+
+		/** if true fast z moves continuously (sawtooth), otherwise it steps between slices (staircase) */
+		ScopeNumber<bool> continuousz;
+
+		Preset();
+
+		void Load(const wptree& pt) override;
+		void Save(wptree& pt) const override;
+	};
+
+	ScannerVectorFrameVolume();
+
+	/** Create function for factory */
+	static std::unique_ptr<ScannerVectorFrameBasic> Create() { return std::unique_ptr<ScannerVectorFrameBasic>(new ScannerVectorFrameVolume()); }
+
+	/** Create copy function for factory */
+	static std::unique_ptr<ScannerVectorFrameBasic> Create(const ScannerVectorFrameVolume& _o) { return std::unique_ptr<ScannerVectorFrameBasic>(new ScannerVectorFrameVolume(_o)); }
+
+	std::vector<boost::signals2::connection> ConnectCopyTrigger(signalchange_t::slot_type _slot) override;
+
 	void ConnectRateUpdate(signalchange_t::slot_type _slot) override;
 
-	void ConnectMicronPerPixelUpdate(signalchange_t::slot_type _slot) override;
+	void ConnectOnlineUpdate(signalchange_t::slot_type _slot) override;
+
+	/** number of slices per volume */
+	ScopeNumber<uint32_t> slices;
+
+	/** fast z position of the first slice */
+	ScopeNumber<double> zstart;
+
+	/** fast z position of the last slice */
+	ScopeNumber<double> zstop;
+
+	/** if true fast z moves continuously (sawtooth), otherwise it steps between slices (staircase) */
+	ScopeNumber<bool> continuousz;
+
+	/** @return fast z position of slice _slice in staircase mode, evenly spaced from zstart to zstop */
+	double SlicePosition(const uint32_t& _slice) const;
+
+	/** @return number of slices */
+	uint32_t Planes() const override { return slices(); }
+
+	/** @return 1, volume scanning does not repeat lines */
+	uint32_t LineRepeats() const override { return 1; }
+
+	/** @return total number of pixels of all slices */
+	uint32_t TotalPixels() const override { return TotalPixelsOneFrame() * Planes(); }
+
+	void Load(const wptree& pt) override;
+	void Save(wptree& pt) const override;
+	void SetReadOnlyWhileScanning(const RunState& _runstate) override;
+
+	std::unique_ptr<ScannerVectorFrameBasic::Preset> MakePreset() const override;
+
+	void SaveToPreset(const std::wstring& _name, const Daq& _daq) override;
+	void LoadFromPreset(const std::wstring& _name, Daq& _daq) override;
+};
+
+/** Parameters for a ScannerVectorFrameMultiROI. Only the rectangular regions of interest inside the field of view are scanned (one after
+* the other with a fast flyback in between), the field itself is defined by zoom, offsets, xres and yres as for a sawtooth scan. Every
+* region is mapped to its place in the xres*yres image, thus micron per pixel stay the same and the frame rate increases by the fraction
+* of the field that is not scanned.
+* @ingroup ScopeParameters */
+class ScannerVectorFrameMultiROI
+	: public ScannerVectorFrameBasic {
+
+public:
+	/** The class for presets */
+	class Preset
+		: public ScannerVectorFrameBasic::Preset {
+	public:
+		/** Cutoff fraction at beginning of each line, relative to the image pixels of the line's region */
+		ScopeNumber<double> xcutoff;
+
+		/** Retrace fraction at end of each line, relative to the image pixels of the line's region */
+		ScopeNumber<double> xretrace;
+
+		/** Number of pixels for the flyback from one region to the next */
+		ScopeNumber<uint32_t> flybackpixels;
+
+		/** the regions of interest */
+		std::vector<ROIProperties> rois;
+
+		Preset();
+
+		void Load(const wptree& pt) override;
+		void Save(wptree& pt) const override;
+	};
+
+	/** Position of one region of interest in the image */
+	struct ROIGeometry {
+		/** first image column */
+		uint32_t column;
+
+		/** image pixels per line */
+		uint32_t pixels;
+
+		/** first image line */
+		uint32_t row;
+
+		/** number of lines */
+		uint32_t lines;
+
+		/** cutoff pixels at the beginning of each line */
+		uint32_t cutoff;
+
+		/** retrace pixels at the end of each line */
+		uint32_t retrace;
+
+		/** @return total number of pixels per line of this region */
+		uint32_t LineSamples() const { return cutoff + pixels + retrace; }
+	};
+
+	ScannerVectorFrameMultiROI();
+
+	/** Create function for factory */
+	static std::unique_ptr<ScannerVectorFrameBasic> Create() { return std::unique_ptr<ScannerVectorFrameBasic>(new ScannerVectorFrameMultiROI()); }
+
+	/** Create copy function for factory */
+	static std::unique_ptr<ScannerVectorFrameBasic> Create(const ScannerVectorFrameMultiROI& _o) { return std::unique_ptr<ScannerVectorFrameBasic>(new ScannerVectorFrameMultiROI(_o)); }
+
+	std::vector<boost::signals2::connection> ConnectCopyTrigger(signalchange_t::slot_type _slot) override;
+
+	void ConnectRateUpdate(signalchange_t::slot_type _slot) override;
 
 	void ConnectOnlineUpdate(signalchange_t::slot_type _slot) override;
 
-	/** vector with properties for all planes */
-	std::vector<PlaneProperties> planes;
+	/** Cutoff fraction at beginning of each line, relative to the image pixels of the line's region */
+	ScopeNumber<double> xcutoff;
+
+	/** Retrace fraction at end of each line, relative to the image pixels of the line's region */
+	ScopeNumber<double> xretrace;
+
+	/** Number of pixels for the flyback from one region to the next (and from the last to the first), the galvos need that time to settle */
+	ScopeNumber<uint32_t> flybackpixels;
+
+	/** the regions of interest, scanned in this order */
+	std::vector<ROIProperties> rois;
+
+	/** @return the regions of interest in image pixels, regions without any pixel (e.g. too small for xres/yres) are left out */
+	std::vector<ROIGeometry> ROIGeometries() const;
+
+	/** @return number of pixels of the longest line */
+	uint32_t XTotalPixels() const override;
+
+	/** @return number of scanned lines in all regions */
+	uint32_t YTotalLines() const override;
+
+	/** @return total number of pixels (lines of all regions plus flybacks) */
+	uint32_t TotalPixels() const override;
+
+	/** @return total number of pixels for one image */
+	uint32_t TotalPixelsOneFrame() const override { return TotalPixels(); }
+
+	void Load(const wptree& pt) override;
+	void Save(wptree& pt) const override;
+	void SetReadOnlyWhileScanning(const RunState& _runstate) override;
+
+	std::unique_ptr<ScannerVectorFrameBasic::Preset> MakePreset() const override;
+
+	void SaveToPreset(const std::wstring& _name, const Daq& _daq) override;
+	void LoadFromPreset(const std::wstring& _name, Daq& _daq) override;
+};
+
+/** Parameters for a ScannerVectorLine. The scanners follow a path (a straight line or a freehand polyline through the points) inside the
+* field of view, the field itself is defined by zoom, offsets, and aspect ratios as for a sawtooth scan. xres is the number of pixels along
+* the path, yres the number of lines in one kymograph frame. Every image line is one pass along the path, thus the y axis of the image is
+* time. Frames follow each other without any gap, the lines of consecutive frames form one continuous stream.
+* @ingroup ScopeParameters */
+class ScannerVectorLine
+	: public ScannerVectorFrameBasic {
+
+public:
+	/** The class for presets */
+	class Preset
+		: public ScannerVectorFrameBasic::Preset {
+	public:
+		/** Cutoff fraction at beginning of line, total pixels per line = xres * (1 + xcutoff + xretrace) */
+		ScopeNumber<double> xcutoff;
+
+		/** Retrace fraction at end of line */
+		ScopeNumber<double> xretrace;
+
+		/** the points of the path */
+		std::vector<PathPointProperties> points;
+
+		Preset();
+
+		void Load(const wptree& pt) override;
+		void Save(wptree& pt) const override;
+	};
+
+	ScannerVectorLine();
+
+	/** Create function for factory */
+	static std::unique_ptr<ScannerVectorFrameBasic> Create() { return std::unique_ptr<ScannerVectorFrameBasic>(new ScannerVectorLine()); }
+
+	/** Create copy function for factory */
+	static std::unique_ptr<ScannerVectorFrameBasic> Create(const ScannerVectorLine& _o) { return std::unique_ptr<ScannerVectorFrameBasic>(new ScannerVectorLine(_o)); }
+
+	std::vector<boost::signals2::connection> ConnectCopyTrigger(signalchange_t::slot_type _slot) override;
+
+	void ConnectRateUpdate(signalchange_t::slot_type _slot) override;
+
+	void ConnectOnlineUpdate(signalchange_t::slot_type _slot) override;
+
+	/** Cutoff fraction at beginning of line (the scanners accelerate along the extension of the first path segment) */
+	ScopeNumber<double> xcutoff;
+
+	/** Retrace fraction at end of line (the scanners return from the end of the path to the beginning of the cutoff) */
+	ScopeNumber<double> xretrace;
+
+	/** the points of the path, two points make a straight line, more a freehand polyline */
+	std::vector<PathPointProperties> points;
+
+	/** @return number of cutoff pixels at the beginning of each line */
+	uint32_t XCutoffPixels() const { return round2ui32(xcutoff() * xres()); }
+
+	/** @return number of retrace pixels at the end of each line */
+	uint32_t XRetracePixels() const { return round2ui32(xretrace() * xres()); }
+
+	/** @return number of pixels per line including cutoff and retrace */
+	uint32_t XTotalPixels() const override { return xres() + XCutoffPixels() + XRetracePixels(); }
+
+	/** @return number of lines per kymograph frame */
+	uint32_t YTotalLines() const override { return yres(); }
+
+	/** @return total number of pixels for one kymograph frame */
+	uint32_t TotalPixels() const override { return XTotalPixels() * YTotalLines(); }
+
+	/** @return total number of pixels for one image */
+	uint32_t TotalPixelsOneFrame() const override { return TotalPixels(); }
+
+	void Load(const wptree& pt) override;
+	void Save(wptree& pt) const override;
+	void SetReadOnlyWhileScanning(const RunState& _runstate) override;
+
+	std::unique_ptr<ScannerVectorFrameBasic::Preset> MakePreset() const override;
+
+	void SaveToPreset(const std::wstring& _name, const Daq& _daq) override;
+	void LoadFromPreset(const std::wstring& _name, Daq& _daq) override;
+};
+
+/** Common parameters for smooth trajectory scans (ScannerVectorLissajous, ScannerVectorSpiral). The scanners never turn around or retrace,
+* every sample goes into the xres*yres image and pixels hit several times per frame are averaged. A "line" of these scans is one period
+* (Lissajous) or one revolution (spiral), so XTotalPixels*YTotalLines is the number of samples per frame as for the raster scans.
+* @ingroup ScopeParameters */
+class ScannerVectorTrajectory
+	: public ScannerVectorFrameBasic {
+
+public:
+	/** The class for presets */
+	class Preset
+		: public ScannerVectorFrameBasic::Preset {
+	public:
+		/** average number of samples per image pixel and frame */
+		ScopeNumber<double> samplesperpixel;
+
+		Preset();
+
+		void Load(const wptree& pt) override;
+		void Save(wptree& pt) const override;
+	};
+
+	ScannerVectorTrajectory();
+
+	std::vector<boost::signals2::connection> ConnectCopyTrigger(signalchange_t::slot_type _slot) override;
+
+	void ConnectRateUpdate(signalchange_t::slot_type _slot) override;
+
+	/** average number of samples per image pixel and frame, too few leave pixels that the trajectory does not hit (then filled
+	* with their nearest hit neighbour) */
+	ScopeNumber<double> samplesperpixel;
+
+	/** @return total number of samples per frame */
+	uint32_t TotalPixels() const override { return XTotalPixels() * YTotalLines(); }
+
+	/** @return total number of samples for one image */
+	uint32_t TotalPixelsOneFrame() const override { return TotalPixels(); }
+
+	void Load(const wptree& pt) override;
+	void Save(wptree& pt) const override;
+	void SetReadOnlyWhileScanning(const RunState& _runstate) override;
+};
+
+/** Parameters for a Lissajous scan. x and y are sines with xcycles and ycycles periods per frame, with no common divisor the figure covers
+* the field densely and closes exactly at the end of the frame, thus consecutive frames follow each other without a flyback.
+* @ingroup ScopeParameters */
+class ScannerVectorLissajous
+	: public ScannerVectorTrajectory {
+
+public:
+	/** The class for presets */
+	class Preset
+		: public ScannerVectorTrajectory::Preset {
+	public:
+		/** number of x periods per frame */
+		ScopeNumber<uint32_t> xcycles;
+
+		/** number of y periods per frame */
+		ScopeNumber<uint32_t> ycycles;
+
+		Preset();
+
+		void Load(const wptree& pt) override;
+		void Save(wptree& pt) const override;
+	};
+
+	ScannerVectorLissajous();
+
+	/** Create function for factory */
+	static std::unique_ptr<ScannerVectorFrameBasic> Create() { return std::unique_ptr<ScannerVectorFrameBasic>(new ScannerVectorLissajous()); }
+
+	/** Create copy function for factory */
+	static std::unique_ptr<ScannerVectorFrameBasic> Create(const ScannerVectorLissajous& _o) { return std::unique_ptr<ScannerVectorFrameBasic>(new ScannerVectorLissajous(_o)); }
+
+	std::vector<boost::signals2::connection> ConnectCopyTrigger(signalchange_t::slot_type _slot) override;
+
+	void ConnectRateUpdate(signalchange_t::slot_type _slot) override;
+
+	/** number of x periods per frame */
+	ScopeNumber<uint32_t> xcycles;
+
+	/** number of y periods per frame, should have no common divisor with xcycles. Similar numbers (e.g. xres and xres-1) give the most
+	* even coverage, with both about as large as the resolution about 4 samples per pixel leave only a few percent of the pixels unhit */
+	ScopeNumber<uint32_t> ycycles;
+
+	/** @return number of samples per x period, so that a frame has samplesperpixel*xres*yres samples */
+	uint32_t XTotalPixels() const override;
+
+	/** @return number of x periods per frame */
+	uint32_t YTotalLines() const override { return xcycles(); }
+
+	void Load(const wptree& pt) override;
+	void Save(wptree& pt) const override;
+	void SetReadOnlyWhileScanning(const RunState& _runstate) override;
+
+	std::unique_ptr<ScannerVectorFrameBasic::Preset> MakePreset() const override;
+
+	void SaveToPreset(const std::wstring& _name, const Daq& _daq) override;
+	void LoadFromPreset(const std::wstring& _name, Daq& _daq) override;
+};
+
+/** Parameters for a spiral scan. An Archimedean spiral from the center to the edge of the field and back to the center, with the same
+* sense of rotation in both directions and at constant path speed, thus neither turnarounds nor a flyback.
+* @ingroup ScopeParameters */
+class ScannerVectorSpiral
+	: public ScannerVectorTrajectory {
+
+public:
+	/** The class for presets */
+	class Preset
+		: public ScannerVectorTrajectory::Preset {
+	public:
+		/** number of revolutions from the center to the edge */
+		ScopeNumber<uint32_t> turns;
+
+		Preset();
+
+		void Load(const wptree& pt) override;
+		void Save(wptree& pt) const override;
+	};
+
+	ScannerVectorSpiral();
+
+	/** Create function for factory */
+	static std::unique_ptr<ScannerVectorFrameBasic> Create() { return std::unique_ptr<ScannerVectorFrameBasic>(new ScannerVectorSpiral()); }
+
+	/** Create copy function for factory */
+	static std::unique_ptr<ScannerVectorFrameBasic> Create(const ScannerVectorSpiral& _o) { return std::unique_ptr<ScannerVectorFrameBasic>(new ScannerVectorSpiral(_o)); }
+
+	std::vector<boost::signals2::connection> ConnectCopyTrigger(signalchange_t::slot_type _slot) override;
+
+	void ConnectRateUpdate(signalchange_t::slot_type _slot) override;
+
+	/** number of revolutions from the center to the edge, about half the image size gives one revolution per pixel of radius */
+	ScopeNumber<uint32_t> turns;
+
+	/** @return average number of samples per revolution, so that the disk inside the field gets samplesperpixel samples per pixel */
+	uint32_t XTotalPixels() const override;
+
+	/** @return number of revolutions per frame (out and back in) */
+	uint32_t YTotalLines() const override { return 2 * turns(); }
 
 	void Load(const wptree& pt) override;
 	void Save(wptree& pt) const override;
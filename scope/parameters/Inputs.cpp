@@ -15,7 +15,10 @@ namespace scope {
 			: channels(2, 1, config::maxchannels, L"Channels")
 			, oversampling(true, false, true, L"Oversampling")
 			, rangetype(Uint16RangeHelper::full, L"Uint16Range")
-			, preframelines(0, 0, 20, L"PreframeLines") {
+			, preframelines(0, 0, 20, L"PreframeLines")
+			, adaptivechunksize(false, false, true, L"AdaptiveChunkSize")
+			, minchunksize(64*64, 64, 16777216, L"MinChunkSize")
+			, maxchunksize(512*512, 64, 16777216, L"MaxChunkSize") {
 		}
 
 		void Inputs::Load(const wptree& _pt) {
@@ -23,6 +26,9 @@ namespace scope {
 			oversampling.SetFromPropertyTree(_pt);
 			rangetype.SetFromPropertyTree(_pt);
 			preframelines.SetFromPropertyTree(_pt);
+			adaptivechunksize.SetFromPropertyTree(_pt);
+			minchunksize.SetFromPropertyTree(_pt);
+			maxchunksize.SetFromPropertyTree(_pt);
 		}
 
 		void Inputs::Save(wptree& _pt) const {
@@ -30,9 +36,16 @@ namespace scope {
 			oversampling.AddToPropertyTree(_pt);
 			rangetype.AddToPropertyTree(_pt);
 			preframelines.AddToPropertyTree(_pt);
+			adaptivechunksize.AddToPropertyTree(_pt);
+			minchunksize.AddToPropertyTree(_pt);
+			maxchunksize.AddToPropertyTree(_pt);
 		}
 
 		void Inputs::SetReadOnlyWhileScanning(const RunState& _runstate) {
+			const bool enabler = (static_cast<RunStateHelper::Mode>(_runstate)==RunStateHelper::Mode::Stopped)?true:false;
+			adaptivechunksize.SetRWState(enabler);
+			minchunksize.SetRWState(enabler);
+			maxchunksize.SetRWState(enabler);
 		}
 
 		/*std::unique_ptr<Inputs> Inputs::Factory(const config::InputEnum& _type) {
@@ -124,11 +137,76 @@ namespace scope {
 		}
 
 		void InputsDAQmx::SetReadOnlyWhileScanning(const RunState& _runstate) {
+			Inputs::SetReadOnlyWhileScanning(_runstate);
+		}
+
+		InputsSimulated::InputsSimulated()
+			: samplingrate(10000000, 100000, 1000000000, L"SamplingRate_Hz")
+			, photonrate(20, 0, 10000, L"PhotonRate_MHz")
+			, backgroundrate(0.2, 0, 1000, L"BackgroundRate_MHz")
+			, countsperphoton(100, 0, 65535, L"CountsPerPhoton")
+			, scannerlag(0, 0, 10000, L"ScannerLag_us")
+			, beads(200, 0, 100000, L"Beads")
+			, seed(1, 0, UINT32_MAX, L"Seed")
+			, realtime(true, false, true, L"Realtime")
+			, chunksize(0, 0, 16777216, L"ChunkSize")
+			, buffertime(1, 0.01, 100, L"BufferTime_s") {
+		}
+
+		double InputsSimulated::MinimumPixeltime() const {
+			return 1/samplingrate() * 1E6;
+		}
+
+		double InputsSimulated::CoercedPixeltime(const double& _pixeltime) const {
+			// Pixeltime can only be an integer multiple of the sampling period
+			return std::max(1.0, std::floor(_pixeltime/MinimumPixeltime())) * MinimumPixeltime();
+		}
+
+		void InputsSimulated::Load(const wptree& _pt) {
+			Inputs::Load(_pt);
+			samplingrate.SetFromPropertyTree(_pt);
+			photonrate.SetFromPropertyTree(_pt);
+			backgroundrate.SetFromPropertyTree(_pt);
+			countsperphoton.SetFromPropertyTree(_pt);
+			scannerlag.SetFromPropertyTree(_pt);
+			beads.SetFromPropertyTree(_pt);
+			seed.SetFromPropertyTree(_pt);
+			realtime.SetFromPropertyTree(_pt);
+			chunksize.SetFromPropertyTree(_pt);
+			buffertime.SetFromPropertyTree(_pt);
+		}
+
+		void InputsSimulated::Save(wptree& _pt) const {
+			Inputs::Save(_pt);
+			samplingrate.AddToPropertyTree(_pt);
+			photonrate.AddToPropertyTree(_pt);
+			backgroundrate.AddToPropertyTree(_pt);
+			countsperphoton.AddToPropertyTree(_pt);
+			scannerlag.AddToPropertyTree(_pt);
+			beads.AddToPropertyTree(_pt);
+			seed.AddToPropertyTree(_pt);
+			realtime.AddToPropertyTree(_pt);
+			chunksize.AddToPropertyTree(_pt);
+			buffertime.AddToPropertyTree(_pt);
+		}
+
+		void InputsSimulated::SetReadOnlyWhileScanning(const RunState& _runstate) {
+			Inputs::SetReadOnlyWhileScanning(_runstate);
+			const bool enabler = (static_cast<RunStateHelper::Mode>(_runstate)==RunStateHelper::Mode::Stopped)?true:false;
+			samplingrate.SetRWState(enabler);
+			beads.SetRWState(enabler);
+			seed.SetRWState(enabler);
+			realtime.SetRWState(enabler);
+			chunksize.SetRWState(enabler);
+			buffertime.SetRWState(enabler);
 		}
 
 		InputsFPGA::InputsFPGA() {
 			// Not oversampling is standard for FPGA, since FPGA generates the pixel clock for the output task
 			oversampling = false;
+			// The DMA FIFOs buffer much more than a DAQmx device, allow bigger chunks
+			minchunksize = 128*128;
+			maxchunksize = 1024*1024;
 		}
 
 		double InputsFPGA::MinimumPixeltime() const {
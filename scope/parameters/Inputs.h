@@ -38,6 +38,16 @@ public:
 	/** number of lines to acquire before each frame, e.g. to wait for the next sync from a resonance scanner (set to 0 usually, use 2 for a resonance scanner) */
 	ScopeNumber<uint32_t> preframelines;
 
+	/** if true DaqController adapts the read chunk size to the input backlog: bigger chunks when reading falls behind (throughput),
+	* smaller chunks when it keeps up (display latency). Only for inputs that report their backlog, otherwise StandardChunkSize is used. */
+	ScopeNumber<bool> adaptivechunksize;
+
+	/** lower bound for the adaptive chunk size (samples per channel) */
+	ScopeNumber<uint32_t> minchunksize;
+
+	/** upper bound for the adaptive chunk size (samples per channel) */
+	ScopeNumber<uint32_t> maxchunksize;
+
 	/** @return the minimum pixel dwell time (in microseconds), depending on max aggregate rate, number of channels, and sampling type */
 	virtual double MinimumPixeltime() const { return 1.0; }
 
@@ -112,6 +122,57 @@ public:
 	void SetReadOnlyWhileScanning(const RunState& _runstate) override;
 };
 
+/** Parameters for the simulated, hardware-free pixel acquisition (see scope::InputsSimulated) */
+class InputsSimulated
+	: public Inputs {
+
+public:
+	InputsSimulated();
+
+	/** Create method for factory */
+	static std::unique_ptr<Inputs> Create() { return std::unique_ptr<Inputs>(new InputsSimulated()); }
+
+	std::unique_ptr<Inputs> Clone() const override { return std::unique_ptr<Inputs>(new InputsSimulated(*this)); }
+
+	/** simulated sampling rate of the "ADC" in Hz, determines the minimum pixel time and the oversampling factor */
+	ScopeNumber<double> samplingrate;
+
+	/** photon rate in MHz at the brightest spot of the specimen */
+	ScopeNumber<double> photonrate;
+
+	/** background/dark count photon rate in MHz */
+	ScopeNumber<double> backgroundrate;
+
+	/** signal counts per detected photon (PMT gain times preamp times ADC) */
+	ScopeNumber<double> countsperphoton;
+
+	/** lag of the simulated scanners behind their command signal in microseconds (compare to Daq::scannerdelay) */
+	ScopeNumber<double> scannerlag;
+
+	/** number of beads in the synthetic specimen */
+	ScopeNumber<uint32_t> beads;
+
+	/** seed for the specimen and the photon noise */
+	ScopeNumber<uint32_t> seed;
+
+	/** if true data is delivered paced at the pixel rate, if false as fast as possible (for load testing) */
+	ScopeNumber<bool> realtime;
+
+	/** samples per channel per read, 0 for the automatic chunk size */
+	ScopeNumber<uint32_t> chunksize;
+
+	/** size of the simulated device buffer in seconds. If reading falls further behind (only in realtime mode), samples are dropped like in a buffer overrun. */
+	ScopeNumber<double> buffertime;
+
+	double MinimumPixeltime() const override;
+
+	double CoercedPixeltime(const double& _pixeltime) const override;
+
+	void Load(const wptree& pt) override;
+	void Save(wptree& pt) const override;
+	void SetReadOnlyWhileScanning(const RunState& _runstate) override;
+};
+
 /** Parameters for pixel acquisition with NI-FPGA */
 class InputsFPGA
 	: public Inputs {
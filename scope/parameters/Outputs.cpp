@@ -61,7 +61,10 @@ namespace scope {
 			, referenceclocksource(L"PXI_Clk10", L"ReferenceClockSource")
 			, referenceclockrate(10000000, 1000000, 100000000, L"ReferenceClockRate_Hz")
 			, externalclocksource(L"/PXI-6259_0/PXI_Trig1", L"ExternalClockSource")
-			, exportpixelclockterminal(L"/PXI-6259_0/PFI12", L"ExportPixelClockTerminal") {
+			, exportpixelclockterminal(L"/PXI-6259_0/PFI12", L"ExportPixelClockTerminal")
+			, streaming(false, false, true, L"Streaming")
+			, streamblocksize(65536, 1024, 16777216, L"StreamBlockSize")
+			, streambufferblocks(4, 2, 64, L"StreamBufferBlocks") {
 		}
 
 		double OutputsDAQmx::CoercedPixeltime(const double& _pixeltime) const {
@@ -81,6 +84,9 @@ namespace scope {
 			referenceclockrate.SetFromPropertyTree(_pt);
 			externalclocksource.SetFromPropertyTree(_pt);
 			exportpixelclockterminal.SetFromPropertyTree(_pt);
+			streaming.SetFromPropertyTree(_pt);
+			streamblocksize.SetFromPropertyTree(_pt);
+			streambufferblocks.SetFromPropertyTree(_pt);
 		}
 
 		void OutputsDAQmx::Save(wptree& _pt) const {
@@ -92,10 +98,17 @@ namespace scope {
 			referenceclockrate.AddToPropertyTree(_pt);
 			externalclocksource.AddToPropertyTree(_pt);
 			exportpixelclockterminal.AddToPropertyTree(_pt);
+			streaming.AddToPropertyTree(_pt);
+			streamblocksize.AddToPropertyTree(_pt);
+			streambufferblocks.AddToPropertyTree(_pt);
 		}
 
 		void OutputsDAQmx::SetReadOnlyWhileScanning(const RunState& _runstate) {
 			Outputs::SetReadOnlyWhileScanning(_runstate);
+			const bool enabler = (static_cast<RunStateHelper::Mode>(_runstate)==RunStateHelper::Mode::Stopped)?true:false;
+			streaming.SetRWState(enabler);
+			streamblocksize.SetRWState(enabler);
+			streambufferblocks.SetRWState(enabler);
 		}
 
 		OutputsDAQmxLineClock::OutputsDAQmxLineClock()
@@ -49,6 +49,9 @@ public:
 	/** @return the minimum pixel dwell time/sample time (in microseconds), depending on ... */
 	virtual double MinimumPixeltime() const { return 1.0; }
 
+	/** @return true if the outputs stream continuous scans from a waveform generator instead of regenerating a complete frame vector */
+	virtual bool Streaming() const { return false; }
+
 	void Load(const wptree& pt) override;
 	void Save(wptree& pt) const override;
 	void SetReadOnlyWhileScanning(const RunState& _runstate) override;
@@ -88,10 +91,22 @@ public:
 	/** terminal to which the pixel/sampleclock is exported */
 	ScopeString exportpixelclockterminal;
 
+	/** If true, continuous scans do not write the whole frame to a regenerating device buffer. The samples are generated block by block
+	* while scanning, host memory and device buffer stay bounded independent of the frame size (see scope::OutputsDAQmx). */
+	ScopeNumber<bool> streaming;
+
+	/** samples per channel generated and written at once when streaming */
+	ScopeNumber<uint32_t> streamblocksize;
+
+	/** size of the device buffer in blocks when streaming (more blocks tolerate longer hiccups of the writing thread) */
+	ScopeNumber<uint32_t> streambufferblocks;
+
 	double CoercedPixeltime(const double& _pixeltime) const override;
 
 	double MinimumPixeltime() const override;
 
+	bool Streaming() const override { return streaming(); }
+
 	void Load(const wptree& pt) override;
 	void Save(wptree& pt) const override;
 	void SetReadOnlyWhileScanning(const RunState& _runstate) override;
@@ -0,0 +1,28 @@
+#include "stdafx.h"
+#include "PathPoint.h"
+
+namespace scope {
+
+namespace parameters {
+
+// save some typing here...
+using namespace boost::property_tree;
+
+PathPointProperties::PathPointProperties(const double& _x, const double& _y)
+	: x(_x, 0.0, 1.0, L"X_Fraction")
+	, y(_y, 0.0, 1.0, L"Y_Fraction") {
+}
+
+void PathPointProperties::Load(const wptree& pt) {
+	x.SetFromPropertyTree(pt);
+	y.SetFromPropertyTree(pt);
+}
+
+void PathPointProperties::Save(wptree& pt) const {
+	x.AddToPropertyTree(pt);
+	y.AddToPropertyTree(pt);
+}
+
+}
+
+}
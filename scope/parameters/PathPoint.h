@@ -0,0 +1,32 @@
+#pragma once
+
+#include "Base.h"
+#include "helpers\ScopeNumber.h"
+
+namespace scope {
+
+	namespace parameters {
+
+/** Parameters of a single point of a line scan path. Positions are fractions of the (zoomed and offset) field of view, (0,0) is the
+* top left corner.
+* @ingroup ScopeParameters */
+class PathPointProperties
+	: public Base {
+
+public:
+	/** x position (fraction of the field width) */
+	ScopeNumber<double> x;
+
+	/** y position (fraction of the field height) */
+	ScopeNumber<double> y;
+
+	/** Quick construct */
+	PathPointProperties(const double& _x = 0.0, const double& _y = 0.0);
+
+	void Load(const wptree& pt) override;
+	void Save(wptree& pt) const override;
+};
+
+}
+
+}
@@ -10,7 +10,7 @@ using namespace boost::property_tree;
 
 PlaneProperties::PlaneProperties(const double& _position, const double& _pockels)
 	: position(_position, -1000.0, 1000.0, L"ZPosition_um")
-	, pockels(0.0, 0.0, 1.0, L"Pockels_Fraction") {
+	, pockels(_pockels, 0.0, 1.0, L"Pockels_Fraction") {
 }
 
 void PlaneProperties::Load(const wptree& pt) {
@@ -0,0 +1,34 @@
+#include "stdafx.h"
+#include "ROI.h"
+
+namespace scope {
+
+namespace parameters {
+
+// save some typing here...
+using namespace boost::property_tree;
+
+ROIProperties::ROIProperties(const double& _left, const double& _top, const double& _width, const double& _height)
+	: left(_left, 0.0, 1.0, L"Left_Fraction")
+	, top(_top, 0.0, 1.0, L"Top_Fraction")
+	, width(_width, 0.01, 1.0, L"Width_Fraction")
+	, height(_height, 0.01, 1.0, L"Height_Fraction") {
+}
+
+void ROIProperties::Load(const wptree& pt) {
+	left.SetFromPropertyTree(pt);
+	top.SetFromPropertyTree(pt);
+	width.SetFromPropertyTree(pt);
+	height.SetFromPropertyTree(pt);
+}
+
+void ROIProperties::Save(wptree& pt) const {
+	left.AddToPropertyTree(pt);
+	top.AddToPropertyTree(pt);
+	width.AddToPropertyTree(pt);
+	height.AddToPropertyTree(pt);
+}
+
+}
+
+}
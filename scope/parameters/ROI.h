@@ -0,0 +1,44 @@
+#pragma once
+
+#include "Base.h"
+#include "helpers\ScopeNumber.h"
+
+namespace scope {
+
+	namespace parameters {
+
+/** Parameters of a single rectangular region of interest for multi ROI scanning. Positions and sizes are fractions of the (zoomed and
+* offset) field of view, (0,0) is the top left corner.
+* @ingroup ScopeParameters */
+class ROIProperties
+	: public Base {
+
+public:
+	/** left border (fraction of the field width) */
+	ScopeNumber<double> left;
+
+	/** top border (fraction of the field height) */
+	ScopeNumber<double> top;
+
+	/** width (fraction of the field width) */
+	ScopeNumber<double> width;
+
+	/** height (fraction of the field height) */
+	ScopeNumber<double> height;
+
+	/** Quick construct */
+	ROIProperties(const double& _left = 0.0, const double& _top = 0.0, const double& _width = 1.0, const double& _height = 1.0);
+
+	/** @return right border (fraction of the field width), never beyond the field */
+	double Right() const { return std::min(1.0, left() + width()); }
+
+	/** @return bottom border (fraction of the field height), never beyond the field */
+	double Bottom() const { return std::min(1.0, top() + height()); }
+
+	void Load(const wptree& pt) override;
+	void Save(wptree& pt) const override;
+};
+
+}
+
+}
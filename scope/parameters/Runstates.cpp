@@ -16,6 +16,7 @@ namespace scope {
 			, spacing(1, 0.1, 50, L"Spacing_um")
 			, zdevicetype(ZDeviceHelper::ZStage, L"ZDeviceType")
 			, overalltime(1, 1, 2000, L"OverallTime_s")
+			, continuousfastz(false, false, true, L"ContinuousFastZ")
 		{
 			spacing.ConnectOther(std::bind(&Stack::UpdatePlanes, this));
 			zdevicetype.ConnectOther(std::bind(&Stack::ResetPlanes, this));
@@ -103,6 +104,7 @@ namespace scope {
 			spacing.SetFromPropertyTree(pt);
 			zdevicetype.SetFromPropertyTree(pt);
 			overalltime.SetFromPropertyTree(pt);
+			continuousfastz.SetFromPropertyTree(pt);
 		}
 
 		void Stack::Save(wptree& pt) const {
@@ -118,6 +120,7 @@ namespace scope {
 			spacing.AddToPropertyTree(pt);
 			zdevicetype.AddToPropertyTree(pt);
 			overalltime.AddToPropertyTree(pt);
+			continuousfastz.AddToPropertyTree(pt);
 		}
 
 		void Stack::SetReadOnlyWhileScanning(const RunState& _runstate) {
@@ -131,6 +134,7 @@ namespace scope {
 				p.SetReadOnlyWhileScanning(_runstate);
 			spacing.SetRWState(enabler);
 			zdevicetype.SetRWState(enabler);
+			continuousfastz.SetRWState(enabler);
 		}
 
 		Timeseries::Timeseries(const uint32_t& _nareas)
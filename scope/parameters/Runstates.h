@@ -38,8 +38,15 @@ namespace scope {
 				/** time in seconds for all timeseries */
 				ScopeNumber<double> overalltime;
 
+				/** if true (and zdevicetype is FastZ), the whole stack is acquired in one continuous run with precalculated fast z and Pockels waveforms
+				* instead of restarting acquisition for every plane */
+				ScopeNumber<bool> continuousfastz;
+
 				Stack(const uint32_t& _nareas);
 
+				/** @return true if the stack is acquired as one continuous fast z run */
+				bool ContinuousFastZ() const { return (zdevicetype().t == ZDeviceHelper::FastZ) && continuousfastz(); }
+
 				/** total span of z stack */
 				virtual double Range(const uint32_t& _area);
 				
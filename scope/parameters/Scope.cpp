@@ -74,6 +74,7 @@ namespace parameters {
 			, stage(_scope.stage)
 			, stimulation(_scope.stimulation)
 			, frames(_scope.frames)
+			, threads(_scope.threads)
 			, startinputsfirst(_scope.startinputsfirst)
 			, commontrigger(_scope.commontrigger)
 			, masterfovsizex(_scope.masterfovsizex)
@@ -132,6 +133,7 @@ namespace parameters {
 			stage = _scope.stage;
 			stimulation = _scope.stimulation;
 			frames = _scope.frames;
+			threads = _scope.threads;
 			startinputsfirst = _scope.startinputsfirst;
 			commontrigger = _scope.commontrigger;
 			masterfovsizex = _scope.masterfovsizex;
@@ -187,6 +189,9 @@ namespace parameters {
 				stage.Load(pt.get_child(L"scope.stage"));
 				stimulation.Load(pt.get_child(L"scope.stimulation"));
 				frames.Load(pt.get_child(L"scope.frames"));
+				// Older parameter files have no threads section
+				if ( pt.get_child_optional(L"scope.threads") )
+					threads.Load(pt.get_child(L"scope.threads"));
 				uint32_t i = 0;
 				for (auto& ar : allareas)
 					ar->Load(pt.get_child(boost::str(boost::wformat(L"scope.area%d") % i++)));
@@ -206,6 +211,7 @@ namespace parameters {
 			wptree ptstage;
 			wptree ptstimulation;
 			wptree ptframes;
+			wptree ptthreads;
 
 			try {
 				nareas.AddToPropertyTree(ptroot);
@@ -236,6 +242,8 @@ namespace parameters {
 				pt.add_child(L"scope.stimulation", ptstimulation);
 				frames.Save(ptframes);
 				pt.add_child(L"scope.frames", ptframes);
+				threads.Save(ptthreads);
+				pt.add_child(L"scope.threads", ptthreads);
 				// use the current locale, convert from wchar_t (here) to UTF-8 (in file), and and generate a BOM header
 				std::locale old_locale;
 				// Attention: the 'new' here is correct that way (weird as it is...)
@@ -255,6 +263,7 @@ namespace parameters {
 			timeseries.SetReadOnlyWhileScanning(_runstate);
 			stage.SetReadOnlyWhileScanning(_runstate);
 			stimulation.SetReadOnlyWhileScanning(_runstate);
+			threads.SetReadOnlyWhileScanning(_runstate);
 		}
 
 
@@ -11,6 +11,7 @@
 #include "Storage.h"
 #include "Runstates.h"
 #include "Windows.h"
+#include "Threads.h"
 
 namespace scope {
 
@@ -73,6 +74,9 @@ namespace scope {
 			/** The parameters for windows on the screen */
 			WindowCollection frames;
 
+			/** Priorities and affinities of the controllers' worker threads */
+			Threads threads;
+
 			/** true: start inputs first, then outputs with output of area 0 as last, so it (e.g. /ao/StartTrigger) can serve as common master trigger for everything else
 			* false: start outputs first, then inputs (area 0 last) so an FPGA doing the input can generate the sample clock for the outputs */
 			ScopeNumber<bool> startinputsfirst;
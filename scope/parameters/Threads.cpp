@@ -0,0 +1,43 @@
+#include "stdafx.h"
+#include "parameters/Threads.h"
+#include "helpers/ScopeException.h"
+
+namespace scope {
+
+namespace parameters {
+
+// Save some typing here...
+using namespace boost::property_tree;
+
+Threads::Threads()
+	: daqpriority(THREAD_PRIORITY_NORMAL, THREAD_PRIORITY_IDLE, THREAD_PRIORITY_TIME_CRITICAL, L"DaqPriority")
+	, daqaffinity(0, 0, UINT64_MAX, L"DaqAffinityMask")
+	, pipelinepriority(THREAD_PRIORITY_NORMAL, THREAD_PRIORITY_IDLE, THREAD_PRIORITY_TIME_CRITICAL, L"PipelinePriority")
+	, pipelineaffinity(0, 0, UINT64_MAX, L"PipelineAffinityMask") {
+}
+
+void Threads::Load(const wptree& pt) {
+	daqpriority.SetFromPropertyTree(pt);
+	daqaffinity.SetFromPropertyTree(pt);
+	pipelinepriority.SetFromPropertyTree(pt);
+	pipelineaffinity.SetFromPropertyTree(pt);
+}
+
+void Threads::Save(wptree& pt) const {
+	daqpriority.AddToPropertyTree(pt);
+	daqaffinity.AddToPropertyTree(pt);
+	pipelinepriority.AddToPropertyTree(pt);
+	pipelineaffinity.AddToPropertyTree(pt);
+}
+
+void Threads::SetReadOnlyWhileScanning(const RunState& _runstate) {
+	const bool enabler = (_runstate.t==RunStateHelper::Mode::Stopped)?true:false;
+	daqpriority.SetRWState(enabler);
+	daqaffinity.SetRWState(enabler);
+	pipelinepriority.SetRWState(enabler);
+	pipelineaffinity.SetRWState(enabler);
+}
+
+}
+
+}
@@ -0,0 +1,41 @@
+#pragma once
+
+#include "helpers/ScopeDatatypes.h"
+#include "helpers/ScopeNumber.h"
+#include "helpers/helpers.h"
+#include "Base.h"
+
+namespace scope {
+
+/** all parameters live in this namespace */
+namespace parameters {
+
+using boost::property_tree::wptree;
+
+/** Priorities and CPU affinities of the controllers' worker threads
+* @ingroup ScopeParameters */
+class Threads
+	: public Base {
+public:
+	Threads();
+
+	/** Windows thread priority of the DaqController worker threads (-2 below normal ... 2 highest, 15 time critical) */
+	ScopeNumber<int32_t> daqpriority;
+
+	/** CPU affinity mask of the DaqController worker threads, 0 for all CPUs */
+	ScopeNumber<uint64_t> daqaffinity;
+
+	/** Windows thread priority of the PipelineController worker threads */
+	ScopeNumber<int32_t> pipelinepriority;
+
+	/** CPU affinity mask of the PipelineController worker threads, 0 for all CPUs */
+	ScopeNumber<uint64_t> pipelineaffinity;
+
+	void Load(const wptree& pt) override;
+	void Save(wptree& pt) const override;
+	void SetReadOnlyWhileScanning(const RunState& _runstate) override;
+};
+
+}
+
+}
@@ -61,6 +61,7 @@
 #define IDD_FPGARESONANCESCANNER_PROPPAGE 242
 #define IDD_FRAMESCAN_RESONANCE_PROPPAGE 243
 #define IDD_FRAMESCAN_RESONANCE_SLAVE_PROPPAGE 245
+#define IDD_SIMULATEDINPUTS_PROPPAGE    246
 #define IDC_PIXELX                      1003
 #define IDC_SCANSETTINGS_HOLDER         1004
 #define IDC_PIXELY                      1004
@@ -247,6 +248,12 @@
 #define IDC_EDITVOLPLN_BUTTON			1160
 #define IDC_RESVOLPLN_BUTTON			1161
 #define IDC_VOLSCAN_PLANES_LIST			1162
+#define IDC_PHOTONRATE_EDIT             1163
+#define IDC_BACKGROUNDRATE_EDIT         1164
+#define IDC_COUNTSPERPHOTON_EDIT        1165
+#define IDC_SCANNERLAG_EDIT             1166
+#define IDC_BEADS_EDIT                  1167
+#define IDC_REALTIME_CHECK              1168
 #define IDC_CH1BUTTON                   32777
 #define IDPANE_MEMORY                   32778
 #define IDC_CH2BUTTON                   32779
@@ -280,9 +287,9 @@
 // 
 #ifdef APSTUDIO_INVOKED
 #ifndef APSTUDIO_READONLY_SYMBOLS
-#define _APS_NEXT_RESOURCE_VALUE        240
+#define _APS_NEXT_RESOURCE_VALUE        247
 #define _APS_NEXT_COMMAND_VALUE         32827
-#define _APS_NEXT_CONTROL_VALUE         1158
+#define _APS_NEXT_CONTROL_VALUE         1169
 #define _APS_NEXT_SYMED_VALUE           116
 #endif
 #endif
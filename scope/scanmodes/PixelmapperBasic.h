@@ -9,7 +9,10 @@
 namespace scope {
 
 	template<uint32_t, uint32_t> class PixelmapperFrameSaw;
+	template<uint32_t, uint32_t> class PixelmapperFrameLineRepeat;
 	template<uint32_t, uint32_t> class PixelmapperFrameBiDi;
+	template<uint32_t, uint32_t> class PixelmapperFramePlaneHopper;
+	template<uint32_t, uint32_t> class PixelmapperTrajectory;
 	template<uint32_t, uint32_t> class PixelmapperFrameResonanceHW;
 	template<uint32_t, uint32_t> class PixelmapperFrameResonanceSW;
 
@@ -38,10 +41,10 @@ namespace scope {
 			parameters::ScannerVectorFrameBasic* svparameters;
 
 			/** for position lookup */
-			const std::vector<std::size_t>* lookup;
+			const std::vector<uint32_t>* lookup;
 			
 			/** last position in lookup where we looked up last time */
-			std::vector<std::size_t>::const_iterator lastlookup;
+			std::vector<uint32_t>::const_iterator lastlookup;
 
 		public:
 			/** Initializes.
@@ -62,12 +65,31 @@ namespace scope {
 				switch ( _scanner ) {
 					case config::ScannerEnum::RegularGalvo:
 						switch ( (ScannerVectorTypeHelper::Mode)_type ) {
+							// Image lines may be repeated, the mapper averages them
+							case ScannerVectorTypeHelper::Sawtooth:
+								return std::make_unique<PixelmapperFrameLineRepeat<NCHANNELS, NAREAS>>();
 							case ScannerVectorTypeHelper::Bidirectional:
 								return std::make_unique<PixelmapperFrameBiDi<NCHANNELS, NAREAS>>();
-							// Not yet implemented
-							//case ScannerVectorTypeHelper::Planehopper:
-							//	return std::unique_ptr<PixelmapperBasic>(new PixelmapperBasic());
-						
+							// The multi ROI lookup vector places every region in the full field image, every sample on its own (no line repeats).
+							// The line repeat mapper skips the cutoff, retrace and flyback samples (mapped to 0) instead of writing them into the first pixel.
+							case ScannerVectorTypeHelper::MultiROI:
+								return std::make_unique<PixelmapperFrameLineRepeat<NCHANNELS, NAREAS>>(false);
+							// The line scan lookup vector puts pass l along the path into image line l, every pixel once per frame. Since the next frame
+							// starts as a copy of the last one, new lines overwrite the oldest ones from top to bottom (rolling kymograph). The line repeat
+							// mapper skips the cutoff and retrace samples (mapped to 0) instead of writing them into the first pixel.
+							case ScannerVectorTypeHelper::LineStraight:
+								return std::make_unique<PixelmapperFrameLineRepeat<NCHANNELS, NAREAS>>();
+							case ScannerVectorTypeHelper::Planehopper:
+								return std::make_unique<PixelmapperFramePlaneHopper<NCHANNELS, NAREAS>>();
+							// The volume lookup vector encodes the slice like the plane hopper's encodes the plane
+							case ScannerVectorTypeHelper::Volume:
+								return std::make_unique<PixelmapperFramePlaneHopper<NCHANNELS, NAREAS>>();
+							// Trajectory scans hit pixels several times per frame, the mapper averages them
+							case ScannerVectorTypeHelper::Lissajous:
+							case ScannerVectorTypeHelper::Spiral:
+								return std::make_unique<PixelmapperTrajectory<NCHANNELS, NAREAS>>();
+
+							// One sample per lookup position, no assumptions about the lookup vector
 							default:
 								return std::make_unique<PixelmapperFrameSaw<NCHANNELS, NAREAS>>();
 						}
@@ -98,7 +120,7 @@ namespace scope {
 			}
 
 			/** Sets the vectors for lookup */
-			virtual void SetLookupVector(const std::vector<std::size_t>* const _lookup) {
+			virtual void SetLookupVector(const std::vector<uint32_t>* const _lookup) {
 				lookup = _lookup;
 				lastlookup = std::begin(*lookup);
 			}
@@ -135,7 +157,7 @@ namespace scope {
 		}
 
 		/** Maps a chunk via the lookup vector */
-		PixelmapperResult LookupChunk(DaqMultiChunk<NCHANNELS, NAREAS, uint16_t>& _chunk, const uint16_t& _currentavgcount) {
+		PixelmapperResult LookupChunk(DaqMultiChunk<NCHANNELS, NAREAS, uint16_t>& _chunk, const uint16_t& _currentavgcount) override {
 			PixelmapperResult result(Nothing);
 			uint32_t n = 1;
 			const uint32_t multiplier = _currentavgcount;								// currentavgcount = 0: first frame, multiply by 0 -> overwrite last image pixel (for running update of old pixels), see PipelineController
@@ -195,6 +217,7 @@ namespace scope {
 	* 	CCIIIIIIIIIRR
 	* 	RRRRRRRRRRRRR
 	* 	RRRRRRRRRRRRR
+	* Every sample is mapped on its own, thus this also works for lookup vectors that are not frame shaped. Discarded samples land in the first pixel.
 	* @tparam NAREAS defines how many areas are mapped in parallel (e.g. multiarea configuration with only one scanner-pair) */
 	template<uint32_t NCHANNELS = 2, uint32_t NAREAS = 1>
 	class PixelmapperFrameSaw
@@ -206,7 +229,7 @@ namespace scope {
 		{ }
 
 		/** Maps multi chunks in parallel via one lookup vector */
-		PixelmapperResult LookupChunk(DaqMultiChunk<NCHANNELS, NAREAS, uint16_t> const _chunk, const uint16_t* _currentavgcount) {
+		PixelmapperResult LookupChunk(DaqMultiChunk<NCHANNELS, NAREAS, uint16_t>& _chunk, const uint16_t& _currentavgcount) override {
 			PixelmapperResult result(Nothing);
 			uint32_t n = 1;
 			const uint32_t multiplier = _currentavgcount;								// currentavgcount = 0: first frame, multiply by 0 -> overwrite last image pixel (for running update of old pixels), see PipelineController
@@ -218,12 +241,12 @@ namespace scope {
 			std::array<DaqChunk<uint16_t>::iterator, NAREAS> chunkit;
 			// Go through all channels
 			for (uint32_t c = 0; c < NCHANNELS; c++) {
-				std::vector<ScopeImageAccessU16> imagedata;
-				std::vector<std::vector<uint16_t>* const> dataptr;
+				std::array<std::unique_ptr<ScopeImageAccessU16>, NAREAS> imagedata;
+				std::array<uint16_t*, NAREAS> dataptr;
 				for (uint32_t a = 0; a < NAREAS; a++) {
 					// Get the data
-					imagedata.push_back(ScopeImageAccessU16(*current_frames[a]->GetChannel(c)));
-					dataptr.push_back(imagedata[a].GetData());
+					imagedata[a] = std::make_unique<ScopeImageAccessU16>(*current_frames[a]->GetChannel(c));
+					dataptr[a] = imagedata[a]->GetPointer();
 
 					// Which sample did we map last in this chunk (initially st::begin)
 					chunkit[a] = _chunk.lastmapped[a][c];
@@ -238,14 +261,14 @@ namespace scope {
 				for (; (lookit != lookupend) && (chunkit[0] != channelend[0]); lookit++) {
 					for (uint32_t a = 0; a < NAREAS; a++) {
 						// Do a little calculation for the online averaging
-						n = (static_cast<uint32_t>(dataptr[a]->operator[](*lookit)) * multiplier) + static_cast<uint32_t>(*chunkit[a]);
-						dataptr[a]->operator[](*lookit) = static_cast<uint16_t>(n / divisor + ((n%divisor)>halfdivisor ? 1u : 0u));
+						n = (static_cast<uint32_t>(dataptr[a][*lookit]) * multiplier) + static_cast<uint32_t>(*chunkit[a]);
+						dataptr[a][*lookit] = static_cast<uint16_t>(n / divisor + ((n%divisor)>halfdivisor ? 1u : 0u));
 						chunkit[a]++;
 					}
 				}
 				// save in the chunk which sample was last mapped
 				for (uint32_t a = 0; a < NAREAS; a++)
-					_chunk->lastmapped[a][c] = chunkit[a];
+					_chunk.lastmapped[a][c] = chunkit[a];
 			}
 			// save which pixel we last looked up
 			if (lookit == lookup->end()) {
@@ -262,6 +285,433 @@ namespace scope {
 		}
 	};
 
+	/** Maps a sawtooth frame whose image lines are scanned several times in a row (parameters::ScannerVectorFrameSaw::linerepeats). All
+	* repeats of a line map to the same image pixels, they are summed in a line sized scratch buffer (stays in cache) and only the mean is
+	* written into the image (combined with older frames for frame averaging) at the last repeat. Thus the image is touched once per line
+	* instead of once per sample and the frame is complete after one pass. With one repeat this is plain sawtooth mapping.\n
+	* First and last repeat of each sample are precomputed from the lookup vector whenever it changes. Cutoff and retrace samples are mapped
+	* to 0 like the first image pixel, the samples of the first pixel are the ones followed by the second pixel.\n
+	* Without line repeats (see constructor) every sample is mapped on its own like in PixelmapperFrameSaw, but the discarded samples are skipped
+	* too, e.g. for multi ROI lookup vectors.
+	* @tparam NAREAS defines how many areas are mapped in parallel (e.g. multiarea configuration with only one scanner-pair) */
+	template<uint32_t NCHANNELS = 2, uint32_t NAREAS = 1>
+	class PixelmapperFrameLineRepeat
+		: public PixelmapperBasic<NCHANNELS, NAREAS> {
+
+	protected:
+		/** Flags for every lookup position */
+		enum RepeatFlags : uint8_t {
+			image = 1,
+			firstrepeat = 2,
+			lastrepeat = 4
+		};
+
+		/** for every lookup position, if it is an image sample and if it is the first and/or last repeat of that pixel */
+		std::vector<uint8_t> repeatflags;
+
+		/** sums of the repeats of the current line, area by area and in each area channel by channel */
+		std::vector<uint32_t> linesums;
+
+		/** repeats per line */
+		uint32_t repeats;
+
+		/** if false, every sample is mapped on its own (repeats is 1 then) */
+		const bool repeatlines;
+
+		/** pixels per image line */
+		uint32_t linewidth;
+
+		/** false if the flags have to be recalculated */
+		bool flagsvalid;
+
+		/** Calculates repeatflags from the lookup vector */
+		void CalculateFlags() {
+			const size_t pixels = current_frames[0]->Pixels();
+			linewidth = current_frames[0]->Linewidth();
+			const size_t n = lookup->size();
+			repeatflags.assign(n, 0);
+			std::vector<uint32_t> hits(pixels, 0);
+			for ( size_t i = 0 ; i < n ; i++ ) {
+				const size_t pos = (*lookup)[i];
+				// discarded samples are mapped to 0 too
+				if ( (pos >= pixels) || ((pos == 0) && ((pixels < 2) || ((*lookup)[(i + 1) % n] != 1))) )
+					continue;
+				repeatflags[i] = repeatlines ? (image | ((hits[pos]++ == 0) ? firstrepeat : 0)) : (image | firstrepeat | lastrepeat);
+			}
+			if ( !repeatlines ) {
+				repeats = 1;
+				linesums.assign(NAREAS * NCHANNELS * linewidth, 0);
+				flagsvalid = true;
+				return;
+			}
+			repeats = std::max(1u, *std::max_element(std::begin(hits), std::end(hits)));
+			std::vector<bool> seen(pixels, false);
+			for ( size_t i = n ; i-- > 0 ; ) {
+				if ( (repeatflags[i] & image) && !seen[(*lookup)[i]] ) {
+					seen[(*lookup)[i]] = true;
+					repeatflags[i] |= lastrepeat;
+				}
+			}
+			linesums.assign(NAREAS * NCHANNELS * linewidth, 0);
+			flagsvalid = true;
+		}
+
+	public:
+		/** @param[in] _repeatlines if false, every sample is mapped on its own instead of averaging the repeats of a line */
+		PixelmapperFrameLineRepeat(const bool& _repeatlines = true)
+			: PixelmapperBasic(ScannerTypeHelper::Regular, ScannerVectorTypeHelper::Sawtooth)
+			, repeats(1)
+			, repeatlines(_repeatlines)
+			, linewidth(1)
+			, flagsvalid(false) {
+		}
+
+		/** Sets the lookup vector, the flags are recalculated before the next chunk is mapped */
+		void SetLookupVector(const std::vector<uint32_t>* const _lookup) override {
+			PixelmapperBasic::SetLookupVector(_lookup);
+			flagsvalid = false;
+		}
+
+		/** Maps multi chunks in parallel via one lookup vector, averaging the repeats of every line */
+		PixelmapperResult LookupChunk(DaqMultiChunk<NCHANNELS, NAREAS, uint16_t>& _chunk, const uint16_t& _currentavgcount) override {
+			PixelmapperResult result(Nothing);
+			const uint32_t multiplier = _currentavgcount;								// currentavgcount = 0: first frame, multiply by 0 -> overwrite last image pixel (for running update of old pixels), see PipelineController
+			const uint32_t divisor = std::max<uint32_t>(1, _currentavgcount + 1);		// currentavgcount = 1: second frame, multiply by 1, divide by 2
+			const uint32_t halfdivisor = std::max<uint32_t>(1, divisor >> 2);			// etc etc
+			if ( !flagsvalid || (linewidth != current_frames[0]->Linewidth()) )
+				CalculateFlags();
+			const uint32_t halfrepeats = repeats >> 1;
+
+			auto lookit = lastlookup;
+			std::array<DaqChunk<uint16_t>::iterator, NAREAS> channelend;
+			std::array<DaqChunk<uint16_t>::iterator, NAREAS> chunkit;
+			// Go through all channels
+			for ( uint32_t c = 0 ; c < NCHANNELS ; c++ ) {
+				std::array<std::unique_ptr<ScopeImageAccessU16>, NAREAS> imagedata;
+				std::array<uint16_t*, NAREAS> dataptr;
+				std::array<uint32_t*, NAREAS> sumptr;
+				for ( uint32_t a = 0 ; a < NAREAS ; a++ ) {
+					imagedata[a] = std::make_unique<ScopeImageAccessU16>(*current_frames[a]->GetChannel(c));
+					dataptr[a] = imagedata[a]->GetPointer();
+					sumptr[a] = linesums.data() + (a*NCHANNELS + c) * linewidth;
+					// Which sample did we map last in this chunk (initially std::begin)
+					chunkit[a] = _chunk.lastmapped[a][c];
+					// where does this channel end in the chunk's data vector
+					channelend[a] = _chunk.GetDataStart(a) + (c + 1)*_chunk.PerChannel();
+				}
+
+				// Which pixel did we last look up in the lookup vector
+				lookit = lastlookup;
+				// Advance iterators in chunk and lookup vector in parallel
+				auto lookupend = std::end(*lookup);
+				for ( ; (lookit != lookupend) && (chunkit[0] != channelend[0]) ; lookit++ ) {
+					const uint8_t flags = repeatflags[lookit - std::begin(*lookup)];
+					if ( !(flags & image) ) {
+						for ( uint32_t a = 0 ; a < NAREAS ; a++ )
+							chunkit[a]++;
+						continue;
+					}
+					const size_t pos = *lookit;
+					// the repeats of a line follow each other, thus one line of sums is enough
+					const size_t column = pos % linewidth;
+					for ( uint32_t a = 0 ; a < NAREAS ; a++ ) {
+						uint32_t& sum = sumptr[a][column];
+						sum = ((flags & firstrepeat) ? 0 : sum) + static_cast<uint32_t>(*chunkit[a]);
+						chunkit[a]++;
+						if ( !(flags & lastrepeat) )
+							continue;
+						// Do a little calculation for the online averaging
+						const uint32_t n = (static_cast<uint32_t>(dataptr[a][pos]) * multiplier) + (sum + halfrepeats) / repeats;
+						dataptr[a][pos] = static_cast<uint16_t>(n / divisor + ((n%divisor)>halfdivisor ? 1u : 0u));
+					}
+				}
+				// save in the chunk which sample was last mapped
+				for ( uint32_t a = 0 ; a < NAREAS ; a++ )
+					_chunk.lastmapped[a][c] = chunkit[a];
+			}
+			// save which pixel we last looked up
+			if ( lookit == lookup->end() ) {
+				lastlookup = std::begin(*lookup);
+				result = PixelmapperResult(result | FrameComplete);
+			}
+			else
+				lastlookup = lookit;
+
+			if ( chunkit[0] == channelend[0] )
+				result = PixelmapperResult(result | EndOfChunk);
+
+			return result;
+		}
+	};
+
+	/** Maps acquired pixels of a plane hopping scan into one image per plane. The lookup vector of ScannerVectorFramePlaneHopper
+	* encodes the plane as plane*planepixels + position in the plane's image, cutoff and retrace samples are mapped like for sawtooth.
+	* @tparam NAREAS defines how many areas are mapped in parallel (e.g. multiarea configuration with only one scanner-pair) */
+	template<uint32_t NCHANNELS = 2, uint32_t NAREAS = 1>
+	class PixelmapperFramePlaneHopper
+		: public PixelmapperBasic<NCHANNELS, NAREAS> {
+
+	protected:
+		/** the frames to be mapped into, area by area and in each area plane by plane (index area*planes + plane) */
+		std::vector<ScopeMultiImagePtr> plane_frames;
+
+		/** number of planes per area */
+		uint32_t planes;
+
+	public:
+		PixelmapperFramePlaneHopper()
+			: PixelmapperBasic(ScannerTypeHelper::Regular, ScannerVectorTypeHelper::Planehopper)
+			, planes(1) {
+		}
+
+		/** Sets the frames of all planes of all areas, area by area and in each area plane by plane */
+		void SetCurrentFrames(std::vector<ScopeMultiImagePtr> const _current_frames) override {
+			assert( (_current_frames.size() % NAREAS) == 0 );
+			plane_frames = _current_frames;
+			planes = static_cast<uint32_t>(_current_frames.size() / NAREAS);
+			for ( uint32_t a = 0 ; a < NAREAS ; a++ )
+				current_frames[a] = plane_frames[a*planes];
+		}
+
+		/** Maps multi chunks in parallel via one lookup vector, the plane is decoded from the lookup value */
+		PixelmapperResult LookupChunk(DaqMultiChunk<NCHANNELS, NAREAS, uint16_t>& _chunk, const uint16_t& _currentavgcount) override {
+			PixelmapperResult result(Nothing);
+			uint32_t n = 1;
+			const uint32_t multiplier = _currentavgcount;								// currentavgcount = 0: first frame, multiply by 0 -> overwrite last image pixel (for running update of old pixels), see PipelineController
+			const uint32_t divisor = std::max<uint32_t>(1, _currentavgcount + 1);		// currentavgcount = 1: second frame, multiply by 1, divide by 2
+			const uint32_t halfdivisor = std::max<uint32_t>(1, divisor >> 2);			// etc etc
+			const size_t planepixels = plane_frames[0]->Pixels();
+
+			auto lookit = lastlookup;
+			std::array<DaqChunk<uint16_t>::iterator, NAREAS> channelend;
+			std::array<DaqChunk<uint16_t>::iterator, NAREAS> chunkit;
+			// Go through all channels
+			for ( uint32_t c = 0 ; c < NCHANNELS ; c++ ) {
+				// Lock the images of all planes of all areas, index area*planes + plane
+				std::vector<std::unique_ptr<ScopeImageAccessU16>> imagedata;
+				std::vector<uint16_t*> dataptr;
+				for ( const auto& f : plane_frames ) {
+					imagedata.push_back(std::make_unique<ScopeImageAccessU16>(*f->GetChannel(c)));
+					dataptr.push_back(imagedata.back()->GetPointer());
+				}
+				for ( uint32_t a = 0 ; a < NAREAS ; a++ ) {
+					// Which sample did we map last in this chunk (initially std::begin)
+					chunkit[a] = _chunk.lastmapped[a][c];
+					// where does this channel end in the chunk's data vector
+					channelend[a] = _chunk.GetDataStart(a) + (c + 1)*_chunk.PerChannel();
+				}
+
+				// Which pixel did we last look up in the lookup vector
+				lookit = lastlookup;
+				// Advance iterators in chunk and lookup vector in parallel
+				auto lookupend = std::end(*lookup);
+				for ( ; (lookit != lookupend) && (chunkit[0] != channelend[0]) ; lookit++ ) {
+					const size_t plane = *lookit / planepixels;
+					const size_t pos = *lookit - plane * planepixels;
+					for ( uint32_t a = 0 ; a < NAREAS ; a++ ) {
+						uint16_t* const pixel = dataptr[a*planes + plane] + pos;
+						// Do a little calculation for the online averaging
+						n = (static_cast<uint32_t>(*pixel) * multiplier) + static_cast<uint32_t>(*chunkit[a]);
+						*pixel = static_cast<uint16_t>(n / divisor + ((n%divisor)>halfdivisor ? 1u : 0u));
+						chunkit[a]++;
+					}
+				}
+				// save in the chunk which sample was last mapped
+				for ( uint32_t a = 0 ; a < NAREAS ; a++ )
+					_chunk.lastmapped[a][c] = chunkit[a];
+			}
+			// save which pixel we last looked up
+			if ( lookit == lookup->end() ) {
+				lastlookup = std::begin(*lookup);
+				result = PixelmapperResult(result | FrameComplete);
+			}
+			else
+				lastlookup = lookit;
+
+			if ( chunkit[0] == channelend[0] )
+				result = PixelmapperResult(result | EndOfChunk);
+
+			return result;
+		}
+	};
+
+	/** Maps the samples of a smooth trajectory scan (ScannerVectorLissajous, ScannerVectorSpiral). The lookup vector maps every sample into
+	* the image and hits most pixels several times per frame, in no particular order. The samples are summed per pixel and each pixel shows the
+	* mean of its samples so far, thus a frame builds up progressively all over the field instead of line by line. The weights for the means
+	* and the pixels the trajectory misses are precomputed from the lookup vector whenever it changes, so they always match the vector
+	* (also after online updates and scanner delay rotations). Missed pixels show their nearest hit neighbour.
+	* @tparam NAREAS defines how many areas are mapped in parallel (e.g. multiarea configuration with only one scanner-pair) */
+	template<uint32_t NCHANNELS = 2, uint32_t NAREAS = 1>
+	class PixelmapperTrajectory
+		: public PixelmapperBasic<NCHANNELS, NAREAS> {
+
+	protected:
+		/** Flags for every lookup position */
+		enum HitFlags : uint8_t {
+			firsthit = 1,
+			lasthit = 2
+		};
+
+		/** missed pixels further away from a hit pixel stay as they are */
+		static const int32_t maxholedistance = 4;
+
+		/** for every lookup position 65536/k, with k the number of samples of that pixel up to and including this one */
+		std::vector<uint32_t> weights;
+
+		/** for every lookup position, if it is the first and/or last sample of that pixel in the frame */
+		std::vector<uint8_t> hitflags;
+
+		/** running sums of the samples per pixel, area by area and in each area channel by channel */
+		std::vector<uint32_t> sums;
+
+		/** the missed pixels filled from pixel p are holes[holestart[p]] to holes[holestart[p+1]-1] */
+		std::vector<uint32_t> holestart;
+
+		/** missed pixels, sorted by the pixel they are filled from */
+		std::vector<uint32_t> holes;
+
+		/** pixels of the images the tables were calculated for, 0 if they have to be recalculated */
+		size_t pixels;
+
+		/** Calculates weights, hitflags and holes from the lookup vector */
+		void CalculateTables() {
+			const uint32_t xres = current_frames[0]->Linewidth();
+			const uint32_t yres = current_frames[0]->Lines();
+			pixels = static_cast<size_t>(xres) * yres;
+
+			std::vector<uint32_t> hits(pixels, 0);
+			weights.resize(lookup->size());
+			hitflags.assign(lookup->size(), 0);
+			for ( size_t i = 0 ; i < lookup->size() ; i++ ) {
+				const uint32_t k = ++hits[(*lookup)[i]];
+				weights[i] = 65536u / k;
+				if ( k == 1 )
+					hitflags[i] |= firsthit;
+			}
+			std::vector<bool> seen(pixels, false);
+			for ( size_t i = lookup->size() ; i-- > 0 ; ) {
+				if ( !seen[(*lookup)[i]] ) {
+					seen[(*lookup)[i]] = true;
+					hitflags[i] |= lasthit;
+				}
+			}
+
+			// Find the nearest hit pixel for every missed one, then sort the missed pixels by that
+			std::vector<std::pair<uint32_t, uint32_t>> fills;
+			const int32_t maxd = maxholedistance;
+			for ( int32_t y = 0 ; y < static_cast<int32_t>(yres) ; y++ ) {
+				for ( int32_t x = 0 ; x < static_cast<int32_t>(xres) ; x++ ) {
+					if ( hits[y*xres + x] != 0 )
+						continue;
+					int32_t best = maxd * maxd + 1;
+					uint32_t from = 0;
+					for ( int32_t dy = std::max(-y, -maxd) ; dy <= std::min(static_cast<int32_t>(yres) - 1 - y, maxd) ; dy++ ) {
+						for ( int32_t dx = std::max(-x, -maxd) ; dx <= std::min(static_cast<int32_t>(xres) - 1 - x, maxd) ; dx++ ) {
+							const uint32_t p = (y + dy)*xres + x + dx;
+							if ( (hits[p] != 0) && (dx*dx + dy*dy < best) ) {
+								best = dx*dx + dy*dy;
+								from = p;
+							}
+						}
+					}
+					if ( best <= maxd * maxd )
+						fills.emplace_back(from, y*xres + x);
+				}
+			}
+			holestart.assign(pixels + 1, 0);
+			for ( const auto& f : fills )
+				holestart[f.first + 1]++;
+			std::partial_sum(std::begin(holestart), std::end(holestart), std::begin(holestart));
+			holes.resize(fills.size());
+			std::vector<uint32_t> next(std::begin(holestart), std::end(holestart) - 1);
+			for ( const auto& f : fills )
+				holes[next[f.first]++] = f.second;
+
+			sums.assign(NAREAS * NCHANNELS * pixels, 0);
+		}
+
+	public:
+		PixelmapperTrajectory()
+			: PixelmapperBasic(ScannerTypeHelper::Regular, ScannerVectorTypeHelper::Lissajous)
+			, pixels(0) {
+		}
+
+		/** Sets the lookup vector, the tables are recalculated before the next chunk is mapped */
+		void SetLookupVector(const std::vector<uint32_t>* const _lookup) override {
+			PixelmapperBasic::SetLookupVector(_lookup);
+			pixels = 0;
+		}
+
+		/** Maps multi chunks in parallel via one lookup vector. Without averaging every sample updates the mean of its pixel, with averaging
+		* the mean of a pixel in this frame is averaged with the older frames at its last sample. */
+		PixelmapperResult LookupChunk(DaqMultiChunk<NCHANNELS, NAREAS, uint16_t>& _chunk, const uint16_t& _currentavgcount) override {
+			PixelmapperResult result(Nothing);
+			const uint32_t multiplier = _currentavgcount;								// currentavgcount = 0: first frame, multiply by 0 -> overwrite last image pixel (for running update of old pixels), see PipelineController
+			const uint32_t divisor = std::max<uint32_t>(1, _currentavgcount + 1);		// currentavgcount = 1: second frame, multiply by 1, divide by 2
+			const uint32_t halfdivisor = std::max<uint32_t>(1, divisor >> 2);			// etc etc
+			if ( pixels != current_frames[0]->Pixels() )
+				CalculateTables();
+
+			auto lookit = lastlookup;
+			std::array<DaqChunk<uint16_t>::iterator, NAREAS> channelend;
+			std::array<DaqChunk<uint16_t>::iterator, NAREAS> chunkit;
+			// Go through all channels
+			for ( uint32_t c = 0 ; c < NCHANNELS ; c++ ) {
+				std::array<std::unique_ptr<ScopeImageAccessU16>, NAREAS> imagedata;
+				std::array<uint16_t*, NAREAS> dataptr;
+				std::array<uint32_t*, NAREAS> sumptr;
+				for ( uint32_t a = 0 ; a < NAREAS ; a++ ) {
+					imagedata[a] = std::make_unique<ScopeImageAccessU16>(*current_frames[a]->GetChannel(c));
+					dataptr[a] = imagedata[a]->GetPointer();
+					sumptr[a] = sums.data() + (a*NCHANNELS + c) * pixels;
+					// Which sample did we map last in this chunk (initially std::begin)
+					chunkit[a] = _chunk.lastmapped[a][c];
+					// where does this channel end in the chunk's data vector
+					channelend[a] = _chunk.GetDataStart(a) + (c + 1)*_chunk.PerChannel();
+				}
+
+				// Which pixel did we last look up in the lookup vector
+				lookit = lastlookup;
+				// Advance iterators in chunk and lookup vector in parallel
+				auto lookupend = std::end(*lookup);
+				for ( ; (lookit != lookupend) && (chunkit[0] != channelend[0]) ; lookit++ ) {
+					const size_t i = lookit - std::begin(*lookup);
+					const size_t pos = *lookit;
+					const uint8_t flags = hitflags[i];
+					for ( uint32_t a = 0 ; a < NAREAS ; a++ ) {
+						uint32_t& sum = sumptr[a][pos];
+						sum = ((flags & firsthit) ? 0 : sum) + static_cast<uint32_t>(*chunkit[a]);
+						chunkit[a]++;
+						if ( (multiplier != 0) && !(flags & lasthit) )
+							continue;
+						const uint32_t mean = static_cast<uint32_t>((static_cast<uint64_t>(sum) * weights[i] + 32768) >> 16);
+						// Do a little calculation for the online averaging
+						const uint32_t n = (static_cast<uint32_t>(dataptr[a][pos]) * multiplier) + mean;
+						const uint16_t value = static_cast<uint16_t>(std::min<uint32_t>(UINT16_MAX, n / divisor + ((n%divisor)>halfdivisor ? 1u : 0u)));
+						dataptr[a][pos] = value;
+						for ( uint32_t h = holestart[pos] ; h < holestart[pos + 1] ; h++ )
+							dataptr[a][holes[h]] = value;
+					}
+				}
+				// save in the chunk which sample was last mapped
+				for ( uint32_t a = 0 ; a < NAREAS ; a++ )
+					_chunk.lastmapped[a][c] = chunkit[a];
+			}
+			// save which pixel we last looked up
+			if ( lookit == lookup->end() ) {
+				lastlookup = std::begin(*lookup);
+				result = PixelmapperResult(result | FrameComplete);
+			}
+			else
+				lastlookup = lookit;
+
+			if ( chunkit[0] == channelend[0] )
+				result = PixelmapperResult(result | EndOfChunk);
+
+			return result;
+		}
+	};
+
 	/** Maps acquired pixels into an image analysing the resonance scanner sync signal, takes care of return fractions, forth/back lines etc
 	* @tparam NAREAS defines how many areas are mapped in parallel (e.g. multiarea configuration with only one scanner-pair) */
 	template<uint32_t NCHANNELS = 2, uint32_t NAREAS = 1>
@@ -273,7 +723,7 @@ namespace scope {
 		}
 
 		/** Maps a chunk */
-		PixelmapperResult LookupChunk(DaqMultiChunk<NCHANNELS, NAREAS, uint16_t>& _chunk, const uint16_t& _currentavgcount) {
+		PixelmapperResult LookupChunk(DaqMultiChunk<NCHANNELS, NAREAS, uint16_t>& _chunk, const uint16_t& _currentavgcount) override {
 			PixelmapperResult result(Nothing);
 
 			return result;
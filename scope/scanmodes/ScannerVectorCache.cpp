@@ -0,0 +1,96 @@
+#include "stdafx.h"
+#include "ScannerVectorCache.h"
+
+namespace scope {
+
+	namespace {
+		/** capacity, e.g. four 1024x1024 full frame vectors with their lookup vectors */
+		const size_t defaultcapacity = 256 * 1024 * 1024;
+	}
+
+	ScannerVectorCache::ScannerVectorCache()
+		: capacity(defaultcapacity)
+		, bytes(0)
+		, hits(0)
+		, misses(0)
+		, evictions(0) {
+	}
+
+	ScannerVectorCache& ScannerVectorCache::GetInstance() {
+		static ScannerVectorCache instance;
+		return instance;
+	}
+
+	uint64_t ScannerVectorCache::Hash(const std::vector<double>& _key) {
+		uint64_t hash = 14695981039346656037ull;
+		for ( const auto& k : _key ) {
+			uint64_t bits;
+			std::memcpy(&bits, &k, sizeof(bits));
+			for ( uint32_t b = 0 ; b < 8 ; b++ ) {
+				hash ^= (bits >> (8*b)) & 0xFF;
+				hash *= 1099511628211ull;
+			}
+		}
+		return hash;
+	}
+
+	void ScannerVectorCache::Erase(std::list<Entry>::iterator _it) {
+		bytes -= _it->Bytes();
+		index.erase(Hash(_it->key));
+		entries.erase(_it);
+	}
+
+	bool ScannerVectorCache::Get(const std::vector<double>& _key, std::vector<int16_t>& _vector, std::vector<uint32_t>& _lookup, int32_t& _lookup_rotation) {
+		std::lock_guard<std::mutex> lock(mutex);
+		auto found = index.find(Hash(_key));
+		if ( (found == std::end(index)) || (found->second->key != _key) ) {
+			misses++;
+			return false;
+		}
+		hits++;
+		// Move to the front (most recently used), iterators stay valid
+		entries.splice(std::begin(entries), entries, found->second);
+		const Entry& e = entries.front();
+		_vector.assign(std::begin(e.vector), std::end(e.vector));
+		_lookup.assign(std::begin(e.lookup), std::end(e.lookup));
+		_lookup_rotation = e.lookup_rotation;
+		return true;
+	}
+
+	void ScannerVectorCache::Put(const std::vector<double>& _key, const std::vector<int16_t>& _vector, const std::vector<uint32_t>& _lookup, const int32_t& _lookup_rotation) {
+		Entry e;
+		e.key = _key;
+		e.lookup_rotation = _lookup_rotation;
+		const size_t size = _vector.size() * sizeof(int16_t) + _lookup.size() * sizeof(uint32_t) + _key.size() * sizeof(double);
+		std::lock_guard<std::mutex> lock(mutex);
+		if ( size > capacity )
+			return;
+
+		// Replace an entry with the same hash (the same key or a collision)
+		const uint64_t hash = Hash(_key);
+		auto found = index.find(hash);
+		if ( found != std::end(index) )
+			Erase(found->second);
+
+		// Drop least recently used entries until the new one fits
+		while ( !entries.empty() && (bytes + size > capacity) ) {
+			Erase(std::prev(std::end(entries)));
+			evictions++;
+		}
+
+		e.vector = _vector;
+		e.lookup = _lookup;
+		entries.push_front(std::move(e));
+		index[hash] = std::begin(entries);
+		bytes += size;
+	}
+
+	std::wstring ScannerVectorCache::Summary() const {
+		std::lock_guard<std::mutex> lock(mutex);
+		std::wostringstream msg;
+		msg << L"Scanner vector cache: " << entries.size() << L" entries, " << bytes / (1024 * 1024) << L" of " << capacity / (1024 * 1024)
+			<< L" MB, " << hits << L" hits, " << misses << L" misses, " << evictions << L" evictions";
+		return msg.str();
+	}
+
+}
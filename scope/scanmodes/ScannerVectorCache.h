@@ -0,0 +1,87 @@
+#pragma once
+
+namespace scope {
+
+	/** Bounded least recently used cache of calculated scanner vectors and lookup vectors, shared by all areas. Entries are keyed by a hash of
+	* all parameter values a vector is calculated from (see ScannerVectorFrameBasic::FillInputs), the full key is compared on lookup so hash
+	* collisions only cost a miss. When the stored vectors exceed the capacity, the least recently used entries are dropped.
+	* Thus revisiting a configuration (stack planes, alternating timeseries planes, preset switching) only copies the vectors.
+	* Scanner vectors store only when caching is switched on (see ScannerVectorFrameBasic::SetCaching), not on online updates.
+	* @ingroup HELPERS */
+	class ScannerVectorCache {
+
+	public:
+		/** One cached vector */
+		struct Entry {
+			/** all parameter values the vectors were calculated from */
+			std::vector<double> key;
+
+			/** the interleaved scanner vector */
+			std::vector<int16_t> vector;
+
+			/** the lookup vector */
+			std::vector<uint32_t> lookup;
+
+			/** the rotation of the lookup vector */
+			int32_t lookup_rotation;
+
+			/** @return memory used by the vectors in bytes */
+			size_t Bytes() const { return vector.size() * sizeof(int16_t) + lookup.size() * sizeof(uint32_t) + key.size() * sizeof(double); }
+		};
+
+	protected:
+		/** protects everything, areas may update their vectors concurrently (e.g. online updates) */
+		mutable std::mutex mutex;
+
+		/** the entries, most recently used first */
+		std::list<Entry> entries;
+
+		/** hash of the key to position in entries */
+		std::unordered_map<uint64_t, std::list<Entry>::iterator> index;
+
+		/** maximum memory for all entries in bytes */
+		const size_t capacity;
+
+		/** current memory of all entries in bytes */
+		size_t bytes;
+
+		/** number of successful lookups */
+		uint64_t hits;
+
+		/** number of failed lookups */
+		uint64_t misses;
+
+		/** number of entries dropped to stay within capacity */
+		uint64_t evictions;
+
+	protected:
+		ScannerVectorCache();
+
+		/** @return FNV-1a hash of the bit patterns of the key values */
+		static uint64_t Hash(const std::vector<double>& _key);
+
+		/** Removes the entry at _it */
+		void Erase(std::list<Entry>::iterator _it);
+
+	public:
+		/** disable copy */
+		ScannerVectorCache(const ScannerVectorCache&) = delete;
+
+		/** disable assignment */
+		ScannerVectorCache& operator=(const ScannerVectorCache&) = delete;
+
+		static ScannerVectorCache& GetInstance();
+
+		/** Copies the cached vectors for _key into the output parameters and marks the entry as most recently used
+		* @return true on a hit, false if nothing is cached for _key */
+		bool Get(const std::vector<double>& _key, std::vector<int16_t>& _vector, std::vector<uint32_t>& _lookup, int32_t& _lookup_rotation);
+
+		/** Stores copies of the vectors for _key, replacing an older entry for the same key and dropping least recently used entries
+		* if the capacity is exceeded. Vectors larger than the capacity are not stored. */
+		void Put(const std::vector<double>& _key, const std::vector<int16_t>& _vector, const std::vector<uint32_t>& _lookup, const int32_t& _lookup_rotation);
+
+		/** @return a one line summary of entries, memory, hits, misses, and evictions for the log */
+		std::wstring Summary() const;
+	};
+
+}
@@ -0,0 +1,120 @@
+#include "stdafx.h"
+#include "ScannerVectorCheck.h"
+#include "ScannerVectorFrameBasic.h"
+#include "parameters/Daq.h"
+#include "parameters/Framescan.h"
+#include "helpers/ScopeException.h"
+
+namespace scope {
+
+namespace {
+	/** @return the parameter changes of the checks (starting at 128x64 pixels). Each step changes the parameters a bit further, some steps go
+	* back to earlier values. */
+	std::vector<std::function<void()>> CheckSteps(parameters::Daq& _daq, parameters::ScannerVectorFrameBasic* const _frame) {
+		_frame->xres = 128;
+		_frame->yres = 64;
+		return {
+			[]() { }
+			, [_frame]() { _frame->pockels = 0.3; }
+			, [_frame]() { _frame->zoom = 2.0; }
+			, [_frame]() { _frame->fastz = 2.5; }
+			, [_frame]() { _frame->xoffset = 0.2; _frame->yoffset = -0.1; }
+			, [&_daq]() { _daq.scannerdelay = 3 * _daq.pixeltime(); }
+			, [&_daq]() { _daq.scannerdelay = -7 * _daq.pixeltime(); }
+			, [_frame]() { _frame->pockels = 0.0; _frame->fastz = -1.0; }
+			, [_frame]() { _frame->zoom = 1.0; }
+			, [_frame]() { _frame->xres = 96; _frame->yres = 80; }
+			, [_frame, &_daq]() { _frame->pockels = 0.7; _daq.scannerdelay = 5 * _daq.pixeltime(); }
+			, [_frame]() { _frame->xres = 128; _frame->yres = 64; _frame->zoom = 3.0; }
+		};
+	}
+}
+
+ScannerVectorCheckResult ScannerVectorIncrementalCheck(const ScannerVectorType& _type, const ScannerVectorFillType& _filltype) {
+	parameters::Daq daq(false);
+	std::unique_ptr<parameters::ScannerVectorFrameBasic> frame(parameters::ScannerVectorFrameBasic::Factory(_type));
+	config::FPUZStageParametersType zstage;
+	const std::vector<std::function<void()>> steps(CheckSteps(daq, frame.get()));
+
+	ScannerVectorCheckResult result;
+	std::unique_ptr<ScannerVectorFrameBasic> incremental(ScannerVectorFrameBasic::Factory(_type, _filltype));
+	for ( const auto& step : steps ) {
+		step();
+		incremental->SetParameters(&daq, frame.get(), &zstage);
+
+		std::unique_ptr<ScannerVectorFrameBasic> full(ScannerVectorFrameBasic::Factory(_type, _filltype));
+		full->SetParameters(&daq, frame.get(), &zstage);
+		full->Recalculate();
+
+		result.steps++;
+		if ( *incremental->GetInterleavedVector() != *full->GetInterleavedVector() )
+			result.vectormismatches++;
+		if ( *incremental->GetLookupVector() != *full->GetLookupVector() )
+			result.lookupmismatches++;
+	}
+	return result;
+}
+
+ScannerVectorStreamCheckResult ScannerVectorStreamSwitchCheck(const ScannerVectorType& _type, const uint32_t& _blocksize) {
+	parameters::Daq daq(false);
+	std::unique_ptr<parameters::ScannerVectorFrameBasic> frame(parameters::ScannerVectorFrameBasic::Factory(_type));
+	config::FPUZStageParametersType zstage;
+	const std::vector<std::function<void()>> steps(CheckSteps(daq, frame.get()));
+
+	// The full frame vector with the current parameters
+	auto fullvector = [&]() {
+		std::unique_ptr<ScannerVectorFrameBasic> full(ScannerVectorFrameBasic::Factory(_type, ScannerVectorFillTypeHelper::FullframeXYZP));
+		full->SetParameters(&daq, frame.get(), &zstage);
+		return *full->GetInterleavedVector();
+	};
+
+	ScannerVectorStreamCheckResult result;
+	std::unique_ptr<ScannerVectorFrameBasic> streamed(ScannerVectorFrameBasic::Factory(_type, ScannerVectorFillTypeHelper::FullframeXYZP));
+	streamed->SetStreaming(true);
+	if ( !streamed->Streaming() )
+		throw ScopeException("ScannerVectorStreamSwitchCheck for a scan type that does not stream");
+	streamed->SetParameters(&daq, frame.get(), &zstage);
+
+	// The frames of the current vector start at origin
+	std::vector<int16_t> current(fullvector());
+	uint64_t origin = 0;
+	std::vector<int16_t> pending;
+	uint64_t switchsample = 0;
+	bool switchpending = false;
+
+	std::vector<int16_t> block(4 * static_cast<size_t>(_blocksize));
+	uint64_t position = 0;
+	for ( size_t s = 0 ; s < steps.size() ; s++ ) {
+		// Generate one and a half frames, so that updates fall at different positions in the frame
+		const uint64_t until = position + current.size() / 4 * 3 / 2;
+		while ( position < until ) {
+			streamed->Generate(position, _blocksize, block.data());
+			for ( uint32_t i = 0 ; i < _blocksize ; i++, position++ ) {
+				if ( switchpending && (position == switchsample) ) {
+					current.swap(pending);
+					origin = switchsample;
+					switchpending = false;
+				}
+				const size_t framepos = 4 * static_cast<size_t>((position - origin) % (current.size() / 4));
+				if ( !std::equal(current.begin() + framepos, current.begin() + framepos + 4, block.begin() + 4 * static_cast<size_t>(i)) )
+					result.samplemismatches++;
+			}
+		}
+
+		// Online update, the switch has to be at a frame start of the current vector that was not generated yet
+		steps[s]();
+		streamed->SetParameters(&daq, frame.get(), &zstage);
+		result.updates++;
+		pending = fullvector();
+		// Nothing to switch if the update did not change the vector (the stream tables stay as they are then)
+		if ( pending == current )
+			continue;
+		switchsample = streamed->StreamSwitchSample();
+		switchpending = true;
+		if ( (switchsample < position) || ((switchsample - origin) % (current.size() / 4) != 0) )
+			result.switchmisses++;
+	}
+	return result;
+}
+
+}
@@ -0,0 +1,54 @@
+#pragma once
+
+#include "helpers/ScopeDatatypes.h"
+
+namespace scope {
+
+	/** Result of a ScannerVectorIncrementalCheck run */
+	struct ScannerVectorCheckResult {
+		/** number of parameter changes compared */
+		uint32_t steps;
+
+		/** number of changes after which the scanner vector differed from the full recalculation */
+		uint32_t vectormismatches;
+
+		/** number of changes after which the lookup vector differed from the full recalculation */
+		uint32_t lookupmismatches;
+
+		ScannerVectorCheckResult() : steps(0), vectormismatches(0), lookupmismatches(0) { }
+	};
+
+	/** Checks the partial updates of a scanner vector (see ScannerVectorFrameBasic::DirtyParts). Applies a fixed sequence of Pockels, zoom,
+	* fast z, offset, scanner delay, and resolution changes to one scanner vector, which then refills only the changed parts. After every
+	* change a second scanner vector with the same parameters is recalculated completely (ScannerVectorFrameBasic::Recalculate), and the
+	* interleaved and lookup vectors of both are compared.\n
+	* Neither scanner vector switches on caching, thus the full recalculation never restores a partially updated vector from the ScannerVectorCache.
+	* @param[in] _type the scan type, must not need parameters from a parameter file (e.g. Sawtooth or Bidirectional)
+	* @param[in] _filltype the fill type of the scanner vectors
+	* @ingroup HELPERS */
+	ScannerVectorCheckResult ScannerVectorIncrementalCheck(const ScannerVectorType& _type, const ScannerVectorFillType& _filltype);
+
+	/** Result of a ScannerVectorStreamSwitchCheck run */
+	struct ScannerVectorStreamCheckResult {
+		/** number of online updates while generating */
+		uint32_t updates;
+
+		/** number of updates (that changed the vector) whose switch sample was not a frame start or was generated already */
+		uint32_t switchmisses;
+
+		/** number of generated samples that differed from the full frame vector of the parameters in effect at their position */
+		uint64_t samplemismatches;
+
+		ScannerVectorStreamCheckResult() : updates(0), switchmisses(0), samplemismatches(0) { }
+	};
+
+	/** Checks the online updates of a streaming scanner vector (see ScannerVectorFrameBasic::SetStreamTables). Generates samples block by
+	* block like a streaming output and applies the parameter changes of ScannerVectorIncrementalCheck in between. Every generated sample is
+	* compared with the full frame vector of the old parameters before the reported switch sample (ScannerVectorFrameBasic::StreamSwitchSample)
+	* and of the new parameters from there on.
+	* @param[in] _type the scan type, must support streaming and not need parameters from a parameter file (e.g. Sawtooth or Bidirectional)
+	* @param[in] _blocksize samples per channel generated at once
+	* @ingroup HELPERS */
+	ScannerVectorStreamCheckResult ScannerVectorStreamSwitchCheck(const ScannerVectorType& _type, const uint32_t& _blocksize);
+
+}
@@ -5,18 +5,40 @@
 #include "ScannerVectorFramePlaneHopper.h"
 #include "ScannerVectorFrameResonanceBiDi.h"
 #include "ScannerVectorFrameResonanceHopper.h"
+#include "ScannerVectorFrameMultiROI.h"
+#include "ScannerVectorLine.h"
+#include "ScannerVectorFrameVolume.h"
+#include "ScannerVectorTrajectory.h"
+#include "ScannerVectorCache.h"
 
 namespace scope {
 
+	ScannerVectorFrameBasic::StreamTables::StreamTables()
+		: linesamples(0)
+		, lines(0)
+		, yretracestart(0.0)
+		, yretraceslope(0.0)
+		, range(1.0)
+		, z(0)
+		, pblank(0)
+		, protation(0) {
+	}
+
 	ScannerVectorFrameBasic::ScannerVectorFrameBasic(const ScannerVectorType& _type, const ScannerVectorFillType& _filltype)
 		: type(_type)
 		, filltype(_filltype)
 		, daqparameters(nullptr)
 		, svparameters(parameters::ScannerVectorFrameBasic::Factory(_type).release())
 		, zparameters(nullptr)
-		, lookup_rotation(0) {
+		, lookup_rotation(0)
+		, streaming(false)
+		, caching(false)
+		, streampending(false)
+		, streamorigin(0)
+		, streamnext(0)
+		, streamswitch(0) {
 		vecptr = std::unique_ptr<std::vector<int16_t>>(new std::vector<int16_t>(svparameters->TotalPixels() * 4));		// for x, y, fast z, Pockels
-		lookup = std::unique_ptr<std::vector<std::size_t>>(new std::vector<std::size_t>(svparameters->TotalPixels()));
+		lookup = std::unique_ptr<std::vector<uint32_t>>(new std::vector<uint32_t>(svparameters->TotalPixels()));
 		UpdateVector();
 	}
 
@@ -36,6 +58,16 @@ namespace scope {
 			return std::unique_ptr<ScannerVectorFrameBasic>(new ScannerVectorFrameResonanceBiDi(_filltype));
 		case ScannerVectorTypeHelper::ResonanceHopper:
 			return std::unique_ptr<ScannerVectorFrameBasic>(new ScannerVectorFrameResonanceHopper(_filltype));
+		case ScannerVectorTypeHelper::MultiROI:
+			return std::unique_ptr<ScannerVectorFrameBasic>(new ScannerVectorFrameMultiROI(_filltype));
+		case ScannerVectorTypeHelper::LineStraight:
+			return std::unique_ptr<ScannerVectorFrameBasic>(new ScannerVectorLine(_filltype));
+		case ScannerVectorTypeHelper::Volume:
+			return std::unique_ptr<ScannerVectorFrameBasic>(new ScannerVectorFrameVolume(_filltype));
+		case ScannerVectorTypeHelper::Lissajous:
+			return std::unique_ptr<ScannerVectorFrameBasic>(new ScannerVectorLissajous(_filltype));
+		case ScannerVectorTypeHelper::Spiral:
+			return std::unique_ptr<ScannerVectorFrameBasic>(new ScannerVectorSpiral(_filltype));
 
 		}
 	}
@@ -43,6 +75,193 @@ namespace scope {
 	void ScannerVectorFrameBasic::UpdateVector() {
 	}
 
+	ScannerVectorFrameBasic::FillInputs ScannerVectorFrameBasic::CurrentFillInputs() const {
+		FillInputs in;
+		in.geometry = { static_cast<double>(filltype), static_cast<double>(svparameters->TotalPixels()), static_cast<double>(svparameters->XTotalPixels())
+			, static_cast<double>(svparameters->YTotalLines()), static_cast<double>(svparameters->XImagePixels()), static_cast<double>(svparameters->YImageLines())
+			, daqparameters->outputs->range() };
+		const double minscanner = daqparameters->outputs->minoutputscanner();
+		const double maxscanner = daqparameters->outputs->maxoutputscanner();
+		in.x = { svparameters->zoom(), svparameters->xoffset(), svparameters->xaspectratio(), svparameters->yaspectratio(), minscanner, maxscanner };
+		in.y = { svparameters->zoom(), svparameters->yoffset(), svparameters->xaspectratio(), svparameters->yaspectratio(), minscanner, maxscanner };
+		in.z = { zparameters->PositionToVoltage(svparameters->fastz()) };
+		in.p = { svparameters->pockels(), svparameters->pockels.ll(), svparameters->pockels.ul(), daqparameters->outputs->minoutputpockels()
+			, daqparameters->outputs->maxoutputpockels(), static_cast<double>(daqparameters->ScannerDelaySamples(false)) };
+		return in;
+	}
+
+	uint32_t ScannerVectorFrameBasic::DirtyParts(FillInputs& _current) const {
+		_current = CurrentFillInputs();
+		if ( _current.geometry != lastinputs.geometry )
+			return PartAll;
+		uint32_t dirty = 0;
+		if ( _current.x != lastinputs.x )
+			dirty |= PartX;
+		if ( _current.y != lastinputs.y )
+			dirty |= PartY;
+		if ( _current.z != lastinputs.z )
+			dirty |= PartZ;
+		if ( _current.p != lastinputs.p )
+			dirty |= PartP;
+		return dirty;
+	}
+
+	std::vector<double> ScannerVectorFrameBasic::CacheKey(const FillInputs& _inputs) const {
+		std::vector<double> key;
+		key.reserve(6 + _inputs.geometry.size() + _inputs.x.size() + _inputs.y.size() + _inputs.z.size() + _inputs.p.size());
+		key.push_back(static_cast<double>(type));
+		// Sizes as separators, so that values cannot shift from one part to the next
+		for ( const auto& part : { &_inputs.geometry, &_inputs.x, &_inputs.y, &_inputs.z, &_inputs.p } ) {
+			key.push_back(static_cast<double>(part->size()));
+			key.insert(std::end(key), std::begin(*part), std::end(*part));
+		}
+		return key;
+	}
+
+	bool ScannerVectorFrameBasic::RestoreFromCache(const FillInputs& _current) {
+		if ( !ScannerVectorCache::GetInstance().Get(CacheKey(_current), *vecptr, *lookup, lookup_rotation) )
+			return false;
+		lastinputs = _current;
+		return true;
+	}
+
+	void ScannerVectorFrameBasic::StoreInCache() const {
+		if ( !caching )
+			return;
+		ScannerVectorCache::GetInstance().Put(CacheKey(lastinputs), *vecptr, *lookup, lookup_rotation);
+	}
+
+	void ScannerVectorFrameBasic::RotateLookup(const int32_t& _rotation) {
+		const int64_t length = static_cast<int64_t>(lookup->size());
+		if ( length == 0 )
+			return;
+		// how far to rotate now (taking into account the earlier rotation), as a left rotation by [0, length)
+		const int64_t by = ((static_cast<int64_t>(_rotation) - lookup_rotation) % length + length) % length;
+		if ( by != 0 )
+			std::rotate(std::begin(*lookup), std::begin(*lookup)+by, std::end(*lookup));
+		lookup_rotation = _rotation;
+	}
+
+	void ScannerVectorFrameBasic::SetStreamTables(StreamTables&& _tables) {
+		std::lock_guard<std::mutex> lock(streammutex);
+		const uint64_t total = static_cast<uint64_t>(stream.linesamples) * stream.lines;
+		if ( (streamnext == 0) || (total == 0) ) {
+			stream = std::move(_tables);
+			pendingstream = StreamTables();
+			streampending = false;
+			streamswitch = 0;
+			return;
+		}
+		// The samples before streamnext are generated (in the device buffer) already, switch at the next frame start after them
+		streamswitch = streamorigin + (streamnext - streamorigin + total - 1) / total * total;
+		pendingstream = std::move(_tables);
+		streampending = true;
+	}
+
+	uint64_t ScannerVectorFrameBasic::StreamSwitchSample() const {
+		std::lock_guard<std::mutex> lock(streammutex);
+		return streamswitch;
+	}
+
+	void ScannerVectorFrameBasic::FieldRange(const double& _aspectratio, const double& _offset, double& _min, double& _range) const {
+		const double minscanner = daqparameters->outputs->minoutputscanner();
+		const double maxscanner = daqparameters->outputs->maxoutputscanner();
+		const double range = maxscanner - minscanner;
+
+		// the larger frame side gets the maximum scanner amplitude
+		_range = std::min(1.0, _aspectratio) * range / svparameters->zoom();
+		double center = (minscanner + maxscanner) * 0.5 + _offset*0.5*range;					// center of the frame, offset +-1 means maximum offset
+		if ( center - 0.5*_range < minscanner )
+			center = minscanner + 0.5*_range;
+		if ( center + 0.5*_range > maxscanner )
+			center = maxscanner - 0.5*_range;
+		_min = center - 0.5*_range;
+	}
+
+	double ScannerVectorFrameBasic::FlybackProfile(const uint32_t& _step, const uint32_t& _steps) {
+		// cosine profile, starts and ends with zero velocity
+		const double t = static_cast<double>(_step + 1) / static_cast<double>(_steps);
+		return 0.5 - 0.5 * cos(M_PI * t);
+	}
+
+	void ScannerVectorFrameBasic::SetStreaming(const bool& _streaming) {
+		const bool s = _streaming && SupportsStreaming() && (filltype == ScannerVectorFillTypeHelper::FullframeXYZP);
+		if ( s == streaming )
+			return;
+		streaming = s;
+		lastinputs = FillInputs();
+		// Free whichever representation is not used anymore
+		if ( streaming )
+			std::vector<int16_t>().swap(*vecptr);
+		else {
+			std::lock_guard<std::mutex> lock(streammutex);
+			stream = StreamTables();
+			pendingstream = StreamTables();
+			streampending = false;
+			streamnext = 0;
+		}
+	}
+
+	void ScannerVectorFrameBasic::Generate(const uint64_t& _start, const uint32_t& _samples, int16_t* const _xyzp) const {
+		std::lock_guard<std::mutex> lock(streammutex);
+		// The output (re)starts, it starts with the newest tables
+		if ( _start == 0 ) {
+			streamorigin = 0;
+			streamswitch = 0;
+			if ( streampending ) {
+				stream = std::move(pendingstream);
+				pendingstream = StreamTables();
+				streampending = false;
+			}
+		}
+		uint32_t done = 0;
+		while ( done < _samples ) {
+			const uint64_t position = _start + done;
+			if ( streampending && (position >= streamswitch) ) {
+				stream = std::move(pendingstream);
+				pendingstream = StreamTables();
+				streampending = false;
+				streamorigin = streamswitch;
+			}
+			// Up to the switch or the end of the block
+			uint32_t samples = _samples - done;
+			if ( streampending && (streamswitch - position < samples) )
+				samples = static_cast<uint32_t>(streamswitch - position);
+			GenerateFromTables(stream, position - streamorigin, samples, _xyzp + 4*static_cast<size_t>(done));
+			done += samples;
+		}
+		streamnext = _start + _samples;
+	}
+
+	void ScannerVectorFrameBasic::GenerateFromTables(const StreamTables& _tables, const uint64_t& _position, const uint32_t& _samples, int16_t* const _xyzp) {
+		const StreamTables& t = _tables;
+		const uint64_t total = static_cast<uint64_t>(t.linesamples) * t.lines;
+		if ( (total == 0) || t.x.empty() || t.pline.empty() ) {
+			std::fill(_xyzp, _xyzp + 4*static_cast<size_t>(_samples), static_cast<int16_t>(0));
+			return;
+		}
+		const Scaler<int16_t> scaletodevice(-t.range, t.range);
+		const uint64_t xlines = t.x.size() / t.linesamples;
+		const uint64_t scanlines = t.yscan.size();
+
+		// i is the position in the frame, j the position in the rotated Pockels signal
+		uint64_t i = _position % total;
+		uint64_t j = (i + (static_cast<int64_t>(t.protation) % static_cast<int64_t>(total) + total)) % total;
+		int16_t* out = _xyzp;
+		for ( uint32_t s = 0 ; s < _samples ; s++, out += 4 ) {
+			const uint64_t l = i / t.linesamples;
+			const uint64_t x = i % t.linesamples;
+			out[0] = t.x[(l % xlines) * t.linesamples + x];
+			out[1] = (l < scanlines) ? t.yscan[l] : scaletodevice(t.yretracestart + ((l - scanlines) * t.linesamples + x) * t.yretraceslope);
+			out[2] = t.z;
+			out[3] = t.pblanklines[j / t.linesamples] ? t.pblank : t.pline[j % t.linesamples];
+			if ( ++i == total )
+				i = 0;
+			if ( ++j == total )
+				j = 0;
+		}
+	}
+
 	void ScannerVectorFrameBasic::SetParameters(parameters::Daq* const _daqparameters, parameters::ScannerVectorFrameBasic* const _svparameters, config::FPUZStageParametersType* const _zparameters) {
 		this->daqparameters = _daqparameters;
 		this->svparameters = _svparameters;
@@ -50,6 +269,12 @@ namespace scope {
 		UpdateVector();
 	}
 
+	void ScannerVectorFrameBasic::Recalculate() {
+		// Empty inputs differ in geometry from any current ones, thus DirtyParts marks everything
+		lastinputs = FillInputs();
+		UpdateVector();
+	}
+
 	void ScannerVectorFrameBasic::SetPockels(const double& _pockelsval) {
 		svparameters->pockels.Set(_pockelsval);
 		UpdateVector();
@@ -66,19 +291,35 @@ namespace scope {
 	}
 
 	void ScannerVectorFrameBasic::SetScannderdelay(const uint32_t& _scannerdelaysamples) {
-		const uint32_t newrot = _scannerdelaysamples - lookup_rotation;				// how far do we have to rotate now (taking into account earlier rotation);
-		if ( newrot > 0 )
-			std::rotate(std::begin(*lookup), std::begin(*lookup)+newrot, std::end(*lookup));
-		if ( newrot < 0 )
-			std::rotate(std::begin(*lookup), std::end(*lookup)+newrot, std::end(*lookup));
-		lookup_rotation = _scannerdelaysamples;
+		RotateLookup(static_cast<int32_t>(_scannerdelaysamples));
 	}
 
 	std::vector<int16_t>* ScannerVectorFrameBasic::GetInterleavedVector() const {
 		return vecptr.get();
 	}
 
-	std::vector<std::size_t>* ScannerVectorFrameBasic::GetLookupVector() const {
+	std::unique_ptr<std::vector<int16_t>> ScannerVectorFrameBasic::GetStackVector(const std::vector<double>& _fastz, const std::vector<double>& _pockels, const uint32_t& _repeats) {
+		if ( (filltype != ScannerVectorFillTypeHelper::FullframeXYZP) && (filltype != ScannerVectorFillTypeHelper::LineZP) )
+			throw ScopeException("Stack vectors are only possible for full frame scanner vectors");
+		if ( streaming )
+			throw ScopeException("Stack vectors are not possible while streaming");
+		assert(_fastz.size() == _pockels.size());
+
+		std::unique_ptr<std::vector<int16_t>> stackvec(new std::vector<int16_t>());
+		for ( size_t p = 0 ; p < _fastz.size() ; p++ ) {
+			// Do not call the GUI signals, we only want the vector for this plane
+			svparameters->fastz.Set(_fastz[p], false, false);
+			svparameters->pockels.Set(_pockels[p], false, false);
+			UpdateVector();
+			if ( p == 0 )
+				stackvec->reserve(vecptr->size() * _fastz.size() * _repeats);
+			for ( uint32_t r = 0 ; r < _repeats ; r++ )
+				stackvec->insert(std::end(*stackvec), std::begin(*vecptr), std::end(*vecptr));
+		}
+		return stackvec;
+	}
+
+	std::vector<uint32_t>* ScannerVectorFrameBasic::GetLookupVector() const {
 		return lookup.get();
 	}
 
@@ -2,6 +2,7 @@
 
 #include "parameters/Scope.h"
 #include "helpers/ScopeDatatypes.h"
+#include "helpers/WaveformGenerator.h"
 
 namespace scope {
 
@@ -9,8 +10,10 @@ namespace scope {
 * and ScannerVectorFillType. The ScannerVectorType describes what kind of frame scan you do in your derived class, e.g. sawtooth or bidirectional. 
 * The ScannerVectorFillType determines how the signals for xyzp are actually filled into the datavector that is later on written to the hardware.
 * You could be putting out complette frames (FullframeXYZP), use a pixel and a line clock (LineXPColumnYZ), or have a slave area without its own
-* scanners (LineZP). Your derived class has to be able to generate signals for all of these cases! */
-class ScannerVectorFrameBasic {
+* scanners (LineZP). Your derived class has to be able to generate signals for all of these cases!\n
+* For streaming outputs (see SetStreaming) a derived class can describe a full frame by line tables instead, Generate then synthesizes the samples. */
+class ScannerVectorFrameBasic
+	: public WaveformGenerator {
 
 protected:
 	/** Type/scan mode of this vector */
@@ -22,6 +25,77 @@ protected:
 	/** iterator definition, just handy */
 	typedef std::vector<int16_t>::iterator iterator;
 
+	/** Parts of the scanner vector, as bits of the mask returned by DirtyParts */
+	enum VectorParts : uint32_t {
+		PartX = 1,
+		PartY = 2,
+		PartZ = 4,
+		PartP = 8,
+		PartLookup = 16,
+		PartAll = 31
+	};
+
+	/** The parameter values the parts of the vector are calculated from. UpdateVector compares them to the values the current vector
+	* was calculated from, so that e.g. a Pockels change only refills the Pockels samples and a scanner delay change only rotates the lookup vector. */
+	struct FillInputs {
+		/** frame geometry and device range, if one of them changes all parts are recalculated */
+		std::vector<double> geometry;
+
+		/** inputs of the x samples */
+		std::vector<double> x;
+
+		/** inputs of the y samples */
+		std::vector<double> y;
+
+		/** inputs of the fast z samples */
+		std::vector<double> z;
+
+		/** inputs of the Pockels samples */
+		std::vector<double> p;
+	};
+
+	/** Compact description of a full frame xyzp signal, line by line. Used instead of the full frame vector when streaming, its size
+	* grows with the number of lines and the samples per line, not with the frame size. */
+	struct StreamTables {
+		/** samples per line */
+		uint32_t linesamples;
+
+		/** lines per frame */
+		uint32_t lines;
+
+		/** x samples of one or more lines, line l uses x line l modulo the number of x lines (e.g. forth and back for bidirectional scans) */
+		std::vector<int16_t> x;
+
+		/** y sample of every scan line (y is constant during a scan line), the lines after them are retrace lines */
+		std::vector<int16_t> yscan;
+
+		/** y voltage at the first retrace sample */
+		double yretracestart;
+
+		/** y voltage change per sample during the retrace */
+		double yretraceslope;
+
+		/** output range of the device, for scaling the y retrace */
+		double range;
+
+		/** the fast z sample, constant during the frame */
+		int16_t z;
+
+		/** Pockels samples of an image line */
+		std::vector<int16_t> pline;
+
+		/** true for lines where the Pockels cell is blanked completely */
+		std::vector<bool> pblanklines;
+
+		/** Pockels sample in blanked lines */
+		int16_t pblank;
+
+		/** the Pockels signal is rotated to the left by that many samples (scanner delay) */
+		int32_t protation;
+
+		StreamTables();
+	};
+
 	/** current daq parameter set */
 	parameters::Daq* daqparameters;
 	
@@ -35,15 +109,94 @@ protected:
 	* or first x,p interleaved and then y,z interleaved (for not fullframevector). */
 	std::unique_ptr<std::vector<int16_t>> vecptr;
 
-	/** gives the position in the image vector for each position in the acquired data vector (keep in mind that the acquired data is read in chunks). */
-	std::unique_ptr<std::vector<std::size_t>> lookup;
+	/** gives the position in the image vector for each position in the acquired data vector (keep in mind that the acquired data is read in chunks).
+	* 32 bit positions are enough (TotalPixels is 32 bit) and halve the memory of the lookup vector and its copies in the pipeline. */
+	std::unique_ptr<std::vector<uint32_t>> lookup;
 
 	/** how much is the current lookup vector rotated to adjust for scannerdelay */
 	int32_t lookup_rotation;
 
+	/** the inputs the current vector was calculated from (empty before the first calculation) */
+	FillInputs lastinputs;
+
+	/** if true, UpdateVector fills the stream tables instead of the full frame vector (see SetStreaming) */
+	bool streaming;
+
+	/** if true, UpdateVector stores newly calculated vectors in the ScannerVectorCache (see SetCaching) */
+	bool caching;
+
+	/** the tables Generate synthesizes the samples from */
+	StreamTables stream;
+
+	/** tables of an online update, Generate switches to them at streamswitch */
+	mutable StreamTables pendingstream;
+
+	/** true while pendingstream waits for the switch */
+	mutable bool streampending;
+
+	/** sample (counted from the start of the output) at which the frames of stream start */
+	mutable uint64_t streamorigin;
+
+	/** the next sample (counted from the start of the output) Generate is asked for, i.e. the output generated all samples before */
+	mutable uint64_t streamnext;
+
+	/** sample (counted from the start of the output) from which on the tables of the last SetStreamTables are generated */
+	mutable uint64_t streamswitch;
+
+	/** protects stream, pendingstream and the stream positions, Generate is called from the thread of the streaming output */
+	mutable std::mutex streammutex;
+
 	/** Calculate the scanner vector based on the current parameters */
 	virtual void UpdateVector();
 
+	/** @return the current parameter values the parts of the vector depend on. Derived classes add the parameters of their frame geometry. */
+	virtual FillInputs CurrentFillInputs() const;
+
+	/** Compares the current inputs with those of the current vector. Derived classes call this at the beginning of UpdateVector and
+	* set lastinputs to _current after filling.
+	* @param[out] _current the current inputs
+	* @return mask of VectorParts that have to be recalculated */
+	uint32_t DirtyParts(FillInputs& _current) const;
+
+	/** @return the key for ScannerVectorCache, the scan type and all inputs */
+	std::vector<double> CacheKey(const FillInputs& _inputs) const;
+
+	/** Takes vector and lookup vector from the ScannerVectorCache if they were calculated for _current before
+	* @return true on a cache hit, then lastinputs is _current */
+	bool RestoreFromCache(const FillInputs& _current);
+
+	/** Puts the current vector and lookup vector (calculated from lastinputs) into the ScannerVectorCache, only if caching is on */
+	void StoreInCache() const;
+
+	/** Rotates the lookup vector to a new scanner delay, taking into account the current rotation. Much cheaper than recalculating it.
+	* @param[in] _rotation the new rotation in samples, positive values rotate to the left */
+	void RotateLookup(const int32_t& _rotation);
+
+	/** @return true if the derived class fills the stream tables in UpdateVector. Otherwise SetStreaming has no effect. */
+	virtual bool SupportsStreaming() const { return false; }
+
+	/** Replaces the stream tables, called from UpdateVector of derived classes. Before the output generated anything the tables are used
+	* right away. While streaming, Generate switches to them at the first frame start the output has not generated yet (see StreamSwitchSample),
+	* thus a frame is never torn. */
+	void SetStreamTables(StreamTables&& _tables);
+
+	/** Synthesizes samples from one set of tables
+	* @param[in] _tables the tables
+	* @param[in] _position position of the first sample, counted from a frame start of these tables
+	* @param[in] _samples number of samples per channel
+	* @param[out] _xyzp where to write to */
+	static void GenerateFromTables(const StreamTables& _tables, const uint64_t& _position, const uint32_t& _samples, int16_t* const _xyzp);
+
+	/** Calculates the voltage range of the field of view along one axis (same as for the sawtooth scan)
+	* @param[in] _aspectratio aspect ratio of this axis divided by the one of the other axis
+	* @param[in] _offset offset of this axis
+	* @param[out] _min voltage at the beginning of the field
+	* @param[out] _range voltage range of the field */
+	void FieldRange(const double& _aspectratio, const double& _offset, double& _min, double& _range) const;
+
+	/** @return the profile of a flyback, smoothly from 0 to 1 for _step from 0 to _steps-1 */
+	static double FlybackProfile(const uint32_t& _step, const uint32_t& _steps);
+
 public:
 	/** Initialize data vector
 	* @param[in] _type Type of scanner vector, set when derived class calls base constructor. Used to generate a fitting parameters set via  parameters::ScannerVectorFrameBasic::Factory.
@@ -56,6 +209,9 @@ public:
 	/** Set current parameters and update vector */
 	virtual void SetParameters(parameters::Daq* const _daqparameters, parameters::ScannerVectorFrameBasic* const _svparameters, config::FPUZStageParametersType* const _zparameters);
 
+	/** Recalculates all parts of the vector and the lookup vector, regardless of what changed since the last update (see ScannerVectorIncrementalCheck) */
+	void Recalculate();
+
 	/** Set current pockels value and update. Do we need these set methods? Is it not automagically set in AreaParameters?! */
 	virtual void SetPockels(const double& _pockelsval);
 
@@ -75,8 +231,17 @@ public:
 	* - LineZP: zp interleaved, total size is one line */
 	virtual std::vector<int16_t>* GetInterleavedVector() const;
 
+	/** Calculates one vector with the frames of all planes of a continuous fast z stack after each other. Every plane is repeated _repeats times
+	* (for averaging) with its own fast z and Pockels values, x and y (and thus the lookup vector) are the same in all frames. Only for the full frame
+	* fill types FullframeXYZP and LineZP.
+	* @param[in] _fastz fast z position for every plane
+	* @param[in] _pockels Pockels value for every plane
+	* @param[in] _repeats number of frames per plane
+	* @post the fast z and Pockels parameters and the scanner vector are those of the last plane */
+	virtual std::unique_ptr<std::vector<int16_t>> GetStackVector(const std::vector<double>& _fastz, const std::vector<double>& _pockels, const uint32_t& _repeats);
+
 	/** @return a reference to the lookup vector */
-	virtual std::vector<size_t>* GetLookupVector() const;
+	virtual std::vector<uint32_t>* GetLookupVector() const;
 
 	/** @return a pointer to the scanner vector parameters */
 	virtual parameters::ScannerVectorFrameBasic* GetSVParameters() const;
@@ -84,6 +249,27 @@ public:
 	/** @return the fill type of the scanner vector */
 	ScannerVectorFillType FillType() const { return filltype; }
 
+	/** Switches between the full frame vector and the stream tables. Only possible for the FullframeXYZP fill type and scan modes that
+	* support it, otherwise streaming stays off. Everything is recalculated on the next SetParameters. While streaming, GetInterleavedVector
+	* returns an empty vector and the outputs get their samples from Generate. */
+	void SetStreaming(const bool& _streaming);
+
+	/** Switches storing of newly calculated vectors in the ScannerVectorCache on or off. Lookups in the cache are always done.
+	* Switch it on only for vectors that are likely revisited (start of a run, stack and timeseries planes), not for online updates, where
+	* every slider tick would put a full copy into the cache and push out the planes. */
+	void SetCaching(const bool& _caching) { caching = _caching; }
+
+	/** @return true if the scanner vector is in streaming mode */
+	bool Streaming() const { return streaming; }
+
+	/** Synthesizes xyzp samples from the stream tables, the same samples the full frame vector would contain at these positions.
+	* Switches to the tables of an online update at StreamSwitchSample. A call with _start 0 (the output starts) uses the newest tables. */
+	void Generate(const uint64_t& _start, const uint32_t& _samples, int16_t* const _xyzp) const override;
+
+	/** @return the sample (counted from the start of the output, like _start of Generate) from which on the tables of the last update
+	* are generated, 0 if they were used from the start */
+	uint64_t StreamSwitchSample() const;
+
 public:
 	/** A static factory method for scan vectors */
 	static std::unique_ptr<ScannerVectorFrameBasic> Factory(const ScannerVectorType& _type, const ScannerVectorFillType& _filltype);
@@ -3,7 +3,8 @@
 
 namespace scope {
 ScannerVectorFrameBiDi::ScannerVectorFrameBiDi(const ScannerVectorFillType& _filltype)
-	: ScannerVectorFrameBasic(ScannerVectorTypeHelper::Bidirectional, _filltype) {
+	: ScannerVectorFrameBasic(ScannerVectorTypeHelper::Bidirectional, _filltype)
+	, bidiparameters(nullptr) {
 }
 
 ScannerVectorFrameBiDi::~ScannerVectorFrameBiDi() {
@@ -11,25 +12,56 @@ ScannerVectorFrameBiDi::~ScannerVectorFrameBiDi() {
 }
 
 void ScannerVectorFrameBiDi::UpdateVector() {
-	// samples for x,y,z,pockels
-	vecptr->resize(4 * svparameters->TotalPixels());
+	bidiparameters = dynamic_cast<parameters::ScannerVectorFrameBiDi*>(svparameters);
+	FillInputs current;
+	const uint32_t dirty = DirtyParts(current);
+	if ( (dirty == 0) || (!streaming && RestoreFromCache(current)) )
+		return;
+
+	// only the line tables for Generate when streaming (see SetStreaming)
+	if ( streaming )
+		FillStream();
+	else {
+		// samples for x,y,z,pockels
+		vecptr->resize(4 * svparameters->TotalPixels());
+		if ( dirty & PartX )
+			FillX();
+		if ( dirty & PartY )
+			FillY();
+		if ( dirty & PartZ )
+			FillZ();
+		if ( dirty & PartP )
+			FillP();
+	}
+
 	lookup->resize(svparameters->TotalPixels());
+	if ( dirty & PartLookup )
+		FillLookup();
+	else
+		RotateLookup(daqparameters->ScannerDelaySamples(false));
+
+	lastinputs = std::move(current);
+	if ( !streaming )
+		StoreInCache();
+}
 
-	FillX();
-	FillY();
-	FillZ();
-	FillP();
-	FillLookup();
+ScannerVectorFrameBasic::FillInputs ScannerVectorFrameBiDi::CurrentFillInputs() const {
+	FillInputs in(ScannerVectorFrameBasic::CurrentFillInputs());
+	const parameters::ScannerVectorFrameBiDi* const params = dynamic_cast<parameters::ScannerVectorFrameBiDi*>(svparameters);
+	in.geometry.insert(std::end(in.geometry), { static_cast<double>(params->XTurnPixels()), static_cast<double>(params->YCutoffLines())
+		, static_cast<double>(params->YRetraceLines()) });
+	return in;
 }
 
 void ScannerVectorFrameBiDi::FillLookup() {
-	parameters::ScannerVectorFrameBiDi* tmp = dynamic_cast<parameters::ScannerVectorFrameBiDi*>(svparameters);
+	parameters::ScannerVectorFrameBiDi* const tmp = bidiparameters;
 	const uint32_t xturnpixels = tmp->XTurnPixels();
 	const uint32_t cutofflines = tmp->YCutoffLines();
 	const uint32_t scanlines = tmp->YScanLines();
 	const uint32_t ytotallines = tmp->YTotalLines();
 	const uint32_t xtotalpixels = tmp->XTotalPixels();
-	uint32_t datapos = 0;
+	uint32_t* const look = lookup->data();
+	size_t datapos = 0;
 	uint32_t imagepos = 0;
 	bool forthline = true;
 	// advance datapos on every sampled pixel, advance imagepos only on pixels that are inside the image -> build up the lookup vector
@@ -38,12 +70,12 @@ void ScannerVectorFrameBiDi::FillLookup() {
 			// only pixels after y cutoff and before y retrace, and after the first 0.5*xturnpixels and before the last 0.5*xturnpixels (?)
 			if ( (l >= cutofflines) && (l < scanlines) && (x >= xturnpixels)) {
 				if ( forthline )
-					lookup->at(datapos) = imagepos++;
+					look[datapos] = imagepos++;
 				else
-					lookup->at(datapos) = --imagepos;		// backline is opposite direction
+					look[datapos] = --imagepos;		// backline is opposite direction
 			}
 			else				// Discard y cutoff and retrace pixels, and x turnpixels
-				lookup->at(datapos) = 0;
+				look[datapos] = 0;
 
 			datapos++;
 		}
@@ -52,16 +84,12 @@ void ScannerVectorFrameBiDi::FillLookup() {
 		forthline = !forthline;
 	}
 	// Adjust for the scannerdelay by rotating the lookup vector (do not respect oversampling, since lookup is done on downsampled data
-	lookup_rotation = daqparameters->ScannerDelaySamples(false);
-	if ( lookup_rotation > 0 )
-		std::rotate(std::begin(*lookup), std::begin(*lookup)+lookup_rotation, std::end(*lookup));
-	if ( lookup_rotation < 0 )
-		std::rotate(std::begin(*lookup), std::end(*lookup)+lookup_rotation, std::end(*lookup));
+	lookup_rotation = 0;
+	RotateLookup(daqparameters->ScannerDelaySamples(false));
 }
 
-void ScannerVectorFrameBiDi::FillX() {
-	parameters::ScannerVectorFrameBiDi* tmp = dynamic_cast<parameters::ScannerVectorFrameBiDi*>(svparameters);
-	const uint32_t framesamples(svparameters->TotalPixels());										// fill y forth and back with the same x stuff
+void ScannerVectorFrameBiDi::XLines(std::vector<int16_t>& _forth, std::vector<int16_t>& _back) const {
+	parameters::ScannerVectorFrameBiDi* const tmp = bidiparameters;
 	const uint32_t linesamples(svparameters->XTotalPixels());
 	const Scaler<int16_t> scaletodevice(-daqparameters->outputs->range(), daqparameters->outputs->range());		// convert full device range to full range of int16_t
 	const double zoom = svparameters->zoom();
@@ -85,33 +113,39 @@ void ScannerVectorFrameBiDi::FillX() {
 	const double xminzoomed = center - 0.5*xrangezoomed;								// minimum x value after zoom
 	const double xmaxzoomed = center + 0.5*xrangezoomed;								// maximum x value after zoom
 	const double xslope = xrangezoomed / static_cast<double>(svparameters->XTotalPixels());
-	
-	uint32_t x = 0;
-	size_t cx = 0;
 
-	do {
-		// fill in XTotalPixels() with increasing values (scanning forth) in X
-		x = 0;
-		for ( size_t i = cx ; i < cx+4*svparameters->XTotalPixels() ; i += 4, x++ )
-			vecptr->at(i) = scaletodevice(xminzoomed + x * xslope);
-
-		cx += 4*linesamples;
-		if ( cx >= 4*framesamples)			// for odd total number of lines, break do not scan back (although bad for scanner
-			break;
+	// All forth lines are the same and all back lines are the same, so scale only one of each. XTotalPixels() increasing values
+	// (scanning forth) in X, then XTotalPixels() decreasing values (scanning back)
+	_forth.resize(linesamples);
+	_back.resize(linesamples);
+	for ( uint32_t x = 0 ; x < linesamples ; x++ ) {
+		_forth[x] = scaletodevice(xminzoomed + x * xslope);
+		_back[x] = scaletodevice(xminzoomed + (linesamples - x) * xslope);
+	}
+}
 
-		// fill in XTotalPixels() with decreasing values (scanning back) in X
-		for ( size_t i = cx ; i < cx+4*svparameters->XTotalPixels() ; i += 4, x-- )
-			vecptr->at(i) = scaletodevice(xminzoomed + x * xslope);
+void ScannerVectorFrameBiDi::FillX() {
+	const uint32_t framesamples(svparameters->TotalPixels());										// fill y forth and back with the same x stuff
+	const uint32_t linesamples(svparameters->XTotalPixels());
+	std::vector<int16_t> forth;
+	std::vector<int16_t> back;
+	XLines(forth, back);
 
-		cx += 4*linesamples;
-	} while ( cx < 4*framesamples );
+	// x is every 4th sample starting at 0 (sizes are set in UpdateVector, so no bounds checking here). For odd total number of lines,
+	// the last line is a forth line and we do not scan back (although bad for scanner)
+	int16_t* const vec = vecptr->data();
+	bool forthline = true;
+	for ( size_t cx = 0 ; cx < 4*static_cast<size_t>(framesamples) ; cx += 4*linesamples, forthline = !forthline ) {
+		int16_t* const v = vec + cx;
+		const int16_t* const line = forthline ? forth.data() : back.data();
+		for ( uint32_t x = 0 ; x < linesamples ; x++ )
+			v[4*x] = line[x];
+	}
 }
 
 
-void ScannerVectorFrameBiDi::FillY() {
-	parameters::ScannerVectorFrameBiDi* tmp = dynamic_cast<parameters::ScannerVectorFrameBiDi*>(svparameters);
-	const uint32_t framesamples(tmp->TotalPixels());
-	const uint32_t linesamples(tmp->XTotalPixels());
+void ScannerVectorFrameBiDi::YColumn(std::vector<int16_t>& _scan, double& _retracestart, double& _retraceslope) const {
+	parameters::ScannerVectorFrameBiDi* const tmp = bidiparameters;
 	const Scaler<int16_t> scaletodevice(-daqparameters->outputs->range(), daqparameters->outputs->range());		// convert full device range to full range of int16_t
 	const double zoom = tmp->zoom();
 	const double range = daqparameters->outputs->maxoutputscanner() - daqparameters->outputs->minoutputscanner();
@@ -135,75 +169,101 @@ void ScannerVectorFrameBiDi::FillY() {
 	const double ymaxzoomed = center + 0.5*yrangezoomed;								// maximum y value after zoom
 	const double yscanslope = yrangezoomed / static_cast<double>(tmp->YScanLines());
 	const double yretraceslope = -yrangezoomed / static_cast<double>(tmp->YRetraceLines() * tmp->XTotalPixels());
-	const uint32_t yscanlinesamples = 4*tmp->YScanLines()*linesamples;
-	uint32_t yscan = 0;
-	uint32_t yretrace = 0;
-	size_t cy = 1;																			// y starts at sample 1
-
-	do {
-		// fill in linesamples with the same value for scanning
-		if ( cy < (1 + yscanlinesamples) ) {
-			for ( size_t i = cy ; i < cy+4*linesamples ; i += 4 )
-				vecptr->at(i) = scaletodevice(yminzoomed + yscan * yscanslope);
-			yscan++;
-		}
-		else {
-			// do a smoother retracing
-			for ( size_t i = cy ; i < cy+4*linesamples ; i += 4 ) {
-				vecptr->at(i) = scaletodevice(ymaxzoomed + yretrace * yretraceslope);
-				yretrace++;
-			}
-		}
-		cy += 4*linesamples;
-	} while ( cy < (4*framesamples + 1) );
+	const uint32_t scanlines = std::min(tmp->YScanLines(), tmp->YTotalLines());
+
+	// one value per scan line, then a smooth retrace from ymaxzoomed
+	_scan.resize(scanlines);
+	for ( uint32_t l = 0 ; l < scanlines ; l++ )
+		_scan[l] = scaletodevice(yminzoomed + l * yscanslope);
+	_retracestart = ymaxzoomed;
+	_retraceslope = yretraceslope;
+}
+
+void ScannerVectorFrameBiDi::FillY() {
+	const uint32_t framesamples(bidiparameters->TotalPixels());
+	const uint32_t linesamples(bidiparameters->XTotalPixels());
+	const Scaler<int16_t> scaletodevice(-daqparameters->outputs->range(), daqparameters->outputs->range());		// convert full device range to full range of int16_t
+	std::vector<int16_t> yscan;
+	double yretracestart = 0.0;
+	double yretraceslope = 0.0;
+	YColumn(yscan, yretracestart, yretraceslope);
+	int16_t* const vec = vecptr->data() + 1;												// y starts at sample 1
+	size_t i = 0;
+
+	// fill in linesamples with the same value for scanning
+	for ( uint32_t l = 0 ; l < yscan.size() ; l++ ) {
+		for ( uint32_t x = 0 ; x < linesamples ; x++, i += 4 )
+			vec[i] = yscan[l];
+	}
+	// do a smoother retracing
+	for ( uint32_t yretrace = 0 ; i < 4*static_cast<size_t>(framesamples) ; yretrace++, i += 4 )
+		vec[i] = scaletodevice(yretracestart + yretrace * yretraceslope);
 }
 
 void ScannerVectorFrameBiDi::FillZ() {
 	//parameters::ScannerVectorFrameBiDi* tmp = dynamic_cast<parameters::ScannerVectorFrameBiDi*>(svparameters);
 	const uint32_t framesamples(svparameters->TotalPixels());
-	const uint32_t linesamples(svparameters->XTotalPixels());
 	// convert full device range to full range of int16_t
 	const Scaler<int16_t> scaletodevice(-daqparameters->outputs->range(), daqparameters->outputs->range());
 	// get the voltage corresponding to current ETL position in micron and scale to device
 	const int16_t fastzoutdev = scaletodevice(zparameters->PositionToVoltage(svparameters->fastz()));
 	// z starts at sample 2
-	size_t cz = 2;
-
-	do {
-		// Fast z position stays constant during normal frame scanning	
-		for ( size_t i = cz ; i < cz + 4*linesamples ; i += 4 )
-			vecptr->at(i) = fastzoutdev;
-		cz += 4*linesamples;
-	} while ( cz < (4*framesamples + 2) );
+	int16_t* const vec = vecptr->data() + 2;
+
+	// Fast z position stays constant during normal frame scanning	
+	for ( size_t i = 0 ; i < 4*static_cast<size_t>(framesamples) ; i += 4 )
+		vec[i] = fastzoutdev;
 }
 
-void ScannerVectorFrameBiDi::FillP() {
-	parameters::ScannerVectorFrameBiDi* tmp = dynamic_cast<parameters::ScannerVectorFrameBiDi*>(svparameters);
-	const uint32_t framesamples(svparameters->TotalPixels());
+void ScannerVectorFrameBiDi::PLines(std::vector<int16_t>& _imageline, std::vector<bool>& _blanklines, int16_t& _blank) const {
+	parameters::ScannerVectorFrameBiDi* const tmp = bidiparameters;
+	const uint32_t ytotallines(tmp->YTotalLines());
 	const uint32_t linesamples(svparameters->XTotalPixels());
 	const uint32_t cutofflines = tmp->YCutoffLines();
 	const uint32_t scanlines = tmp->YScanLines();
 	// convert full device range to full range of int16_t
 	const Scaler<int16_t> scaletodevice(-daqparameters->outputs->range(), daqparameters->outputs->range());
-	// get the voltage corresponding to current ETL position in micron and scale to device
-	const int16_t pockelsdev = scaletodevice(tmp->pockels());
+	_blank = scaletodevice(0.0);
+
+	// Pockels stays constant during scan (no x-flyback blanking needed), blanking during Y cutoff and retrace
+	_imageline.assign(linesamples, scaletodevice(tmp->pockels()));
+	_blanklines.resize(ytotallines);
+	for ( uint32_t l = 0 ; l < ytotallines ; l++ )
+		_blanklines[l] = (l < cutofflines) || (l > scanlines);
+}
+
+void ScannerVectorFrameBiDi::FillP() {
+	const uint32_t linesamples(svparameters->XTotalPixels());
+	std::vector<int16_t> imageline;
+	std::vector<bool> blanklines;
+	int16_t blankdev = 0;
+	PLines(imageline, blanklines, blankdev);
 	// pockels starts at sample 3
-	size_t cp = 3;
-
-	do {
-		// Pockels blanking during Y cutoff and retrace
-		if ( (cp < (3 + 4*cutofflines*linesamples))
-			|| (cp > (3 + 4*scanlines*linesamples)) ) {
-			for ( size_t i = cp ; i < cp + 4*linesamples ; i += 4 )
-				vecptr->at(i) = scaletodevice(0.0);
-		}
-		else {
-			// Pockels stays constant during scan (no x-flyback blanking needed)
-			for ( size_t i = cp ; i < cp + 4*linesamples ; i += 4 )
-				vecptr->at(i) = pockelsdev;
-		}
-		cp += 4*linesamples;
-	} while ( cp < (4*framesamples + 2) );
+	int16_t* const vec = vecptr->data() + 3;
+	size_t i = 0;
+
+	for ( uint32_t l = 0 ; l < blanklines.size() ; l++ ) {
+		const bool blankline = blanklines[l];
+		for ( uint32_t x = 0 ; x < linesamples ; x++, i += 4 )
+			vec[i] = blankline ? blankdev : imageline[x];
+	}
+}
+
+void ScannerVectorFrameBiDi::FillStream() {
+	StreamTables tables;
+	tables.linesamples = bidiparameters->XTotalPixels();
+	tables.lines = bidiparameters->YTotalLines();
+	tables.range = daqparameters->outputs->range();
+	// forth line, then back line
+	std::vector<int16_t> back;
+	XLines(tables.x, back);
+	tables.x.insert(std::end(tables.x), std::begin(back), std::end(back));
+	YColumn(tables.yscan, tables.yretracestart, tables.yretraceslope);
+	const Scaler<int16_t> scaletodevice(-tables.range, tables.range);
+	tables.z = scaletodevice(zparameters->PositionToVoltage(svparameters->fastz()));
+	PLines(tables.pline, tables.pblanklines, tables.pblank);
+	tables.protation = 0;
+	SetStreamTables(std::move(tables));
 }
 
 
@@ -9,11 +9,34 @@ class ScannerVectorFrameBiDi :
 	public ScannerVectorFrameBasic {
 
 protected:
+	/** the scanner vector parameters, cast once per UpdateVector for the Fill functions */
+	parameters::ScannerVectorFrameBiDi* bidiparameters;
 
 protected:
-	/** Calculate the scanner vector based on the current parameters */
+	/** Calculate the scanner vector based on the current parameters, only the parts whose parameters changed are refilled */
 	void UpdateVector() override;
 
+	/** @return the base class inputs plus turn, cutoff and retrace */
+	FillInputs CurrentFillInputs() const override;
+
+	/** @return true, full frame bidirectional scans can stream */
+	bool SupportsStreaming() const override { return true; }
+
+	/** Calculates the x samples of a forth and a back line (all forth lines are the same and all back lines are the same) */
+	void XLines(std::vector<int16_t>& _forth, std::vector<int16_t>& _back) const;
+
+	/** Calculates the y signal, constant during each scan line, then a smooth retrace
+	* @param[out] _scan the y sample of every scan line
+	* @param[out] _retracestart y voltage at the first retrace sample
+	* @param[out] _retraceslope y voltage change per retrace sample */
+	void YColumn(std::vector<int16_t>& _scan, double& _retracestart, double& _retraceslope) const;
+
+	/** Calculates the Pockels signal
+	* @param[out] _imageline the Pockels samples of an image line
+	* @param[out] _blanklines true for every line that is blanked completely (y cutoff and retrace)
+	* @param[out] _blank the blanked Pockels sample */
+	void PLines(std::vector<int16_t>& _imageline, std::vector<bool>& _blanklines, int16_t& _blank) const;
+
 	/** Fill the samples for the x scanner axis */
 	void FillX();
 
@@ -26,6 +49,9 @@ protected:
 	/** Fill the samples for the Pockels cell (cutoff&retrace blanking for x and y) */
 	void FillP();
 
+	/** Fill the stream tables for Generate instead of the full frame vector, when streaming */
+	void FillStream();
+
 	/** Fill in the lookup vector */
 	void FillLookup();
 
@@ -0,0 +1,213 @@
+#include "StdAfx.h"
+#include "ScannerVectorFrameMultiROI.h"
+#include "helpers/ScopeTrace.h"
+
+namespace scope {
+
+	ScannerVectorFrameMultiROI::ScannerVectorFrameMultiROI(const ScannerVectorFillType& _filltype)
+		: ScannerVectorFrameBasic(ScannerVectorTypeHelper::MultiROI, _filltype)
+		, roiparameters(nullptr) {
+	}
+
+	ScannerVectorFrameMultiROI::~ScannerVectorFrameMultiROI() {
+
+	}
+
+	void ScannerVectorFrameMultiROI::UpdateVector() {
+		ScopeTraceSpan span("ScannerVectorFrameMultiROI::UpdateVector");
+		roiparameters = dynamic_cast<parameters::ScannerVectorFrameMultiROI*>(svparameters);
+		FillInputs current;
+		const uint32_t dirty = DirtyParts(current);
+		if ( (dirty == 0) || RestoreFromCache(current) )
+			return;
+
+		geometries = roiparameters->ROIGeometries();
+		switch ( filltype ) {
+		case ScannerVectorFillTypeHelper::FullframeXYZP:
+			// interleaved samples for x,y,z,pockels
+			vecptr->resize(4*svparameters->TotalPixels());
+			if ( dirty & PartX )
+				FillX();
+			if ( dirty & PartY )
+				FillY();
+			if ( dirty & PartZ )
+				FillZ();
+			if ( dirty & PartP )
+				FillP();
+			break;
+		case ScannerVectorFillTypeHelper::LineZP:
+			vecptr->resize(2*svparameters->TotalPixels());
+			if ( dirty & PartZ )
+				FillZ();
+			if ( dirty & PartP )
+				FillP();
+			break;
+		default:
+			throw ScopeException("Multi ROI scans need full frame outputs, line clocked outputs are not possible");
+		}
+
+		lookup->resize(svparameters->TotalPixels());
+		if ( dirty & PartLookup )
+			FillLookup();
+		else
+			RotateLookup(daqparameters->ScannerDelaySamples(false));
+
+		lastinputs = std::move(current);
+		StoreInCache();
+	}
+
+	ScannerVectorFrameBasic::FillInputs ScannerVectorFrameMultiROI::CurrentFillInputs() const {
+		FillInputs in(ScannerVectorFrameBasic::CurrentFillInputs());
+		const parameters::ScannerVectorFrameMultiROI* const params = dynamic_cast<parameters::ScannerVectorFrameMultiROI*>(svparameters);
+		in.geometry.insert(std::end(in.geometry), { params->xcutoff(), params->xretrace(), static_cast<double>(params->flybackpixels()) });
+		for ( const auto& g : params->ROIGeometries() )
+			in.geometry.insert(std::end(in.geometry), { static_cast<double>(g.column), static_cast<double>(g.pixels), static_cast<double>(g.row), static_cast<double>(g.lines) });
+		return in;
+	}
+
+	void ScannerVectorFrameMultiROI::FillX() {
+		const Scaler<int16_t> scaletodevice(-daqparameters->outputs->range(), daqparameters->outputs->range());		// convert full device range to full range of int16_t
+		const double minscanner = daqparameters->outputs->minoutputscanner();
+		const double maxscanner = daqparameters->outputs->maxoutputscanner();
+		const uint32_t flyback = roiparameters->flybackpixels();
+		double xmin = 0.0;
+		double xrange = 0.0;
+		FieldRange(roiparameters->xaspectratio() / roiparameters->yaspectratio(), roiparameters->xoffset(), xmin, xrange);
+		const double dx = xrange / static_cast<double>(roiparameters->xres());							// voltage per image column
+		// cutoff may reach a bit beyond the field but never beyond the scanner range
+		auto coerce = [&](const double& _x) { return std::min(maxscanner, std::max(minscanner, _x)); };
+		// a line starts cutoff pixels before the region
+		auto linestart = [&](const parameters::ScannerVectorFrameMultiROI::ROIGeometry& _g) {
+			return xmin + (static_cast<double>(_g.column) - static_cast<double>(_g.cutoff)) * dx; };
+
+		int16_t* const vec = vecptr->data();
+		size_t i = 0;
+		for ( size_t r = 0 ; r < geometries.size() ; r++ ) {
+			const auto& g = geometries[r];
+			const double start = linestart(g);
+			const double end = xmin + (g.column + g.pixels) * dx;
+			const double retraceslope = (start - end) / static_cast<double>(std::max(1u, g.retrace));
+
+			// All lines of a region are the same, ramp with the pixel size of the field during cutoff and image pixels, then retrace to the start
+			std::vector<int16_t> line(g.LineSamples());
+			for ( uint32_t x = 0 ; x < g.cutoff + g.pixels ; x++ )
+				line[x] = scaletodevice(coerce(start + x * dx));
+			for ( uint32_t x = 0 ; x < g.retrace ; x++ )
+				line[g.cutoff + g.pixels + x] = scaletodevice(coerce(end + x * retraceslope));
+			for ( uint32_t l = 0 ; l < g.lines ; l++ ) {
+				for ( const auto& s : line ) {
+					vec[i] = s;
+					i += 4;
+				}
+			}
+
+			// Flyback to the start of the next region
+			const double from = coerce(start);
+			const double to = coerce(linestart(geometries[(r + 1) % geometries.size()]));
+			for ( uint32_t f = 0 ; f < flyback ; f++, i += 4 )
+				vec[i] = scaletodevice(from + FlybackProfile(f, flyback) * (to - from));
+		}
+	}
+
+	void ScannerVectorFrameMultiROI::FillY() {
+		const Scaler<int16_t> scaletodevice(-daqparameters->outputs->range(), daqparameters->outputs->range());		// convert full device range to full range of int16_t
+		const uint32_t flyback = roiparameters->flybackpixels();
+		double ymin = 0.0;
+		double yrange = 0.0;
+		FieldRange(roiparameters->yaspectratio() / roiparameters->xaspectratio(), roiparameters->yoffset(), ymin, yrange);
+		const double dy = yrange / static_cast<double>(roiparameters->yres());							// voltage per image line
+
+		int16_t* const vec = vecptr->data() + 1;												// y starts at sample 1
+		size_t i = 0;
+		for ( size_t r = 0 ; r < geometries.size() ; r++ ) {
+			const auto& g = geometries[r];
+			const uint32_t linesamples = g.LineSamples();
+
+			// y is constant during a line (including its retrace)
+			for ( uint32_t l = 0 ; l < g.lines ; l++ ) {
+				const int16_t y = scaletodevice(ymin + (g.row + l) * dy);
+				for ( uint32_t x = 0 ; x < linesamples ; x++, i += 4 )
+					vec[i] = y;
+			}
+
+			// Flyback from the last line of this region to the first line of the next region
+			const double last = ymin + (g.row + g.lines - 1) * dy;
+			const double next = ymin + geometries[(r + 1) % geometries.size()].row * dy;
+			for ( uint32_t f = 0 ; f < flyback ; f++, i += 4 )
+				vec[i] = scaletodevice(last + FlybackProfile(f, flyback) * (next - last));
+		}
+	}
+
+	void ScannerVectorFrameMultiROI::FillZ() {
+		const uint32_t framesamples(roiparameters->TotalPixels());
+		const Scaler<int16_t> scaletodevice(-daqparameters->outputs->range(), daqparameters->outputs->range());	// convert full device range to full range of int16_t
+		const int16_t fastzoutdev = scaletodevice(zparameters->PositionToVoltage(svparameters->fastz()));					// get the voltage corresponding to current ETL position in micron and scale to device
+		// z is sample 2 of 4 for FullframeXYZP, sample 0 of 2 for LineZP
+		const size_t step_size = (filltype == ScannerVectorFillTypeHelper::FullframeXYZP) ? 4 : 2;
+		const size_t cz_init = (filltype == ScannerVectorFillTypeHelper::FullframeXYZP) ? 2 : 0;
+
+		// Fast z position stays constant, also during flyback
+		int16_t* const vec = vecptr->data() + cz_init;
+		for ( size_t i = 0 ; i < step_size*framesamples ; i += step_size )
+			vec[i] = fastzoutdev;
+	}
+
+	void ScannerVectorFrameMultiROI::FillP() {
+		const uint32_t framesamples(roiparameters->TotalPixels());
+		const uint32_t flyback = roiparameters->flybackpixels();
+		const double pockelsoutval = (roiparameters->pockels()-roiparameters->pockels.ll())/(roiparameters->pockels.ul()-roiparameters->pockels.ll())
+			*daqparameters->outputs->maxoutputpockels()+daqparameters->outputs->minoutputpockels();							// scale pockels value from displayed value (e.g. 0..1) to device value (e.g. 0..2)
+		const Scaler<int16_t> scaletodevice(-daqparameters->outputs->range(), daqparameters->outputs->range());		// convert full device range to full range of int16_t
+		const int16_t blankdev = scaletodevice(0.0);
+		const int16_t pockelsdev = scaletodevice(pockelsoutval);
+		// Pockels is sample 3 of 4 for FullframeXYZP, sample 1 of 2 for LineZP
+		const size_t step_size = (filltype == ScannerVectorFillTypeHelper::FullframeXYZP) ? 4 : 2;
+		const size_t cp_init = (filltype == ScannerVectorFillTypeHelper::FullframeXYZP) ? 3 : 1;
+
+		// Pockels open on image pixels, blanked during cutoff, retrace, and flyback
+		std::vector<int16_t> pockels;
+		pockels.reserve(framesamples);
+		for ( const auto& g : geometries ) {
+			std::vector<int16_t> line(g.LineSamples(), blankdev);
+			std::fill(std::begin(line) + g.cutoff, std::begin(line) + g.cutoff + g.pixels, pockelsdev);
+			for ( uint32_t l = 0 ; l < g.lines ; l++ )
+				pockels.insert(std::end(pockels), std::begin(line), std::end(line));
+			pockels.insert(std::end(pockels), flyback, blankdev);
+		}
+
+		// Adjust for the scannerdelay by rotating the Pockels signal (do not respect oversampling, since pockels vector is with pixels, not oversampled input samples)
+		const int64_t length = static_cast<int64_t>(pockels.size());
+		const int64_t by = (static_cast<int64_t>(daqparameters->ScannerDelaySamples(false)) % length + length) % length;
+		std::rotate(std::begin(pockels), std::begin(pockels) + by, std::end(pockels));
+
+		int16_t* const vec = vecptr->data() + cp_init;
+		for ( size_t i = 0 ; i < pockels.size() ; i++ )
+			vec[i*step_size] = pockels[i];
+	}
+
+	void ScannerVectorFrameMultiROI::FillLookup() {
+		const uint32_t xres = roiparameters->xres();
+		const uint32_t flyback = roiparameters->flybackpixels();
+		uint32_t* const look = lookup->data();
+		size_t datapos = 0;
+		// every region goes to its own place in the full field image, samples outside of the image pixels are mapped to 0
+		for ( const auto& g : geometries ) {
+			for ( uint32_t l = 0 ; l < g.lines ; l++ ) {
+				const uint32_t imagepos = (g.row + l) * xres + g.column;
+				for ( uint32_t x = 0 ; x < g.cutoff ; x++ )
+					look[datapos++] = 0;
+				for ( uint32_t x = 0 ; x < g.pixels ; x++ )
+					look[datapos++] = imagepos + x;
+				for ( uint32_t x = 0 ; x < g.retrace ; x++ )
+					look[datapos++] = 0;
+			}
+			for ( uint32_t f = 0 ; f < flyback ; f++ )
+				look[datapos++] = 0;
+		}
+
+		// Adjust for the scannerdelay by rotating the lookup vector (do not respect oversampling, since lookup is done on downsampled data
+		lookup_rotation = 0;
+		RotateLookup(daqparameters->ScannerDelaySamples(false));
+	}
+
+}
@@ -0,0 +1,53 @@
+#pragma once
+
+#include "ScannerVectorFrameBasic.h"
+
+namespace scope {
+
+/** Calculates scanner, fast z, and Pockels control voltages for a multi region of interest scan. Every region is scanned like a small
+* sawtooth frame, then the scanners fly back (with a smooth cosine profile, Pockels blanked) to the first line of the next region. The lookup
+* vector maps each region to its place in the full field image, thus the pixel mapping is the same as for sawtooth scans. */
+class ScannerVectorFrameMultiROI
+	: public ScannerVectorFrameBasic {
+
+protected:
+	/** the scanner vector parameters, cast once per UpdateVector for the Fill functions */
+	parameters::ScannerVectorFrameMultiROI* roiparameters;
+
+	/** the regions in image pixels, calculated once per UpdateVector */
+	std::vector<parameters::ScannerVectorFrameMultiROI::ROIGeometry> geometries;
+
+protected:
+	/** Calculate the scanner vector based on the current parameters, only the parts whose parameters changed are refilled */
+	void UpdateVector() override;
+
+	/** @return the base class inputs plus cutoff, retrace, flyback and the regions */
+	FillInputs CurrentFillInputs() const override;
+
+	/** Fill the samples for the x scanner axis */
+	void FillX();
+
+	/** Fill the samples for the y scanner axis */
+	void FillY();
+
+	/** Fill the samples for the fast z axis (stays constant here) */
+	void FillZ();
+
+	/** Fill the samples for the Pockels cell (open only on image pixels) */
+	void FillP();
+
+	/** Fill in the lookup vector */
+	void FillLookup();
+
+public:
+	/** @param[in] _filltype type of vector fill, see GetInterleavedVector for details. ScannerVectorFillTypeHelper::LineXPColumnYZ is not
+	* possible since the lines of different regions are different. */
+	ScannerVectorFrameMultiROI(const ScannerVectorFillType& _filltype);
+
+	~ScannerVectorFrameMultiROI();
+};
+
+/** A shared pointer to a ScannerVectorFrameMultiROI */
+typedef std::shared_ptr<ScannerVectorFrameMultiROI> ScannerVectorFrameMultiROIPtr;
+
+}
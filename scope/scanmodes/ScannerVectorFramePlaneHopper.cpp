@@ -1,10 +1,15 @@
 #include "stdafx.h"
 #include "ScannerVectorFramePlaneHopper.h"
+#include "helpers/ScopeTrace.h"
 
 namespace scope {
 	
 ScannerVectorFramePlaneHopper::ScannerVectorFramePlaneHopper(const ScannerVectorFillType& _filltype)
-	: ScannerVectorFrameBasic(ScannerVectorTypeHelper::Planehopper, _filltype) {
+	: ScannerVectorFrameSaw(ScannerVectorTypeHelper::Planehopper, _filltype) {
+}
+
+ScannerVectorFramePlaneHopper::ScannerVectorFramePlaneHopper(const ScannerVectorType& _type, const ScannerVectorFillType& _filltype)
+	: ScannerVectorFrameSaw(_type, _filltype) {
 }
 
 ScannerVectorFramePlaneHopper::~ScannerVectorFramePlaneHopper() {
@@ -12,9 +17,173 @@ ScannerVectorFramePlaneHopper::~ScannerVectorFramePlaneHopper() {
 }
 
 void ScannerVectorFramePlaneHopper::UpdateVector() {
+	ScopeTraceSpan span("ScannerVectorFramePlaneHopper::UpdateVector");
+	sawparameters = dynamic_cast<parameters::ScannerVectorFrameSaw*>(svparameters);
+	FillInputs current;
+	const uint32_t dirty = DirtyParts(current);
+	if ( (dirty == 0) || RestoreFromCache(current) )
+		return;
+
+	switch ( filltype ) {
+	case ScannerVectorFillTypeHelper::FullframeXYZP:
+		// interleaved samples for x,y,z,pockels
+		vecptr->resize(4*svparameters->TotalPixels());
+		// x lines are the same for all planes, ScannerVectorFrameSaw::FillX fills TotalPixels (thus all planes)
+		if ( dirty & PartX )
+			ScannerVectorFrameSaw::FillX();
+		if ( dirty & PartY )
+			FillY();
+		if ( dirty & PartZ )
+			FillZ();
+		if ( dirty & PartP )
+			FillP();
+		break;
+	case ScannerVectorFillTypeHelper::LineZP:
+		vecptr->resize(2*svparameters->TotalPixels());
+		if ( dirty & PartZ )
+			FillZ();
+		if ( dirty & PartP )
+			FillP();
+		break;
+	default:
+		throw ScopeException("Plane hopping needs full frame outputs, line clocked outputs are not possible");
+	}
+
+	lookup->resize(svparameters->TotalPixels());
+	if ( dirty & PartLookup )
+		FillLookup();
+	else
+		RotateLookup(daqparameters->ScannerDelaySamples(false));
+
+	lastinputs = std::move(current);
+	StoreInCache();
+}
+
+ScannerVectorFrameBasic::FillInputs ScannerVectorFramePlaneHopper::CurrentFillInputs() const {
+	FillInputs in(ScannerVectorFrameSaw::CurrentFillInputs());
+	in.z.clear();
+	for ( const auto& pl : PlaneList() ) {
+		in.z.push_back(zparameters->PositionToVoltage(pl.position()));
+		in.p.push_back(pl.pockels());
+	}
+	return in;
+}
+
+std::vector<parameters::PlaneProperties> ScannerVectorFramePlaneHopper::PlaneList() const {
+	const parameters::ScannerVectorFramePlaneHopper* const params = dynamic_cast<parameters::ScannerVectorFramePlaneHopper*>(svparameters);
+	if ( params->planes.empty() )
+		return std::vector<parameters::PlaneProperties>(1, parameters::PlaneProperties(params->fastz(), params->pockels()));
+	return params->planes;
+}
 
+void ScannerVectorFramePlaneHopper::FillY() {
+	const uint32_t planes(sawparameters->Planes());
+	const size_t planesamples(sawparameters->TotalPixelsOneFrame());
+	const uint32_t linesamples(sawparameters->XTotalPixels());
+	const Scaler<int16_t> scaletodevice(-daqparameters->outputs->range(), daqparameters->outputs->range());		// convert full device range to full range of int16_t
+	std::vector<int16_t> yscan;
+	double yretracestart = 0.0;
+	double yretraceslope = 0.0;
+	YColumn(yscan, yretracestart, yretraceslope);
+	int16_t* const vec = vecptr->data() + 1;												// y starts at sample 1
+
+	// every plane is a complete sawtooth frame
+	for ( uint32_t p = 0 ; p < planes ; p++ ) {
+		size_t i = 4 * p * planesamples;
+		const size_t planeend = 4 * (p + 1) * planesamples;
+		for ( uint32_t l = 0 ; l < yscan.size() ; l++ ) {
+			for ( uint32_t x = 0 ; x < linesamples ; x++, i += 4 )
+				vec[i] = yscan[l];
+		}
+		for ( uint32_t yretrace = 0 ; i < planeend ; yretrace++, i += 4 )
+			vec[i] = scaletodevice(yretracestart + yretrace * yretraceslope);
+	}
+}
+
+void ScannerVectorFramePlaneHopper::FillZ() {
+	const std::vector<parameters::PlaneProperties> planelist(PlaneList());
+	const size_t planes(planelist.size());
+	const size_t planesamples(sawparameters->TotalPixelsOneFrame());
+	const size_t scansamples(static_cast<size_t>(std::min(sawparameters->YScanLines(), sawparameters->YTotalLines())) * sawparameters->XTotalPixels());
+	const Scaler<int16_t> scaletodevice(-daqparameters->outputs->range(), daqparameters->outputs->range());	// convert full device range to full range of int16_t
+	std::vector<int16_t> fastzoutdev(planes);
+	std::transform(std::begin(planelist), std::end(planelist), std::begin(fastzoutdev), [&](const parameters::PlaneProperties& _pl)
+		{ return scaletodevice(zparameters->PositionToVoltage(_pl.position())); } );
+	size_t cz_init = 0, step_size = 0;
+	// Decide vector storage locations and step_size based on Master/Slave
+	if (filltype == ScannerVectorFillTypeHelper::FullframeXYZP) {
+		cz_init = 2; step_size = 4; 
+	}
+	if (filltype == ScannerVectorFillTypeHelper::LineZP) {
+		cz_init = 0; step_size = 2; 
+	}
+
+	// Fast z stays at the plane's position during the scan lines and hops to the next plane's position during the y retrace
+	int16_t* const vec = vecptr->data() + cz_init;
+	for ( size_t p = 0 ; p < planes ; p++ ) {
+		int16_t* const v = vec + step_size * p * planesamples;
+		for ( size_t i = 0 ; i < step_size*scansamples ; i += step_size )
+			v[i] = fastzoutdev[p];
+		for ( size_t i = step_size*scansamples ; i < step_size*planesamples ; i += step_size )
+			v[i] = fastzoutdev[(p + 1) % planes];
+	}
+}
+
+void ScannerVectorFramePlaneHopper::FillP() {
+	const std::vector<parameters::PlaneProperties> planelist(PlaneList());
+	const size_t planesamples(sawparameters->TotalPixelsOneFrame());
+	const uint32_t linesamples(sawparameters->XTotalPixels());
+	size_t cp_init = 0, step_size = 0;
+	// Decide vector storage locations and step_size based on Master/Slave
+	if (filltype == ScannerVectorFillTypeHelper::FullframeXYZP) {
+		cp_init = 3; step_size = 4; 
+	}
+	if (filltype == ScannerVectorFillTypeHelper::LineZP) {
+		cp_init = 1; step_size = 2; 
+	}
+	std::vector<int16_t> imageline;
+	std::vector<bool> blanklines;
+	int16_t blankdev = 0;
+
+	int16_t* const vec = vecptr->data() + cp_init;
+	size_t i = 0;
+	for ( const auto& pl : planelist ) {
+		PLines(pl.pockels(), imageline, blanklines, blankdev);
+		for ( uint32_t l = 0 ; l < blanklines.size() ; l++ ) {
+			const bool blankline = blanklines[l];
+			for ( uint32_t x = 0 ; x < linesamples ; x++, i += step_size )
+				vec[i] = blankline ? blankdev : imageline[x];
+		}
+	}
+
+	// Adjust for the scannerdelay by rotating the pockels vector (do not respect oversampling, since pockels vector is with pixels, not oversampled input samples)
+	RotateP(cp_init, step_size, step_size*planesamples*planelist.size(), daqparameters->ScannerDelaySamples(false));
 }
 
+void ScannerVectorFramePlaneHopper::FillLookup() {
+	const uint32_t planes = sawparameters->Planes();
+	const uint32_t cutofflines = sawparameters->YCutoffLines();
+	const uint32_t scanlines = sawparameters->YScanLines();
+	const uint32_t cutoffpixels = sawparameters->XCutoffPixels();
+	const uint32_t scanpixels = sawparameters->XScanPixels();
+	const uint32_t ytotallines = sawparameters->YTotalLines();
+	const uint32_t xtotalpixels = sawparameters->XTotalPixels();
+	const uint32_t planepixels = sawparameters->XImagePixels() * sawparameters->YImageLines();
+	uint32_t* const look = lookup->data();
+	size_t datapos = 0;
+	// as for a sawtooth frame, but every plane's image positions start at plane*planepixels
+	for ( uint32_t p = 0 ; p < planes ; p++ ) {
+		uint32_t imagepos = p * planepixels;
+		for ( uint32_t l = 0 ; l < ytotallines ; l++ ) {
+			const bool imageline = (l >= cutofflines) && (l < scanlines);
+			for ( uint32_t x = 0 ; x < xtotalpixels ; x++ )
+				look[datapos++] = ( imageline && (x >= cutoffpixels) && (x < scanpixels) ) ? imagepos++ : 0;
+		}
+	}
 
+	// Adjust for the scannerdelay by rotating the lookup vector (do not respect oversampling, since lookup is done on downsampled data
+	lookup_rotation = 0;
+	RotateLookup(daqparameters->ScannerDelaySamples(false));
+}
 
-}
\ No newline at end of file
+}
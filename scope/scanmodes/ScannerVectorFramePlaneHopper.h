@@ -1,22 +1,54 @@
 #pragma once
 
-#include "ScannerVectorFrameBasic.h"
+#include "ScannerVectorFrameSaw.h"
 
 namespace scope {
 
-/** Frame scanning with ETL plane hopping */
-class ScannerVectorFramePlaneHopper :
-	public ScannerVectorFrameBasic {
+/** Frame scanning with ETL plane hopping. One daq frame consists of one sawtooth frame per plane, each with the fast z position and Pockels
+* value of its plane. The fast z hops at the beginning of the previous plane's y retrace, thus the ETL settles during retrace and y cutoff.
+* The lookup vector encodes the plane: plane*xres*yres + position in the plane's image (see PixelmapperFramePlaneHopper). */
+class ScannerVectorFramePlaneHopper
+	: public ScannerVectorFrameSaw {
 
 protected:
-	/** Update the vector */
-	void UpdateVector();
+	/** Calculate the scanner vector based on the current parameters, only the parts whose parameters changed are refilled */
+	void UpdateVector() override;
+
+	/** @return the sawtooth inputs plus fast z and Pockels of all planes */
+	FillInputs CurrentFillInputs() const override;
+
+	/** @return false, the stream tables have no plane dependent z and Pockels */
+	bool SupportsStreaming() const override { return false; }
+
+	/** @return fast z position and Pockels value of every plane (the frame's fastz and pockels if there are no planes) */
+	virtual std::vector<parameters::PlaneProperties> PlaneList() const;
+
+	/** Fill the samples for the y scanner axis, the same sawtooth frame for every plane */
+	void FillY();
+
+	/** Fill the samples for the fast z axis, constant during each plane's scan lines */
+	virtual void FillZ();
+
+	/** Fill the samples for the Pockels cell with the Pockels value of each plane */
+	void FillP();
+
+	/** Fill in the lookup vector */
+	void FillLookup();
+
+	/** For derived scan types that scan one sawtooth frame per plane with another fast z waveform
+	* @param[in] _type the type of the derived scanner vector
+	* @param[in] _filltype type of vector fill, see GetInterleavedVector for details */
+	ScannerVectorFramePlaneHopper(const ScannerVectorType& _type, const ScannerVectorFillType& _filltype);
 
 public:
-	/** @param[in] _filltype type of vector fill, see GetInterleavedVector for details */
+	/** @param[in] _filltype type of vector fill, see GetInterleavedVector for details. ScannerVectorFillTypeHelper::LineXPColumnYZ is not
+	* possible since fast z changes between the frames of one daq frame. */
 	ScannerVectorFramePlaneHopper(const ScannerVectorFillType& _filltype);
 
 	~ScannerVectorFramePlaneHopper();
 };
 
-}
\ No newline at end of file
+/** A shared pointer to a ScannerVectorFramePlaneHopper */
+typedef std::shared_ptr<ScannerVectorFramePlaneHopper> ScannerVectorFramePlaneHopperPtr;
+
+}
@@ -1,11 +1,18 @@
 #include "StdAfx.h"
 #include "ScannerVectorFrameSaw.h"
 #include "controllers/ScopeLogger.h"
+#include "helpers/ScopeTrace.h"
 
 namespace scope {
 
 	ScannerVectorFrameSaw::ScannerVectorFrameSaw(const ScannerVectorFillType& _filltype)
-		: ScannerVectorFrameBasic(ScannerVectorTypeHelper::Sawtooth, _filltype) {
+		: ScannerVectorFrameBasic(ScannerVectorTypeHelper::Sawtooth, _filltype)
+		, sawparameters(nullptr) {
+	}
+
+	ScannerVectorFrameSaw::ScannerVectorFrameSaw(const ScannerVectorType& _type, const ScannerVectorFillType& _filltype)
+		: ScannerVectorFrameBasic(_type, _filltype)
+		, sawparameters(nullptr) {
 	}
 
 	ScannerVectorFrameSaw::~ScannerVectorFrameSaw() {
@@ -13,80 +20,96 @@ namespace scope {
 	}
 
 	void ScannerVectorFrameSaw::UpdateVector() {
-	#ifdef _DEBUG
-		LARGE_INTEGER countspre;
-		LARGE_INTEGER countspost;
-		LARGE_INTEGER countfreq;
-		QueryPerformanceCounter(&countspre);
-	#endif
+		ScopeTraceSpan span("ScannerVectorFrameSaw::UpdateVector");
+		sawparameters = dynamic_cast<parameters::ScannerVectorFrameSaw*>(svparameters);
+		FillInputs current;
+		const uint32_t dirty = DirtyParts(current);
+		if ( (dirty == 0) || (!streaming && RestoreFromCache(current)) )
+			return;
 
 		switch ( filltype ) {
 		case ScannerVectorFillTypeHelper::FullframeXYZP:
+			// only the line tables for Generate when streaming (see SetStreaming)
+			if ( streaming ) {
+				FillStream();
+				break;
+			}
 			// interleaved samples for x,y,z,pockels
 			vecptr->resize(4*svparameters->TotalPixels());
-			FillX();
-			FillY();
-			FillZ();
-			FillP();
+			if ( dirty & PartX )
+				FillX();
+			if ( dirty & PartY )
+				FillY();
+			if ( dirty & PartZ )
+				FillZ();
+			if ( dirty & PartP )
+				FillP();
 			break;
 		case ScannerVectorFillTypeHelper::LineXPColumnYZ:
 			// interleaved samples for x,p + interleaved samples for y,z
 			vecptr->resize(2*svparameters->XTotalPixels() + 2*svparameters->YTotalLines());
-			FillXP();
-			FillYZ();
+			if ( dirty & (PartX | PartP) )
+				FillXP();
+			if ( dirty & (PartY | PartZ) )
+				FillYZ();
 			break;
 		case ScannerVectorFillTypeHelper::LineZP:
 			vecptr->resize(2*svparameters->TotalPixels());
-			FillZ();
-			FillP();
+			if ( dirty & PartZ )
+				FillZ();
+			if ( dirty & PartP )
+				FillP();
 			break;
 		default:
 			throw ScopeException("ScannerVectorFillType not yet implemented");
 		}
 
 		lookup->resize(svparameters->TotalPixels());
-		FillLookup();
-
-	#ifdef _DEBUG
-		QueryPerformanceCounter(&countspost);
-		QueryPerformanceFrequency(&countfreq);
-		double time = static_cast<double>((countspost.QuadPart-countspre.QuadPart))/static_cast<double>(countfreq.QuadPart) * 1000;
-		DBOUT(L"Time for updating vector " << time << L" ms");
-	#endif
+		if ( dirty & PartLookup )
+			FillLookup();
+		else
+			RotateLookup(daqparameters->ScannerDelaySamples(false));
+
+		lastinputs = std::move(current);
+		if ( !streaming )
+			StoreInCache();
+	}
+
+	ScannerVectorFrameBasic::FillInputs ScannerVectorFrameSaw::CurrentFillInputs() const {
+		FillInputs in(ScannerVectorFrameBasic::CurrentFillInputs());
+		const parameters::ScannerVectorFrameSaw* const params = dynamic_cast<parameters::ScannerVectorFrameSaw*>(svparameters);
+		in.geometry.insert(std::end(in.geometry), { static_cast<double>(params->XCutoffPixels()), static_cast<double>(params->XRetracePixels())
+			, static_cast<double>(params->YCutoffLines()), static_cast<double>(params->YRetraceLines()), static_cast<double>(params->LineRepeats()) });
+		return in;
 	}
 
 	void ScannerVectorFrameSaw::FillLookup() {
-		parameters::ScannerVectorFrameSaw* tmp = dynamic_cast<parameters::ScannerVectorFrameSaw*>(svparameters);
-		const uint32_t cutofflines = tmp->YCutoffLines();
-		const uint32_t scanlines = tmp->YScanLines();
-		const uint32_t cutoffpixels = tmp->XCutoffPixels();
-		const uint32_t scanpixels = tmp->XScanPixels();
-		const uint32_t ytotallines = tmp->YTotalLines();
-		const uint32_t xtotalpixels = tmp->XTotalPixels();
-		uint32_t datapos = 0;
-		uint32_t imagepos = 0;
-		// advance datapos on every sampled pixel, advance imagepos only on pixels that are inside the image -> build up the lookup vector
+		const uint32_t cutofflines = sawparameters->YCutoffLines();
+		const uint32_t ramplines = sawparameters->YRampLines();
+		const uint32_t repeats = sawparameters->LineRepeats();
+		const uint32_t cutoffpixels = sawparameters->XCutoffPixels();
+		const uint32_t scanpixels = sawparameters->XScanPixels();
+		const uint32_t ytotallines = sawparameters->YTotalLines();
+		const uint32_t xtotalpixels = sawparameters->XTotalPixels();
+		const uint32_t ximagepixels = sawparameters->XImagePixels();
+		uint32_t* const look = lookup->data();
+		size_t datapos = 0;
+		// advance datapos on every sampled pixel, only pixels inside the image get a position in the image -> build up the lookup vector.
+		// All repeats of an image line map to the same image positions (averaged by PixelmapperFrameLineRepeat)
 		for ( uint32_t l = 0 ; l < ytotallines ; l++ ) {
-			for ( uint32_t x = 0 ; x < xtotalpixels ; x++ ) {
-				if ( (l >= cutofflines) && (l < scanlines) && (x >= cutoffpixels) && (x < scanpixels) )
-					lookup->at(datapos) = imagepos++;
-				else
-					lookup->at(datapos) = 0;
-				datapos++;
-			}
+			const bool imageline = (l >= cutofflines) && (l < ramplines);
+			const uint32_t imagepos = imageline ? ((l - cutofflines) / repeats) * ximagepixels : 0;
+			for ( uint32_t x = 0 ; x < xtotalpixels ; x++ )
+				look[datapos++] = ( imageline && (x >= cutoffpixels) && (x < scanpixels) ) ? imagepos + x - cutoffpixels : 0;
 		}
 
 		// Adjust for the scannerdelay by rotating the lookup vector (do not respect oversampling, since lookup is done on downsampled data
-		lookup_rotation = daqparameters->ScannerDelaySamples(false);
-		if ( lookup_rotation > 0 )
-			std::rotate(std::begin(*lookup), std::begin(*lookup)+lookup_rotation, std::end(*lookup));
-		if ( lookup_rotation < 0 )
-			std::rotate(std::begin(*lookup), std::end(*lookup)+lookup_rotation, std::end(*lookup));
+		lookup_rotation = 0;
+		RotateLookup(daqparameters->ScannerDelaySamples(false));
 	}
 
-	void ScannerVectorFrameSaw::FillX() {
-		parameters::ScannerVectorFrameSaw* tmp = dynamic_cast<parameters::ScannerVectorFrameSaw*>(svparameters);
-		const uint32_t framesamples(tmp->TotalPixels());
+	std::vector<int16_t> ScannerVectorFrameSaw::XLine() const {
+		parameters::ScannerVectorFrameSaw* const tmp = sawparameters;
 		const uint32_t linesamples(tmp->XTotalPixels());
 		const Scaler<int16_t> scaletodevice(-daqparameters->outputs->range(), daqparameters->outputs->range());		// convert full device range to full range of int16_t
 		const double zoom = tmp->zoom();
@@ -111,31 +134,34 @@ namespace scope {
 		const double xmaxzoomed = center + 0.5*xrangezoomed;								// maximum x value after zoom
 		const double xscanslope = xrangezoomed / static_cast<double>(tmp->XScanPixels());
 		const double xretraceslope = -xrangezoomed / static_cast<double>(tmp->XRetracePixels());
-		const uint32_t xscansamples = 4*tmp->XScanPixels();
-		const uint32_t xtotalsamples = 4*tmp->XTotalPixels();
+		const uint32_t xscanpixels = tmp->XScanPixels();
+
+		// All lines are the same, so scale only one line: XCutoffPixels()+XImagePixels() increasing values (scanning), then
+		// XRetracePixels() decreasing values (retracing)
+		std::vector<int16_t> line(linesamples);
+		for ( uint32_t x = 0 ; x < xscanpixels ; x++ )
+			line[x] = scaletodevice(xminzoomed + x * xscanslope);
+		for ( uint32_t x = xscanpixels ; x < linesamples ; x++ )
+			line[x] = scaletodevice(xmaxzoomed + (x - xscanpixels) * xretraceslope);
+		return line;
+	}
 
-		uint32_t x = 0;
-		size_t cx = 0;
-
-		do {
-			// fill in XCutoffSamples()+XImageSamples() with increasing values (scanning) in X
-			x = 0;
-			for ( size_t i = cx ; i < cx+xscansamples ; i += 4, x++ )
-				vecptr->at(i) = scaletodevice(xminzoomed + x * xscanslope);
-			
-			// fill in XRetraceSamples() with decreasing values (retracing) in X
-			x = 0;
-			for ( size_t i = cx+xscansamples ; i < cx+xtotalsamples ; i += 4, x++ )
-				vecptr->at(i) = scaletodevice(xmaxzoomed + x * xretraceslope);
-
-			cx += 4*linesamples;
-		} while ( cx < 4*framesamples );
+	void ScannerVectorFrameSaw::FillX() {
+		const uint32_t framesamples(sawparameters->TotalPixels());
+		const std::vector<int16_t> line(XLine());
+		const uint32_t linesamples(static_cast<uint32_t>(line.size()));
+
+		// x is every 4th sample starting at 0 (sizes are checked in UpdateVector, so no bounds checking here)
+		int16_t* const vec = vecptr->data();
+		for ( size_t cx = 0 ; cx < 4*static_cast<size_t>(framesamples) ; cx += 4*linesamples ) {
+			int16_t* const v = vec + cx;
+			for ( uint32_t x = 0 ; x < linesamples ; x++ )
+				v[4*x] = line[x];
+		}
 	}
 
-	void ScannerVectorFrameSaw::FillY() {
-		parameters::ScannerVectorFrameSaw* tmp = dynamic_cast<parameters::ScannerVectorFrameSaw*>(svparameters);
-		const uint32_t framesamples(tmp->TotalPixels());
-		const uint32_t linesamples(tmp->XTotalPixels());
+	void ScannerVectorFrameSaw::YColumn(std::vector<int16_t>& _scan, double& _retracestart, double& _retraceslope) const {
+		parameters::ScannerVectorFrameSaw* const tmp = sawparameters;
 		const Scaler<int16_t> scaletodevice(-daqparameters->outputs->range(), daqparameters->outputs->range());		// convert full device range to full range of int16_t
 		const double zoom = tmp->zoom();
 		const double range = daqparameters->outputs->maxoutputscanner() - daqparameters->outputs->minoutputscanner();
@@ -159,119 +185,129 @@ namespace scope {
 		const double ymaxzoomed = center + 0.5*yrangezoomed;								// maximum y value after zoom
 		const double yscanslope = yrangezoomed / static_cast<double>(tmp->YScanLines());
 		const double yretraceslope = -yrangezoomed / static_cast<double>(tmp->YRetraceLines() * tmp->XTotalPixels());
-		const uint32_t yscanlinesamples = 4*tmp->YScanLines()*linesamples;
-		uint32_t yscan = 0;
-		uint32_t yretrace = 0;
-		size_t cy = 1;																			// y starts at sample 1
-
-		do {
-			// fill in linesamples with the same value for scanning
-			if ( cy < (1 + yscanlinesamples) ) {
-				for ( size_t i = cy ; i < cy+4*linesamples ; i += 4 )
-					vecptr->at(i) = scaletodevice(yminzoomed + yscan * yscanslope);
-				yscan++;
-			}
-			else {
-				// do a smoother retracing
-				for ( size_t i = cy ; i < cy+4*linesamples ; i += 4 ) {
-					vecptr->at(i) = scaletodevice(ymaxzoomed + yretrace * yretraceslope);
-					yretrace++;
-				}
-			}
-			cy += 4*linesamples;
-		} while ( cy < (4*framesamples + 1) );
+		const uint32_t cutofflines = tmp->YCutoffLines();
+		const uint32_t repeats = tmp->LineRepeats();
+		const uint32_t ramplines = std::min(tmp->YRampLines(), tmp->YTotalLines());
+
+		// one value per scan line (y is held during the repeats of an image line), then a smooth retrace from ymaxzoomed
+		_scan.resize(ramplines);
+		for ( uint32_t l = 0 ; l < ramplines ; l++ ) {
+			const uint32_t scanline = (l < cutofflines) ? l : cutofflines + (l - cutofflines) / repeats;
+			_scan[l] = scaletodevice(yminzoomed + scanline * yscanslope);
+		}
+		_retracestart = ymaxzoomed;
+		_retraceslope = yretraceslope;
+	}
+
+	void ScannerVectorFrameSaw::FillY() {
+		const uint32_t framesamples(sawparameters->TotalPixels());
+		const uint32_t linesamples(sawparameters->XTotalPixels());
+		const Scaler<int16_t> scaletodevice(-daqparameters->outputs->range(), daqparameters->outputs->range());		// convert full device range to full range of int16_t
+		std::vector<int16_t> yscan;
+		double yretracestart = 0.0;
+		double yretraceslope = 0.0;
+		YColumn(yscan, yretracestart, yretraceslope);
+		int16_t* const vec = vecptr->data() + 1;												// y starts at sample 1
+		size_t i = 0;
+
+		// fill in linesamples with the same value for scanning
+		for ( uint32_t l = 0 ; l < yscan.size() ; l++ ) {
+			for ( uint32_t x = 0 ; x < linesamples ; x++, i += 4 )
+				vec[i] = yscan[l];
+		}
+		// do a smoother retracing
+		for ( uint32_t yretrace = 0 ; i < 4*static_cast<size_t>(framesamples) ; yretrace++, i += 4 )
+			vec[i] = scaletodevice(yretracestart + yretrace * yretraceslope);
 	}
 
 	void ScannerVectorFrameSaw::FillZ() {
-		parameters::ScannerVectorFrameSaw* tmp = dynamic_cast<parameters::ScannerVectorFrameSaw*>(svparameters);
+		parameters::ScannerVectorFrameSaw* const tmp = sawparameters;
 		const uint32_t framesamples(tmp->TotalPixels());
-		const uint32_t linesamples(tmp->XTotalPixels());
 		const Scaler<int16_t> scaletodevice(-daqparameters->outputs->range(), daqparameters->outputs->range());	// convert full device range to full range of int16_t
 		const int16_t fastzoutdev = scaletodevice(zparameters->PositionToVoltage(svparameters->fastz()));					// get the voltage corresponding to current ETL position in micron and scale to device
-		size_t cz = 0, cz_init = 0, step_size = 0;
+		size_t cz_init = 0, step_size = 0;
 		// Decide vector storage locations and step_size based on Master/Slave
 		if (filltype == ScannerVectorFillTypeHelper::FullframeXYZP) {
-			cz = 2;	cz_init = 2; step_size = 4; 
+			cz_init = 2; step_size = 4; 
 		}
 		if (filltype == ScannerVectorFillTypeHelper::LineZP) {
-			cz = 0;	cz_init = 0; step_size = 2; 
+			cz_init = 0; step_size = 2; 
 		}
 
-		do {
-			// Fast z position stays constant during normal frame scanning	
-			for ( size_t i = cz ; i < cz + step_size*linesamples ; i += step_size )
-				vecptr->at(i) = fastzoutdev;
-			cz += step_size*linesamples;
-		} while ( cz < (step_size*framesamples + cz_init) );
+		// Fast z position stays constant during normal frame scanning	
+		int16_t* const vec = vecptr->data() + cz_init;
+		for ( size_t i = 0 ; i < step_size*framesamples ; i += step_size )
+			vec[i] = fastzoutdev;
 	}
 
-	void ScannerVectorFrameSaw::FillP() {
-		parameters::ScannerVectorFrameSaw* tmp = dynamic_cast<parameters::ScannerVectorFrameSaw*>(svparameters);
-		const uint32_t framesamples(tmp->TotalPixels());
+	void ScannerVectorFrameSaw::PLines(const double& _pockels, std::vector<int16_t>& _imageline, std::vector<bool>& _blanklines, int16_t& _blank) const {
+		parameters::ScannerVectorFrameSaw* const tmp = sawparameters;
 		const uint32_t linesamples(tmp->XTotalPixels());
+		const uint32_t ytotallines(tmp->YTotalLines());
 		const uint32_t cutofflines = tmp->YCutoffLines();
-		const uint32_t scanlines = tmp->YScanLines();
+		const uint32_t ramplines = tmp->YRampLines();
 		const uint32_t cutoffpixels = tmp->XCutoffPixels();
 		const uint32_t scanpixels = tmp->XScanPixels();
-		const double pockelsoutval = (tmp->pockels()-tmp->pockels.ll())/(tmp->pockels.ul()-tmp->pockels.ll())
+		const double pockelsoutval = (_pockels-tmp->pockels.ll())/(tmp->pockels.ul()-tmp->pockels.ll())
 			*daqparameters->outputs->maxoutputpockels()+daqparameters->outputs->minoutputpockels();							// scale pockels value from displayed value (e.g. 0..1) to device value (e.g. 0..2)
 		const Scaler<int16_t> scaletodevice(-daqparameters->outputs->range(), daqparameters->outputs->range());		// convert full device range to full range of int16_t
-		size_t cp = 0, cp_init = 0, step_size = 0;
+		_blank = scaletodevice(0.0);
+		const int16_t pockelsdev = scaletodevice(pockelsoutval);
+
+		// Pockels blanking during X cutoff and X retrace, pockels during image
+		_imageline.assign(linesamples, _blank);
+		std::fill(std::begin(_imageline) + std::min(cutoffpixels, linesamples), std::begin(_imageline) + std::min(scanpixels, linesamples), pockelsdev);
+
+		// Pockels blanking during Y cutoff and retrace
+		_blanklines.resize(ytotallines);
+		for ( uint32_t l = 0 ; l < ytotallines ; l++ )
+			_blanklines[l] = (l < cutofflines) || (l > ramplines);
+	}
+
+	void ScannerVectorFrameSaw::FillP() {
+		const uint32_t framesamples(sawparameters->TotalPixels());
+		const uint32_t linesamples(sawparameters->XTotalPixels());
+		size_t cp_init = 0, step_size = 0;
 		// Decide vector storage locations and step_size based on Master/Slave
 		if (filltype == ScannerVectorFillTypeHelper::FullframeXYZP) {
-			cp = 3;	cp_init = 3; step_size = 4; 
+			cp_init = 3; step_size = 4; 
 		}
 		if (filltype == ScannerVectorFillTypeHelper::LineZP) {
-			cp = 1;	cp_init = 1; step_size = 2; 
+			cp_init = 1; step_size = 2; 
+		}
+		std::vector<int16_t> imageline;
+		std::vector<bool> blanklines;
+		int16_t blankdev = 0;
+		PLines(sawparameters->pockels(), imageline, blanklines, blankdev);
+
+		int16_t* const vec = vecptr->data() + cp_init;
+		size_t i = 0;
+		for ( uint32_t l = 0 ; l < blanklines.size() ; l++ ) {
+			const bool blankline = blanklines[l];
+			for ( uint32_t x = 0 ; x < linesamples ; x++, i += step_size )
+				vec[i] = blankline ? blankdev : imageline[x];
 		}
-
-		do {
-			// Pockels blanking during Y cutoff and retrace
-			if ( (cp < (cp_init + step_size*cutofflines*linesamples))
-				|| (cp > (cp_init + step_size*scanlines*linesamples)) ) {
-				for ( size_t i = cp ; i < cp + step_size*linesamples ; i += step_size )
-					vecptr->at(i) = scaletodevice(0.0);
-			}
-			else {
-				// Pockels blanking during X cutoff and X retrace, pockels during image
-				for ( size_t i = cp ; i < cp+step_size*cutoffpixels ; i += step_size )
-					vecptr->at(i) = scaletodevice(0.0);
-				for ( size_t i = cp+step_size*cutoffpixels ; i < cp+step_size*scanpixels ; i += step_size )
-					vecptr->at(i) = scaletodevice(pockelsoutval);
-				for ( size_t i = cp+step_size*scanpixels ; i < cp+4*linesamples ; i += step_size )
-					vecptr->at(i) = scaletodevice(0.0);
-			}
-			cp += step_size*linesamples;
-		} while ( cp < (step_size*framesamples + cp_init) );
 
 		// Adjust for the scannerdelay by rotating the pockels vector (do not respect oversampling, since pockels vector is with pixels, not oversampled input samples)
-		const int32_t pockels_rotation = daqparameters->ScannerDelaySamples(false);
-		if ( pockels_rotation > 0 ) {
-			auto length = vecptr->size() / step_size;
-			size_t p = 0;
-			size_t pr = p + pockels_rotation;
-			for ( uint32_t i = 0 ; i < length ; ++i ) {
-				std::swap(vecptr->at(cp_init+step_size*p), vecptr->at(cp_init+step_size*pr));
-				// Modulo does the turnaround
-				p = (p+1)%length;
-				pr = (pr+1)%length;
-			}	
-		}
-		if ( pockels_rotation < 0 ) {
-			auto length = vecptr->size() / step_size;
-			size_t p = 0;					// from reverse p starts at 1
-			size_t pr = p - pockels_rotation;
-			for ( uint32_t i = 0 ; i < length ; ++i) {
-				std::swap(vecptr->at(step_size*(length-p)-1), vecptr->at(step_size*(length-pr)-1));
-				// Modulo does the turnaround
-				p = (p+1)%length;
-				pr = (pr+1)%length;
-			}
-		}
+		RotateP(cp_init, step_size, step_size*framesamples, daqparameters->ScannerDelaySamples(false));
+	}
+
+	void ScannerVectorFrameSaw::FillStream() {
+		StreamTables tables;
+		tables.linesamples = sawparameters->XTotalPixels();
+		tables.lines = sawparameters->YTotalLines();
+		tables.range = daqparameters->outputs->range();
+		tables.x = XLine();
+		YColumn(tables.yscan, tables.yretracestart, tables.yretraceslope);
+		const Scaler<int16_t> scaletodevice(-tables.range, tables.range);
+		tables.z = scaletodevice(zparameters->PositionToVoltage(svparameters->fastz()));
+		PLines(sawparameters->pockels(), tables.pline, tables.pblanklines, tables.pblank);
+		tables.protation = daqparameters->ScannerDelaySamples(false);
+		SetStreamTables(std::move(tables));
 	}
 
 	void ScannerVectorFrameSaw::FillXP() {
-		parameters::ScannerVectorFrameSaw* tmp = dynamic_cast<parameters::ScannerVectorFrameSaw*>(svparameters);
+		parameters::ScannerVectorFrameSaw* const tmp = sawparameters;
 		const Scaler<int16_t> scaletodevice(-daqparameters->outputs->range(), daqparameters->outputs->range());		// convert full device range to full range of int16_t
 		const double zoom = tmp->zoom();
 		const double range = daqparameters->outputs->maxoutputscanner() - daqparameters->outputs->minoutputscanner();
@@ -303,59 +339,39 @@ namespace scope {
 		const double pockelsoutval = (tmp->pockels()-tmp->pockels.ll())/(tmp->pockels.ul()-tmp->pockels.ll())
 			*daqparameters->outputs->maxoutputpockels()+daqparameters->outputs->minoutputpockels();
 
+		const int16_t pockelsdev = scaletodevice(pockelsoutval);
+
 		uint32_t x = 0;
-		const size_t cx = 0;		// xp interleaved starts at index 0
+		int16_t* const vec = vecptr->data();		// xp interleaved starts at index 0
 
 		// fill in XCutoffSamples()+XImageSamples() with increasing values (scanning) in X
-		for ( size_t i = cx ; i < cx+xcutoffsamples ; i += 2, ++x ) {
+		for ( size_t i = 0 ; i < xcutoffsamples ; i += 2, ++x ) {
 			// x galvo ramps up
-			vecptr->at(i) = scaletodevice(xminzoomed + x * xscanslope);
+			vec[i] = scaletodevice(xminzoomed + x * xscanslope);
 			// Pockels cell is blanked/closed
-			vecptr->at(i+1) = 0;
+			vec[i+1] = 0;
 		}
-		for ( size_t i = cx+xcutoffsamples ; i < cx+xcutoffsamples+ximagesamples ; i += 2, ++x ) {
+		for ( size_t i = xcutoffsamples ; i < xcutoffsamples+ximagesamples ; i += 2, ++x ) {
 			// x galvo ramps further up
-			vecptr->at(i) = scaletodevice(xminzoomed + x * xscanslope);
+			vec[i] = scaletodevice(xminzoomed + x * xscanslope);
 			// Pockels cell is open now
-			vecptr->at(i+1) = scaletodevice(pockelsoutval);
+			vec[i+1] = pockelsdev;
 		}
 		// fill in XRetraceSamples() with decreasing values (retracing) in X
 		x = 0;	// restart sloping
-		for ( size_t i = cx+xcutoffsamples+ximagesamples ; i < cx+xtotalsamples ; i += 2, ++x ) {
+		for ( size_t i = xcutoffsamples+ximagesamples ; i < xtotalsamples ; i += 2, ++x ) {
 			// x galvo quickly ramps down
-			vecptr->at(i) = scaletodevice(xmaxzoomed + x * xretraceslope);
+			vec[i] = scaletodevice(xmaxzoomed + x * xretraceslope);
 			// Pockels cell blanked/closed again
-			vecptr->at(i+1) = 0;
+			vec[i+1] = 0;
 		}
 
 		// Adjust for the scannerdelay by rotating the pockels vector (do not respect oversampling, since pockels vector is with pixels, not oversampled input samples)
-		const int32_t pockels_rotation = daqparameters->ScannerDelaySamples(false);
-		if ( pockels_rotation > 0 ) {
-			auto length = xtotalsamples;
-			size_t p = 1;								// pockels starts at 2nd sample
-			size_t pr = p + pockels_rotation*2;			// every 2nd sample is pockels
-			for ( uint32_t i = 0 ; i < length ; ++i ) {
-				std::swap(vecptr->at(p), vecptr->at(pr));
-				// Modulo does the turnaround
-				p = (p+2)%length;
-				pr = (pr+2)%length;
-			}	
-		}
-		if ( pockels_rotation < 0 ) {
-			auto length = xtotalsamples;
-			size_t p = 0;							// from reverse pockels starts at 0
-			size_t pr = p + pockels_rotation*2;		// every 2nd sample is pockels
-			for ( uint32_t i = 0 ; i < length ; ++i) {
-				std::swap(vecptr->at(length-p), vecptr->at(length-pr));
-				// Modulo does the turnaround
-				p = (p+2)%length;
-				pr = (pr+2)%length;
-			}
-		}
+		RotateP(1, 2, xtotalsamples, daqparameters->ScannerDelaySamples(false));
 	}
 
 	void ScannerVectorFrameSaw::FillYZ() {
-		parameters::ScannerVectorFrameSaw* tmp = dynamic_cast<parameters::ScannerVectorFrameSaw*>(svparameters);
+		parameters::ScannerVectorFrameSaw* const tmp = sawparameters;
 		const Scaler<int16_t> scaletodevice(-daqparameters->outputs->range(), daqparameters->outputs->range());		// convert full device range to full range of int16_t
 		const double zoom = tmp->zoom();
 		const double range = daqparameters->outputs->maxoutputscanner() - daqparameters->outputs->minoutputscanner();
@@ -380,35 +396,38 @@ namespace scope {
 		const double yretraceslope = -yrangezoomed / static_cast<double>(tmp->YRetraceLines());
 		// *2 since samples for y and z are interleaved
 		const uint32_t ycutoffsamples = 2*tmp->YCutoffLines();
-		const uint32_t yimagesamples = 2*tmp->YImageLines();
+		const uint32_t yimagesamples = 2*tmp->YImageLines()*tmp->LineRepeats();
 		const uint32_t ytotalsamples = 2*tmp->YTotalLines();
+		const uint32_t cutofflines = tmp->YCutoffLines();
+		const uint32_t repeats = tmp->LineRepeats();
 
 		const Scaler<int16_t> scaletodevicez(-daqparameters->outputs->range(), daqparameters->outputs->range());	// convert full device range to full range of int16_t
 		const int16_t fastzoutdev = scaletodevicez(zparameters->PositionToVoltage(svparameters->fastz()));					// get the voltage corresponding to current ETL position in micron an
 
 		uint32_t y = 0;
-		const size_t cy = 2*tmp->XTotalPixels();		// yz interleaved starts after 2*XTotalPixels (for xp)
+		int16_t* const vec = vecptr->data() + 2*tmp->XTotalPixels();		// yz interleaved starts after 2*XTotalPixels (for xp)
 
 		// fill in YCutoffSamples()+YImageSamples() with increasing values (scanning) in Y
-		for ( size_t i = cy ; i < cy+ycutoffsamples+yimagesamples ; i += 2, ++y ) {
-			// y galvo ramps up
-			vecptr->at(i) = scaletodevice(yminzoomed + y * yscanslope);
+		for ( size_t i = 0 ; i < ycutoffsamples+yimagesamples ; i += 2, ++y ) {
+			// y galvo ramps up, held during the repeats of an image line
+			const uint32_t scanline = (y < cutofflines) ? y : cutofflines + (y - cutofflines) / repeats;
+			vec[i] = scaletodevice(yminzoomed + scanline * yscanslope);
 			// fast z stays
-			vecptr->at(i+1) = fastzoutdev;
+			vec[i+1] = fastzoutdev;
 		}
 		// fill in YRetraceSamples() with decreasing values (retracing) in Y
 		y = 0;	// restart sloping
-		for ( size_t i = cy+ycutoffsamples+yimagesamples ; i < cy+ytotalsamples ; i += 2, ++y ) {
+		for ( size_t i = ycutoffsamples+yimagesamples ; i < ytotalsamples ; i += 2, ++y ) {
 			// y galvo quickly ramps down
-			vecptr->at(i) = scaletodevice(ymaxzoomed + y * yretraceslope);
+			vec[i] = scaletodevice(ymaxzoomed + y * yretraceslope);
 			// fast z stays
-			vecptr->at(i+1) = fastzoutdev;
+			vec[i+1] = fastzoutdev;
 		}
 
 	}
 
 	void ScannerVectorFrameSaw::FillZP() {
-		parameters::ScannerVectorFrameSaw* tmp = dynamic_cast<parameters::ScannerVectorFrameSaw*>(svparameters);
+		parameters::ScannerVectorFrameSaw* const tmp = sawparameters;
 		const Scaler<int16_t> scaletodevice(-daqparameters->outputs->range(), daqparameters->outputs->range());		// convert full device range to full range of int16_t
 		const int16_t pockelsoutval = scaletodevice((tmp->pockels()-tmp->pockels.ll())/(tmp->pockels.ul()-tmp->pockels.ll())
 			*daqparameters->outputs->maxoutputpockels()+daqparameters->outputs->minoutputpockels());
@@ -434,28 +453,22 @@ namespace scope {
 
 	}
 
-	void ScannerVectorFrameSaw::RotateP(const size_t& _pstart, const size_t& _interleavedfactor, const int32_t& _rotateby) {
-		const size_t length = vecptr->size();
-		if ( _rotateby > 0 ) {
-			size_t p = _pstart;
-			size_t pr = p + _rotateby*_interleavedfactor;
-			for ( uint32_t i = 0 ; i < length ; i += _interleavedfactor ) {
-				std::swap(vecptr->at(p), vecptr->at(pr));
-				// Modulo does the turnaround
-				p = (p+_interleavedfactor)%length;
-				pr = (pr+_interleavedfactor)%length;
-			}	
-		}
-		if ( _rotateby < 0 ) {
-			size_t p = 0;							// from reverse pockels starts at 0
-			size_t pr = p + _rotateby*_interleavedfactor;
-			for ( uint32_t i = 0 ; i < vecptr->size() ; i += _interleavedfactor ) {
-				std::swap(vecptr->at(length-p), vecptr->at(length-pr));
-				// Modulo does the turnaround
-				p = (p+_interleavedfactor)%length;
-				pr = (pr+_interleavedfactor)%length;
-			}
-		}
+	void ScannerVectorFrameSaw::RotateP(const size_t& _pstart, const size_t& _interleavedfactor, const size_t& _samples, const int32_t& _rotateby) {
+		const int64_t length = static_cast<int64_t>(_samples / _interleavedfactor);
+		if ( (length == 0) || (_rotateby == 0) )
+			return;
+		// as a left rotation by [0, length)
+		const int64_t by = (_rotateby % length + length) % length;
+		if ( by == 0 )
+			return;
+		// Gather the strided Pockels samples, rotate them, and scatter them back
+		int16_t* const vec = vecptr->data() + _pstart;
+		std::vector<int16_t> pockels(static_cast<size_t>(length));
+		for ( int64_t i = 0 ; i < length ; i++ )
+			pockels[i] = vec[i*_interleavedfactor];
+		std::rotate(std::begin(pockels), std::begin(pockels) + by, std::end(pockels));
+		for ( int64_t i = 0 ; i < length ; i++ )
+			vec[i*_interleavedfactor] = pockels[i];
 	}
 
 }
\ No newline at end of file
@@ -4,14 +4,41 @@
 
 namespace scope {
 
-/** Calculates scanner, fast z, and pockels control voltages for a saw tooth frame scan */
+/** Calculates scanner, fast z, and pockels control voltages for a saw tooth frame scan. With line repeats every image line is scanned
+* several times while y is held, the lookup vector maps all repeats to the same image line. */
 class ScannerVectorFrameSaw
  : public ScannerVectorFrameBasic {
 
 protected:
-	/** Calculate the scanner vector based on the current parameters */
+	/** the scanner vector parameters, cast once per UpdateVector for the Fill functions */
+	parameters::ScannerVectorFrameSaw* sawparameters;
+
+protected:
+	/** Calculate the scanner vector based on the current parameters, only the parts whose parameters changed are refilled */
 	void UpdateVector() override;
 
+	/** @return the base class inputs plus cutoff and retrace */
+	FillInputs CurrentFillInputs() const override;
+
+	/** @return true, full frame sawtooth scans can stream */
+	bool SupportsStreaming() const override { return true; }
+
+	/** @return the x samples of one line (all lines are the same) */
+	std::vector<int16_t> XLine() const;
+
+	/** Calculates the y signal, constant during each scan line, then a smooth retrace
+	* @param[out] _scan the y sample of every scan line
+	* @param[out] _retracestart y voltage at the first retrace sample
+	* @param[out] _retraceslope y voltage change per retrace sample */
+	void YColumn(std::vector<int16_t>& _scan, double& _retracestart, double& _retraceslope) const;
+
+	/** Calculates the Pockels signal (before rotation for the scanner delay)
+	* @param[in] _pockels the Pockels value (in units of the pockels parameter) on image pixels
+	* @param[out] _imageline the Pockels samples of an image line (blanked during x cutoff and retrace)
+	* @param[out] _blanklines true for every line that is blanked completely (y cutoff and retrace)
+	* @param[out] _blank the blanked Pockels sample */
+	void PLines(const double& _pockels, std::vector<int16_t>& _imageline, std::vector<bool>& _blanklines, int16_t& _blank) const;
+
 	/** Fill the samples for the x scanner axis */
 	void FillX();
 
@@ -24,6 +51,9 @@ protected:
 	/** Fill the samples for the Pockels cell (cutoff&retrace blanking for x and y) */
 	void FillP();
 
+	/** Fill the stream tables for Generate instead of the full frame vector. For filltype ScannerVectorFillTypeHelper::FullframeXYZP when streaming. */
+	void FillStream();
+
 	/** Fill the samples for x and Pockels cell for one line. For filltype ScannerVectorFillTypeHelper::LineXPColumnYZ. */
 	void FillXP();
 
@@ -39,8 +69,14 @@ protected:
 	/** Rotate the Pockels samples in the scanner vector
 	* @param[in] _pstart the first Pockels sample. If e.g. the vector is filled XYZPXYZPXYZP... this should be 3.
 	* @param[in] _interleavedfactor the number of interleaved signals. For XYZP this is 4, for ZP 2 etc.
-	* @param[in] _rotateby the number of samples to rotate by. */
-	void RotateP(const size_t& _pstart, const size_t& _interleavedfactor, const int32_t& _rotateby);
+	* @param[in] _samples the number of samples (all signals) to rotate in, starting at 0
+	* @param[in] _rotateby the number of Pockels samples to rotate by, positive values rotate to the left */
+	void RotateP(const size_t& _pstart, const size_t& _interleavedfactor, const size_t& _samples, const int32_t& _rotateby);
+
+	/** For derived scan types that scan sawtooth frames
+	* @param[in] _type the type of the derived scanner vector
+	* @param[in] _filltype type of vector fill, see GetInterleavedVector for details */
+	ScannerVectorFrameSaw(const ScannerVectorType& _type, const ScannerVectorFillType& _filltype);
 
 public:
 	/** * @param[in] _filltype type of vector fill, see GetInterleavedVector for details */
@@ -0,0 +1,88 @@
+#include "stdafx.h"
+#include "ScannerVectorFrameVolume.h"
+#include "helpers/ScopeTrace.h"
+
+namespace scope {
+
+ScannerVectorFrameVolume::ScannerVectorFrameVolume(const ScannerVectorFillType& _filltype)
+	: ScannerVectorFramePlaneHopper(ScannerVectorTypeHelper::Volume, _filltype)
+	, volumeparameters(nullptr) {
+}
+
+void ScannerVectorFrameVolume::UpdateVector() {
+	ScopeTraceSpan span("ScannerVectorFrameVolume::UpdateVector");
+	volumeparameters = dynamic_cast<parameters::ScannerVectorFrameVolume*>(svparameters);
+	// Interpolate the calibration once per update, FillZ and CurrentFillInputs only read the table
+	zlinevoltages = zparameters->PositionsToVoltages(ZLinePositions());
+	ScannerVectorFramePlaneHopper::UpdateVector();
+}
+
+ScannerVectorFrameBasic::FillInputs ScannerVectorFrameVolume::CurrentFillInputs() const {
+	FillInputs in(ScannerVectorFrameSaw::CurrentFillInputs());
+	in.z = zlinevoltages;
+	return in;
+}
+
+std::vector<parameters::PlaneProperties> ScannerVectorFrameVolume::PlaneList() const {
+	const parameters::ScannerVectorFrameVolume* const params = dynamic_cast<parameters::ScannerVectorFrameVolume*>(svparameters);
+	std::vector<parameters::PlaneProperties> planelist;
+	for ( uint32_t s = 0 ; s < params->Planes() ; s++ )
+		planelist.push_back(parameters::PlaneProperties(params->SlicePosition(s), params->pockels()));
+	return planelist;
+}
+
+std::vector<double> ScannerVectorFrameVolume::ZLinePositions() const {
+	const uint32_t slices = volumeparameters->Planes();
+	const uint32_t ytotallines = volumeparameters->YTotalLines();
+	const uint32_t scanlines = std::min(volumeparameters->YScanLines(), ytotallines);
+	const size_t lines = static_cast<size_t>(slices) * ytotallines;
+	std::vector<double> positions(lines);
+
+	if ( !volumeparameters->continuousz() ) {
+		// Staircase: the slice's position during its scan lines, the next slice's position during its y retrace (thus the fast z settles
+		// during retrace and y cutoff), after the last slice back to the first
+		for ( uint32_t s = 0 ; s < slices ; s++ ) {
+			for ( uint32_t l = 0 ; l < ytotallines ; l++ )
+				positions[s*ytotallines + l] = volumeparameters->SlicePosition((l < scanlines) ? s : (s + 1) % slices);
+		}
+	}
+	else {
+		// Sawtooth: linear from zstart to zstop through the scan and retrace lines of all slices, back to zstart during the last slice's y retrace
+		const uint32_t flyback = ytotallines - scanlines;
+		const size_t ramp = lines - flyback;
+		const double zstart = volumeparameters->zstart();
+		const double zstop = volumeparameters->zstop();
+		const double zstep = (ramp > 1) ? (zstop - zstart) / static_cast<double>(ramp - 1) : 0.0;
+		for ( size_t l = 0 ; l < ramp ; l++ )
+			positions[l] = zstart + l * zstep;
+		for ( uint32_t f = 0 ; f < flyback ; f++ )
+			positions[ramp + f] = zstop + (zstart - zstop) * FlybackProfile(f, flyback);
+	}
+	return positions;
+}
+
+void ScannerVectorFrameVolume::FillZ() {
+	const uint32_t linesamples(sawparameters->XTotalPixels());
+	const Scaler<int16_t> scaletodevice(-daqparameters->outputs->range(), daqparameters->outputs->range());	// convert full device range to full range of int16_t
+	size_t cz_init = 0, step_size = 0;
+	// Decide vector storage locations and step_size based on Master/Slave
+	if (filltype == ScannerVectorFillTypeHelper::FullframeXYZP) {
+		cz_init = 2; step_size = 4; 
+	}
+	else if (filltype == ScannerVectorFillTypeHelper::LineZP) {
+		cz_init = 0; step_size = 2; 
+	}
+	else
+		throw ScopeException("Volume scans need full frame or line ZP outputs, line clocked x/y outputs are not possible");
+
+	// Fast z is constant during each line, the per line voltages come from the lookup table
+	int16_t* const vec = vecptr->data() + cz_init;
+	size_t i = 0;
+	for ( const auto& zvolt : zlinevoltages ) {
+		const int16_t zdev = scaletodevice(zvolt);
+		for ( uint32_t x = 0 ; x < linesamples ; x++, i += step_size )
+			vec[i] = zdev;
+	}
+}
+
+}
@@ -0,0 +1,47 @@
+#pragma once
+
+#include "ScannerVectorFramePlaneHopper.h"
+
+namespace scope {
+
+/** Volume scanning with a fast z device. One daq frame consists of one sawtooth frame per slice, the fast z follows a per line waveform
+* through the volume: either a staircase (constant during each slice's scan lines, step to the next slice during the y retrace) or a
+* continuous sawtooth (linear through all lines of all slices, back to the start during the last slice's y retrace). The z positions are
+* converted once per update into a per line voltage lookup table by interpolating the fast z calibration.
+* The lookup vector encodes the slice as for the plane hopper (slice*xres*yres + position in the slice's image). */
+class ScannerVectorFrameVolume
+	: public ScannerVectorFramePlaneHopper {
+
+protected:
+	/** the scanner vector parameters, cast once per UpdateVector */
+	parameters::ScannerVectorFrameVolume* volumeparameters;
+
+	/** fast z output voltage for every line of the volume (slices*YTotalLines) */
+	std::vector<double> zlinevoltages;
+
+protected:
+	/** Calculates the fast z voltage lookup table, then the vector as for the plane hopper */
+	void UpdateVector() override;
+
+	/** @return the sawtooth inputs with the fast z voltages of all lines */
+	FillInputs CurrentFillInputs() const override;
+
+	/** @return position (staircase position of each slice) and the frame's Pockels value for every slice */
+	std::vector<parameters::PlaneProperties> PlaneList() const override;
+
+	/** @return fast z position in micron for every line of the volume */
+	std::vector<double> ZLinePositions() const;
+
+	/** Fill the samples for the fast z axis from the per line voltage lookup table */
+	void FillZ() override;
+
+public:
+	/** @param[in] _filltype type of vector fill, see GetInterleavedVector for details. ScannerVectorFillTypeHelper::LineXPColumnYZ is not
+	* possible since fast z changes during one daq frame. */
+	ScannerVectorFrameVolume(const ScannerVectorFillType& _filltype);
+};
+
+/** A shared pointer to a ScannerVectorFrameVolume */
+typedef std::shared_ptr<ScannerVectorFrameVolume> ScannerVectorFrameVolumePtr;
+
+}
@@ -0,0 +1,235 @@
+#include "StdAfx.h"
+#include "ScannerVectorLine.h"
+#include "helpers/ScopeTrace.h"
+
+namespace scope {
+
+	ScannerVectorLine::ScannerVectorLine(const ScannerVectorFillType& _filltype)
+		: ScannerVectorFrameBasic(ScannerVectorTypeHelper::LineStraight, _filltype)
+		, lineparameters(nullptr) {
+	}
+
+	ScannerVectorLine::~ScannerVectorLine() {
+
+	}
+
+	void ScannerVectorLine::UpdateVector() {
+		ScopeTraceSpan span("ScannerVectorLine::UpdateVector");
+		lineparameters = dynamic_cast<parameters::ScannerVectorLine*>(svparameters);
+		FillInputs current;
+		const uint32_t dirty = DirtyParts(current);
+		if ( (dirty == 0) || RestoreFromCache(current) )
+			return;
+
+		switch ( filltype ) {
+		case ScannerVectorFillTypeHelper::FullframeXYZP:
+			// interleaved samples for x,y,z,pockels
+			vecptr->resize(4*svparameters->TotalPixels());
+			// the arc length resampling depends on both axes, thus x and y are always calculated together
+			if ( dirty & (PartX | PartY) ) {
+				CalculatePath();
+				FillX();
+				FillY();
+			}
+			if ( dirty & PartZ )
+				FillZ();
+			if ( dirty & PartP )
+				FillP();
+			break;
+		case ScannerVectorFillTypeHelper::LineZP:
+			vecptr->resize(2*svparameters->TotalPixels());
+			if ( dirty & PartZ )
+				FillZ();
+			if ( dirty & PartP )
+				FillP();
+			break;
+		default:
+			throw ScopeException("Line scans need full frame outputs, line clocked outputs are not possible");
+		}
+
+		lookup->resize(svparameters->TotalPixels());
+		if ( dirty & PartLookup )
+			FillLookup();
+		else
+			RotateLookup(daqparameters->ScannerDelaySamples(false));
+
+		lastinputs = std::move(current);
+		StoreInCache();
+	}
+
+	ScannerVectorFrameBasic::FillInputs ScannerVectorLine::CurrentFillInputs() const {
+		FillInputs in(ScannerVectorFrameBasic::CurrentFillInputs());
+		const parameters::ScannerVectorLine* const params = dynamic_cast<parameters::ScannerVectorLine*>(svparameters);
+		in.geometry.insert(std::end(in.geometry), { params->xcutoff(), params->xretrace() });
+		for ( const auto& p : params->points )
+			in.geometry.insert(std::end(in.geometry), { p.x(), p.y() });
+		return in;
+	}
+
+	void ScannerVectorLine::CalculatePath() {
+		const double minscanner = daqparameters->outputs->minoutputscanner();
+		const double maxscanner = daqparameters->outputs->maxoutputscanner();
+		const uint32_t xres = lineparameters->xres();
+		const uint32_t cutoff = lineparameters->XCutoffPixels();
+		const uint32_t retrace = lineparameters->XRetracePixels();
+		double xmin = 0.0;
+		double xrange = 0.0;
+		double ymin = 0.0;
+		double yrange = 0.0;
+		FieldRange(lineparameters->xaspectratio() / lineparameters->yaspectratio(), lineparameters->xoffset(), xmin, xrange);
+		FieldRange(lineparameters->yaspectratio() / lineparameters->xaspectratio(), lineparameters->yoffset(), ymin, yrange);
+
+		// Path points in voltages and the arc length at each of them, without any point scan the center of the field
+		std::vector<std::pair<double, double>> vertices;
+		for ( const auto& p : lineparameters->points )
+			vertices.push_back(std::make_pair(xmin + p.x() * xrange, ymin + p.y() * yrange));
+		if ( vertices.empty() )
+			vertices.push_back(std::make_pair(xmin + 0.5 * xrange, ymin + 0.5 * yrange));
+		std::vector<double> arclength(1, 0.0);
+		for ( size_t v = 1 ; v < vertices.size() ; v++ )
+			arclength.push_back(arclength.back() + std::hypot(vertices[v].first - vertices[v-1].first, vertices[v].second - vertices[v-1].second));
+		const double length = arclength.back();
+		const double ds = length / static_cast<double>(xres);												// voltage step per pixel along the path
+
+		// Position at arc length _s, walking along the segments
+		auto positionat = [&](const double& _s) {
+			const size_t seg = std::min<size_t>(vertices.size() - 1, std::distance(std::begin(arclength), std::upper_bound(std::begin(arclength), std::end(arclength), _s)));
+			if ( (seg == 0) || (arclength[seg] == arclength[seg-1]) )
+				return vertices[seg];
+			const double t = std::min(1.0, (_s - arclength[seg-1]) / (arclength[seg] - arclength[seg-1]));
+			return std::make_pair(vertices[seg-1].first + t * (vertices[seg].first - vertices[seg-1].first)
+				, vertices[seg-1].second + t * (vertices[seg].second - vertices[seg-1].second));
+		};
+
+		// Direction of the first segment with a length, for the cutoff
+		double dirx = 1.0;
+		double diry = 0.0;
+		for ( size_t v = 1 ; v < vertices.size() ; v++ ) {
+			const double seglength = arclength[v] - arclength[v-1];
+			if ( seglength > 0.0 ) {
+				dirx = (vertices[v].first - vertices[v-1].first) / seglength;
+				diry = (vertices[v].second - vertices[v-1].second) / seglength;
+				break;
+			}
+		}
+
+		// cutoff may reach a bit beyond the field but never beyond the scanner range
+		auto coerce = [&](const std::pair<double, double>& _p) {
+			return std::make_pair(std::min(maxscanner, std::max(minscanner, _p.first)), std::min(maxscanner, std::max(minscanner, _p.second))); };
+
+		path.clear();
+		path.reserve(cutoff + xres + retrace);
+		for ( uint32_t c = 0 ; c < cutoff ; c++ ) {
+			const double back = static_cast<double>(cutoff - c) * ds;
+			path.push_back(coerce(std::make_pair(vertices.front().first - back * dirx, vertices.front().second - back * diry)));
+		}
+		for ( uint32_t x = 0 ; x < xres ; x++ )
+			path.push_back(coerce(positionat(x * ds)));
+
+		// Retrace from the end of the path to the beginning of the cutoff
+		const std::pair<double, double> from(coerce(vertices.back()));
+		const std::pair<double, double> to(path.front());
+		for ( uint32_t r = 0 ; r < retrace ; r++ ) {
+			const double f = FlybackProfile(r, retrace);
+			path.push_back(std::make_pair(from.first + f * (to.first - from.first), from.second + f * (to.second - from.second)));
+		}
+	}
+
+	void ScannerVectorLine::FillX() {
+		const Scaler<int16_t> scaletodevice(-daqparameters->outputs->range(), daqparameters->outputs->range());		// convert full device range to full range of int16_t
+		std::vector<int16_t> line(path.size());
+		std::transform(std::begin(path), std::end(path), std::begin(line), [&](const std::pair<double, double>& _p) { return scaletodevice(_p.first); });
+
+		// All lines of the frame are the same
+		int16_t* const vec = vecptr->data();
+		size_t i = 0;
+		for ( uint32_t l = 0 ; l < lineparameters->YTotalLines() ; l++ ) {
+			for ( const auto& s : line ) {
+				vec[i] = s;
+				i += 4;
+			}
+		}
+	}
+
+	void ScannerVectorLine::FillY() {
+		const Scaler<int16_t> scaletodevice(-daqparameters->outputs->range(), daqparameters->outputs->range());		// convert full device range to full range of int16_t
+		std::vector<int16_t> line(path.size());
+		std::transform(std::begin(path), std::end(path), std::begin(line), [&](const std::pair<double, double>& _p) { return scaletodevice(_p.second); });
+
+		// Other than in frame scans y follows the path during every line
+		int16_t* const vec = vecptr->data() + 1;												// y starts at sample 1
+		size_t i = 0;
+		for ( uint32_t l = 0 ; l < lineparameters->YTotalLines() ; l++ ) {
+			for ( const auto& s : line ) {
+				vec[i] = s;
+				i += 4;
+			}
+		}
+	}
+
+	void ScannerVectorLine::FillZ() {
+		const uint32_t framesamples(lineparameters->TotalPixels());
+		const Scaler<int16_t> scaletodevice(-daqparameters->outputs->range(), daqparameters->outputs->range());	// convert full device range to full range of int16_t
+		const int16_t fastzoutdev = scaletodevice(zparameters->PositionToVoltage(svparameters->fastz()));					// get the voltage corresponding to current ETL position in micron and scale to device
+		// z is sample 2 of 4 for FullframeXYZP, sample 0 of 2 for LineZP
+		const size_t step_size = (filltype == ScannerVectorFillTypeHelper::FullframeXYZP) ? 4 : 2;
+		const size_t cz_init = (filltype == ScannerVectorFillTypeHelper::FullframeXYZP) ? 2 : 0;
+
+		int16_t* const vec = vecptr->data() + cz_init;
+		for ( size_t i = 0 ; i < step_size*framesamples ; i += step_size )
+			vec[i] = fastzoutdev;
+	}
+
+	void ScannerVectorLine::FillP() {
+		const uint32_t xres = lineparameters->xres();
+		const uint32_t cutoff = lineparameters->XCutoffPixels();
+		const double pockelsoutval = (lineparameters->pockels()-lineparameters->pockels.ll())/(lineparameters->pockels.ul()-lineparameters->pockels.ll())
+			*daqparameters->outputs->maxoutputpockels()+daqparameters->outputs->minoutputpockels();							// scale pockels value from displayed value (e.g. 0..1) to device value (e.g. 0..2)
+		const Scaler<int16_t> scaletodevice(-daqparameters->outputs->range(), daqparameters->outputs->range());		// convert full device range to full range of int16_t
+		const int16_t blankdev = scaletodevice(0.0);
+		const int16_t pockelsdev = scaletodevice(pockelsoutval);
+		// Pockels is sample 3 of 4 for FullframeXYZP, sample 1 of 2 for LineZP
+		const size_t step_size = (filltype == ScannerVectorFillTypeHelper::FullframeXYZP) ? 4 : 2;
+		const size_t cp_init = (filltype == ScannerVectorFillTypeHelper::FullframeXYZP) ? 3 : 1;
+
+		// Pockels open on path pixels, blanked during cutoff and retrace
+		std::vector<int16_t> line(lineparameters->XTotalPixels(), blankdev);
+		std::fill(std::begin(line) + cutoff, std::begin(line) + cutoff + xres, pockelsdev);
+		std::vector<int16_t> pockels;
+		pockels.reserve(lineparameters->TotalPixels());
+		for ( uint32_t l = 0 ; l < lineparameters->YTotalLines() ; l++ )
+			pockels.insert(std::end(pockels), std::begin(line), std::end(line));
+
+		// Adjust for the scannerdelay by rotating the Pockels signal (do not respect oversampling, since pockels vector is with pixels, not oversampled input samples)
+		const int64_t length = static_cast<int64_t>(pockels.size());
+		const int64_t by = (static_cast<int64_t>(daqparameters->ScannerDelaySamples(false)) % length + length) % length;
+		std::rotate(std::begin(pockels), std::begin(pockels) + by, std::end(pockels));
+
+		int16_t* const vec = vecptr->data() + cp_init;
+		for ( size_t i = 0 ; i < pockels.size() ; i++ )
+			vec[i*step_size] = pockels[i];
+	}
+
+	void ScannerVectorLine::FillLookup() {
+		const uint32_t xres = lineparameters->xres();
+		const uint32_t cutoff = lineparameters->XCutoffPixels();
+		const uint32_t retrace = lineparameters->XRetracePixels();
+		uint32_t* const look = lookup->data();
+		size_t datapos = 0;
+		// pass l along the path goes into image line l, samples during cutoff and retrace are mapped to 0
+		for ( uint32_t l = 0 ; l < lineparameters->YTotalLines() ; l++ ) {
+			const uint32_t imagepos = l * xres;
+			for ( uint32_t x = 0 ; x < cutoff ; x++ )
+				look[datapos++] = 0;
+			for ( uint32_t x = 0 ; x < xres ; x++ )
+				look[datapos++] = imagepos + x;
+			for ( uint32_t x = 0 ; x < retrace ; x++ )
+				look[datapos++] = 0;
+		}
+
+		// Adjust for the scannerdelay by rotating the lookup vector (do not respect oversampling, since lookup is done on downsampled data
+		lookup_rotation = 0;
+		RotateLookup(daqparameters->ScannerDelaySamples(false));
+	}
+
+}
@@ -0,0 +1,57 @@
+#pragma once
+
+#include "ScannerVectorFrameBasic.h"
+
+namespace scope {
+
+/** Calculates scanner, fast z, and Pockels control voltages for a line scan along a straight or freehand path. The path is resampled at
+* equal arc length to xres pixels, before it the scanners accelerate along the extension of the first segment (cutoff), after it they
+* return smoothly to the beginning of the cutoff (retrace). One frame repeats the path yres times, the lookup vector maps pass l to image
+* line l, thus the image is a kymograph (position along the path vs. time). */
+class ScannerVectorLine
+	: public ScannerVectorFrameBasic {
+
+protected:
+	/** the scanner vector parameters, cast once per UpdateVector for the Fill functions */
+	parameters::ScannerVectorLine* lineparameters;
+
+	/** x and y voltages of all samples of one line (cutoff, path, retrace), calculated by CalculatePath */
+	std::vector<std::pair<double, double>> path;
+
+protected:
+	/** Calculate the scanner vector based on the current parameters, only the parts whose parameters changed are refilled */
+	void UpdateVector() override;
+
+	/** @return the base class inputs plus cutoff, retrace, and the path points */
+	FillInputs CurrentFillInputs() const override;
+
+	/** Calculates the x and y voltages of one line into path */
+	void CalculatePath();
+
+	/** Fill the samples for the x scanner axis */
+	void FillX();
+
+	/** Fill the samples for the y scanner axis */
+	void FillY();
+
+	/** Fill the samples for the fast z axis (stays constant here) */
+	void FillZ();
+
+	/** Fill the samples for the Pockels cell (open only on path pixels) */
+	void FillP();
+
+	/** Fill in the lookup vector */
+	void FillLookup();
+
+public:
+	/** @param[in] _filltype type of vector fill, see GetInterleavedVector for details. ScannerVectorFillTypeHelper::LineXPColumnYZ is not
+	* possible since x and y both change during a line. */
+	ScannerVectorLine(const ScannerVectorFillType& _filltype);
+
+	~ScannerVectorLine();
+};
+
+/** A shared pointer to a ScannerVectorLine */
+typedef std::shared_ptr<ScannerVectorLine> ScannerVectorLinePtr;
+
+}
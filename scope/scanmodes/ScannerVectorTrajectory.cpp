@@ -0,0 +1,173 @@
+#include "StdAfx.h"
+#include "ScannerVectorTrajectory.h"
+#include "helpers/ScopeTrace.h"
+
+namespace scope {
+
+	ScannerVectorTrajectory::ScannerVectorTrajectory(const ScannerVectorType& _type, const ScannerVectorFillType& _filltype)
+		: ScannerVectorFrameBasic(_type, _filltype)
+		, trajectoryparameters(nullptr) {
+	}
+
+	void ScannerVectorTrajectory::UpdateVector() {
+		ScopeTraceSpan span("ScannerVectorTrajectory::UpdateVector");
+		trajectoryparameters = dynamic_cast<parameters::ScannerVectorTrajectory*>(svparameters);
+		FillInputs current;
+		const uint32_t dirty = DirtyParts(current);
+		if ( (dirty == 0) || RestoreFromCache(current) )
+			return;
+
+		// Positions only depend on the geometry, but a cache hit before may have restored a vector of another geometry
+		if ( (dirty & (PartX | PartY | PartLookup)) && (current.geometry != positionsgeometry) ) {
+			xpositions.resize(svparameters->TotalPixels());
+			ypositions.resize(svparameters->TotalPixels());
+			CalculateTrajectory();
+			positionsgeometry = current.geometry;
+		}
+
+		switch ( filltype ) {
+		case ScannerVectorFillTypeHelper::FullframeXYZP:
+			// interleaved samples for x,y,z,pockels
+			vecptr->resize(4*svparameters->TotalPixels());
+			if ( dirty & PartX )
+				FillX();
+			if ( dirty & PartY )
+				FillY();
+			if ( dirty & PartZ )
+				FillZ();
+			if ( dirty & PartP )
+				FillP();
+			break;
+		case ScannerVectorFillTypeHelper::LineZP:
+			vecptr->resize(2*svparameters->TotalPixels());
+			if ( dirty & PartZ )
+				FillZ();
+			if ( dirty & PartP )
+				FillP();
+			break;
+		default:
+			throw ScopeException("Trajectory scans need full frame outputs, line clocked outputs are not possible");
+		}
+
+		lookup->resize(svparameters->TotalPixels());
+		if ( dirty & PartLookup )
+			FillLookup();
+		else
+			RotateLookup(daqparameters->ScannerDelaySamples(false));
+
+		lastinputs = std::move(current);
+		StoreInCache();
+	}
+
+	void ScannerVectorTrajectory::FillX() {
+		const Scaler<int16_t> scaletodevice(-daqparameters->outputs->range(), daqparameters->outputs->range());		// convert full device range to full range of int16_t
+		double xmin = 0.0;
+		double xrange = 0.0;
+		FieldRange(trajectoryparameters->xaspectratio() / trajectoryparameters->yaspectratio(), trajectoryparameters->xoffset(), xmin, xrange);
+		int16_t* const vec = vecptr->data();
+		for ( size_t i = 0 ; i < xpositions.size() ; i++ )
+			vec[4*i] = scaletodevice(xmin + xpositions[i] * xrange);
+	}
+
+	void ScannerVectorTrajectory::FillY() {
+		const Scaler<int16_t> scaletodevice(-daqparameters->outputs->range(), daqparameters->outputs->range());		// convert full device range to full range of int16_t
+		double ymin = 0.0;
+		double yrange = 0.0;
+		FieldRange(trajectoryparameters->yaspectratio() / trajectoryparameters->xaspectratio(), trajectoryparameters->yoffset(), ymin, yrange);
+		int16_t* const vec = vecptr->data() + 1;												// y starts at sample 1
+		for ( size_t i = 0 ; i < ypositions.size() ; i++ )
+			vec[4*i] = scaletodevice(ymin + ypositions[i] * yrange);
+	}
+
+	void ScannerVectorTrajectory::FillZ() {
+		const uint32_t framesamples(trajectoryparameters->TotalPixels());
+		const Scaler<int16_t> scaletodevice(-daqparameters->outputs->range(), daqparameters->outputs->range());	// convert full device range to full range of int16_t
+		const int16_t fastzoutdev = scaletodevice(zparameters->PositionToVoltage(svparameters->fastz()));					// get the voltage corresponding to current ETL position in micron and scale to device
+		// z is sample 2 of 4 for FullframeXYZP, sample 0 of 2 for LineZP
+		const size_t step_size = (filltype == ScannerVectorFillTypeHelper::FullframeXYZP) ? 4 : 2;
+		const size_t cz_init = (filltype == ScannerVectorFillTypeHelper::FullframeXYZP) ? 2 : 0;
+
+		int16_t* const vec = vecptr->data() + cz_init;
+		for ( size_t i = 0 ; i < step_size*framesamples ; i += step_size )
+			vec[i] = fastzoutdev;
+	}
+
+	void ScannerVectorTrajectory::FillP() {
+		const uint32_t framesamples(trajectoryparameters->TotalPixels());
+		const double pockelsoutval = (trajectoryparameters->pockels()-trajectoryparameters->pockels.ll())/(trajectoryparameters->pockels.ul()-trajectoryparameters->pockels.ll())
+			*daqparameters->outputs->maxoutputpockels()+daqparameters->outputs->minoutputpockels();							// scale pockels value from displayed value (e.g. 0..1) to device value (e.g. 0..2)
+		const Scaler<int16_t> scaletodevice(-daqparameters->outputs->range(), daqparameters->outputs->range());		// convert full device range to full range of int16_t
+		const int16_t pockelsdev = scaletodevice(pockelsoutval);
+		// Pockels is sample 3 of 4 for FullframeXYZP, sample 1 of 2 for LineZP
+		const size_t step_size = (filltype == ScannerVectorFillTypeHelper::FullframeXYZP) ? 4 : 2;
+		const size_t cp_init = (filltype == ScannerVectorFillTypeHelper::FullframeXYZP) ? 3 : 1;
+
+		// Every sample is an image sample, no blanking
+		int16_t* const vec = vecptr->data() + cp_init;
+		for ( size_t i = 0 ; i < step_size*framesamples ; i += step_size )
+			vec[i] = pockelsdev;
+	}
+
+	void ScannerVectorTrajectory::FillLookup() {
+		const uint32_t xres = trajectoryparameters->xres();
+		const uint32_t yres = trajectoryparameters->yres();
+		uint32_t* const look = lookup->data();
+		for ( size_t i = 0 ; i < xpositions.size() ; i++ ) {
+			const size_t column = std::min<size_t>(xres - 1, static_cast<size_t>(std::max(0.0, xpositions[i] * xres)));
+			const size_t row = std::min<size_t>(yres - 1, static_cast<size_t>(std::max(0.0, ypositions[i] * yres)));
+			look[i] = static_cast<uint32_t>(row * xres + column);
+		}
+
+		// Adjust for the scannerdelay by rotating the lookup vector (do not respect oversampling, since lookup is done on downsampled data
+		lookup_rotation = 0;
+		RotateLookup(daqparameters->ScannerDelaySamples(false));
+	}
+
+	ScannerVectorLissajous::ScannerVectorLissajous(const ScannerVectorFillType& _filltype)
+		: ScannerVectorTrajectory(ScannerVectorTypeHelper::Lissajous, _filltype) {
+	}
+
+	ScannerVectorFrameBasic::FillInputs ScannerVectorLissajous::CurrentFillInputs() const {
+		FillInputs in(ScannerVectorTrajectory::CurrentFillInputs());
+		const parameters::ScannerVectorLissajous* const params = dynamic_cast<parameters::ScannerVectorLissajous*>(svparameters);
+		in.geometry.push_back(static_cast<double>(params->ycycles()));
+		return in;
+	}
+
+	void ScannerVectorLissajous::CalculateTrajectory() {
+		const parameters::ScannerVectorLissajous* const params = dynamic_cast<parameters::ScannerVectorLissajous*>(svparameters);
+		const double a = params->xcycles();
+		const double b = params->ycycles();
+		// With both cycle numbers odd the figure runs through itself backwards after half a frame (half of the samples wasted),
+		// a small phase offset of x breaks that symmetry
+		const double phase = ((params->xcycles() % 2 == 1) && (params->ycycles() % 2 == 1)) ? M_PI / (2.0 * b) : 0.0;
+		const double n = static_cast<double>(xpositions.size());
+		for ( size_t i = 0 ; i < xpositions.size() ; i++ ) {
+			const double u = 2.0 * M_PI * static_cast<double>(i) / n;
+			xpositions[i] = 0.5 + 0.5 * std::sin(a * u + phase);
+			ypositions[i] = 0.5 + 0.5 * std::sin(b * u);
+		}
+	}
+
+	ScannerVectorSpiral::ScannerVectorSpiral(const ScannerVectorFillType& _filltype)
+		: ScannerVectorTrajectory(ScannerVectorTypeHelper::Spiral, _filltype) {
+	}
+
+	void ScannerVectorSpiral::CalculateTrajectory() {
+		const parameters::ScannerVectorSpiral* const params = dynamic_cast<parameters::ScannerVectorSpiral*>(svparameters);
+		const double turns = params->turns();
+		const double n = static_cast<double>(xpositions.size());
+		for ( size_t i = 0 ; i < xpositions.size() ; i++ ) {
+			const double u = static_cast<double>(i) / n;
+			// Path length of an Archimedean spiral grows with the square of the radius, r = sqrt(s) gives constant path speed.
+			// Outwards in the first half, inwards in the second, the angle keeps increasing so that the rotation does not reverse.
+			// Inwards takes half a revolution more, thus the beam arrives at the center from the opposite side and passes straight through.
+			const double s = (u < 0.5) ? 2.0 * u : 2.0 - 2.0 * u;
+			const double r = std::sqrt(s);
+			const double theta = (u < 0.5) ? 2.0 * M_PI * turns * r : 2.0 * M_PI * turns + (2.0 * M_PI * turns + M_PI) * (1.0 - r);
+			xpositions[i] = 0.5 + 0.5 * r * std::cos(theta);
+			ypositions[i] = 0.5 + 0.5 * r * std::sin(theta);
+		}
+	}
+
+}
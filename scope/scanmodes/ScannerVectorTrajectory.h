@@ -0,0 +1,88 @@
+#pragma once
+
+#include "ScannerVectorFrameBasic.h"
+
+namespace scope {
+
+/** Base class for smooth trajectory scans. The derived classes calculate the position of every sample in the field, from these the x and
+* y voltages and the lookup vector are filled. Every sample is mapped into the image, pixels that are hit several times per frame are
+* averaged by PixelmapperTrajectory with weights precomputed from the lookup vector. Fast z and Pockels stay constant. */
+class ScannerVectorTrajectory
+	: public ScannerVectorFrameBasic {
+
+protected:
+	/** the scanner vector parameters, cast once per UpdateVector for the Fill functions */
+	parameters::ScannerVectorTrajectory* trajectoryparameters;
+
+	/** x position of every sample as fraction of the field (0..1), calculated by the derived class */
+	std::vector<double> xpositions;
+
+	/** y position of every sample as fraction of the field (0..1), calculated by the derived class */
+	std::vector<double> ypositions;
+
+	/** the geometry inputs xpositions and ypositions were calculated for */
+	std::vector<double> positionsgeometry;
+
+protected:
+	/** Calculate the scanner vector based on the current parameters, only the parts whose parameters changed are refilled */
+	void UpdateVector() override;
+
+	/** Calculates xpositions and ypositions for all TotalPixels samples of a frame. The trajectory has to close, i.e. the sample after
+	* the last is the first sample of the next frame. */
+	virtual void CalculateTrajectory() = 0;
+
+	/** Fill the samples for the x scanner axis */
+	void FillX();
+
+	/** Fill the samples for the y scanner axis */
+	void FillY();
+
+	/** Fill the samples for the fast z axis (stays constant here) */
+	void FillZ();
+
+	/** Fill the samples for the Pockels cell (stays open here) */
+	void FillP();
+
+	/** Fill in the lookup vector, the pixel each sample is in */
+	void FillLookup();
+
+	/** @param[in] _type the type of the derived scanner vector
+	* @param[in] _filltype type of vector fill, see GetInterleavedVector for details. ScannerVectorFillTypeHelper::LineXPColumnYZ is not
+	* possible since x and y both change all the time. */
+	ScannerVectorTrajectory(const ScannerVectorType& _type, const ScannerVectorFillType& _filltype);
+};
+
+/** Lissajous scan, x and y are sines with XCycles and YCycles periods per frame */
+class ScannerVectorLissajous
+	: public ScannerVectorTrajectory {
+
+protected:
+	/** @return the base class inputs plus the y cycles (x cycles are the lines) */
+	FillInputs CurrentFillInputs() const override;
+
+	void CalculateTrajectory() override;
+
+public:
+	/** @param[in] _filltype type of vector fill, see GetInterleavedVector for details */
+	ScannerVectorLissajous(const ScannerVectorFillType& _filltype);
+};
+
+/** Archimedean spiral scan from the center out and back in, at constant path speed */
+class ScannerVectorSpiral
+	: public ScannerVectorTrajectory {
+
+protected:
+	void CalculateTrajectory() override;
+
+public:
+	/** @param[in] _filltype type of vector fill, see GetInterleavedVector for details */
+	ScannerVectorSpiral(const ScannerVectorFillType& _filltype);
+};
+
+/** A shared pointer to a ScannerVectorLissajous */
+typedef std::shared_ptr<ScannerVectorLissajous> ScannerVectorLissajousPtr;
+
+/** A shared pointer to a ScannerVectorSpiral */
+typedef std::shared_ptr<ScannerVectorSpiral> ScannerVectorSpiralPtr;
+
+}
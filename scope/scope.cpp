@@ -3,6 +3,9 @@
 #include "config\config_choices.h"
 #include "TheScope.h"
 #include "controllers/ScopeLogger.h"
+#include "controllers/ScopeBenchmark.h"
+#include "helpers/ScopeTrace.h"
+#include "helpers/DiagnosticLog.h"
 #include "version.h"
 
 /** @file scope/scope.cpp This is the main file for the Scope.exe */
@@ -65,6 +68,7 @@ int Run(HINSTANCE hInstance) {
 		std::this_thread::sleep_for(std::chrono::milliseconds(20));				// Move this around on debug build mutex bug
 			
 		scope::ScopeLogger::GetInstance().SetFilepath(myscope.GetStorageFolder()+L"\\"+GetCurrentDateString());
+		scope::DiagnosticLog::GetInstance().SetFilepath(myscope.GetStorageFolder()+L"\\"+GetCurrentDateString());
 
 		// Create the main window
 		myscope.CreateAndShowMainWindow();
@@ -105,10 +109,53 @@ int Run(HINSTANCE hInstance) {
 	}
 	
 	_Module.RemoveMessageLoop();
+	// Diagnostics pass warnings on to the ScopeLogger, thus shut them down first
+	scope::DiagnosticLog::GetInstance().Shutdown();
 	scope::ScopeLogger::GetInstance().Shutdown();
 	return nRet;
 }
 
+/** Run the headless benchmark (see scope::ScopeBenchmarkOptions::Parse for the command line options), no windows are created.
+* The report goes to the console of the calling process (or a new console) and optionally into a file. */
+int RunBenchmark(const std::wstring& _cmdline) {
+	if ( !::AttachConsole(ATTACH_PARENT_PROCESS) )
+		::AllocConsole();
+	HANDLE console = ::GetStdHandle(STD_OUTPUT_HANDLE);
+	auto print = [&console](const std::wstring& _text) {
+		DWORD written = 0;
+		::WriteConsole(console, _text.c_str(), static_cast<DWORD>(_text.size()), &written, NULL);
+	};
+
+	int nRet = 0;
+	try {
+		const scope::ScopeBenchmarkOptions options(scope::ScopeBenchmarkOptions::Parse(_cmdline));
+		print(L"\nRunning Scope benchmark for " + std::to_wstring(options.duration) + L" s\n");
+		scope::ScopeBenchmark benchmark(options);
+		const std::wstring report(benchmark.Run());
+		print(report);
+		if ( !options.reportfile.empty() ) {
+			std::wofstream file(options.reportfile);
+			file << report;
+		}
+	}
+	catch (std::exception& e) {
+		print(L"Benchmark failed: " + std::wstring(CA2W(e.what())) + L"\n");
+		nRet = -1;
+	}
+	// Anything else has to be handled here too, the logger ScopeExceptionHandler logs to is shut down below
+	catch (...) {
+		scope::ScopeExceptionHandler(__FUNCTION__);
+		print(L"Benchmark failed with an unknown exception\n");
+		nRet = -1;
+	}
+
+	// Diagnostics pass warnings on to the ScopeLogger, thus shut them down first
+	scope::DiagnosticLog::GetInstance().Shutdown();
+	scope::ScopeLogger::GetInstance().Shutdown();
+	::FreeConsole();
+	return nRet;
+}
+
 int WINAPI wWinMain(HINSTANCE hInstance, HINSTANCE /*hPrevInstance*/, LPTSTR lpstrCmdLine, int nCmdShow) {
 	// Uncomment these to get a memory dump on exit
 
@@ -138,7 +185,30 @@ int WINAPI wWinMain(HINSTANCE hInstance, HINSTANCE /*hPrevInstance*/, LPTSTR lps
 	HMODULE hInstRich = ::LoadLibrary(CRichEditCtrl::GetLibraryName());
 	assert(hInstRich != NULL);
 
-	int32_t nRet = Run(hInstance);
+	// "scope.exe /benchmark ..." runs the acquisition chain headless, otherwise start the GUI
+	int32_t nRet = 0;
+	if ( std::wstring(lpstrCmdLine).find(L"/benchmark") != std::wstring::npos )
+		nRet = RunBenchmark(lpstrCmdLine);
+	else {
+		// "scope.exe /trace=file.json" traces the acquisition stages of the whole session and writes the trace on exit
+		// (quote paths with spaces, e.g. /trace="C:\my traces\session.json")
+		std::wstring tracefile(L"");
+		for ( const auto& arg : SplitCommandLine(lpstrCmdLine) ) {
+			if ( arg.compare(0, 7, L"/trace=") == 0 )
+				tracefile = arg.substr(7);
+		}
+		if ( !tracefile.empty() )
+			scope::ScopeTracer::GetInstance().Enable(true);
+		nRet = Run(hInstance);
+		if ( !tracefile.empty() ) {
+			try {
+				scope::ScopeTracer::GetInstance().Enable(false);
+				scope::ScopeTracer::GetInstance().ExportChromeTrace(tracefile);
+			}
+			// The logger is already shut down
+			catch (...) { scope::ScopeExceptionHandler(__FUNCTION__, false, true); }
+		}
+	}
 
 	// Unload RichEdit library
 	::FreeLibrary(hInstRich);
@@ -116,8 +116,12 @@ extern CAppModule _Module;
 // Some common STL stuff
 #include <array>
 #include <sstream>
+#include <iomanip>
 #include <vector>
 #include <map>
+#include <set>
+#include <list>
+#include <unordered_map>
 #include <numeric>
 #include <memory>
 #include <deque>
@@ -127,6 +131,7 @@ extern CAppModule _Module;
 #include <fstream>
 #include <chrono>
 #include <mutex>
+#include <shared_mutex>
 #include <thread>
 #include <atomic>
 #include <condition_variable>